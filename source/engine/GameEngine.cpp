@@ -1,5 +1,7 @@
 #include "GameEngine.h"
 
+#include <thread>
+
 
 GameEngine::GameEngine() {
 	m_Quit = false;
@@ -18,29 +20,75 @@ void GameEngine::Init() {
 
 	m_PlatformFileSys = new PlatformFileSystem();
 
-	m_TexRegistry = new TextureRegistry();
-	m_Resource = new ResourceManager(m_PlatformFileSys, m_TexRegistry);
-	m_Input = new InputManager(this, m_PlatformInput);
-	m_Render = new Renderer(m_PlatformWindow);
+	BaseMemSetBudget(kMemTagResource, kGameEngineResourceBudget);
+	BaseMemSetBudget(kMemTagPhysics, kGameEnginePhysicsBudget);
+	BaseMemSetBudget(kMemTagEntity, kGameEngineEntityBudget);
+	BaseMemSetBudget(kMemTagRender, kGameEngineRenderBudget);
+
+	m_FrameAlloc = MEM_NEW FrameAllocator(kGameEngineFrameMemory, kFrameBufferingDouble);
+
+	// Jobs run on all cores besides the one running the main loop, which
+	// also runs jobs while it waits for them
+	unsigned int coreCount = std::thread::hardware_concurrency();
+	m_JobSystem = MEM_NEW JobSystem(coreCount > 1 ? (int)coreCount - 1 : 0);
+
+	{
+		MemTagScope tag(kMemTagRender);
+
+		m_TexRegistry = MEM_NEW TextureRegistry();
+	}
+
+	{
+		MemTagScope tag(kMemTagResource);
+
+		m_Resource = MEM_NEW ResourceManager(m_PlatformFileSys, m_TexRegistry);
+		m_Resource->SetJobSystem(m_JobSystem);
+	}
+
+	m_Input = MEM_NEW InputManager(this, m_PlatformInput);
+
+	{
+		MemTagScope tag(kMemTagRender);
+
+		m_Render = MEM_NEW Renderer(m_PlatformWindow);
+	}
+
+	{
+		MemTagScope tag(kMemTagPhysics);
+
+		m_PhysWorld = MEM_NEW PhysWorld();
+		m_PhysWorld->SetJobSystem(m_JobSystem);
+	}
 
-	m_PhysWorld = new PhysWorld();
-	m_EntityManager = new EntityManager(m_PhysWorld);
-	m_Scene = new Scene(m_PlatformWindow);
+	{
+		MemTagScope tag(kMemTagEntity);
 
-	m_StateMachine = new GameStateMachine();
+		m_EntityManager = MEM_NEW EntityManager(m_PhysWorld);
+		m_Scene = MEM_NEW Scene(m_PlatformWindow);
+		m_Scene->SetJobSystem(m_JobSystem);
+	}
+
+	m_StateMachine = MEM_NEW GameStateMachine();
 }
 
 void GameEngine::Shutdown() {
-	delete m_StateMachine;
+#if defined(_MEM_TRACKING)
+	// Usage at the end of the session, before the subsystems free everything
+	BaseMemLogReport();
+#endif
+
+	MEM_DELETE(m_StateMachine);
 
-	delete m_Scene;
-	delete m_EntityManager;
-	delete m_PhysWorld;
+	MEM_DELETE(m_Scene);
+	MEM_DELETE(m_EntityManager);
+	MEM_DELETE(m_PhysWorld);
 
-	delete m_Render;
-	delete m_Input;
-	delete m_Resource;
-	delete m_TexRegistry;
+	MEM_DELETE(m_Render);
+	MEM_DELETE(m_Input);
+	MEM_DELETE(m_Resource);
+	MEM_DELETE(m_TexRegistry);
+	MEM_DELETE(m_JobSystem);
+	MEM_DELETE(m_FrameAlloc);
 
 	delete m_PlatformFileSys;
 	delete m_PlatformInput;
@@ -50,30 +98,55 @@ void GameEngine::Shutdown() {
 
 void GameEngine::MainLoop() {
 
+	m_Clock.Reset();
+
 	while (!m_Quit) {
-		m_StateMachine->Update();
+		// Frees the scratch memory of the loop before last
+		m_FrameAlloc->NextFrame();
 
 		// Update the resource manager;
-		m_Resource->Update();
+		{
+			MemTagScope tag(kMemTagResource);
+
+			m_Resource->Update();
+		}
 
 		// Update input
 		m_Input->Update();
 
-		// Update physics
-		m_PhysWorld->Update();
+		// Runs as many steps as real time has passed, up to the clock's limit
+		int stepCount = m_Clock.Tick();
+
+		for (int i = 0; i < stepCount && !m_Quit; ++i) {
+			m_Scene->StoreRenderState();
+
+			m_StateMachine->Update();
+
+			// Update physics
+			{
+				MemTagScope tag(kMemTagPhysics);
+
+				m_PhysWorld->Update();
+			}
+
+			// Update scene
+			{
+				MemTagScope tag(kMemTagEntity);
 
-		// Update scene
-		m_Scene->Update();
+				m_Scene->Update();
+			}
+		}
 
 
 		// Rendering logic
+		MemTagScope tag(kMemTagRender);
 
 		// Sets up before any rendering
 		m_Render->PreRender();
 
 		//m_Render->Render();
 
-		m_Scene->Render();
+		m_Scene->Render(m_Clock.GetAlpha());
 
 		m_Render->PostRender();
 	}
@@ -5,6 +5,8 @@
 
 #include "platform/platform_include.h"
 
+#include "allocator/FrameAllocator.h"
+#include "job/JobSystem.h"
 #include "render/TextureRegistry.h"
 #include "resource/ResourceManager.h"
 #include "input/InputManager.h"
@@ -13,6 +15,17 @@
 #include "entity/EntityManager.h"
 #include "entity/Scene.h"
 #include "state/GameStateMachine.h"
+#include "time/GameClock.h"
+
+// Bytes of scratch memory in each buffer of the frame allocator
+const size_t kGameEngineFrameMemory = 1024 * 1024;
+
+// Memory budgets of the subsystems; a warning is logged when a subsystem
+// goes over its budget, see base_memory.h
+const size_t kGameEngineResourceBudget = MEGABYTES_TO_BYTES(320);
+const size_t kGameEnginePhysicsBudget = MEGABYTES_TO_BYTES(64);
+const size_t kGameEngineEntityBudget = MEGABYTES_TO_BYTES(64);
+const size_t kGameEngineRenderBudget = MEGABYTES_TO_BYTES(128);
 
 // Forward declarations
 
@@ -34,11 +47,19 @@ public:
 	void Shutdown();
 
 	// Main loop of the game
+	//
+	// Simulates the game in fixed steps of the clock and renders once per
+	// loop, interpolating between the last two steps
 	void MainLoop();
 
 	// Quits the game
 	void QuitGame();
 
+	// Scratch memory that is freed at the end of the next loop, so data
+	// allocated in one loop can still be read in the following one
+	FrameAllocator* GetFrameAllocator() { return m_FrameAlloc; }
+
+	JobSystem* GetJobSystem() { return m_JobSystem; }
 	TextureRegistry* GetTextureRegistry() { return m_TexRegistry; }
 	ResourceManager* GetResourceManager() { return m_Resource; }
 	InputManager* GetInputManager() { return m_Input; }
@@ -46,6 +67,7 @@ public:
 	EntityManager* GetEntityManager() { return m_EntityManager; }
 	Scene* GetScene() { return m_Scene; }
 	GameStateMachine* GetStateMachine() { return m_StateMachine; }
+	GameClock* GetClock() { return &m_Clock; }
 
 private:
 	PlatformApp* m_PlatformApp;
@@ -54,6 +76,8 @@ private:
 	PlatformFileSystem* m_PlatformFileSys;
 
 	// Engine subsystems
+	FrameAllocator* m_FrameAlloc;
+	JobSystem* m_JobSystem;
 	TextureRegistry* m_TexRegistry;
 	ResourceManager* m_Resource;
 	InputManager* m_Input;
@@ -65,6 +89,9 @@ private:
 
 	GameStateMachine* m_StateMachine;
 
+	// Decides how many simulation steps run in each loop
+	GameClock m_Clock;
+
 	// Shutdown engine if true
 	bool m_Quit;
 };
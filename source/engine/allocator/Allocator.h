@@ -4,6 +4,7 @@
 #include "base_include.h"
 
 #include <stdlib.h>
+#include <cstring>
 
 //--------------------------------------------------
 //
@@ -22,18 +23,77 @@ const int kAllocatorDefaultAlignment = 16;
 //
 // Interface for all memory allocators
 //
+// Containers take an IAllocator* so that a subsystem can decide where their
+// memory comes from, e.g. a frame arena for data that only lives for a
+// frame. Containers that are given no allocator use GetDefaultAllocator()
+//
 //--------------------------------------------------
 class IAllocator {
 
 public:
 	virtual ~IAllocator() {}
 
-	virtual void AllocAligned(size_t size, size_t alignment) = 0;
+	// Allocates memory of the specified size with the correct alignment
+	//
+	// Alignment must be a power of 2. Returns nullptr if the allocator is out
+	// of memory
+	virtual void* AllocAligned(size_t size, size_t alignment) = 0;
+
+	// Allocates memory of the specified size with the default alignment of
+	// the allocator. Returns nullptr if the allocator is out of memory
+	virtual void* Alloc(size_t size) = 0;
+
+	// Frees memory allocated from this allocator. Does nothing for nullptr
+	virtual void Dealloc(void* ptr) = 0;
+
+	// Resizes memory allocated from this allocator to size bytes, keeping
+	// its first min(oldSize, size) bytes. The memory may move
+	//
+	// ptr may be nullptr, in which case oldSize MUST be 0. Returns nullptr,
+	// and leaves ptr allocated, if the allocator is out of memory
+	//
+	// The default allocates new memory, copies and frees the old memory
+	virtual void* Realloc(void* ptr, size_t oldSize, size_t size, size_t alignment) {
+		void* newPtr = AllocAligned(size, alignment);
+
+		if (newPtr == nullptr) {
+			return nullptr;
+		}
+
+		if (ptr != nullptr) {
+			memcpy(newPtr, ptr, oldSize < size ? oldSize : size);
+
+			Dealloc(ptr);
+		}
+
+		return newPtr;
+	}
 
-	virtual void Alloc(size_t size) = 0;
+	// Bytes in use, as counted by the allocator
+	virtual size_t GetUsedSize() const = 0;
+
+	// Number of allocations in use, as counted by the allocator
+	virtual size_t GetAllocCount() const = 0;
 };
 
-// Returns the num of bytes needed to offset the address so that it is 
+// Returns the allocator of the general heap, which any thread may use
+IAllocator* GetDefaultAllocator();
+
+// Allocates raw memory for count objects T from the allocator
+//
+// Objects are NOT constructed. Asserts if the allocator is out of memory
+template<typename T>
+inline T* AllocArray(IAllocator* allocator, size_t count) {
+	ASSERT(allocator != nullptr);
+
+	T* data = (T*)allocator->AllocAligned(sizeof(T) * count, alignof(T));
+
+	ASSERT(data != nullptr || count == 0);
+
+	return data;
+}
+
+// Returns the num of bytes needed to offset the address so that it is
 // aligned
 //
 // Alignment must be a power of 2 (usually 4 or 16) and below 32
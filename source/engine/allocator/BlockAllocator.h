@@ -39,8 +39,8 @@ struct BlockAllocHeader {
 // Once all objects have been deallocated from a block, the block will be 
 // freed for reuse. 
 //
-// Allocator also supports defragmentation. Use it sparingly as it is a COSTLY
-// operation
+// Blocks are never moved, so pointers into them stay valid. See
+// TlsfAllocator::Defragment() for memory that can be compacted
 //
 //--------------------------------------------------
 class BlockAllocator {
@@ -57,12 +57,6 @@ public:
 	void* Alloc(size_t size);
 	void Dealloc(void* ptr);
 
-	// Defragments the memory by repeatedly moving the last block to empty 
-	// blocks in front of it
-	//
-	// COSTLY operation
-	void Defragment();
-
 public:
 	size_t GetBlockMax() const { return m_BlockCount; }
 	size_t GetBlockSize() const { return m_BlockSize; }
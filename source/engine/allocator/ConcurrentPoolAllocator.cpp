@@ -0,0 +1,62 @@
+#include "ConcurrentPoolAllocator.h"
+
+// Bit i is set while thread index i is used by a running thread
+static std::atomic<uint64_t> s_UsedThreadIndices(0);
+
+//--------------------------------------------------
+//
+// ConcurrentPoolThread
+//
+// Frees the thread index of a thread when the thread exits
+//
+//--------------------------------------------------
+class ConcurrentPoolThread {
+
+public:
+	ConcurrentPoolThread() {
+		m_Index = -1;
+	}
+
+	~ConcurrentPoolThread() {
+		if (m_Index >= 0) {
+			s_UsedThreadIndices.fetch_and(~((uint64_t)1 << m_Index), std::memory_order_release);
+		}
+	}
+
+	int GetIndex() {
+		if (m_Index < 0) {
+			m_Index = AcquireIndex();
+		}
+
+		return m_Index;
+	}
+
+private:
+	// Takes the lowest free index
+	static int AcquireIndex() {
+		uint64_t used = s_UsedThreadIndices.load(std::memory_order_relaxed);
+
+		while (true) {
+			ASSERT(used != ~(uint64_t)0);
+
+			int index = 0;
+
+			while ((used & ((uint64_t)1 << index)) != 0) {
+				++index;
+			}
+
+			if (s_UsedThreadIndices.compare_exchange_weak(used, used | ((uint64_t)1 << index),
+														  std::memory_order_acquire, std::memory_order_relaxed)) {
+				return index;
+			}
+		}
+	}
+
+	int m_Index;
+};
+
+static thread_local ConcurrentPoolThread s_Thread;
+
+int ConcurrentPoolGetThreadIndex() {
+	return s_Thread.GetIndex();
+}
\ No newline at end of file
@@ -0,0 +1,360 @@
+#ifndef CONCURRENTPOOLALLOCATOR_H_
+#define CONCURRENTPOOLALLOCATOR_H_
+
+#include "base_include.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <type_traits>
+
+// Max number of threads that can use concurrent pools at the same time
+const int kConcurrentPoolThreadMax = 64;
+
+// Number of chunks that are moved between a thread cache and the shared free
+// list at once
+const int kConcurrentPoolBatchSize = 32;
+
+// Max number of blocks in a pool. Blocks double in size, so a pool runs out
+// of chunk indices before it runs out of blocks
+const int kConcurrentPoolBlockMax = 32;
+
+// Size of a cache line, used to keep the caches of different threads apart
+const size_t kConcurrentPoolCacheLineSize = 64;
+
+// Returns the index of the calling thread in [0, kConcurrentPoolThreadMax)
+//
+// Indices are unique among the running threads. The index of a thread is
+// given to a later thread once the thread exits
+int ConcurrentPoolGetThreadIndex();
+
+//--------------------------------------------------
+//
+// ConcurrentPoolAllocator
+//
+// Pool of chunks large enough to contain object T that any thread can
+// allocate from and deallocate to
+//
+// Every thread keeps a cache of free chunks in the pool, so most calls only
+// touch memory of the calling thread. An empty cache takes a batch of
+// kConcurrentPoolBatchSize chunks from a shared lock-free list, and a cache
+// that holds two batches returns one to it. Chunks freed on one thread can
+// be allocated on any other
+//
+// When the shared list is empty, batches are carved from the top of the
+// newest block. When the blocks are used up, the pool allocates another
+// block with as many chunks as all the previous ones. Blocks are raw memory,
+// so no T is constructed until the client constructs it, and chunks never
+// move, so pointers to them stay valid as the pool grows
+//
+// The shared list refers to chunks by a 32-bit index and is tagged with a
+// counter, so a batch that is taken and returned between a thread's read of
+// the list and its update is detected
+//
+// IMPT: client MUST manually construct and destruct each object in the pool,
+// and no thread may use the pool while it is destroyed
+//
+//--------------------------------------------------
+template<typename T>
+class ConcurrentPoolAllocator {
+
+public:
+	// Allocates the first block with num chunks, rounded up to a multiple of
+	// the batch size
+	//
+	// num must be greater than 0
+	explicit ConcurrentPoolAllocator(size_t num) {
+		ASSERT(num > 0);
+
+		m_Blocks[0] = nullptr;
+		m_BlockCount = 0;
+
+		m_Capacity = 0;
+		m_Top = 0;
+
+		m_SharedHead = kNoChunk;
+
+		m_Caches = MEM_NEW ThreadCache[kConcurrentPoolThreadMax];
+
+		for (int i = 0; i < kConcurrentPoolThreadMax; ++i) {
+			m_Caches[i].head = nullptr;
+			m_Caches[i].count = 0;
+		}
+
+		size_t batchNum = (num + kConcurrentPoolBatchSize - 1) / kConcurrentPoolBatchSize;
+
+		AddBlock(batchNum * kConcurrentPoolBatchSize);
+	}
+
+	// Deallocates all blocks
+	~ConcurrentPoolAllocator() {
+		int blockCount = m_BlockCount.load(std::memory_order_acquire);
+
+		for (int i = 0; i < blockCount; ++i) {
+			MEM_DELETE_ARR(m_Blocks[i]);
+		}
+
+		MEM_DELETE_ARR(m_Caches);
+	}
+
+	// Allocates a chunk from the cache of the calling thread, refilling the
+	// cache if it is empty
+	T* Alloc() {
+		ThreadCache& cache = m_Caches[ConcurrentPoolGetThreadIndex()];
+
+		if (cache.head == nullptr) {
+			cache.head = AllocBatch();
+			cache.count = kConcurrentPoolBatchSize;
+		}
+
+		FreeChunk* chunk = cache.head;
+
+		cache.head = chunk->next;
+		--cache.count;
+
+		return (T*)chunk;
+	}
+
+	// Deallocates the chunk pointed to by ptr to the cache of the calling
+	// thread. Ptr must be a chunk that was allocated from this pool, on any
+	// thread
+	//
+	// Returns a batch to the shared list if the cache holds two batches
+	void Dealloc(T* ptr) {
+		ASSERT(GetChunkIndex(ptr) != kNoChunk);
+
+		ThreadCache& cache = m_Caches[ConcurrentPoolGetThreadIndex()];
+
+		FreeChunk* chunk = new(ptr) FreeChunk;
+
+		chunk->next = cache.head;
+
+		cache.head = chunk;
+		++cache.count;
+
+		if (cache.count >= 2 * kConcurrentPoolBatchSize) {
+			FreeChunk* batch = cache.head;
+			FreeChunk* last = batch;
+
+			for (int i = 1; i < kConcurrentPoolBatchSize; ++i) {
+				last = last->next;
+			}
+
+			cache.head = last->next;
+			cache.count -= kConcurrentPoolBatchSize;
+
+			last->next = nullptr;
+
+			PushBatch(batch);
+		}
+	}
+
+	// Total number of chunks in all blocks
+	size_t GetChunkNum() const {
+		return m_Capacity.load(std::memory_order_relaxed);
+	}
+
+private:
+	// Layout of a free chunk
+	struct FreeChunk {
+		// Next chunk in the thread cache or in the batch
+		FreeChunk* next;
+
+		// Index of the first chunk of the next batch in the shared list. Only
+		// set on the first chunk of a batch
+		std::atomic<uint32_t> nextBatch;
+	};
+
+	// Chunks are large enough to hold a FreeChunk while they are free
+	static const size_t kChunkSize = sizeof(T) > sizeof(FreeChunk) ? sizeof(T) : sizeof(FreeChunk);
+	static const size_t kChunkAlignment = alignof(T) > alignof(FreeChunk) ? alignof(T) : alignof(FreeChunk);
+
+	typedef typename std::aligned_storage<kChunkSize, kChunkAlignment>::type Storage;
+
+	// Index of no chunk; ends the shared list
+	static const uint32_t kNoChunk = 0xFFFFFFFF;
+
+	// Free chunks of a thread, padded to a cache line
+	struct ThreadCache {
+		FreeChunk* head;
+		int count;
+
+		char pad[kConcurrentPoolCacheLineSize - sizeof(FreeChunk*) - sizeof(int)];
+	};
+
+	// Takes a batch from the shared list, carves one from the top of the
+	// blocks if the list is empty, or adds a block if the blocks are used up
+	FreeChunk* AllocBatch() {
+		while (true) {
+			FreeChunk* batch = PopBatch();
+
+			if (batch != nullptr) {
+				return batch;
+			}
+
+			batch = CarveBatch();
+
+			if (batch != nullptr) {
+				return batch;
+			}
+
+			std::lock_guard<std::mutex> lock(m_GrowMutex);
+
+			// Another thread may have added a block or returned a batch while
+			// this one waited for the lock
+			if ((uint32_t)m_SharedHead.load(std::memory_order_acquire) != kNoChunk ||
+				m_Top.load(std::memory_order_relaxed) < m_Capacity.load(std::memory_order_relaxed)) {
+				continue;
+			}
+
+			AddBlock(m_Capacity.load(std::memory_order_relaxed));
+		}
+	}
+
+	// Returns nullptr if the shared list is empty
+	FreeChunk* PopBatch() {
+		uint64_t head = m_SharedHead.load(std::memory_order_acquire);
+
+		while ((uint32_t)head != kNoChunk) {
+			FreeChunk* batch = GetChunk((uint32_t)head);
+
+			// If another thread took the batch since head was read, the
+			// chunk may already be in use and the value read is garbage, but
+			// then the tag has changed and the exchange fails
+			uint32_t next = batch->nextBatch.load(std::memory_order_relaxed);
+
+			if (m_SharedHead.compare_exchange_weak(head, MakeHead(head, next), std::memory_order_acquire,
+												   std::memory_order_acquire)) {
+				return batch;
+			}
+		}
+
+		return nullptr;
+	}
+
+	// Adds the batch to the front of the shared list
+	void PushBatch(FreeChunk* batch) {
+		uint32_t index = GetChunkIndex((T*)batch);
+		uint64_t head = m_SharedHead.load(std::memory_order_relaxed);
+
+		do {
+			batch->nextBatch.store((uint32_t)head, std::memory_order_relaxed);
+		} while (!m_SharedHead.compare_exchange_weak(head, MakeHead(head, index), std::memory_order_release,
+													 std::memory_order_relaxed));
+	}
+
+	// Links the next batch of unused chunks at the top of the blocks.
+	// Returns nullptr if all chunks in the blocks have been carved
+	FreeChunk* CarveBatch() {
+		uint32_t top = m_Top.load(std::memory_order_relaxed);
+
+		do {
+			if (top >= m_Capacity.load(std::memory_order_acquire)) {
+				return nullptr;
+			}
+		} while (!m_Top.compare_exchange_weak(top, top + kConcurrentPoolBatchSize, std::memory_order_relaxed));
+
+		// Blocks are multiples of the batch size, so the batch is in one block
+		FreeChunk* batch = GetChunk(top);
+		Storage* chunks = (Storage*)batch;
+
+		for (int i = 0; i < kConcurrentPoolBatchSize; ++i) {
+			FreeChunk* chunk = new(&chunks[i]) FreeChunk;
+
+			chunk->next = (i + 1 < kConcurrentPoolBatchSize) ? (FreeChunk*)&chunks[i + 1] : nullptr;
+		}
+
+		return batch;
+	}
+
+	// Adds a block of num chunks after the last block. Called by one thread
+	// at a time
+	void AddBlock(size_t num) {
+		int blockCount = m_BlockCount.load(std::memory_order_relaxed);
+		uint32_t capacity = m_Capacity.load(std::memory_order_relaxed);
+
+		ASSERT(blockCount < kConcurrentPoolBlockMax);
+		ASSERT(num <= (size_t)(kNoChunk - capacity));
+
+		m_Blocks[blockCount] = MEM_NEW Storage[num];
+		m_BlockFirst[blockCount] = capacity;
+
+		// Publishes the block before its chunks can be carved
+		m_BlockCount.store(blockCount + 1, std::memory_order_release);
+		m_Capacity.store(capacity + (uint32_t)num, std::memory_order_release);
+	}
+
+	// Returns the chunk at the index, which MUST be below the capacity
+	FreeChunk* GetChunk(uint32_t index) const {
+		int block = m_BlockCount.load(std::memory_order_acquire) - 1;
+
+		while (index < m_BlockFirst[block]) {
+			--block;
+		}
+
+		return (FreeChunk*)&m_Blocks[block][index - m_BlockFirst[block]];
+	}
+
+	// Returns the index of the chunk pointed to by ptr, or kNoChunk if ptr
+	// does not point to a chunk in the pool
+	uint32_t GetChunkIndex(T* ptr) const {
+		int blockCount = m_BlockCount.load(std::memory_order_acquire);
+
+		// Newest blocks hold the most chunks, so they are searched first
+		for (int i = blockCount - 1; i >= 0; --i) {
+			uint32_t last = i + 1 < blockCount ? m_BlockFirst[i + 1] : m_Capacity.load(std::memory_order_acquire);
+
+			size_t begin = (size_t)m_Blocks[i];
+			size_t end = begin + sizeof(Storage) * (last - m_BlockFirst[i]);
+
+			if ((size_t)ptr >= begin && (size_t)ptr < end) {
+				size_t offset = (size_t)ptr - begin;
+
+				if (offset % sizeof(Storage) != 0) {
+					return kNoChunk;
+				}
+
+				return m_BlockFirst[i] + (uint32_t)(offset / sizeof(Storage));
+			}
+		}
+
+		return kNoChunk;
+	}
+
+	// Shared list head with the tag of the previous head increased by one
+	static uint64_t MakeHead(uint64_t head, uint32_t index) {
+		return (((head >> 32) + 1) << 32) | index;
+	}
+
+private:
+	// Blocks are only added under m_GrowMutex and are published by
+	// m_BlockCount
+	Storage* m_Blocks[kConcurrentPoolBlockMax];
+
+	// Index of the first chunk of each block
+	uint32_t m_BlockFirst[kConcurrentPoolBlockMax];
+
+	std::atomic<int> m_BlockCount;
+
+	// Total number of chunks in all blocks
+	std::atomic<uint32_t> m_Capacity;
+
+	// Index of the first chunk that has not been carved into a batch
+	std::atomic<uint32_t> m_Top;
+
+	// Index of the first chunk of the first batch in the shared list in the
+	// low 32 bits, and the tag in the high 32 bits
+	std::atomic<uint64_t> m_SharedHead;
+
+	// Indexed by ConcurrentPoolGetThreadIndex()
+	ThreadCache* m_Caches;
+
+	std::mutex m_GrowMutex;
+
+private:
+	// Allocator is uncopyable
+	ConcurrentPoolAllocator(const ConcurrentPoolAllocator&);
+	ConcurrentPoolAllocator& operator=(const ConcurrentPoolAllocator&);
+};
+
+#endif
\ No newline at end of file
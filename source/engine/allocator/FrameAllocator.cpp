@@ -1,61 +1,181 @@
 #include "FrameAllocator.h"
 
-#include "Allocator.h"
+#include <type_traits>
 
-FrameAllocator::FrameAllocator(size_t capacity) {
-	ASSERT(capacity > 0);
+// Unit that the buffers are allocated in, so that they start aligned
+typedef std::aligned_storage<kFrameAllocatorAlignment, kFrameAllocatorAlignment>::type FrameAllocatorUnit;
 
-	m_Memory = new byte_t[capacity];
-
-	m_Capacity = capacity;
+FrameAllocator::FrameAllocator(size_t capacity) {
+	Init(capacity, kFrameBufferingSingle);
+}
 
-	m_TopAddr = (size_t)m_Memory;
-	m_Size = 0;
+FrameAllocator::FrameAllocator(size_t capacity, FrameBuffering_t buffering) {
+	Init(capacity, buffering);
 }
 
 FrameAllocator::~FrameAllocator() {
-	m_Size = 0;
-	m_TopAddr = 0;
+	m_Top = 0;
+	m_Buffer = nullptr;
 
 	m_Capacity = 0;
 
-	delete[] m_Memory;
+	FrameAllocatorUnit* units = (FrameAllocatorUnit*)m_Memory;
+
+	MEM_DELETE_ARR(units);
+
+	m_Memory = nullptr;
 }
 
-void* FrameAllocator::AllocAligned(size_t size, size_t alignment) {
-    byte_t offset = CalcAlignedOffset(m_TopAddr, alignment);
+void FrameAllocator::Init(size_t capacity, FrameBuffering_t buffering) {
+	ASSERT(capacity > 0);
+
+	// Rounds each buffer up so that the second buffer also starts aligned
+	size_t unitCount = (capacity + kFrameAllocatorAlignment - 1) / kFrameAllocatorAlignment;
+	size_t bufferCount = (buffering == kFrameBufferingDouble) ? 2 : 1;
+
+	m_Memory = (byte_t*)MEM_NEW FrameAllocatorUnit[unitCount * bufferCount];
+	m_Buffer = m_Memory;
+
+	m_Buffering = buffering;
+
+	m_Top = 0;
+	m_Capacity = unitCount * kFrameAllocatorAlignment;
 
-	size_t newSize = size + offset;
+	m_LastAlloc = m_Capacity;
+	m_AllocCount = 0;
 
-	void* addr = AllocInternal(newSize);
-    
-    addr = (void*)((size_t)addr + offset);
+	m_PeakSize = 0;
+	m_LastPeakSize = 0;
+	m_MaxPeakSize = 0;
 
-	// Stores the offset information 1 byte before the returned memory address
-    byte_t* byteAddr = (byte_t*)addr;
-    --byteAddr;
-    *byteAddr = offset;
+	m_OverflowCount = 0;
 
-	return addr;
+	m_Frame = 0;
+}
+
+void* FrameAllocator::AllocAligned(size_t size, size_t alignment) {
+	ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+	// Buffers start aligned to kFrameAllocatorAlignment, so larger alignments
+	// are computed from the address
+	size_t address = (size_t)m_Buffer + m_Top;
+	size_t aligned = (address + alignment - 1) & ~(alignment - 1);
+
+	return AllocAt(m_Top + (aligned - address), size);
 }
 
 void* FrameAllocator::Alloc(size_t size) {
-	return AllocInternal(size);
+	return AllocAt(m_Top, size);
 }
 
-void* FrameAllocator::AllocInternal(size_t size) {
-	size_t returnAddr = m_TopAddr;
+void* FrameAllocator::AllocAt(size_t offset, size_t size) {
+	// Checked without adding to offset, so a huge size cannot wrap around
+	if (offset > m_Capacity || size > m_Capacity - offset) {
+		++m_OverflowCount;
+
+		LOG_ERROR("FrameAllocator: Allocation of %zu bytes does not fit (%zu of %zu bytes used)", size, m_Top,
+				  m_Capacity);
+
+		return nullptr;
+	}
+
+	m_Top = offset + size;
+
+	m_LastAlloc = offset;
+	++m_AllocCount;
+
+	if (m_Top > m_PeakSize) {
+		m_PeakSize = m_Top;
+	}
+
+	return m_Buffer + offset;
+}
 
-    m_TopAddr += size;
+void FrameAllocator::Dealloc(void* ptr) {
+	if (ptr == nullptr || ptr != m_Buffer + m_LastAlloc) {
+		return;
+	}
 
-    m_Size += size;
+	m_Top = m_LastAlloc;
+	m_LastAlloc = m_Capacity;
 
-	return (void*)returnAddr;
+	--m_AllocCount;
 }
 
+void* FrameAllocator::Realloc(void* ptr, size_t oldSize, size_t size, size_t alignment) {
+	if (ptr == nullptr || ptr != m_Buffer + m_LastAlloc || ((size_t)ptr & (alignment - 1)) != 0) {
+		return IAllocator::Realloc(ptr, oldSize, size, alignment);
+	}
+
+	if (size > m_Capacity - m_LastAlloc) {
+		++m_OverflowCount;
+
+		LOG_ERROR("FrameAllocator: Reallocation to %zu bytes does not fit (%zu of %zu bytes used)", size, m_Top,
+				  m_Capacity);
+
+		return nullptr;
+	}
+
+	m_Top = m_LastAlloc + size;
+
+	if (m_Top > m_PeakSize) {
+		m_PeakSize = m_Top;
+	}
+
+	return ptr;
+}
+
+FrameMarker FrameAllocator::GetMarker() const {
+	FrameMarker marker;
+	marker.top = m_Top;
+	marker.allocCount = m_AllocCount;
+	marker.frame = m_Frame;
+
+	return marker;
+}
+
+void FrameAllocator::Rewind(const FrameMarker& marker) {
+	ASSERT(marker.frame == m_Frame);
+	ASSERT(marker.top <= m_Top);
+
+	m_Top = marker.top;
+	m_AllocCount = marker.allocCount;
+
+	if (m_LastAlloc >= m_Top) {
+		m_LastAlloc = m_Capacity;
+	}
+}
+
+void FrameAllocator::NextFrame() {
+	EndFrame();
+
+	if (m_Buffering == kFrameBufferingDouble) {
+		m_Buffer = (m_Buffer == m_Memory) ? m_Memory + m_Capacity : m_Memory;
+	}
+}
 
 void FrameAllocator::Clear() {
-	m_TopAddr = (size_t)m_Memory;
-	m_Size = 0;
+	EndFrame();
+
+	m_Buffer = m_Memory;
 }
 
+size_t FrameAllocator::GetMaxPeakSize() const {
+	return m_PeakSize > m_MaxPeakSize ? m_PeakSize : m_MaxPeakSize;
+}
+
+void FrameAllocator::EndFrame() {
+	m_LastPeakSize = m_PeakSize;
+
+	if (m_PeakSize > m_MaxPeakSize) {
+		m_MaxPeakSize = m_PeakSize;
+	}
+
+	m_PeakSize = 0;
+	m_Top = 0;
+
+	m_LastAlloc = m_Capacity;
+	m_AllocCount = 0;
+
+	++m_Frame;
+}
\ No newline at end of file
@@ -3,6 +3,32 @@
 
 #include "base_include.h"
 
+#include "Allocator.h"
+
+// Alignment of the start of each frame buffer
+const size_t kFrameAllocatorAlignment = 16;
+
+enum FrameBuffering_t {
+	// One buffer; memory of a frame is gone once the next frame starts
+	kFrameBufferingSingle,
+
+	// Two buffers used in turns; memory of a frame stays readable during the
+	// next frame
+	kFrameBufferingDouble
+};
+
+// Position of the top of a FrameAllocator, used to free everything that
+// was allocated after it
+struct FrameMarker {
+	size_t top;
+
+	// Allocations in use when the marker was taken
+	size_t allocCount;
+
+	// Frame that the marker was taken in
+	uint64_t frame;
+};
+
 //--------------------------------------------------
 //
 // FrameAllocator
@@ -10,43 +36,175 @@
 // Allocates memory at the top of the allocator. Allocator is of fixed size and
 // will not resize if the limit is reached
 //
-// Suitable for single use buffers or to store permanent objects that will only
-// be removed at the end of the game
+// Suitable for scratch memory that is only needed until the end of the frame,
+// e.g. render commands, contact lists and temporary strings. Allocating only
+// moves the top, and all of it is freed at once by NextFrame() or Clear().
+// Memory allocated after a marker can be freed early by rewinding to it
+//
+// A double buffered allocator has two buffers of the capacity each, and
+// NextFrame() switches between them, so data from frame N can still be read
+// during frame N+1
+//
+// An allocation that does not fit returns nullptr and is counted by
+// GetOverflowCount()
+//
+// As an IAllocator, Dealloc() and Realloc() only free or grow memory in
+// place if it is the last allocation; other memory stays allocated until
+// the end of the frame
+//
+// Objects are NOT constructed or destructed by the allocator
 //
 //--------------------------------------------------
-class FrameAllocator {
+class FrameAllocator: public IAllocator {
 
 public:
 	explicit FrameAllocator(size_t capacity);
-	~FrameAllocator();
+	FrameAllocator(size_t capacity, FrameBuffering_t buffering);
+	virtual ~FrameAllocator();
 
 	// Allocates memory of the specified size with the correct alignment
 	//
-	// Alignment must be a power of 2 (usually 4 or 16) and <= 32
-	void* AllocAligned(size_t size, size_t alignment);
+	// Alignment must be a power of 2. No bytes are skipped if the top is
+	// already aligned
+	virtual void* AllocAligned(size_t size, size_t alignment);
+
+	// Allocates memory of the specified size, with no alignment
+	virtual void* Alloc(size_t size);
+
+	// Moves the top back if ptr is the last allocation
+	virtual void Dealloc(void* ptr);
+
+	// Grows or shrinks in place if ptr is the last allocation
+	virtual void* Realloc(void* ptr, size_t oldSize, size_t size, size_t alignment);
+
+	// Allocates an array of count objects T, aligned for T
+	template<typename T>
+	T* AllocArray(size_t count) {
+		return (T*)AllocAligned(sizeof(T) * count, alignof(T));
+	}
+
+	// Returns a marker at the current top
+	FrameMarker GetMarker() const;
+
+	// Frees all memory allocated after the marker was taken
+	//
+	// Marker MUST be from the current frame and not below a marker that was
+	// already rewound to
+	void Rewind(const FrameMarker& marker);
 
-	// Allocates memory of the specified size
-	void* Alloc(size_t size);
+	// Ends the frame and starts the next one
+	//
+	// Frees the memory of the new frame's buffer, which is the previous
+	// frame's memory if the allocator is double buffered
+	void NextFrame();
 
-	// Clears the entire stack
+	// Frees all memory, of both buffers if the allocator is double buffered,
+	// and ends the frame like NextFrame()
 	void Clear();
 
-	size_t GetSize() const { return m_Size; }
+	// Bytes used in the current frame
+	size_t GetSize() const { return m_Top; }
+
+	// Same as GetSize()
+	virtual size_t GetUsedSize() const { return m_Top; }
+
+	// Number of allocations in use in the current frame; memory that
+	// Dealloc() cannot free stays counted until the end of the frame
+	virtual size_t GetAllocCount() const { return m_AllocCount; }
+
+	// Bytes in each buffer
 	size_t GetCapacity() const { return m_Capacity; }
 
+	FrameBuffering_t GetBuffering() const { return m_Buffering; }
+
+	// Most bytes used at once during the current frame
+	size_t GetPeakSize() const { return m_PeakSize; }
+
+	// Most bytes used at once during the last frame that ended
+	size_t GetLastPeakSize() const { return m_LastPeakSize; }
+
+	// Most bytes used at once during any frame
+	size_t GetMaxPeakSize() const;
+
+	// Number of allocations that did not fit since the allocator was created
+	size_t GetOverflowCount() const { return m_OverflowCount; }
+
+	// Number of frames that have ended
+	uint64_t GetFrame() const { return m_Frame; }
+
 private:
-	void* AllocInternal(size_t size);
+	void Init(size_t capacity, FrameBuffering_t buffering);
+
+	// Moves the top to offset + size and returns the memory at offset
+	void* AllocAt(size_t offset, size_t size);
+
+	// Records the peak of the frame and resets the top
+	void EndFrame();
 
 private:
+	// Memory of all buffers, aligned to kFrameAllocatorAlignment
 	byte_t* m_Memory;
 
-	// Location of the top in memory
-	size_t m_TopAddr;
-	// Current number of bytes being used
-	size_t m_Size;
+	// Buffer of the current frame
+	byte_t* m_Buffer;
+
+	FrameBuffering_t m_Buffering;
+
+	// Offset of the top in the current buffer; also the number of bytes in use
+	size_t m_Top;
+
+	// Offset of the last allocation, or m_Capacity if the memory under the
+	// top is not known to be a single allocation
+	size_t m_LastAlloc;
 
-	// Total number of bytes of memory that can be allocated
+	size_t m_AllocCount;
+
+	// Number of bytes of memory that can be allocated in each buffer
 	size_t m_Capacity;
+
+	size_t m_PeakSize;
+	size_t m_LastPeakSize;
+	size_t m_MaxPeakSize;
+
+	size_t m_OverflowCount;
+
+	uint64_t m_Frame;
+
+private:
+	// Allocator is uncopyable
+	FrameAllocator(const FrameAllocator&);
+	FrameAllocator& operator=(const FrameAllocator&);
+};
+
+//--------------------------------------------------
+//
+// FrameAllocatorScope
+//
+// Rewinds a FrameAllocator to where it was when the scope was created once
+// the scope ends
+//
+//--------------------------------------------------
+class FrameAllocatorScope {
+
+public:
+	explicit FrameAllocatorScope(FrameAllocator* allocator) {
+		ASSERT(allocator != nullptr);
+
+		m_Allocator = allocator;
+		m_Marker = allocator->GetMarker();
+	}
+
+	~FrameAllocatorScope() {
+		m_Allocator->Rewind(m_Marker);
+	}
+
+private:
+	FrameAllocator* m_Allocator;
+	FrameMarker m_Marker;
+
+private:
+	FrameAllocatorScope(const FrameAllocatorScope&);
+	FrameAllocatorScope& operator=(const FrameAllocatorScope&);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "HeapAllocator.h"
+
+// Stored right in front of every allocation
+struct HeapAllocHeader {
+	// Address returned by BaseMemAlloc()
+	void* memory;
+
+	// Size that was requested
+	size_t size;
+};
+
+static_assert(sizeof(HeapAllocHeader) <= kAllocatorDefaultAlignment, "Header must fit in the default alignment");
+
+HeapAllocator::HeapAllocator() {
+	m_UsedSize = 0;
+	m_AllocCount = 0;
+}
+
+HeapAllocator::~HeapAllocator() {
+	// All memory MUST be freed before the allocator is destroyed
+	ASSERT(m_AllocCount.load() == 0);
+}
+
+void* HeapAllocator::AllocAligned(size_t size, size_t alignment) {
+	ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+	if (alignment < kAllocatorDefaultAlignment) {
+		alignment = kAllocatorDefaultAlignment;
+	}
+
+	// Memory is aligned to at least the size of a header, so there is always
+	// room for the header in front of the aligned address
+	void* memory = BaseMemAlloc(size + alignment, nullptr, 0);
+
+	if (memory == nullptr) {
+		return nullptr;
+	}
+
+	size_t address = ((size_t)memory + sizeof(HeapAllocHeader) + alignment - 1) & ~(alignment - 1);
+
+	HeapAllocHeader* header = (HeapAllocHeader*)address - 1;
+	header->memory = memory;
+	header->size = size;
+
+	m_UsedSize.fetch_add(size, std::memory_order_relaxed);
+	m_AllocCount.fetch_add(1, std::memory_order_relaxed);
+
+	return (void*)address;
+}
+
+void* HeapAllocator::Alloc(size_t size) {
+	return AllocAligned(size, kAllocatorDefaultAlignment);
+}
+
+void HeapAllocator::Dealloc(void* ptr) {
+	if (ptr == nullptr) {
+		return;
+	}
+
+	HeapAllocHeader* header = (HeapAllocHeader*)ptr - 1;
+
+	m_UsedSize.fetch_sub(header->size, std::memory_order_relaxed);
+	m_AllocCount.fetch_sub(1, std::memory_order_relaxed);
+
+	BaseMemFree(header->memory);
+}
+
+size_t HeapAllocator::GetUsedSize() const {
+	return m_UsedSize.load(std::memory_order_relaxed);
+}
+
+size_t HeapAllocator::GetAllocCount() const {
+	return m_AllocCount.load(std::memory_order_relaxed);
+}
+
+IAllocator* GetDefaultAllocator() {
+	// Never destroyed, so that containers in static objects can still free
+	// their memory when they are destroyed at exit
+	static HeapAllocator* s_Allocator = MEM_NEW HeapAllocator();
+
+	return s_Allocator;
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef HEAPALLOCATOR_H_
+#define HEAPALLOCATOR_H_
+
+#include "base_include.h"
+
+#include "Allocator.h"
+
+#include <atomic>
+
+//--------------------------------------------------
+//
+// HeapAllocator
+//
+// Allocates memory from the general heap with BaseMemAlloc(), so that the
+// memory is counted against the tag of the calling thread
+//
+// Every allocation has a small header in front of it that records its size,
+// so that the used size can be counted, and the address that BaseMemAlloc()
+// returned, so that any alignment can be given. Any thread may use the
+// allocator
+//
+//--------------------------------------------------
+class HeapAllocator: public IAllocator {
+
+public:
+	HeapAllocator();
+	virtual ~HeapAllocator();
+
+	virtual void* AllocAligned(size_t size, size_t alignment);
+	virtual void* Alloc(size_t size);
+	virtual void Dealloc(void* ptr);
+
+	// Bytes requested by the allocations in use, without their headers
+	virtual size_t GetUsedSize() const;
+	virtual size_t GetAllocCount() const;
+
+private:
+	std::atomic<size_t> m_UsedSize;
+	std::atomic<size_t> m_AllocCount;
+
+private:
+	// Allocator is uncopyable
+	HeapAllocator(const HeapAllocator&);
+	HeapAllocator& operator=(const HeapAllocator&);
+};
+
+#endif
\ No newline at end of file
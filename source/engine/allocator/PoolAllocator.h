@@ -3,6 +3,13 @@
 
 #include "base_include.h"
 
+#include "Allocator.h"
+
+#include <type_traits>
+
+// Max number of blocks that a growable pool can allocate
+const int kPoolAllocatorBlockMax = 32;
+
 //--------------------------------------------------
 //
 // PoolAllocator
@@ -13,6 +20,14 @@
 // The size of type T must be as large as the size of a pointer because a free 
 // chunk will contain a pointer to the next chunk in the free list.
 //
+// A growable pool allocates another block of memory when all chunks are used,
+// doubling the number of chunks. Chunks never move, so pointers to them stay
+// valid as the pool grows
+//
+// Blocks are raw memory, so no T is constructed until the client constructs
+// it. They come from an IAllocator, the default allocator unless one is
+// given. See ConcurrentPoolAllocator for a pool that many threads can share
+//
 // IMPT: client MUST manually construct and destruct each object in the pool
 //
 //--------------------------------------------------
@@ -24,17 +39,17 @@ public:
 	//
 	// num must be greater than 0
 	explicit PoolAllocator(size_t num) {
-		ASSERT(sizeof(T) >= sizeof(size_t)); // Object T must as large as size_t
-		ASSERT(num > 0);
+		Init(num, false, GetDefaultAllocator());
+	}
 
-		m_Capacity = sizeof(T) * num;
-		m_ChunkNum = num;
-		m_ChunkSize = sizeof(T);
+	// If growable is true, the pool grows instead of running out of chunks
+	PoolAllocator(size_t num, bool growable) {
+		Init(num, growable, GetDefaultAllocator());
+	}
 
-		m_Memory = MEM_NEW T[num];
-		m_TopChunk = (T*)&m_Memory[0];
-		m_FreeListHead = nullptr;
-		m_MaxAddress = (size_t)m_Memory + m_Capacity;
+	// Blocks are allocated from allocator, which MUST outlive the pool
+	PoolAllocator(size_t num, bool growable, IAllocator* allocator) {
+		Init(num, growable, allocator);
 	}
 
 	// Deallocates memory
@@ -43,7 +58,12 @@ public:
 		m_FreeListHead = nullptr;
 		m_TopChunk = nullptr;
 
-		MEM_DELETE_ARR(m_Memory);
+		for (int i = 0; i < m_BlockCount; ++i) {
+			m_Allocator->Dealloc(m_Blocks[i]);
+			m_Blocks[i] = nullptr;
+		}
+
+		m_Memory = nullptr;
 
 		m_ChunkSize = 0;
 		m_ChunkNum = 0;
@@ -60,6 +80,11 @@ public:
 			return address;
 		}
 
+		// Moves on to the next block if the current one is used up
+		if ((size_t)m_TopChunk >= m_MaxAddress && m_Growable) {
+			NextBlock();
+		}
+
 		ASSERT((size_t)m_TopChunk < m_MaxAddress);
 
 		// If the free list is empty, allocate from the top of the pool
@@ -74,9 +99,7 @@ public:
 	//
 	// Chunk is added to the front of the free list
 	void Dealloc(T* ptr) {
-		ASSERT((((size_t)ptr - (size_t)m_Memory) % m_ChunkSize) == 0);
-		ASSERT(ptr >= m_Memory);
-		ASSERT((size_t)ptr < m_MaxAddress);
+		ASSERT(IsInPool(ptr));
 
 		*((T**)ptr) = m_FreeListHead; // Chunk will point to the previous list head 
 
@@ -84,15 +107,90 @@ public:
 	}
 
 	// Deallocates all chunks
+	//
+	// A growable pool keeps all of its blocks
 	void Clear() {
+		m_CurrentBlock = 0;
 		m_TopChunk = m_Memory;
+		m_MaxAddress = (size_t)m_Memory + sizeof(T) * m_BlockSizes[0];
 		m_FreeListHead = nullptr;
 	}
 
+	// Total number of chunks in all blocks
 	size_t GetChunkNum() const { return m_ChunkNum; }
 
+	bool IsGrowable() const { return m_Growable; }
+
+	IAllocator* GetAllocator() const { return m_Allocator; }
+
+private:
+	void Init(size_t num, bool growable, IAllocator* allocator) {
+		ASSERT(sizeof(T) >= sizeof(size_t)); // Object T must as large as size_t
+		ASSERT(num > 0);
+		ASSERT(allocator != nullptr);
+
+		m_Allocator = allocator;
+
+		m_Capacity = sizeof(T) * num;
+		m_ChunkNum = num;
+		m_ChunkSize = sizeof(T);
+
+		m_Blocks[0] = AllocArray<Storage>(m_Allocator, num);
+
+		m_Memory = (T*)m_Blocks[0];
+		m_TopChunk = m_Memory;
+		m_FreeListHead = nullptr;
+		m_MaxAddress = (size_t)m_Memory + m_Capacity;
+
+		m_Growable = growable;
+
+		m_BlockSizes[0] = num;
+		m_BlockCount = 1;
+		m_CurrentBlock = 0;
+	}
+
+	// Allocates from the next block, creating it if it does not exist yet
+	void NextBlock() {
+		++m_CurrentBlock;
+
+		if (m_CurrentBlock == m_BlockCount) {
+			ASSERT(m_BlockCount < kPoolAllocatorBlockMax);
+
+			// New block has as many chunks as all the previous ones
+			size_t num = m_ChunkNum;
+
+			m_Blocks[m_BlockCount] = AllocArray<Storage>(m_Allocator, num);
+			m_BlockSizes[m_BlockCount] = num;
+			++m_BlockCount;
+
+			m_ChunkNum += num;
+			m_Capacity += sizeof(T) * num;
+		}
+
+		m_TopChunk = (T*)m_Blocks[m_CurrentBlock];
+		m_MaxAddress = (size_t)m_TopChunk + sizeof(T) * m_BlockSizes[m_CurrentBlock];
+	}
+
+	// Tests if ptr points to a chunk in one of the blocks
+	bool IsInPool(T* ptr) const {
+		for (int i = 0; i < m_BlockCount; ++i) {
+			size_t begin = (size_t)m_Blocks[i];
+			size_t end = begin + sizeof(T) * m_BlockSizes[i];
+
+			if ((size_t)ptr >= begin && (size_t)ptr < end) {
+				return (((size_t)ptr - begin) % m_ChunkSize) == 0;
+			}
+		}
+
+		return false;
+	}
+
 private:
-	T* m_Memory;
+	typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+
+	IAllocator* m_Allocator;
+
+	T* m_Memory; // First block
 	size_t m_Capacity;
 
 	// Tracks the most recent dealloced chunk.
@@ -107,6 +205,16 @@ private:
 	size_t m_ChunkSize;
 	size_t m_ChunkNum;
 
+	bool m_Growable;
+
+	// All blocks of memory; a fixed pool only has the first block
+	Storage* m_Blocks[kPoolAllocatorBlockMax];
+	size_t m_BlockSizes[kPoolAllocatorBlockMax];
+	int m_BlockCount;
+
+	// Block that the top chunk is in
+	int m_CurrentBlock;
+
 private:
 	// Allocator is uncopyable
 	PoolAllocator(const PoolAllocator&);
@@ -0,0 +1,596 @@
+#include "TlsfAllocator.h"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// Bytes in front of the data of a block. The free list pointers are part of
+// the data, so only free blocks use them
+const size_t kTlsfHeaderSize = offsetof(TlsfBlock, nextFree);
+
+// Smallest data of a block, large enough for the free list pointers
+const size_t kTlsfBlockSizeMin = sizeof(TlsfBlock) - kTlsfHeaderSize;
+
+// Set in the size of a free block
+const size_t kTlsfFreeBit = 1;
+
+// Unit that the memory is allocated in, so that it starts aligned
+typedef std::aligned_storage<kTlsfAlignment, kTlsfAlignment>::type TlsfUnit;
+
+// Index of the lowest set bit; mask must not be 0
+static int LowestBit(uint32_t mask) {
+	ASSERT(mask != 0);
+
+#if defined(__GNUC__)
+	return __builtin_ctz(mask);
+#else
+	int index = 0;
+
+	while ((mask & 1u) == 0) {
+		mask >>= 1;
+		++index;
+	}
+
+	return index;
+#endif
+}
+
+// Index of the highest set bit; value must not be 0
+static int HighestBit(size_t value) {
+	ASSERT(value != 0);
+
+#if defined(__GNUC__)
+	return (int)(sizeof(unsigned long long) * 8) - 1 - __builtin_clzll((unsigned long long)value);
+#else
+	int index = 0;
+
+	while ((value >> 1) != 0) {
+		value >>= 1;
+		++index;
+	}
+
+	return index;
+#endif
+}
+
+static size_t GetBlockSize(const TlsfBlock* block) {
+	return block->size & ~kTlsfFreeBit;
+}
+
+static bool IsBlockFree(const TlsfBlock* block) {
+	return (block->size & kTlsfFreeBit) != 0;
+}
+
+static TlsfBlock* GetNextBlock(const TlsfBlock* block) {
+	return (TlsfBlock*)((size_t)block + kTlsfHeaderSize + GetBlockSize(block));
+}
+
+static void* GetBlockData(const TlsfBlock* block) {
+	return (void*)((size_t)block + kTlsfHeaderSize);
+}
+
+static TlsfBlock* GetDataBlock(const void* ptr) {
+	return (TlsfBlock*)((size_t)ptr - kTlsfHeaderSize);
+}
+
+TlsfAllocator::TlsfAllocator(size_t capacity) {
+	capacity &= ~(kTlsfAlignment - 1);
+
+	ASSERT(capacity >= kTlsfSmallBlockSize);
+	ASSERT((capacity >> kTlsfFirstLevelMax) == 0);
+
+	m_Memory = (byte_t*)MEM_NEW TlsfUnit[capacity / kTlsfAlignment];
+	m_Capacity = capacity;
+
+	m_FirstLevelMap = 0;
+
+	for (int i = 0; i < kTlsfFirstLevelCount; ++i) {
+		m_SecondLevelMap[i] = 0;
+
+		for (int j = 0; j < kTlsfSecondLevelCount; ++j) {
+			m_FreeLists[i][j] = nullptr;
+		}
+	}
+
+	m_UsedSize = 0;
+	m_PeakUsedSize = 0;
+	m_AllocCount = 0;
+	m_FreeBlockCount = 0;
+
+	// One free block spans the memory, followed by an empty block that is
+	// never free, so that the last block has a next block to check
+	TlsfBlock* block = (TlsfBlock*)m_Memory;
+	block->prevPhys = nullptr;
+	block->size = capacity - 2 * kTlsfHeaderSize;
+
+	TlsfBlock* sentinel = GetNextBlock(block);
+	sentinel->prevPhys = block;
+	sentinel->size = 0;
+
+	InsertFreeBlock(block);
+
+	m_DefragBlock = block;
+	m_DefragPassClean = false;
+	m_DefragDone = false;
+}
+
+TlsfAllocator::~TlsfAllocator() {
+	m_Capacity = 0;
+
+	TlsfUnit* units = (TlsfUnit*)m_Memory;
+
+	MEM_DELETE_ARR(units);
+
+	m_Memory = nullptr;
+}
+
+void* TlsfAllocator::Alloc(size_t size) {
+	if (size > m_Capacity) {
+		return nullptr;
+	}
+
+	size_t blockSize = CalcBlockSize(size);
+
+	TlsfBlock* block = TakeFreeBlock(blockSize);
+
+	if (block == nullptr) {
+		return nullptr;
+	}
+
+	SplitBlock(block, blockSize);
+
+	return UseBlock(block);
+}
+
+void* TlsfAllocator::AllocAligned(size_t size, size_t alignment) {
+	ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+	if (alignment <= kTlsfAlignment) {
+		return Alloc(size);
+	}
+
+	if (size > m_Capacity) {
+		return nullptr;
+	}
+
+	size_t blockSize = CalcBlockSize(size);
+
+	// Leaves room to move the data to the alignment, and for a free block in
+	// front of it
+	TlsfBlock* block = TakeFreeBlock(blockSize + alignment + sizeof(TlsfBlock));
+
+	if (block == nullptr) {
+		return nullptr;
+	}
+
+	size_t data = (size_t)GetBlockData(block);
+	size_t aligned = (data + alignment - 1) & ~(alignment - 1);
+
+	// Gap is too small for a free block, so the next aligned address is used
+	if (aligned != data && aligned - data < sizeof(TlsfBlock)) {
+		aligned = (data + sizeof(TlsfBlock) + alignment - 1) & ~(alignment - 1);
+	}
+
+	size_t gap = aligned - data;
+
+	if (gap > 0) {
+		// Front of the block becomes a free block of its own
+		TlsfBlock* alignedBlock = GetDataBlock((void*)aligned);
+		alignedBlock->prevPhys = block;
+		alignedBlock->size = GetBlockSize(block) - gap;
+
+		GetNextBlock(alignedBlock)->prevPhys = alignedBlock;
+
+		block->size = gap - kTlsfHeaderSize;
+
+		InsertFreeBlock(block);
+
+		block = alignedBlock;
+	}
+
+	SplitBlock(block, blockSize);
+
+	return UseBlock(block);
+}
+
+void TlsfAllocator::Dealloc(void* ptr) {
+	if (ptr == nullptr) {
+		return;
+	}
+
+	ASSERT((size_t)ptr > (size_t)m_Memory && (size_t)ptr < (size_t)m_Memory + m_Capacity);
+
+	TlsfBlock* block = GetDataBlock(ptr);
+
+	ASSERT(!IsBlockFree(block));
+
+	m_UsedSize -= kTlsfHeaderSize + GetBlockSize(block);
+	--m_AllocCount;
+
+	block = MergeBlock(block);
+
+	InsertFreeBlock(block);
+}
+
+void* TlsfAllocator::Realloc(void* ptr, size_t oldSize, size_t size, size_t alignment) {
+	if (ptr == nullptr || size > m_Capacity || ((size_t)ptr & (alignment - 1)) != 0) {
+		return IAllocator::Realloc(ptr, oldSize, size, alignment);
+	}
+
+	TlsfBlock* block = GetDataBlock(ptr);
+
+	ASSERT(!IsBlockFree(block));
+
+	size_t blockSize = CalcBlockSize(size);
+	size_t currentSize = GetBlockSize(block);
+
+	TlsfBlock* next = GetNextBlock(block);
+
+	// Moves if the free block after it, if any, is too small to grow into
+	if (blockSize > currentSize &&
+		(!IsBlockFree(next) || currentSize + kTlsfHeaderSize + GetBlockSize(next) < blockSize)) {
+		return IAllocator::Realloc(ptr, oldSize, size, alignment);
+	}
+
+	m_UsedSize -= kTlsfHeaderSize + currentSize;
+
+	// Takes in the free block after it, so that the end that is not needed
+	// is given back as one free block
+	if (IsBlockFree(next)) {
+		RemoveFreeBlock(next);
+		ForgetBlock(next, block);
+
+		block->size = currentSize + kTlsfHeaderSize + GetBlockSize(next);
+
+		GetNextBlock(block)->prevPhys = block;
+	}
+
+	SplitBlock(block, blockSize);
+
+	m_UsedSize += kTlsfHeaderSize + GetBlockSize(block);
+
+	if (m_UsedSize > m_PeakUsedSize) {
+		m_PeakUsedSize = m_UsedSize;
+	}
+
+	return ptr;
+}
+
+size_t TlsfAllocator::GetAllocSize(const void* ptr) const {
+	ASSERT(ptr != nullptr);
+
+	return GetBlockSize(GetDataBlock(ptr));
+}
+
+size_t TlsfAllocator::Defragment(size_t byteMax, TlsfRelocateFunc func, void* context) {
+	ASSERT(func != nullptr);
+
+	if (m_DefragDone) {
+		return 0;
+	}
+
+	size_t movedSize = 0;
+
+	TlsfBlock* block = m_DefragBlock;
+
+	for (int i = 0; i < kTlsfDefragBlockMax; ++i) {
+		// Starts from the front again at the sentinel. Nothing can move
+		// until the blocks change if the whole pass moved nothing
+		if (GetBlockSize(block) == 0) {
+			m_DefragDone = m_DefragPassClean;
+			m_DefragPassClean = true;
+
+			block = (TlsfBlock*)m_Memory;
+			break;
+		}
+
+		if (!IsBlockFree(block) && block->prevPhys != nullptr && IsBlockFree(block->prevPhys)) {
+			size_t size = GetBlockSize(block);
+
+			if (movedSize + size > byteMax) {
+				// Waits for the next call, unless it would never fit
+				if (size <= byteMax) {
+					break;
+				}
+			}
+			else {
+				void* oldPtr = GetBlockData(block);
+
+				block = SlideBlock(block);
+
+				func(context, oldPtr, GetBlockData(block));
+
+				movedSize += size;
+			}
+		}
+
+		block = GetNextBlock(block);
+	}
+
+	m_DefragBlock = block;
+
+	return movedSize;
+}
+
+bool TlsfAllocator::CheckBlocks() const {
+	const TlsfBlock* prev = nullptr;
+	const TlsfBlock* block = (const TlsfBlock*)m_Memory;
+
+	size_t usedSize = 0;
+	size_t allocCount = 0;
+	size_t freeBlockCount = 0;
+
+	// Sentinel is the only block with no data
+	while (GetBlockSize(block) != 0) {
+		if (block->prevPhys != prev) {
+			return false;
+		}
+
+		if (IsBlockFree(block)) {
+			// Free blocks are always merged with their neighbours
+			if (prev != nullptr && IsBlockFree(prev)) {
+				return false;
+			}
+
+			int fl;
+			int sl;
+			MapInsert(GetBlockSize(block), &fl, &sl);
+
+			if ((m_SecondLevelMap[fl] & (1u << sl)) == 0) {
+				return false;
+			}
+
+			++freeBlockCount;
+		}
+		else {
+			usedSize += kTlsfHeaderSize + GetBlockSize(block);
+			++allocCount;
+		}
+
+		prev = block;
+		block = GetNextBlock(block);
+
+		if ((size_t)block >= (size_t)m_Memory + m_Capacity) {
+			return false;
+		}
+	}
+
+	if (block->prevPhys != prev || IsBlockFree(block)) {
+		return false;
+	}
+
+	if ((size_t)block + kTlsfHeaderSize != (size_t)m_Memory + m_Capacity) {
+		return false;
+	}
+
+	return usedSize == m_UsedSize && allocCount == m_AllocCount && freeBlockCount == m_FreeBlockCount;
+}
+
+size_t TlsfAllocator::CalcBlockSize(size_t size) {
+	size_t blockSize = (size + kTlsfAlignment - 1) & ~(kTlsfAlignment - 1);
+
+	return blockSize < kTlsfBlockSizeMin ? kTlsfBlockSizeMin : blockSize;
+}
+
+void TlsfAllocator::MapInsert(size_t size, int* fl, int* sl) {
+	if (size < kTlsfSmallBlockSize) {
+		*fl = 0;
+		*sl = (int)(size / (kTlsfSmallBlockSize / kTlsfSecondLevelCount));
+	}
+	else {
+		int bit = HighestBit(size);
+
+		*fl = bit - kTlsfSmallBlockLog2 + 1;
+		*sl = (int)(size >> (bit - kTlsfSecondLevelLog2)) ^ kTlsfSecondLevelCount;
+	}
+}
+
+void TlsfAllocator::MapSearch(size_t size, int* fl, int* sl) {
+	// Rounds up to the next size class, so that every block in the class fits
+	if (size >= kTlsfSmallBlockSize) {
+		size += ((size_t)1 << (HighestBit(size) - kTlsfSecondLevelLog2)) - 1;
+	}
+
+	MapInsert(size, fl, sl);
+}
+
+TlsfBlock* TlsfAllocator::TakeFreeBlock(size_t size) {
+	int fl;
+	int sl;
+	MapSearch(size, &fl, &sl);
+
+	if (fl >= kTlsfFirstLevelCount) {
+		return nullptr;
+	}
+
+	// Looks for a list in the same first level class first, then in the
+	// larger first level classes
+	uint32_t slMap = m_SecondLevelMap[fl] & (~0u << sl);
+
+	if (slMap == 0) {
+		uint32_t flMap = m_FirstLevelMap & (~0u << (fl + 1));
+
+		if (flMap == 0) {
+			return nullptr;
+		}
+
+		fl = LowestBit(flMap);
+		slMap = m_SecondLevelMap[fl];
+	}
+
+	sl = LowestBit(slMap);
+
+	TlsfBlock* block = m_FreeLists[fl][sl];
+
+	ASSERT(block != nullptr && GetBlockSize(block) >= size);
+
+	RemoveFreeBlock(block);
+
+	return block;
+}
+
+void TlsfAllocator::InsertFreeBlock(TlsfBlock* block) {
+	int fl;
+	int sl;
+	MapInsert(GetBlockSize(block), &fl, &sl);
+
+	block->size |= kTlsfFreeBit;
+
+	TlsfBlock* head = m_FreeLists[fl][sl];
+
+	block->prevFree = nullptr;
+	block->nextFree = head;
+
+	if (head != nullptr) {
+		head->prevFree = block;
+	}
+
+	m_FreeLists[fl][sl] = block;
+
+	m_FirstLevelMap |= (1u << fl);
+	m_SecondLevelMap[fl] |= (1u << sl);
+
+	++m_FreeBlockCount;
+
+	// Every change to the blocks goes through the free lists, including
+	// the moves of Defragment()
+	m_DefragPassClean = false;
+	m_DefragDone = false;
+}
+
+void TlsfAllocator::RemoveFreeBlock(TlsfBlock* block) {
+	ASSERT(IsBlockFree(block));
+
+	int fl;
+	int sl;
+	MapInsert(GetBlockSize(block), &fl, &sl);
+
+	if (block->prevFree != nullptr) {
+		block->prevFree->nextFree = block->nextFree;
+	}
+	else {
+		m_FreeLists[fl][sl] = block->nextFree;
+
+		if (block->nextFree == nullptr) {
+			m_SecondLevelMap[fl] &= ~(1u << sl);
+
+			if (m_SecondLevelMap[fl] == 0) {
+				m_FirstLevelMap &= ~(1u << fl);
+			}
+		}
+	}
+
+	if (block->nextFree != nullptr) {
+		block->nextFree->prevFree = block->prevFree;
+	}
+
+	block->size &= ~kTlsfFreeBit;
+
+	--m_FreeBlockCount;
+
+	m_DefragPassClean = false;
+	m_DefragDone = false;
+}
+
+void TlsfAllocator::SplitBlock(TlsfBlock* block, size_t size) {
+	size_t blockSize = GetBlockSize(block);
+
+	if (blockSize < size + sizeof(TlsfBlock)) {
+		return;
+	}
+
+	TlsfBlock* rest = (TlsfBlock*)((size_t)GetBlockData(block) + size);
+	rest->prevPhys = block;
+	rest->size = blockSize - size - kTlsfHeaderSize;
+
+	GetNextBlock(rest)->prevPhys = rest;
+
+	block->size = size;
+
+	// Block after the rest is never free, so the rest needs no merging
+	InsertFreeBlock(rest);
+}
+
+TlsfBlock* TlsfAllocator::MergeBlock(TlsfBlock* block) {
+	TlsfBlock* next = GetNextBlock(block);
+
+	if (IsBlockFree(next)) {
+		RemoveFreeBlock(next);
+		ForgetBlock(next, block);
+
+		block->size += kTlsfHeaderSize + GetBlockSize(next);
+
+		GetNextBlock(block)->prevPhys = block;
+	}
+
+	TlsfBlock* prev = block->prevPhys;
+
+	if (prev != nullptr && IsBlockFree(prev)) {
+		RemoveFreeBlock(prev);
+		ForgetBlock(block, prev);
+
+		prev->size += kTlsfHeaderSize + GetBlockSize(block);
+
+		GetNextBlock(prev)->prevPhys = prev;
+
+		block = prev;
+	}
+
+	return block;
+}
+
+void* TlsfAllocator::UseBlock(TlsfBlock* block) {
+	m_UsedSize += kTlsfHeaderSize + GetBlockSize(block);
+	++m_AllocCount;
+
+	if (m_UsedSize > m_PeakUsedSize) {
+		m_PeakUsedSize = m_UsedSize;
+	}
+
+	return GetBlockData(block);
+}
+
+TlsfBlock* TlsfAllocator::SlideBlock(TlsfBlock* block) {
+	TlsfBlock* free = block->prevPhys;
+
+	ASSERT(!IsBlockFree(block));
+	ASSERT(free != nullptr && IsBlockFree(free));
+
+	RemoveFreeBlock(free);
+
+	size_t size = GetBlockSize(block);
+	size_t freeSize = GetBlockSize(free);
+
+	TlsfBlock* next = GetNextBlock(block);
+
+	// Ranges overlap when the block is larger than the free space
+	memmove(GetBlockData(free), GetBlockData(block), size);
+
+	free->size = size;
+
+	// Free space keeps its size, now after the moved block
+	TlsfBlock* rest = GetNextBlock(free);
+	rest->prevPhys = free;
+	rest->size = freeSize;
+
+	next->prevPhys = rest;
+
+	if (IsBlockFree(next)) {
+		RemoveFreeBlock(next);
+		ForgetBlock(next, rest);
+
+		rest->size += kTlsfHeaderSize + GetBlockSize(next);
+
+		GetNextBlock(rest)->prevPhys = rest;
+	}
+
+	InsertFreeBlock(rest);
+
+	return free;
+}
+
+void TlsfAllocator::ForgetBlock(TlsfBlock* block, TlsfBlock* survivor) {
+	if (m_DefragBlock == block) {
+		m_DefragBlock = survivor;
+	}
+}
\ No newline at end of file
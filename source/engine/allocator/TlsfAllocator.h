@@ -0,0 +1,213 @@
+#ifndef TLSFALLOCATOR_H_
+#define TLSFALLOCATOR_H_
+
+#include "base_include.h"
+
+#include "Allocator.h"
+
+// Alignment of every allocation, and granularity of the block sizes
+const size_t kTlsfAlignment = 16;
+
+// log2 of the number of second level size classes in each first level class.
+// Each class spans 1/16 of its power of 2, which bounds the space that a
+// free block can lose to rounding
+const int kTlsfSecondLevelLog2 = 4;
+const int kTlsfSecondLevelCount = 1 << kTlsfSecondLevelLog2;
+
+// Blocks below this size are all in the first first level class, in size
+// classes of kTlsfAlignment bytes
+const int kTlsfSmallBlockLog2 = kTlsfSecondLevelLog2 + 4;
+const size_t kTlsfSmallBlockSize = (size_t)1 << kTlsfSmallBlockLog2;
+
+// Largest first level class is [2^(kTlsfFirstLevelMax - 1), 2^kTlsfFirstLevelMax)
+const int kTlsfFirstLevelMax = 32;
+const int kTlsfFirstLevelCount = kTlsfFirstLevelMax - kTlsfSmallBlockLog2 + 1;
+
+// Max number of blocks that one call of Defragment() looks at, so that a
+// call with little to move is cheap too
+const int kTlsfDefragBlockMax = 1024;
+
+// Called by Defragment() after an allocation has moved from oldPtr to newPtr
+//
+// oldPtr is no longer valid. MUST NOT use the allocator
+typedef void (*TlsfRelocateFunc)(void* context, void* oldPtr, void* newPtr);
+
+//--------------------------------------------------
+//
+// TlsfBlock
+//
+// Header in front of every block of a TlsfAllocator
+//
+// Blocks tile the memory of the allocator; the next block in memory starts
+// right after the data of a block
+//
+//--------------------------------------------------
+struct TlsfBlock {
+	// Previous block in memory, or nullptr for the first block
+	TlsfBlock* prevPhys;
+
+	// Size of the data in bytes, a multiple of kTlsfAlignment. The lowest bit
+	// is set while the block is free
+	size_t size;
+
+	// Neighbours in the free list of the size class, only while the block is
+	// free. They are stored in the data of the block
+	TlsfBlock* nextFree;
+	TlsfBlock* prevFree;
+};
+
+//--------------------------------------------------
+//
+// TlsfAllocator
+//
+// General purpose allocator of a fixed region of memory (Two-Level
+// Segregated Fit)
+//
+// Free blocks are kept in lists by size class. A first level class is a
+// power of 2 and is split into kTlsfSecondLevelCount second level classes.
+// Bitmaps of the non-empty classes find a free block that fits with a few
+// bit operations, so Alloc() and Dealloc() take constant time however many
+// blocks there are. A free block is merged with the free blocks next to it
+// in memory at once, so free space does not degrade into small pieces over a
+// session of loads and unloads
+//
+// Alloc() returns nullptr if no free block fits. Realloc() grows and
+// shrinks a block in place when the block after it is free
+//
+// Defragment() compacts the memory a few blocks at a time, so it can run
+// every frame. It is only for an owner that can patch every pointer into
+// the allocator, see ResourceManager
+//
+//--------------------------------------------------
+class TlsfAllocator: public IAllocator {
+
+public:
+	// Capacity includes the headers of the blocks. Must be at least
+	// kTlsfSmallBlockSize and less than 2^kTlsfFirstLevelMax
+	explicit TlsfAllocator(size_t capacity);
+	virtual ~TlsfAllocator();
+
+	// Allocates memory of the specified size aligned to kTlsfAlignment
+	virtual void* Alloc(size_t size);
+
+	// Allocates memory of the specified size with the correct alignment
+	//
+	// Alignment must be a power of 2
+	virtual void* AllocAligned(size_t size, size_t alignment);
+
+	// Ptr must be memory allocated from this allocator, or nullptr
+	virtual void Dealloc(void* ptr);
+
+	virtual void* Realloc(void* ptr, size_t oldSize, size_t size, size_t alignment);
+
+	// Returns the number of bytes that can be used at ptr, which is at least
+	// the size that was allocated
+	size_t GetAllocSize(const void* ptr) const;
+
+	// Moves allocations down into the free block in front of them, until
+	// byteMax bytes have been moved. func is called for each allocation
+	// that moved. Returns the number of bytes moved
+	//
+	// Picks up where the previous call stopped, and starts again from the
+	// front once it reaches the end of the memory. Allocations larger than
+	// byteMax are left in place
+	//
+	// Every allocation MUST have come from Alloc(), since a move keeps only
+	// kTlsfAlignment
+	size_t Defragment(size_t byteMax, TlsfRelocateFunc func, void* context);
+
+	// Returns false once Defragment() has walked all blocks without moving
+	// any, until a block is allocated or freed. Defragment() does nothing
+	// until then, e.g. when the only blocks behind holes are too large to move
+	bool CanDefragment() const { return !m_DefragDone; }
+
+	// Walks all blocks and returns false if any header is inconsistent
+	//
+	// Takes time linear in the number of blocks; for tests and debugging
+	bool CheckBlocks() const;
+
+public:
+	size_t GetCapacity() const { return m_Capacity; }
+
+	// Bytes in allocated blocks, including their headers
+	virtual size_t GetUsedSize() const { return m_UsedSize; }
+
+	// Largest value of GetUsedSize() since the allocator was created
+	size_t GetPeakUsedSize() const { return m_PeakUsedSize; }
+
+	virtual size_t GetAllocCount() const { return m_AllocCount; }
+
+	// Number of free blocks; more free blocks for the same free space means
+	// more fragmented memory
+	size_t GetFreeBlockCount() const { return m_FreeBlockCount; }
+
+private:
+	// Size of the data that an allocation of size needs
+	static size_t CalcBlockSize(size_t size);
+
+	// Size class that a free block of the size is stored in
+	static void MapInsert(size_t size, int* fl, int* sl);
+
+	// Smallest size class whose blocks all fit the size
+	static void MapSearch(size_t size, int* fl, int* sl);
+
+	// Finds a free block of at least size bytes and removes it from its list.
+	// Returns nullptr if there is none
+	TlsfBlock* TakeFreeBlock(size_t size);
+
+	void InsertFreeBlock(TlsfBlock* block);
+	void RemoveFreeBlock(TlsfBlock* block);
+
+	// Splits the end of the block off as a free block if it is large enough
+	// to hold one after size bytes
+	void SplitBlock(TlsfBlock* block, size_t size);
+
+	// Merges the free block with the free blocks before and after it, and
+	// returns the merged block
+	TlsfBlock* MergeBlock(TlsfBlock* block);
+
+	// Marks the block as allocated and returns its data
+	void* UseBlock(TlsfBlock* block);
+
+	// Moves the allocated block to the start of the free block in front of
+	// it, which becomes free space after it. Returns the moved block
+	TlsfBlock* SlideBlock(TlsfBlock* block);
+
+	// Called when the header of block is merged into survivor, so that the
+	// block that Defragment() continues from stays valid
+	void ForgetBlock(TlsfBlock* block, TlsfBlock* survivor);
+
+private:
+	byte_t* m_Memory;
+	size_t m_Capacity;
+
+	// Bit fl is set if any list of first level class fl is not empty
+	uint32_t m_FirstLevelMap;
+
+	// Bit sl of entry fl is set if list [fl][sl] is not empty
+	uint32_t m_SecondLevelMap[kTlsfFirstLevelCount];
+
+	TlsfBlock* m_FreeLists[kTlsfFirstLevelCount][kTlsfSecondLevelCount];
+
+	size_t m_UsedSize;
+	size_t m_PeakUsedSize;
+	size_t m_AllocCount;
+	size_t m_FreeBlockCount;
+
+	// Block that the next Defragment() starts from
+	TlsfBlock* m_DefragBlock;
+
+	// True while nothing has moved, been allocated or been freed since
+	// Defragment() last started from the front
+	bool m_DefragPassClean;
+
+	// Set when a whole pass of Defragment() was clean
+	bool m_DefragDone;
+
+private:
+	// Allocator is uncopyable
+	TlsfAllocator(const TlsfAllocator&);
+	TlsfAllocator& operator=(const TlsfAllocator&);
+};
+
+#endif
\ No newline at end of file
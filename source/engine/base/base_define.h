@@ -18,6 +18,15 @@
 #endif
 
 
+// Tracks memory by subsystem in debug mode, or if asked for from CMake
+
+#undef _MEM_TRACKING
+
+#if defined(_DEBUG) || defined(EXT_MEM_TRACKING)
+	#define _MEM_TRACKING
+#endif
+
+
 // determines the operating system
 
 #undef _PLATFORM_WIN
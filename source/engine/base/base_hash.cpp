@@ -1,9 +1,13 @@
 #include "base_hash.h"
 
-#include "hash/MurmurHash2.h"
-
 uint64_t HashString(const char* str) {
-	uint64_t res = MurmurHash64A((const void*)str, strlen(str), kHashSeed);
+	return FastHash64((const void*)str, strlen(str), kHashSeed);
+}
+
+uint64_t HashString(const char* str, size_t length) {
+	return FastHash64((const void*)str, length, kHashSeed);
+}
 
-	return res;
+uint64_t HashData(const void* data, size_t size) {
+	return FastHashBulk(data, size, kHashSeed);
 }
\ No newline at end of file
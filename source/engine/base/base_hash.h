@@ -4,13 +4,15 @@
 #include "base_types.h"
 #include "base_macros.h"
 
-#include "hash/MurmurHash2.h"
+#include "hash/FastHash.h"
+
+#include <cstring>
 
 //--------------------------------------------------
 //
 // Defines the hash functions
 //
-// Uses MurmurHash2
+// Uses FastHash64() for keys and strings, and FastHashBulk() for buffers
 //
 //--------------------------------------------------
 
@@ -18,14 +20,20 @@ const uint64_t kHashSeed = 0; // TODO: randomize this variable
 
 uint64_t HashString(const char* str);
 
+// Hashes the first length chars of str; same result as HashString() on a
+// string of that length
+uint64_t HashString(const char* str, size_t length);
+
+// Hashes the content of a buffer of any size, e.g. to find resources with the
+// same data or to key a cache by its input
+uint64_t HashData(const void* data, size_t size);
+
 template<typename T>
 class Hash {
 
 public:
 	uint64_t HashFunc(const T& key) {
-		uint64_t res = MurmurHash64A((const void*)&key, sizeof(T), kHashSeed);
-
-		return res;
+		return FastHash64((const void*)&key, sizeof(T), kHashSeed);
 	}
 };
 
@@ -35,9 +43,7 @@ class Hash<T*> {
 
 public:
 	uint64_t HashFunc(const T* key) {
-		uint64_t res = MurmurHash64A((const void*)key, sizeof(T), kHashSeed);
-
-		return res;
+		return FastHash64((const void*)key, sizeof(T), kHashSeed);
 	}
 };
 
@@ -63,4 +69,45 @@ public:
 };
 
 
+//--------------------------------------------------
+//
+// Defines the key equality functions used by the hash containers
+//
+// A container may also be given its own equality class. Adding EqualFunc()
+// overloads that take another type of key lets the container be searched
+// with that type; the caller then passes in the hash of the key, which MUST
+// be equal to the hash of the stored key that it is equal to
+//
+//--------------------------------------------------
+
+template<typename T>
+class Equal {
+
+public:
+	bool EqualFunc(const T& key1, const T& key2) {
+		return key1 == key2;
+	}
+};
+
+// Specialization for const char*; compares the strings
+template<>
+class Equal<const char*> {
+
+public:
+	bool EqualFunc(const char* key1, const char* key2) {
+		return strcmp(key1, key2) == 0;
+	}
+};
+
+// Specialization for char*; compares the strings
+template<>
+class Equal<char*> {
+
+public:
+	bool EqualFunc(const char* key1, const char* key2) {
+		return strcmp(key1, key2) == 0;
+	}
+};
+
+
 #endif
\ No newline at end of file
@@ -11,5 +11,6 @@
 #include "base_types.h"
 #include "base_macros.h"
 #include "base_hash.h"
+#include "base_string_id.h"
 
 #endif
\ No newline at end of file
@@ -12,6 +12,7 @@
 #include "base_define.h"
 #include "base_log.h"
 #include "base_hash.h"
+#include "base_memory.h"
 
 
 // Assert macro
@@ -19,7 +20,14 @@
 
 
 // Memory allocation macro
-#define MEM_NEW new
+//
+// When memory is tracked, records the call site of the allocation; see
+// base_memory.h
+#if defined(_MEM_TRACKING)
+	#define MEM_NEW new(__FILE__, __LINE__)
+#else
+	#define MEM_NEW new
+#endif
 
 #define MEM_DELETE(ptr) delete ptr; ptr = nullptr
 #define MEM_DELETE_ARR(ptr) delete[] ptr; ptr = nullptr
@@ -0,0 +1,394 @@
+#include "base_memory.h"
+
+#include "base_include.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+
+// Max number of call sites that are told apart; later sites are counted as
+// unknown
+const int kBaseMemSiteMax = 4096;
+
+// Number of call sites in a report
+const int kBaseMemReportSiteMax = 16;
+
+// Written to every header, so that freeing memory that did not come from
+// BaseMemAlloc() is caught
+const uint16_t kBaseMemHeaderCheck = 0xbeef;
+
+static thread_local MemTag_t s_Tag = kMemTagGeneral;
+
+static const char* s_TagNames[kMemTagCount] = {
+	"General",
+	"Resource",
+	"Physics",
+	"Entity",
+	"Render"
+};
+
+// Usage of one tag, updated by any thread
+struct BaseMemTagStats {
+	std::atomic<size_t> allocCount;
+	std::atomic<size_t> size;
+	std::atomic<size_t> peakSize;
+	std::atomic<size_t> totalAllocCount;
+
+	std::atomic<size_t> budget;
+
+	// Set while the tag is over its budget, so that it is only reported once
+	std::atomic<bool> overBudget;
+};
+
+static BaseMemTagStats s_TagStats[kMemTagCount];
+
+MemTag_t BaseMemGetTag() {
+	return s_Tag;
+}
+
+void BaseMemSetTag(MemTag_t tag) {
+	ASSERT(tag >= 0 && tag < kMemTagCount);
+
+	s_Tag = tag;
+}
+
+const char* BaseMemGetTagName(MemTag_t tag) {
+	ASSERT(tag >= 0 && tag < kMemTagCount);
+
+	return s_TagNames[tag];
+}
+
+void BaseMemGetStats(MemTag_t tag, MemStats* stats) {
+	ASSERT(tag >= 0 && tag < kMemTagCount);
+	ASSERT(stats != nullptr);
+
+	BaseMemTagStats& tagStats = s_TagStats[tag];
+
+	stats->allocCount = tagStats.allocCount.load(std::memory_order_relaxed);
+	stats->size = tagStats.size.load(std::memory_order_relaxed);
+	stats->peakSize = tagStats.peakSize.load(std::memory_order_relaxed);
+	stats->totalAllocCount = tagStats.totalAllocCount.load(std::memory_order_relaxed);
+	stats->budget = tagStats.budget.load(std::memory_order_relaxed);
+}
+
+void BaseMemSetBudget(MemTag_t tag, size_t budget) {
+	ASSERT(tag >= 0 && tag < kMemTagCount);
+
+	s_TagStats[tag].budget.store(budget, std::memory_order_relaxed);
+	s_TagStats[tag].overBudget.store(false, std::memory_order_relaxed);
+}
+
+bool BaseMemIsOverBudget(MemTag_t tag) {
+	ASSERT(tag >= 0 && tag < kMemTagCount);
+
+	size_t budget = s_TagStats[tag].budget.load(std::memory_order_relaxed);
+
+	return budget > 0 && s_TagStats[tag].size.load(std::memory_order_relaxed) > budget;
+}
+
+void BaseMemResetPeaks() {
+	for (int i = 0; i < kMemTagCount; ++i) {
+		BaseMemTagStats& tagStats = s_TagStats[i];
+
+		tagStats.peakSize.store(tagStats.size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		tagStats.totalAllocCount.store(tagStats.allocCount.load(std::memory_order_relaxed),
+									   std::memory_order_relaxed);
+	}
+}
+
+#if defined(_MEM_TRACKING)
+
+// Stored right in front of every tracked allocation
+struct BaseMemHeader {
+	uint64_t size;
+
+	// Index of the call site, 0 if it is not known
+	uint32_t site;
+
+	uint16_t tag;
+	uint16_t check;
+};
+
+// Keeps the memory after the header aligned as malloc() aligns it
+static_assert(sizeof(BaseMemHeader) == 16, "Header must keep the alignment of malloc()");
+
+// Usage of the memory allocated at one line with one tag
+struct BaseMemSite {
+	const char* file;
+	int line;
+	MemTag_t tag;
+
+	size_t allocCount;
+	size_t size;
+};
+
+// Open addressed table of the call sites; entry 0 is the unknown site
+static BaseMemSite s_Sites[kBaseMemSiteMax];
+static int s_SiteCount = 1;
+static std::mutex s_SiteMutex;
+
+// Returns the index of the call site, adding it if it is new
+//
+// MUST be called with s_SiteMutex locked
+static uint32_t FindSite(const char* file, int line, MemTag_t tag) {
+	// Keeps the table at most 3/4 full, so that probing stays short
+	size_t hash = ((size_t)file >> 3) * 31 + (size_t)line * 131 + (size_t)tag;
+	uint32_t index = (uint32_t)(hash & (kBaseMemSiteMax - 1));
+
+	while (true) {
+		if (index != 0) {
+			BaseMemSite& site = s_Sites[index];
+
+			if (site.file == nullptr) {
+				if (s_SiteCount >= kBaseMemSiteMax / 4 * 3) {
+					return 0;
+				}
+
+				site.file = file;
+				site.line = line;
+				site.tag = tag;
+				++s_SiteCount;
+
+				return index;
+			}
+
+			if (site.file == file && site.line == line && site.tag == tag) {
+				return index;
+			}
+		}
+
+		index = (index + 1) & (kBaseMemSiteMax - 1);
+	}
+}
+
+void* BaseMemAlloc(size_t size, const char* file, int line) {
+	BaseMemHeader* header = (BaseMemHeader*)malloc(sizeof(BaseMemHeader) + size);
+
+	if (header == nullptr) {
+		return nullptr;
+	}
+
+	MemTag_t tag = s_Tag;
+
+	header->size = size;
+	header->site = 0;
+	header->tag = (uint16_t)tag;
+	header->check = kBaseMemHeaderCheck;
+
+	if (file != nullptr) {
+		std::lock_guard<std::mutex> lock(s_SiteMutex);
+
+		header->site = FindSite(file, line, tag);
+
+		s_Sites[header->site].allocCount += 1;
+		s_Sites[header->site].size += size;
+	}
+
+	BaseMemTagStats& tagStats = s_TagStats[tag];
+
+	tagStats.allocCount.fetch_add(1, std::memory_order_relaxed);
+	tagStats.totalAllocCount.fetch_add(1, std::memory_order_relaxed);
+
+	size_t newSize = tagStats.size.fetch_add(size, std::memory_order_relaxed) + size;
+	size_t peakSize = tagStats.peakSize.load(std::memory_order_relaxed);
+
+	while (newSize > peakSize &&
+		   !tagStats.peakSize.compare_exchange_weak(peakSize, newSize, std::memory_order_relaxed)) {
+	}
+
+	size_t budget = tagStats.budget.load(std::memory_order_relaxed);
+
+	if (budget > 0 && newSize > budget && !tagStats.overBudget.exchange(true, std::memory_order_relaxed)) {
+		LOG_WARNING("Memory: %s is over its budget (%zu of %zu bytes)", s_TagNames[tag], newSize, budget);
+	}
+
+	return header + 1;
+}
+
+void BaseMemFree(void* ptr) {
+	if (ptr == nullptr) {
+		return;
+	}
+
+	BaseMemHeader* header = (BaseMemHeader*)ptr - 1;
+
+	ASSERT(header->check == kBaseMemHeaderCheck);
+	ASSERT(header->tag < kMemTagCount);
+
+	size_t size = (size_t)header->size;
+
+	if (header->site != 0) {
+		std::lock_guard<std::mutex> lock(s_SiteMutex);
+
+		s_Sites[header->site].allocCount -= 1;
+		s_Sites[header->site].size -= size;
+	}
+
+	BaseMemTagStats& tagStats = s_TagStats[header->tag];
+
+	tagStats.allocCount.fetch_sub(1, std::memory_order_relaxed);
+
+	size_t newSize = tagStats.size.fetch_sub(size, std::memory_order_relaxed) - size;
+
+	// Warns again if the tag goes back over its budget
+	if (newSize <= tagStats.budget.load(std::memory_order_relaxed)) {
+		tagStats.overBudget.store(false, std::memory_order_relaxed);
+	}
+
+	header->check = 0;
+
+	free(header);
+}
+
+void BaseMemLogReport() {
+	BaseLogPrint("Memory usage by tag:");
+
+	for (int i = 0; i < kMemTagCount; ++i) {
+		MemStats stats;
+		BaseMemGetStats((MemTag_t)i, &stats);
+
+		BaseLogPrint("  %-10s %12zu bytes in %8zu allocations, peak %12zu bytes, budget %12zu bytes%s", s_TagNames[i],
+					 stats.size, stats.allocCount, stats.peakSize, stats.budget,
+					 BaseMemIsOverBudget((MemTag_t)i) ? " (OVER)" : "");
+	}
+
+	// Copies the largest sites, so that logging does not hold the lock
+	BaseMemSite topSites[kBaseMemReportSiteMax];
+	int topCount = 0;
+
+	{
+		std::lock_guard<std::mutex> lock(s_SiteMutex);
+
+		for (int i = 1; i < kBaseMemSiteMax; ++i) {
+			const BaseMemSite& site = s_Sites[i];
+
+			if (site.file == nullptr || site.size == 0) {
+				continue;
+			}
+
+			// Insertion into the list sorted by size
+			int index = topCount < kBaseMemReportSiteMax ? topCount++ : kBaseMemReportSiteMax;
+
+			while (index > 0 && topSites[index - 1].size < site.size) {
+				if (index < kBaseMemReportSiteMax) {
+					topSites[index] = topSites[index - 1];
+				}
+
+				--index;
+			}
+
+			if (index < kBaseMemReportSiteMax) {
+				topSites[index] = site;
+			}
+		}
+	}
+
+	BaseLogPrint("Largest call sites:");
+
+	for (int i = 0; i < topCount; ++i) {
+		BaseLogPrint("  %12zu bytes in %8zu allocations (%s) %s:%d", topSites[i].size, topSites[i].allocCount,
+					 s_TagNames[topSites[i].tag], topSites[i].file, topSites[i].line);
+	}
+}
+
+// Global new and delete are replaced so that memory from MEM_NEW can be
+// freed with a plain delete. Memory from any other new is tracked with an
+// unknown call site
+
+void* operator new(size_t size) {
+	void* ptr = BaseMemAlloc(size, nullptr, 0);
+
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+
+	return ptr;
+}
+
+void* operator new[](size_t size) {
+	void* ptr = BaseMemAlloc(size, nullptr, 0);
+
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+
+	return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+	return BaseMemAlloc(size, nullptr, 0);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+	return BaseMemAlloc(size, nullptr, 0);
+}
+
+void* operator new(size_t size, const char* file, int line) {
+	void* ptr = BaseMemAlloc(size, file, line);
+
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+
+	return ptr;
+}
+
+void* operator new[](size_t size, const char* file, int line) {
+	void* ptr = BaseMemAlloc(size, file, line);
+
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+	BaseMemFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+	BaseMemFree(ptr);
+}
+
+// Sized versions are called by code built for C++14 and later, such as the
+// standard library
+void operator delete(void* ptr, size_t size) noexcept {
+	BaseMemFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t size) noexcept {
+	BaseMemFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+	BaseMemFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+	BaseMemFree(ptr);
+}
+
+void operator delete(void* ptr, const char* file, int line) noexcept {
+	BaseMemFree(ptr);
+}
+
+void operator delete[](void* ptr, const char* file, int line) noexcept {
+	BaseMemFree(ptr);
+}
+
+#else
+
+void* BaseMemAlloc(size_t size, const char* file, int line) {
+	return malloc(size);
+}
+
+void BaseMemFree(void* ptr) {
+	free(ptr);
+}
+
+void BaseMemLogReport() {
+	BaseLogPrint("Memory tracking is off; build with BUILD_MEM_TRACKING or in debug mode");
+}
+
+#endif
\ No newline at end of file
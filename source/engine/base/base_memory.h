@@ -0,0 +1,128 @@
+#ifndef BASE_MEMORY_H_
+#define BASE_MEMORY_H_
+
+//--------------------------------------------------
+//
+// Defines the memory tracking functions
+//
+// User should allocate memory with the MEM_NEW and MEM_DELETE macros from
+// base_include.h
+//
+// When tracking is on (_MEM_TRACKING, see base_define.h), every allocation
+// with new and delete has a small header that records its size, the tag of
+// the subsystem that made it and, for MEM_NEW, the file and line it was made
+// at. Each tag has a budget; a warning is logged when a tag goes over its
+// budget
+//
+// Allocations are tagged with the tag of the innermost MemTagScope on their
+// thread. Jobs run with the tag of their worker thread, kMemTagGeneral
+//
+// When tracking is off, MEM_NEW is plain new and the stats stay at zero
+//
+//--------------------------------------------------
+
+#include "base_define.h"
+
+#include <cstddef>
+#include <new>
+
+// Subsystem that an allocation is counted against
+enum MemTag_t {
+	kMemTagGeneral,
+	kMemTagResource,
+	kMemTagPhysics,
+	kMemTagEntity,
+	kMemTagRender,
+
+	kMemTagCount
+};
+
+// Usage of one tag
+struct MemStats {
+	// Allocations in use, and bytes that they requested
+	size_t allocCount;
+	size_t size;
+
+	// Largest size since the stats were reset
+	size_t peakSize;
+
+	// Allocations made since the stats were reset
+	size_t totalAllocCount;
+
+	// 0 if the tag has no budget
+	size_t budget;
+};
+
+// Allocates and frees tracked memory of the current tag
+//
+// file is nullptr if the call site is not known. Memory from
+// BaseMemAlloc() MUST be freed with BaseMemFree()
+void* BaseMemAlloc(size_t size, const char* file, int line);
+void BaseMemFree(void* ptr);
+
+// Tag of the calling thread
+MemTag_t BaseMemGetTag();
+void BaseMemSetTag(MemTag_t tag);
+
+const char* BaseMemGetTagName(MemTag_t tag);
+
+void BaseMemGetStats(MemTag_t tag, MemStats* stats);
+
+// Sets the number of bytes that the tag should stay under. 0 removes the
+// budget
+//
+// A warning is logged once each time the tag goes over its budget
+void BaseMemSetBudget(MemTag_t tag, size_t budget);
+
+bool BaseMemIsOverBudget(MemTag_t tag);
+
+// Sets the peak and total count of every tag to its current usage
+void BaseMemResetPeaks();
+
+// Logs the usage of each tag, and the call sites that hold the most memory
+void BaseMemLogReport();
+
+//--------------------------------------------------
+//
+// MemTagScope
+//
+// Sets the tag of the calling thread for the lifetime of the scope, and
+// restores the previous tag at the end
+//
+//--------------------------------------------------
+class MemTagScope {
+
+public:
+	explicit MemTagScope(MemTag_t tag) {
+		m_PrevTag = BaseMemGetTag();
+
+		BaseMemSetTag(tag);
+	}
+
+	~MemTagScope() {
+		BaseMemSetTag(m_PrevTag);
+	}
+
+private:
+	MemTag_t m_PrevTag;
+
+private:
+	// Scope is uncopyable
+	MemTagScope(const MemTagScope&);
+	MemTagScope& operator=(const MemTagScope&);
+};
+
+#if defined(_MEM_TRACKING)
+
+// Used by MEM_NEW to record the call site. The global new and delete are
+// replaced in base_memory.cpp, so MEM_DELETE stays a plain delete
+void* operator new(size_t size, const char* file, int line);
+void* operator new[](size_t size, const char* file, int line);
+
+// Only called if a constructor throws
+void operator delete(void* ptr, const char* file, int line) noexcept;
+void operator delete[](void* ptr, const char* file, int line) noexcept;
+
+#endif
+
+#endif
\ No newline at end of file
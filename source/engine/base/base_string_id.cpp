@@ -0,0 +1,105 @@
+#include "base_string_id.h"
+
+#include "base_macros.h"
+
+#include "container/FlatHashMap.h"
+
+#include <mutex>
+
+// Initial number of strings in the string table
+const int kStringTableSizeInit = 256;
+
+//--------------------------------------------------
+//
+// StringTable
+//
+// Copies of all interned strings, keyed by their id
+//
+//--------------------------------------------------
+class StringTable {
+
+public:
+	StringTable(): m_Table(kStringTableSizeInit, kContainerGrowthAuto) {}
+
+	~StringTable() {
+		for (auto it = m_Table.Begin(); it != m_Table.End(); ++it) {
+			char* str = it.GetValue();
+
+			MEM_DELETE_ARR(str);
+		}
+	}
+
+	StringId Intern(const char* str) {
+		StringId id(str);
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		auto it = m_Table.Find(id);
+
+		if (it != m_Table.End()) {
+			if (strcmp(it.GetValue(), str) != 0) {
+				LOG_FATAL_ERROR("StringTable: \'%s\' and \'%s\' have the same id", it.GetValue(), str);
+			}
+
+			return id;
+		}
+
+		size_t length = strlen(str);
+
+		char* copy = MEM_NEW char[length + 1];
+		memcpy(copy, str, length + 1);
+
+		m_Table.Insert(id, copy);
+
+		return id;
+	}
+
+	const char* Find(StringId id) {
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		auto it = m_Table.Find(id);
+
+		if (it == m_Table.End()) {
+			return nullptr;
+		}
+
+		return it.GetValue();
+	}
+
+private:
+	FlatHashMap<StringId, char*> m_Table;
+
+	std::mutex m_Mutex;
+};
+
+// Created on first use, so that strings can be interned during static
+// initialization, e.g. by the entity type registration
+static StringTable& GetStringTable() {
+	static StringTable table;
+
+	return table;
+}
+
+uint64_t HashStringId(const char* str) {
+	uint64_t hash = kStringIdFnvOffset;
+
+	for (; *str != '\0'; ++str) {
+		hash = (hash ^ (uint64_t)(unsigned char)*str) * kStringIdFnvPrime;
+	}
+
+	return StringIdMix(hash);
+}
+
+const char* StringId::GetString() const {
+	const char* str = FindInternedString(*this);
+
+	return str != nullptr ? str : "<unknown>";
+}
+
+StringId InternString(const char* str) {
+	return GetStringTable().Intern(str);
+}
+
+const char* FindInternedString(StringId id) {
+	return GetStringTable().Find(id);
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#ifndef BASE_STRING_ID_H_
+#define BASE_STRING_ID_H_
+
+#include "base_types.h"
+#include "base_hash.h"
+
+#include <type_traits>
+
+//--------------------------------------------------
+//
+// Defines the string ids
+//
+// A string id is the 64 bit hash of a string, used in place of the string as
+// the key of names that are looked up often, such as resource paths, texture
+// names and sprite clips. Looking up a string id is a single integer probe,
+// instead of hashing the whole string on every call
+//
+// Ids of string literals are computed at compile time with STRING_ID().
+// Strings that names are created from should be interned with
+// InternString(), which keeps a copy of the string so that the id can be
+// turned back into the string for logging
+//
+// Uses FNV-1a with a final mix, since it can be computed by a constexpr
+// function; the id is NOT the same as HashString() of the string
+//
+//--------------------------------------------------
+
+const uint64_t kStringIdFnvOffset = 14695981039346656037ULL;
+const uint64_t kStringIdFnvPrime = 1099511628211ULL;
+
+constexpr uint64_t StringIdShiftXor(uint64_t hash, int shift) {
+	return hash ^ (hash >> shift);
+}
+
+// Mixes the high bits of the hash into the low bits, which the containers
+// use to pick the bucket
+constexpr uint64_t StringIdMix(uint64_t hash) {
+	return StringIdShiftXor(StringIdShiftXor(StringIdShiftXor(hash, 33) * 0xFF51AFD7ED558CCDULL, 33) *
+							0xC4CEB9FE1A85EC53ULL, 33);
+}
+
+constexpr uint64_t StringIdFnv(const char* str, uint64_t hash) {
+	return *str == '\0' ? hash : StringIdFnv(str + 1, (hash ^ (uint64_t)(unsigned char)*str) * kStringIdFnvPrime);
+}
+
+// Hash of the string; may be evaluated at compile time
+constexpr uint64_t HashStringConst(const char* str) {
+	return StringIdMix(StringIdFnv(str, kStringIdFnvOffset));
+}
+
+// Same result as HashStringConst(), computed with a loop at run time
+uint64_t HashStringId(const char* str);
+
+class StringId {
+
+public:
+	constexpr StringId(): m_Hash(0) {}
+
+	// Hashes the string at run time without interning it
+	explicit StringId(const char* str): m_Hash(HashStringId(str)) {}
+
+	static constexpr StringId FromHash(uint64_t hash) {
+		return StringId(hash, 0);
+	}
+
+	constexpr uint64_t GetHash() const { return m_Hash; }
+
+	constexpr bool IsValid() const { return m_Hash != 0; }
+
+	// Interned string with this id, or "<unknown>" if the string was never
+	// interned
+	const char* GetString() const;
+
+	constexpr bool operator==(const StringId& id) const { return m_Hash == id.m_Hash; }
+	constexpr bool operator!=(const StringId& id) const { return m_Hash != id.m_Hash; }
+
+private:
+	// Unused int keeps the constructor apart from the public ones
+	constexpr StringId(uint64_t hash, int): m_Hash(hash) {}
+
+private:
+	uint64_t m_Hash;
+};
+
+// Returns the id of the string literal, computed at compile time
+#define STRING_ID(str) StringId::FromHash(std::integral_constant<uint64_t, HashStringConst(str)>::value)
+
+// Returns the id of the string and keeps a copy of the string in the global
+// string table
+//
+// Two different strings with the same id is a fatal error. Thread safe
+StringId InternString(const char* str);
+
+// Returns the interned string with the id, or nullptr if there is none
+//
+// Thread safe
+const char* FindInternedString(StringId id);
+
+// Specialization for string ids; the id already is a hash
+template<>
+class Hash<StringId> {
+
+public:
+	uint64_t HashFunc(const StringId& key) {
+		return key.GetHash();
+	}
+};
+
+#endif
\ No newline at end of file
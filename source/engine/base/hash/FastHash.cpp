@@ -0,0 +1,226 @@
+#include "FastHash.h"
+
+// Accumulation uses AVX2 if the build enables it, else SSE2 on x86-64, else
+// a scalar loop
+#if !defined(EXT_FASTHASH_NO_SIMD) && defined(__AVX2__)
+	#include <immintrin.h>
+	#define FASTHASH_SIMD_AVX2
+#elif !defined(EXT_FASTHASH_NO_SIMD) && defined(__SSE2__)
+	#include <emmintrin.h>
+	#define FASTHASH_SIMD_SSE2
+#endif
+
+// Buffers shorter than this are hashed by FastHash64(), which is faster
+// until the accumulators pay for their setup and merge
+const size_t kFastHashBulkMin = 256;
+
+// Number of accumulator lanes and bytes read into them at a time
+const int kFastHashLaneCount = 8;
+const size_t kFastHashStripeSize = 64;
+
+// Accumulators are scrambled after each block of stripes
+const int kFastHashStripesPerBlock = 16;
+const size_t kFastHashBlockSize = kFastHashStripeSize * kFastHashStripesPerBlock;
+
+const uint64_t kFastHashPrime32 = 0x9E3779B1ULL;
+const uint64_t kFastHashPrime64 = 0x9E3779B185EBCA87ULL;
+
+// Stripe i of a block is keyed by kFastHashStripeSecret[i..i+8); the last
+// stripe of the buffer by the 8 after the last stripe of a block
+static const uint64_t kFastHashStripeSecret[kFastHashStripesPerBlock + kFastHashLaneCount] = {
+	0x3A34CE6380FC0BC5ULL, 0xC05A677850DC981AULL, 0x9E32CDF7948370BDULL, 0xA7765F796F00BBEFULL,
+	0xBBBB23FE6921FE52ULL, 0x5BF0C31CACF1E17FULL, 0x3E1900A6529BE043ULL, 0x2A16CD9ED424EA1EULL,
+	0x579593114410E048ULL, 0x0A29F5FE3DF351F0ULL, 0x1B4897E079059AD2ULL, 0x2D9CD179C9E412E1ULL,
+	0x315949173D12F7E0ULL, 0x7C69B356B72B606FULL, 0xB6EC11F8CAA9EBCFULL, 0x841E03B1ED92F734ULL,
+	0x8898A5DF2BA2AE99ULL, 0xF810FEA09E7EEAA5ULL, 0x27A56DE32B6A852CULL, 0x141D3CDEB2A328A7ULL,
+	0xFA6C784C6C59C00FULL, 0x6BB8C0B28140B75FULL, 0xB3469BAEABCF5FACULL, 0xC03B1AF969A981B8ULL
+};
+
+static const uint64_t kFastHashScrambleSecret[kFastHashLaneCount] = {
+	0xEC7C99144BE2AC06ULL, 0x52AF400DEB7B9DAEULL, 0x4E3C54F2F51F1E28ULL, 0x7991820C21348DAAULL,
+	0x16FDA58F4606377CULL, 0x1F2B3B8EC35C9E73ULL, 0x88BA012F31187EB0ULL, 0x38156C76CE316DA2ULL
+};
+
+static const uint64_t kFastHashMergeSecret[kFastHashLaneCount] = {
+	0x568C3ABE507F99C9ULL, 0xFBB94B9C5AA35F85ULL, 0x6357D4CE0564F16DULL, 0x807B8E8B225D506CULL,
+	0xE94DD7B1C51EFC33ULL, 0xC78818D18F476C5AULL, 0xAFDD7F640CFB3147ULL, 0x88E410D77DB44E58ULL
+};
+
+#if defined(FASTHASH_SIMD_SSE2)
+// Adds 2 lanes of a stripe into their accumulators
+static inline __m128i FastHashAccumulateSse2(__m128i acc, __m128i data, __m128i key) {
+	__m128i keyed = _mm_xor_si128(data, key);
+
+	// Multiplies the low 32 bits of each lane by the high 32 bits
+	__m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+
+	// Swaps the neighbouring lanes
+	__m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+
+	return _mm_add_epi64(acc, _mm_add_epi64(product, swapped));
+}
+#endif
+
+// Adds the stripes into the accumulators; stripe i is keyed by the 8 secrets
+// from secret + i
+//
+// Each lane adds the product of the low and high 32 bits of the keyed data,
+// and the unkeyed data of its neighbour lane so that no input is lost when a
+// product is 0
+//
+// Accumulators are kept in registers for all stripes, since the compiler
+// must assume that a store to them can change the data
+static inline void FastHashAccumulate(uint64_t* acc, const unsigned char* data, int stripeCount, const uint64_t* secret) {
+#if defined(FASTHASH_SIMD_AVX2)
+	__m256i acc0 = _mm256_load_si256((const __m256i*)acc);
+	__m256i acc1 = _mm256_load_si256((const __m256i*)acc + 1);
+
+	for (int i = 0; i < stripeCount; ++i) {
+		const __m256i* dataPtr = (const __m256i*)(data + i * kFastHashStripeSize);
+		const __m256i* keyPtr = (const __m256i*)(secret + i);
+
+		__m256i data0 = _mm256_loadu_si256(dataPtr);
+		__m256i data1 = _mm256_loadu_si256(dataPtr + 1);
+
+		__m256i keyed0 = _mm256_xor_si256(data0, _mm256_loadu_si256(keyPtr));
+		__m256i keyed1 = _mm256_xor_si256(data1, _mm256_loadu_si256(keyPtr + 1));
+
+		// Multiplies the low 32 bits of each lane by the high 32 bits
+		__m256i product0 = _mm256_mul_epu32(keyed0, _mm256_shuffle_epi32(keyed0, _MM_SHUFFLE(0, 3, 0, 1)));
+		__m256i product1 = _mm256_mul_epu32(keyed1, _mm256_shuffle_epi32(keyed1, _MM_SHUFFLE(0, 3, 0, 1)));
+
+		// Swaps the neighbouring lanes
+		acc0 = _mm256_add_epi64(acc0, _mm256_add_epi64(product0, _mm256_shuffle_epi32(data0, _MM_SHUFFLE(1, 0, 3, 2))));
+		acc1 = _mm256_add_epi64(acc1, _mm256_add_epi64(product1, _mm256_shuffle_epi32(data1, _MM_SHUFFLE(1, 0, 3, 2))));
+	}
+
+	_mm256_store_si256((__m256i*)acc, acc0);
+	_mm256_store_si256((__m256i*)acc + 1, acc1);
+#elif defined(FASTHASH_SIMD_SSE2)
+	__m128i acc0 = _mm_load_si128((const __m128i*)acc);
+	__m128i acc1 = _mm_load_si128((const __m128i*)acc + 1);
+	__m128i acc2 = _mm_load_si128((const __m128i*)acc + 2);
+	__m128i acc3 = _mm_load_si128((const __m128i*)acc + 3);
+
+	for (int i = 0; i < stripeCount; ++i) {
+		const __m128i* dataPtr = (const __m128i*)(data + i * kFastHashStripeSize);
+		const __m128i* keyPtr = (const __m128i*)(secret + i);
+
+		acc0 = FastHashAccumulateSse2(acc0, _mm_loadu_si128(dataPtr), _mm_loadu_si128(keyPtr));
+		acc1 = FastHashAccumulateSse2(acc1, _mm_loadu_si128(dataPtr + 1), _mm_loadu_si128(keyPtr + 1));
+		acc2 = FastHashAccumulateSse2(acc2, _mm_loadu_si128(dataPtr + 2), _mm_loadu_si128(keyPtr + 2));
+		acc3 = FastHashAccumulateSse2(acc3, _mm_loadu_si128(dataPtr + 3), _mm_loadu_si128(keyPtr + 3));
+	}
+
+	_mm_store_si128((__m128i*)acc, acc0);
+	_mm_store_si128((__m128i*)acc + 1, acc1);
+	_mm_store_si128((__m128i*)acc + 2, acc2);
+	_mm_store_si128((__m128i*)acc + 3, acc3);
+#else
+	uint64_t accLocal[kFastHashLaneCount];
+
+	for (int j = 0; j < kFastHashLaneCount; ++j) {
+		accLocal[j] = acc[j];
+	}
+
+	for (int i = 0; i < stripeCount; ++i) {
+		const unsigned char* stripe = data + i * kFastHashStripeSize;
+
+		for (int j = 0; j < kFastHashLaneCount; ++j) {
+			uint64_t keyed = FastHashRead64(stripe + j * 8) ^ secret[i + j];
+
+			accLocal[j] += (keyed & 0xFFFFFFFFULL) * (keyed >> 32);
+			accLocal[j] += FastHashRead64(stripe + (j ^ 1) * 8);
+		}
+	}
+
+	for (int j = 0; j < kFastHashLaneCount; ++j) {
+		acc[j] = accLocal[j];
+	}
+#endif
+}
+
+// Spreads the high bits of the accumulators into the low bits, which the
+// 32 bit multiplies would otherwise never mix back in
+static inline void FastHashScramble(uint64_t* acc) {
+#if defined(FASTHASH_SIMD_AVX2)
+	__m256i* accVec = (__m256i*)acc;
+	__m256i prime = _mm256_set1_epi32((int)kFastHashPrime32);
+
+	for (int i = 0; i < kFastHashLaneCount / 4; ++i) {
+		__m256i value = _mm256_xor_si256(accVec[i], _mm256_srli_epi64(accVec[i], 47));
+		value = _mm256_xor_si256(value, _mm256_loadu_si256((const __m256i*)kFastHashScrambleSecret + i));
+
+		// 64x32 bit multiply from two 32x32 bit multiplies
+		__m256i valueHi = _mm256_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1));
+		__m256i productLo = _mm256_mul_epu32(value, prime);
+		__m256i productHi = _mm256_mul_epu32(valueHi, prime);
+
+		accVec[i] = _mm256_add_epi64(productLo, _mm256_slli_epi64(productHi, 32));
+	}
+#elif defined(FASTHASH_SIMD_SSE2)
+	__m128i* accVec = (__m128i*)acc;
+	__m128i prime = _mm_set1_epi32((int)kFastHashPrime32);
+
+	for (int i = 0; i < kFastHashLaneCount / 2; ++i) {
+		__m128i value = _mm_xor_si128(accVec[i], _mm_srli_epi64(accVec[i], 47));
+		value = _mm_xor_si128(value, _mm_loadu_si128((const __m128i*)kFastHashScrambleSecret + i));
+
+		// 64x32 bit multiply from two 32x32 bit multiplies
+		__m128i valueHi = _mm_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1));
+		__m128i productLo = _mm_mul_epu32(value, prime);
+		__m128i productHi = _mm_mul_epu32(valueHi, prime);
+
+		accVec[i] = _mm_add_epi64(productLo, _mm_slli_epi64(productHi, 32));
+	}
+#else
+	for (int i = 0; i < kFastHashLaneCount; ++i) {
+		uint64_t value = acc[i] ^ (acc[i] >> 47);
+		value ^= kFastHashScrambleSecret[i];
+
+		acc[i] = value * kFastHashPrime32;
+	}
+#endif
+}
+
+uint64_t FastHashBulk(const void* data, size_t len, uint64_t seed) {
+	if (len < kFastHashBulkMin) {
+		return FastHash64(data, len, seed);
+	}
+
+	const unsigned char* ptr = (const unsigned char*)data;
+
+	alignas(32) uint64_t acc[kFastHashLaneCount];
+
+	for (int i = 0; i < kFastHashLaneCount; ++i) {
+		acc[i] = seed ^ kFastHashMergeSecret[i];
+	}
+
+	// The last block is done below, even if it is full, so that there is
+	// always a last stripe
+	size_t blockCount = (len - 1) / kFastHashBlockSize;
+
+	for (size_t block = 0; block < blockCount; ++block) {
+		FastHashAccumulate(acc, ptr + block * kFastHashBlockSize, kFastHashStripesPerBlock, kFastHashStripeSecret);
+		FastHashScramble(acc);
+	}
+
+	int stripeCount = (int)((len - blockCount * kFastHashBlockSize - 1) / kFastHashStripeSize);
+
+	FastHashAccumulate(acc, ptr + blockCount * kFastHashBlockSize, stripeCount, kFastHashStripeSecret);
+
+	// Last 64 bytes, which may overlap the stripes before it
+	FastHashAccumulate(acc, ptr + len - kFastHashStripeSize, 1, &kFastHashStripeSecret[kFastHashStripesPerBlock]);
+
+	uint64_t result = len * kFastHashPrime64;
+
+	for (int i = 0; i < kFastHashLaneCount; i += 2) {
+		result += FastHashMix(acc[i] ^ kFastHashStripeSecret[i + 3], acc[i + 1] ^ kFastHashStripeSecret[i + 4]);
+	}
+
+	result ^= result >> 37;
+	result *= 0x165667919E3779F9ULL;
+	result ^= result >> 32;
+
+	return result;
+}
\ No newline at end of file
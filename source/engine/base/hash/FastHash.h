@@ -0,0 +1,157 @@
+#ifndef FASTHASH_H_
+#define FASTHASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+//--------------------------------------------------
+//
+// Defines the fast hash functions
+//
+// FastHash64() is for short keys such as ints, pointers and names. It is
+// based on wyhash by Wang Yi (public domain), and mixes 16 bytes with one
+// 64x64->128 bit multiply. It is inline so that hashing a key of fixed size
+// compiles down to a few instructions
+//
+// FastHashBulk() is for long buffers, e.g. hashing the content of a resource.
+// It is modeled on XXH3: 8 lanes of accumulators are updated with 32x32->64
+// bit multiplies, which SSE2 and AVX2 do 2 or 4 lanes at a time. The result
+// is the same for every instruction set
+//
+// Reads are unaligned safe. Results are NOT the same on big-endian machines
+//
+//--------------------------------------------------
+
+const uint64_t kFastHashSecret0 = 0x2D358DCCAA6C78A5ULL;
+const uint64_t kFastHashSecret1 = 0x8BB84B93962EACC9ULL;
+const uint64_t kFastHashSecret2 = 0x4B33A62ED433D4A3ULL;
+const uint64_t kFastHashSecret3 = 0x4D5A2DA51DE1AA47ULL;
+
+// Multiplies a and b into a 128 bit product, stored as its low half in a and
+// its high half in b
+inline void FastHashMul128(uint64_t* a, uint64_t* b) {
+#if defined(__SIZEOF_INT128__)
+	__extension__ typedef unsigned __int128 FastHashU128_t;
+
+	FastHashU128_t product = (FastHashU128_t)*a * *b;
+
+	*a = (uint64_t)product;
+	*b = (uint64_t)(product >> 64);
+#else
+	uint64_t aHi = *a >> 32;
+	uint64_t aLo = (uint32_t)*a;
+	uint64_t bHi = *b >> 32;
+	uint64_t bLo = (uint32_t)*b;
+
+	uint64_t hi = aHi * bHi;
+	uint64_t mid0 = aHi * bLo;
+	uint64_t mid1 = bHi * aLo;
+	uint64_t lo = aLo * bLo;
+
+	uint64_t sum = lo + (mid0 << 32);
+	uint64_t carry = sum < lo;
+
+	lo = sum + (mid1 << 32);
+	carry += lo < sum;
+
+	*a = lo;
+	*b = hi + (mid0 >> 32) + (mid1 >> 32) + carry;
+#endif
+}
+
+// Folds the 128 bit product of a and b into 64 bits
+inline uint64_t FastHashMix(uint64_t a, uint64_t b) {
+	FastHashMul128(&a, &b);
+
+	return a ^ b;
+}
+
+inline uint64_t FastHashRead64(const unsigned char* ptr) {
+	uint64_t value;
+	memcpy(&value, ptr, sizeof(value));
+
+	return value;
+}
+
+inline uint64_t FastHashRead32(const unsigned char* ptr) {
+	uint32_t value;
+	memcpy(&value, ptr, sizeof(value));
+
+	return value;
+}
+
+// Reads 1 to 3 bytes
+inline uint64_t FastHashRead3(const unsigned char* ptr, size_t len) {
+	return ((uint64_t)ptr[0] << 16) | ((uint64_t)ptr[len >> 1] << 8) | ptr[len - 1];
+}
+
+inline uint64_t FastHash64(const void* key, size_t len, uint64_t seed) {
+	const unsigned char* ptr = (const unsigned char*)key;
+
+	seed ^= FastHashMix(seed ^ kFastHashSecret0, kFastHashSecret1);
+
+	uint64_t a;
+	uint64_t b;
+
+	if (len <= 16) {
+		// Reads the first and last 4 or 8 bytes, which overlap for short keys
+		if (len >= 4) {
+			size_t offset = (len >> 3) << 2;
+
+			a = (FastHashRead32(ptr) << 32) | FastHashRead32(ptr + offset);
+			b = (FastHashRead32(ptr + len - 4) << 32) | FastHashRead32(ptr + len - 4 - offset);
+		}
+		else if (len > 0) {
+			a = FastHashRead3(ptr, len);
+			b = 0;
+		}
+		else {
+			a = 0;
+			b = 0;
+		}
+	}
+	else {
+		size_t rest = len;
+
+		// Three independent chains so that the multiplies overlap
+		if (rest > 48) {
+			uint64_t seed1 = seed;
+			uint64_t seed2 = seed;
+
+			do {
+				seed = FastHashMix(FastHashRead64(ptr) ^ kFastHashSecret1, FastHashRead64(ptr + 8) ^ seed);
+				seed1 = FastHashMix(FastHashRead64(ptr + 16) ^ kFastHashSecret2, FastHashRead64(ptr + 24) ^ seed1);
+				seed2 = FastHashMix(FastHashRead64(ptr + 32) ^ kFastHashSecret3, FastHashRead64(ptr + 40) ^ seed2);
+
+				ptr += 48;
+				rest -= 48;
+			} while (rest > 48);
+
+			seed ^= seed1 ^ seed2;
+		}
+
+		while (rest > 16) {
+			seed = FastHashMix(FastHashRead64(ptr) ^ kFastHashSecret1, FastHashRead64(ptr + 8) ^ seed);
+
+			ptr += 16;
+			rest -= 16;
+		}
+
+		// Last 16 bytes, which may overlap the bytes already mixed
+		a = FastHashRead64(ptr + rest - 16);
+		b = FastHashRead64(ptr + rest - 8);
+	}
+
+	a ^= kFastHashSecret1;
+	b ^= seed;
+
+	FastHashMul128(&a, &b);
+
+	return FastHashMix(a ^ kFastHashSecret0 ^ len, b ^ kFastHashSecret1);
+}
+
+// Hash of a long buffer; short buffers are passed on to FastHash64()
+uint64_t FastHashBulk(const void* data, size_t len, uint64_t seed);
+
+#endif
\ No newline at end of file
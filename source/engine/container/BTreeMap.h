@@ -0,0 +1,919 @@
+#ifndef BTREEMAP_H_
+#define BTREEMAP_H_
+
+#include "base_include.h"
+
+#include "allocator/PoolAllocator.h"
+
+#include "ContainerGrowth.h"
+
+#include <new>
+
+// Target size of a node; a few cache lines so that a node is searched with
+// few cache misses and the hardware prefetcher streams the leaves
+const int kBTreeNodeBytes = 256;
+
+// Largest power of two that is not greater than the capacity; first step of
+// the binary search within a node
+constexpr int BTreeSearchStep(int capacity) {
+	return (capacity < 2) ? 1 : 2 * BTreeSearchStep(capacity / 2);
+}
+
+// Max depth of the tree; with the min fan out of 4 this fits far more
+// entries than can be allocated
+const int kBTreeDepthMax = 32;
+
+// Number of entries of the specified size that fit in a node, and at least 4
+// so that a split node still has 2
+constexpr int BTreeNodeCapacity(size_t entrySize) {
+	return (int)((kBTreeNodeBytes - 32) / entrySize) < 4 ? 4 : (int)((kBTreeNodeBytes - 32) / entrySize);
+}
+
+//--------------------------------------------------
+//
+// BTreeMap
+//
+// An ordered associative array with the same interface as TreeMap
+//
+// Key MUST be a type that supports the less than operator (<). Each key must
+// be unique - no duplicates allowed
+//
+// Implemented as a B+ tree. Entries are only stored in the leaves, which hold
+// as many keys and values as fit in a few cache lines, in sorted arrays.
+// Leaves are linked in key order, so iterating over the map or over a range
+// of keys reads the leaves in sequence instead of following a pointer per
+// entry
+//
+// Every node except the root is at least half full
+//
+// Iterators are invalidated by Insert() and Remove(), since entries move
+// within and between the leaves
+//
+// A growable map allocates more nodes when it is full, see ContainerGrowth.h.
+// Nodes are constructed in the pool memory when allocated and destroyed when
+// freed, so every slot of a node holds a constructed Key and Value
+//
+//--------------------------------------------------
+template<typename Key, typename Value>
+class BTreeMap {
+
+// Forward declarations
+public:
+	class Iterator;
+	friend class Iterator;
+
+private:
+	struct Node;
+	struct LeafNode;
+	struct InnerNode;
+
+	// Max and min number of entries in a leaf
+	static const int kLeafCapacity = BTreeNodeCapacity(sizeof(Key) + sizeof(Value));
+	static const int kLeafMin = kLeafCapacity / 2;
+
+	// Max and min number of keys in an inner node, which has one more child
+	static const int kInnerCapacity = BTreeNodeCapacity(sizeof(Key) + sizeof(void*));
+	static const int kInnerMin = kInnerCapacity / 2;
+
+public:
+	explicit BTreeMap(int capacity):
+	m_LeafAlloc(CalcLeafCount(capacity)),
+	m_InnerAlloc(CalcInnerCount(capacity))
+	{
+		Init(capacity, kContainerGrowthFixed);
+	}
+
+	// If growth is kContainerGrowthAuto, capacity is only the initial size
+	BTreeMap(int capacity, ContainerGrowth_t growth):
+	m_LeafAlloc(CalcLeafCount(capacity), growth == kContainerGrowthAuto),
+	m_InnerAlloc(CalcInnerCount(capacity), growth == kContainerGrowthAuto)
+	{
+		Init(capacity, growth);
+	}
+
+	~BTreeMap() {
+		Clear();
+	}
+
+	// Inserts the value with the corresponding key
+	//
+	// The value is NOT inserted if the key already exists in the map
+	void Insert(const Key& key, const Value& value) {
+		ASSERT(m_Growth == kContainerGrowthAuto || m_Size < m_Capacity);
+
+		if (m_Root == nullptr) {
+			LeafNode* leaf = AllocLeaf();
+
+			m_Root = leaf;
+			m_FirstLeaf = leaf;
+		}
+
+		InnerNode* path[kBTreeDepthMax];
+		int pathIndex[kBTreeDepthMax];
+
+		LeafNode* leaf = FindLeaf(key, path, pathIndex);
+		int depth = m_Depth;
+
+		int pos = LowerBound<kLeafCapacity>(leaf->keys, leaf->count, key);
+
+		// If key already exists, method does NOT insert the new value
+		if (pos < leaf->count && !(key < leaf->keys[pos])) {
+			ASSERT(0);
+			return;
+		}
+
+		++m_Size;
+
+		if (leaf->count < kLeafCapacity) {
+			InsertInLeaf(leaf, pos, key, value);
+			return;
+		}
+
+		// Splits the full leaf in half and adds the new leaf to the parent
+		LeafNode* right = AllocLeaf();
+
+		int leftCount = (kLeafCapacity + 1) / 2;
+
+		for (int i = leftCount; i < kLeafCapacity; ++i) {
+			right->keys[i - leftCount] = leaf->keys[i];
+			right->values[i - leftCount] = leaf->values[i];
+		}
+
+		right->count = kLeafCapacity - leftCount;
+		leaf->count = leftCount;
+
+		right->next = leaf->next;
+		right->prev = leaf;
+
+		if (leaf->next != nullptr) {
+			leaf->next->prev = right;
+		}
+
+		leaf->next = right;
+
+		if (pos <= leftCount) {
+			InsertInLeaf(leaf, pos, key, value);
+		}
+		else {
+			InsertInLeaf(right, pos - leftCount, key, value);
+		}
+
+		Key separator = right->keys[0];
+		Node* newChild = right;
+
+		// Each full parent is split in turn, moving its middle key up
+		while (depth > 0) {
+			--depth;
+
+			InnerNode* parent = path[depth];
+			int childIndex = pathIndex[depth];
+
+			if (parent->count < kInnerCapacity) {
+				InsertInInner(parent, childIndex, separator, newChild);
+				return;
+			}
+
+			InnerNode* newInner = AllocInner();
+
+			separator = SplitInner(parent, newInner, childIndex, separator, newChild);
+			newChild = newInner;
+		}
+
+		// Root was split, so the tree gets one level deeper
+		InnerNode* root = AllocInner();
+
+		root->count = 1;
+		root->keys[0] = separator;
+		root->children[0] = m_Root;
+		root->children[1] = newChild;
+
+		m_Root = root;
+		++m_Depth;
+
+		ASSERT(m_Depth < kBTreeDepthMax);
+	}
+
+	// Removes the entry with the specified key
+	//
+	// Does nothing if there is no such entry in the map
+	void Remove(const Key& key) {
+		if (m_Root == nullptr) {
+			return;
+		}
+
+		InnerNode* path[kBTreeDepthMax];
+		int pathIndex[kBTreeDepthMax];
+
+		LeafNode* leaf = FindLeaf(key, path, pathIndex);
+
+		int pos = LowerBound<kLeafCapacity>(leaf->keys, leaf->count, key);
+
+		// Returns if there is no entry with the specified key
+		if (pos == leaf->count || key < leaf->keys[pos]) {
+			return;
+		}
+
+		for (int i = pos + 1; i < leaf->count; ++i) {
+			leaf->keys[i - 1] = leaf->keys[i];
+			leaf->values[i - 1] = leaf->values[i];
+		}
+
+		--leaf->count;
+		--m_Size;
+
+		if (m_Depth == 0) {
+			if (leaf->count == 0) {
+				FreeLeaf(leaf);
+
+				m_Root = nullptr;
+				m_FirstLeaf = nullptr;
+			}
+
+			return;
+		}
+
+		if (leaf->count >= kLeafMin) {
+			return;
+		}
+
+		// Leaf is less than half full, so it takes an entry from a sibling,
+		// or is merged with one if both siblings are at the minimum
+		if (!RebalanceLeaf(leaf, path[m_Depth - 1], pathIndex[m_Depth - 1])) {
+			return;
+		}
+
+		// Merge removed a key from the parent, which may now be less than
+		// half full too
+		for (int depth = m_Depth - 1; depth > 0; --depth) {
+			if (path[depth]->count >= kInnerMin) {
+				return;
+			}
+
+			if (!RebalanceInner(path[depth], path[depth - 1], pathIndex[depth - 1])) {
+				return;
+			}
+		}
+
+		// Root with a single child is replaced by the child
+		InnerNode* root = (InnerNode*)m_Root;
+
+		if (root->count == 0) {
+			m_Root = root->children[0];
+			--m_Depth;
+
+			FreeInner(root);
+		}
+	}
+
+	// Returns an iterator to the entry that corresponds to the key
+	//
+	// If there is no such entry, returns an iterator that equals to End()
+	Iterator Find(const Key& key) {
+		Iterator it = LowerBound(key);
+
+		if (it.leaf != nullptr && key < it.GetKey()) {
+			return End();
+		}
+
+		return it;
+	}
+
+	// Returns an iterator to the first entry with a key that is not less
+	// than the specified key, or End() if there is none
+	//
+	// Iterating from LowerBound(begin) until the key is not less than end
+	// visits the keys in [begin, end)
+	Iterator LowerBound(const Key& key) {
+		if (m_Root == nullptr) {
+			return End();
+		}
+
+		LeafNode* leaf = FindLeaf(key, nullptr, nullptr);
+
+		return MakeIterator(leaf, LowerBound<kLeafCapacity>(leaf->keys, leaf->count, key));
+	}
+
+	// Returns an iterator to the first entry with a key that is greater than
+	// the specified key, or End() if there is none
+	Iterator UpperBound(const Key& key) {
+		if (m_Root == nullptr) {
+			return End();
+		}
+
+		LeafNode* leaf = FindLeaf(key, nullptr, nullptr);
+
+		return MakeIterator(leaf, UpperBound<kLeafCapacity>(leaf->keys, leaf->count, key));
+	}
+
+	// Replaces the content of the map with the entries, which MUST be sorted
+	// by key with no duplicates
+	//
+	// Builds the tree bottom up with full nodes, which is much faster than
+	// inserting the entries one by one
+	void BulkLoad(const Key* keys, const Value* values, int count) {
+		ASSERT(m_Growth == kContainerGrowthAuto || count <= m_Capacity);
+
+		Clear();
+
+		if (count == 0) {
+			return;
+		}
+
+		// Nodes of the level being built and the smallest key under each,
+		// which becomes the separator in the level above
+		int nodeCount = (count + kLeafCapacity - 1) / kLeafCapacity;
+
+		Node** nodes = MEM_NEW Node*[nodeCount];
+		Key* minKeys = MEM_NEW Key[nodeCount];
+
+		LeafNode* prev = nullptr;
+		int entryIndex = 0;
+
+		for (int i = 0; i < nodeCount; ++i) {
+			LeafNode* leaf = AllocLeaf();
+
+			// Spreads the entries evenly so that the last leaf is not left
+			// less than half full
+			int leafCount = count / nodeCount + (i < count % nodeCount ? 1 : 0);
+
+			for (int j = 0; j < leafCount; ++j, ++entryIndex) {
+				ASSERT(entryIndex == 0 || keys[entryIndex - 1] < keys[entryIndex]);
+
+				leaf->keys[j] = keys[entryIndex];
+				leaf->values[j] = values[entryIndex];
+			}
+
+			leaf->count = leafCount;
+			leaf->prev = prev;
+
+			if (prev != nullptr) {
+				prev->next = leaf;
+			}
+			else {
+				m_FirstLeaf = leaf;
+			}
+
+			prev = leaf;
+
+			nodes[i] = leaf;
+			minKeys[i] = leaf->keys[0];
+		}
+
+		// Each level above takes the nodes of the level below as children
+		while (nodeCount > 1) {
+			int childCount = nodeCount;
+
+			nodeCount = (childCount + kInnerCapacity) / (kInnerCapacity + 1);
+
+			int childIndex = 0;
+
+			for (int i = 0; i < nodeCount; ++i) {
+				InnerNode* inner = AllocInner();
+
+				int innerChildCount = childCount / nodeCount + (i < childCount % nodeCount ? 1 : 0);
+
+				Key innerMinKey = minKeys[childIndex];
+
+				for (int j = 0; j < innerChildCount; ++j, ++childIndex) {
+					inner->children[j] = nodes[childIndex];
+
+					if (j > 0) {
+						inner->keys[j - 1] = minKeys[childIndex];
+					}
+				}
+
+				inner->count = innerChildCount - 1;
+
+				// Written in place, since entry i is only read after the
+				// children of entries before it
+				nodes[i] = inner;
+				minKeys[i] = innerMinKey;
+			}
+
+			++m_Depth;
+		}
+
+		m_Root = nodes[0];
+		m_Size = count;
+
+		MEM_DELETE_ARR(minKeys);
+		MEM_DELETE_ARR(nodes);
+	}
+
+	void Clear() {
+		if (m_Root != nullptr) {
+			DestroySubtree(m_Root, m_Depth);
+		}
+
+		m_LeafAlloc.Clear();
+		m_InnerAlloc.Clear();
+
+		m_Root = nullptr;
+		m_FirstLeaf = nullptr;
+
+		m_Depth = 0;
+		m_Size = 0;
+	}
+
+	Iterator Begin() {
+		return MakeIterator(m_FirstLeaf, 0);
+	}
+
+	Iterator End() {
+		Iterator it;
+
+		it.owner = this;
+
+		return it;
+	}
+
+	// A growable map is never full
+	bool IsFull() const {
+		return m_Growth == kContainerGrowthFixed && m_Size == m_Capacity;
+	}
+
+	bool IsEmpty() const {
+		return m_Size == 0;
+	}
+
+public:
+	int GetSize() const {
+		return m_Size;
+	}
+
+	int GetCapacity() const {
+		return m_Capacity;
+	}
+
+	// Number of levels of inner nodes above the leaves
+	int GetDepth() const {
+		return m_Depth;
+	}
+
+private:
+	void Init(int capacity, ContainerGrowth_t growth) {
+		ASSERT(capacity > 0);
+
+		m_Capacity = capacity;
+		m_Growth = growth;
+
+		m_Root = nullptr;
+		m_FirstLeaf = nullptr;
+
+		m_Depth = 0;
+		m_Size = 0;
+	}
+
+	// Max number of leaves for the number of entries, with each leaf but
+	// the root at least half full
+	static int CalcLeafCount(int capacity) {
+		return capacity / kLeafMin + 1;
+	}
+
+	// Each inner node but the root has at least kInnerMin + 1 children, so
+	// each level has at most that many times fewer nodes than the one below
+	static int CalcInnerCount(int capacity) {
+		return CalcLeafCount(capacity) / kInnerMin + kBTreeDepthMax;
+	}
+
+	LeafNode* AllocLeaf() {
+		LeafNode* leaf = new(m_LeafAlloc.Alloc()) LeafNode();
+
+		leaf->count = 0;
+		leaf->prev = nullptr;
+		leaf->next = nullptr;
+
+		return leaf;
+	}
+
+	InnerNode* AllocInner() {
+		InnerNode* inner = new(m_InnerAlloc.Alloc()) InnerNode();
+
+		inner->count = 0;
+
+		return inner;
+	}
+
+	void FreeLeaf(LeafNode* leaf) {
+		leaf->~LeafNode();
+		m_LeafAlloc.Dealloc(leaf);
+	}
+
+	void FreeInner(InnerNode* inner) {
+		inner->~InnerNode();
+		m_InnerAlloc.Dealloc(inner);
+	}
+
+	// Destroys the node and all nodes under it, which has depth levels of
+	// inner nodes; their memory is left to the pools
+	void DestroySubtree(Node* node, int depth) {
+		if (depth == 0) {
+			((LeafNode*)node)->~LeafNode();
+			return;
+		}
+
+		InnerNode* inner = (InnerNode*)node;
+
+		for (int i = 0; i <= inner->count; ++i) {
+			DestroySubtree(inner->children[i], depth - 1);
+		}
+
+		inner->~InnerNode();
+	}
+
+	// Index of the first key that is not less than the key
+	//
+	// Binary search with the same number of steps for every node of the
+	// capacity, and no branch on the comparison, since the CPU could not
+	// predict either one. Probes past the last key compare against the last
+	// key instead, which never moves the result below the right index
+	template<int kCapacity>
+	static int LowerBound(const Key* keys, int count, const Key& key) {
+		if (count == 0) {
+			return 0;
+		}
+
+		int pos = 0;
+
+		for (int step = BTreeSearchStep(kCapacity); step > 0; step /= 2) {
+			int probe = (pos + step < count) ? pos + step : count;
+
+			pos += (keys[probe - 1] < key) ? step : 0;
+		}
+
+		return (pos < count) ? pos : count;
+	}
+
+	// Index of the first key that is greater than the key
+	template<int kCapacity>
+	static int UpperBound(const Key* keys, int count, const Key& key) {
+		if (count == 0) {
+			return 0;
+		}
+
+		int pos = 0;
+
+		for (int step = BTreeSearchStep(kCapacity); step > 0; step /= 2) {
+			int probe = (pos + step < count) ? pos + step : count;
+
+			pos += (key < keys[probe - 1]) ? 0 : step;
+		}
+
+		return (pos < count) ? pos : count;
+	}
+
+	// Returns the leaf that the key belongs in
+	//
+	// If path is not nullptr, the inner nodes passed through and the index of
+	// the child taken in each are written to path and pathIndex
+	LeafNode* FindLeaf(const Key& key, InnerNode** path, int* pathIndex) {
+		Node* node = m_Root;
+
+		for (int depth = 0; depth < m_Depth; ++depth) {
+			InnerNode* inner = (InnerNode*)node;
+
+			// Keys equal to a separator are in the child to its right
+			int childIndex = UpperBound<kInnerCapacity>(inner->keys, inner->count, key);
+
+			if (path != nullptr) {
+				path[depth] = inner;
+				pathIndex[depth] = childIndex;
+			}
+
+			node = inner->children[childIndex];
+		}
+
+		return (LeafNode*)node;
+	}
+
+	// Returns an iterator to the entry, moving to the next leaf if index is
+	// past the end of the leaf
+	Iterator MakeIterator(LeafNode* leaf, int index) {
+		Iterator it;
+
+		it.owner = this;
+
+		if (leaf != nullptr && index == leaf->count) {
+			leaf = leaf->next;
+			index = 0;
+		}
+
+		if (leaf != nullptr) {
+			it.leaf = leaf;
+			it.index = index;
+		}
+
+		return it;
+	}
+
+	void InsertInLeaf(LeafNode* leaf, int pos, const Key& key, const Value& value) {
+		for (int i = leaf->count; i > pos; --i) {
+			leaf->keys[i] = leaf->keys[i - 1];
+			leaf->values[i] = leaf->values[i - 1];
+		}
+
+		leaf->keys[pos] = key;
+		leaf->values[pos] = value;
+
+		++leaf->count;
+	}
+
+	// Inserts the key after child childIndex, and the child after the key
+	void InsertInInner(InnerNode* inner, int childIndex, const Key& key, Node* child) {
+		for (int i = inner->count; i > childIndex; --i) {
+			inner->keys[i] = inner->keys[i - 1];
+			inner->children[i + 1] = inner->children[i];
+		}
+
+		inner->keys[childIndex] = key;
+		inner->children[childIndex + 1] = child;
+
+		++inner->count;
+	}
+
+	// Splits the full inner node as if the key and child were inserted into
+	// it, moving the upper half into right
+	//
+	// Returns the middle key, which separates the two nodes in the parent
+	Key SplitInner(InnerNode* inner, InnerNode* right, int childIndex, const Key& key, Node* child) {
+		Key keys[kInnerCapacity + 1];
+		Node* children[kInnerCapacity + 2];
+
+		for (int i = 0, j = 0; i <= kInnerCapacity; ++i) {
+			keys[i] = (i == childIndex) ? key : inner->keys[j++];
+		}
+
+		for (int i = 0, j = 0; i <= kInnerCapacity + 1; ++i) {
+			children[i] = (i == childIndex + 1) ? child : inner->children[j++];
+		}
+
+		int leftCount = (kInnerCapacity + 1) / 2;
+
+		for (int i = 0; i < leftCount; ++i) {
+			inner->keys[i] = keys[i];
+			inner->children[i] = children[i];
+		}
+
+		inner->children[leftCount] = children[leftCount];
+		inner->count = leftCount;
+
+		right->count = kInnerCapacity - leftCount;
+
+		for (int i = 0; i < right->count; ++i) {
+			right->keys[i] = keys[leftCount + 1 + i];
+			right->children[i] = children[leftCount + 1 + i];
+		}
+
+		right->children[right->count] = children[kInnerCapacity + 1];
+
+		return keys[leftCount];
+	}
+
+	// Removes key keyIndex and the child after it from the inner node
+	void RemoveFromInner(InnerNode* inner, int keyIndex) {
+		for (int i = keyIndex + 1; i < inner->count; ++i) {
+			inner->keys[i - 1] = inner->keys[i];
+			inner->children[i] = inner->children[i + 1];
+		}
+
+		--inner->count;
+	}
+
+	// Fixes a leaf that is less than half full, which is child childIndex
+	// of the parent
+	//
+	// Returns true if the leaf was merged, which removes a key from the
+	// parent
+	bool RebalanceLeaf(LeafNode* leaf, InnerNode* parent, int childIndex) {
+		LeafNode* left = childIndex > 0 ? (LeafNode*)parent->children[childIndex - 1] : nullptr;
+		LeafNode* right = childIndex < parent->count ? (LeafNode*)parent->children[childIndex + 1] : nullptr;
+
+		if (left != nullptr && left->count > kLeafMin) {
+			InsertInLeaf(leaf, 0, left->keys[left->count - 1], left->values[left->count - 1]);
+			--left->count;
+
+			parent->keys[childIndex - 1] = leaf->keys[0];
+
+			return false;
+		}
+
+		if (right != nullptr && right->count > kLeafMin) {
+			leaf->keys[leaf->count] = right->keys[0];
+			leaf->values[leaf->count] = right->values[0];
+			++leaf->count;
+
+			for (int i = 1; i < right->count; ++i) {
+				right->keys[i - 1] = right->keys[i];
+				right->values[i - 1] = right->values[i];
+			}
+
+			--right->count;
+
+			parent->keys[childIndex] = right->keys[0];
+
+			return false;
+		}
+
+		// Merges the right one of the two leaves into the left one
+		if (left != nullptr) {
+			MergeLeaves(left, leaf);
+			RemoveFromInner(parent, childIndex - 1);
+		}
+		else {
+			MergeLeaves(leaf, right);
+			RemoveFromInner(parent, childIndex);
+		}
+
+		return true;
+	}
+
+	void MergeLeaves(LeafNode* left, LeafNode* right) {
+		for (int i = 0; i < right->count; ++i) {
+			left->keys[left->count + i] = right->keys[i];
+			left->values[left->count + i] = right->values[i];
+		}
+
+		left->count += right->count;
+
+		left->next = right->next;
+
+		if (right->next != nullptr) {
+			right->next->prev = left;
+		}
+
+		FreeLeaf(right);
+	}
+
+	// Fixes an inner node that is less than half full, which is child
+	// childIndex of the parent
+	//
+	// Returns true if the node was merged, which removes a key from the
+	// parent
+	bool RebalanceInner(InnerNode* inner, InnerNode* parent, int childIndex) {
+		InnerNode* left = childIndex > 0 ? (InnerNode*)parent->children[childIndex - 1] : nullptr;
+		InnerNode* right = childIndex < parent->count ? (InnerNode*)parent->children[childIndex + 1] : nullptr;
+
+		// Borrowing rotates a child through the parent, whose separator
+		// moves down into the node
+		if (left != nullptr && left->count > kInnerMin) {
+			inner->children[inner->count + 1] = inner->children[inner->count];
+
+			for (int i = inner->count; i > 0; --i) {
+				inner->keys[i] = inner->keys[i - 1];
+				inner->children[i] = inner->children[i - 1];
+			}
+
+			inner->keys[0] = parent->keys[childIndex - 1];
+			inner->children[0] = left->children[left->count];
+			++inner->count;
+
+			parent->keys[childIndex - 1] = left->keys[left->count - 1];
+			--left->count;
+
+			return false;
+		}
+
+		if (right != nullptr && right->count > kInnerMin) {
+			inner->keys[inner->count] = parent->keys[childIndex];
+			inner->children[inner->count + 1] = right->children[0];
+			++inner->count;
+
+			parent->keys[childIndex] = right->keys[0];
+
+			for (int i = 1; i < right->count; ++i) {
+				right->keys[i - 1] = right->keys[i];
+				right->children[i - 1] = right->children[i];
+			}
+
+			right->children[right->count - 1] = right->children[right->count];
+			--right->count;
+
+			return false;
+		}
+
+		if (left != nullptr) {
+			MergeInner(left, inner, parent->keys[childIndex - 1]);
+			RemoveFromInner(parent, childIndex - 1);
+		}
+		else {
+			MergeInner(inner, right, parent->keys[childIndex]);
+			RemoveFromInner(parent, childIndex);
+		}
+
+		return true;
+	}
+
+	// Merges right into left, with the separator of the parent between them
+	void MergeInner(InnerNode* left, InnerNode* right, const Key& separator) {
+		left->keys[left->count] = separator;
+
+		for (int i = 0; i < right->count; ++i) {
+			left->keys[left->count + 1 + i] = right->keys[i];
+			left->children[left->count + 1 + i] = right->children[i];
+		}
+
+		left->children[left->count + 1 + right->count] = right->children[right->count];
+		left->count += 1 + right->count;
+
+		FreeInner(right);
+	}
+
+private:
+	struct Node {
+		int count; // Number of keys
+	};
+
+	struct LeafNode: public Node {
+		Key keys[kLeafCapacity];
+		Value values[kLeafCapacity];
+
+		// Neighbouring leaves in key order
+		LeafNode* prev;
+		LeafNode* next;
+	};
+
+	struct InnerNode: public Node {
+		// Keys in children[i] are less than keys[i], and keys in
+		// children[i + 1] are not less than keys[i]
+		Key keys[kInnerCapacity];
+		Node* children[kInnerCapacity + 1];
+	};
+
+	PoolAllocator<LeafNode> m_LeafAlloc;
+	PoolAllocator<InnerNode> m_InnerAlloc;
+
+	// nullptr if the map is empty
+	Node* m_Root;
+
+	LeafNode* m_FirstLeaf;
+
+	int m_Depth; // Number of inner node levels; 0 if the root is a leaf
+	int m_Size;
+
+	int m_Capacity;
+
+	ContainerGrowth_t m_Growth;
+
+public:
+	class Iterator {
+		friend class BTreeMap;
+
+	public:
+		Iterator() {
+			owner = nullptr;
+			leaf = nullptr;
+			index = 0;
+		}
+
+		const Key& GetKey() {
+			ASSERT(leaf != nullptr);
+			return leaf->keys[index];
+		}
+
+		Value& GetValue() {
+			ASSERT(leaf != nullptr);
+			return leaf->values[index];
+		}
+
+		Iterator& operator++() {
+			if (leaf != nullptr) {
+				++index;
+
+				if (index == leaf->count) {
+					leaf = leaf->next;
+					index = 0;
+				}
+			}
+
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator temp = *this;
+
+			++(*this);
+
+			return temp;
+		}
+
+		bool operator==(const Iterator& it) {
+			return leaf == it.leaf && index == it.index;
+		}
+
+		bool operator!=(const Iterator& it) {
+			return !(*this == it);
+		}
+
+	private:
+		BTreeMap* owner;
+
+		LeafNode* leaf; // nullptr at the end
+		int index;
+	};
+
+private:
+	BTreeMap(const BTreeMap&);
+	BTreeMap& operator=(const BTreeMap&);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,25 @@
+#ifndef CONTAINERGROWTH_H_
+#define CONTAINERGROWTH_H_
+
+//--------------------------------------------------
+//
+// Defines how the associative containers behave when they are full
+//
+// A fixed container asserts when more entries than its capacity are
+// inserted. A growable container treats its capacity as the initial size and
+// grows when it is full. Hash tables then rehash incrementally: each insert
+// or removal moves a bounded number of buckets from the old table to the new
+// one, so a resize is spread over many operations instead of stalling one
+//
+//--------------------------------------------------
+
+enum ContainerGrowth_t {
+	kContainerGrowthFixed,
+	kContainerGrowthAuto
+};
+
+// Number of buckets, or groups of slots, moved to the new table on each
+// insert or removal while a hash table is growing
+const int kContainerRehashStep = 4;
+
+#endif
\ No newline at end of file
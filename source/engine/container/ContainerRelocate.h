@@ -0,0 +1,42 @@
+#ifndef CONTAINERRELOCATE_H_
+#define CONTAINERRELOCATE_H_
+
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//--------------------------------------------------
+//
+// ContainerRelocatable
+//
+// Whether a T can be moved to another address with memcpy() and without
+// calling its constructor or destructor
+//
+// True for trivially copyable types. Specialize it for other types that do
+// not store pointers to themselves, so that the arrays move them in bulk
+//
+//--------------------------------------------------
+template<typename T>
+struct ContainerRelocatable {
+	static const bool value = std::is_trivially_copyable<T>::value;
+};
+
+// Moves count constructed elements from src to the uninitialized memory at
+// dst, leaving the memory at src uninitialized
+//
+// The ranges must NOT overlap
+template<typename T>
+void ContainerRelocate(T* dst, T* src, size_t count) {
+	if (ContainerRelocatable<T>::value) {
+		memcpy((void*)dst, (void*)src, count * sizeof(T));
+	}
+	else {
+		for (size_t i = 0; i < count; ++i) {
+			new(&dst[i]) T(std::move(src[i]));
+			src[i].~T();
+		}
+	}
+}
+
+#endif
\ No newline at end of file
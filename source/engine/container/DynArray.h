@@ -3,7 +3,18 @@
 
 #include "base_include.h"
 
+#include "allocator/Allocator.h"
+
+#include "ContainerRelocate.h"
+
+#include <algorithm>
 #include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Capacity of the first allocation of an array that was created empty
+const size_t kDynArrayCapacityMin = 8;
 
 //--------------------------------------------------
 //
@@ -11,101 +22,273 @@
 //
 // Resizable, dynamic array
 //
+// When full, PushBack(), EmplaceBack() and Insert() double the capacity, so
+// appending costs amortized constant time. Growing, shrinking and shifting
+// the elements move them with memcpy() if T is relocatable, and with its
+// move constructor otherwise; see ContainerRelocate.h
+//
+// Memory is allocated from an IAllocator, the default allocator unless one
+// is given. Resize() of a relocatable T goes through IAllocator::Realloc(),
+// so an allocator that can grow memory in place avoids the copy
+//
+// References to the elements are invalidated when the array grows
+//
+// Copies copy every element into memory of their own. Moving takes over the
+// memory and the allocator of the other array, which is left empty
+//
 //--------------------------------------------------
 template<typename T>
 class DynArray {
 
 public:
+	DynArray() {
+		Init(GetDefaultAllocator());
+	}
+
 	DynArray(size_t capacity) {
-		m_Data = nullptr;
+		Init(GetDefaultAllocator());
 
 		Resize(capacity);
+	}
 
-		m_Tail = 0;
+	// Memory is allocated from allocator, which MUST outlive the array
+	explicit DynArray(IAllocator* allocator) {
+		Init(allocator);
+	}
+
+	DynArray(size_t capacity, IAllocator* allocator) {
+		Init(allocator);
+
+		Resize(capacity);
+	}
+
+	// Copy allocates from the same allocator as the other array
+	DynArray(const DynArray& other) {
+		Init(other.m_Allocator);
+
+		CopyFrom(other);
+	}
+
+	DynArray(DynArray&& other) {
+		Init(other.m_Allocator);
+
+		MoveFrom(other);
 	}
 
 	~DynArray() {
-		m_Tail = 0;
+		Clear();
+
 		m_Capacity = 0;
 
-		if (m_Data != nullptr) {
-			delete[] m_Data;
+		m_Allocator->Dealloc(m_Data);
+		m_Data = nullptr;
+	}
+
+	// Keeps the allocator and, if it is large enough, the memory of this
+	// array
+	DynArray& operator=(const DynArray& other) {
+		if (this != &other) {
+			Clear();
+			CopyFrom(other);
 		}
 
+		return *this;
+	}
+
+	DynArray& operator=(DynArray&& other) {
+		if (this != &other) {
+			Clear();
+
+			m_Allocator->Dealloc(m_Data);
+			m_Data = nullptr;
+			m_Capacity = 0;
+
+			MoveFrom(other);
+		}
+
+		return *this;
 	}
 
 	T& operator[](int index) {
-		return m_Data[index];
+		return GetData()[index];
 	}
 
 	void PushBack(const T& element) {
-		ASSERT(!IsFull());
+		EmplaceBack(element);
+	}
+
+	void PushBack(T&& element) {
+		EmplaceBack(std::move(element));
+	}
+
+	// Constructs the element in place at the end of the array from the
+	// arguments
+	template<typename... Args>
+	T& EmplaceBack(Args&&... args) {
+		if (IsFull()) {
+			// New element is constructed before the old elements are moved,
+			// since the arguments may refer to them
+			size_t capacity = CalcGrowCapacity();
+
+			Storage* data = AllocArray<Storage>(m_Allocator, capacity);
+			T* element = new(&data[m_Tail]) T(std::forward<Args>(args)...);
+
+			Reallocate(data, capacity);
+
+			++m_Tail;
+
+			return *element;
+		}
+
+		T* element = new(&m_Data[m_Tail]) T(std::forward<Args>(args)...);
 
-		m_Data[m_Tail] = element;
 		++m_Tail;
+
+		return *element;
 	}
 
 	void PopBack() {
 		ASSERT(!IsEmpty());
 
 		--m_Tail;
+
+		GetData()[m_Tail].~T();
 	}
 
+	// Inserts the element before the element at index, shifting the
+	// following elements up
 	void Insert(const T& element, int index) {
-		ASSERT(!IsFull());
-		ASSERT(index <= m_Tail);
+		ASSERT(index >= 0 && (size_t)index <= m_Tail);
+
+		// Copied first, since the element may be in the array
+		T value(element);
+
+		if (IsFull()) {
+			Resize(CalcGrowCapacity());
+		}
+
+		T* data = GetData();
+
+		if (ContainerRelocatable<T>::value) {
+			memmove((void*)&data[index + 1], (void*)&data[index], (m_Tail - index) * sizeof(T));
+
+			new(&data[index]) T(std::move(value));
+		}
+		else if ((size_t)index == m_Tail) {
+			new(&data[index]) T(std::move(value));
+		}
+		else {
+			new(&data[m_Tail]) T(std::move(data[m_Tail - 1]));
 
-		for (int i = m_Tail; i > index; --i) {
-			m_Data[i] = m_Data[i-1];
+			std::move_backward(&data[index], &data[m_Tail - 1], &data[m_Tail]);
+
+			data[index] = std::move(value);
 		}
-		m_Data[index] = element;
 
 		++m_Tail;
 	}
 
+	// Removes the element at index, shifting the following elements down to
+	// keep their order
 	void Remove(int index) {
 		ASSERT(!IsEmpty());
-		ASSERT(index < m_Tail);
+		ASSERT(index >= 0 && (size_t)index < m_Tail);
+
+		T* data = GetData();
+
+		if (ContainerRelocatable<T>::value) {
+			data[index].~T();
+
+			memmove((void*)&data[index], (void*)&data[index + 1], (m_Tail - index - 1) * sizeof(T));
+		}
+		else {
+			std::move(&data[index + 1], &data[m_Tail], &data[index]);
 
-		for (int i = index; i < (m_Tail - 1); ++i) {
-			m_Data[i] = m_Data[i+1];
+			data[m_Tail - 1].~T();
 		}
 
 		--m_Tail;
 	}
 
+	// Removes the element at index by moving the last element into its place
+	//
+	// Constant time, but does NOT keep the order of the elements
+	void SwapRemove(int index) {
+		ASSERT(!IsEmpty());
+		ASSERT(index >= 0 && (size_t)index < m_Tail);
+
+		T* data = GetData();
+
+		if ((size_t)index != m_Tail - 1) {
+			data[index] = std::move(data[m_Tail - 1]);
+		}
+
+		PopBack();
+	}
+
+	// Removes all elements; capacity is unchanged
+	void Clear() {
+		T* data = GetData();
+
+		if (!std::is_trivially_destructible<T>::value) {
+			for (size_t i = 0; i < m_Tail; ++i) {
+				data[i].~T();
+			}
+		}
+
+		m_Tail = 0;
+	}
+
+	// Changes the capacity, removing the elements that no longer fit
 	void Resize(size_t capacity) {
 		ASSERT(capacity > 0);
 
-		T* prevMem = m_Data;
+		T* data = GetData();
 
-		m_Data = new T[capacity];
+		while (m_Tail > capacity) {
+			--m_Tail;
 
-		// Copies and deletes the old memory if memory was allocated before
-		if (prevMem != nullptr) {
-			size_t overlap = capacity > m_Capacity ? m_Capacity : capacity;
-			
-			memcpy((void*)m_Data, (void*)prevMem, overlap * sizeof(T));
-			delete[] prevMem;
+			data[m_Tail].~T();
+		}
+
+		if (ContainerRelocatable<T>::value && m_Data != nullptr) {
+			// Only the constructed elements need to be kept
+			Storage* newData = (Storage*)m_Allocator->Realloc(m_Data, sizeof(T) * m_Tail, sizeof(T) * capacity, alignof(T));
 
-			if (m_Tail > overlap) {
-				m_Tail = overlap;
+			// Old buffer is still allocated and holds the elements if the
+			// allocator is out of memory
+			ASSERT(newData != nullptr);
+
+			if (newData == nullptr) {
+				return;
 			}
+
+			m_Data = newData;
+			m_Capacity = capacity;
+
+			return;
 		}
 
-		m_Capacity = capacity;
+		Reallocate(AllocArray<Storage>(m_Allocator, capacity), capacity);
+	}
+
+	// Makes sure that the capacity is at least the specified capacity
+	void Reserve(size_t capacity) {
+		if (capacity > m_Capacity) {
+			Resize(capacity);
+		}
 	}
 
 	T& GetBack() {
 		ASSERT(!IsEmpty());
 
-		return m_Data[m_Tail];
+		return GetData()[m_Tail - 1];
 	}
 
 	T& GetFront() {
 		ASSERT(!IsEmpty());
 
-		return m_Data[0];
+		return GetData()[0];
 	}
 
 	size_t GetCapacity() const {
@@ -124,8 +307,82 @@ public:
 		return m_Tail == m_Capacity;
 	}
 
+	IAllocator* GetAllocator() const {
+		return m_Allocator;
+	}
+
 private:
-	T* m_Data;
+	typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+
+	void Init(IAllocator* allocator) {
+		ASSERT(allocator != nullptr);
+
+		m_Allocator = allocator;
+
+		m_Data = nullptr;
+		m_Capacity = 0;
+		m_Tail = 0;
+	}
+
+	T* GetData() {
+		return (T*)m_Data;
+	}
+
+	size_t CalcGrowCapacity() const {
+		return m_Capacity < kDynArrayCapacityMin ? kDynArrayCapacityMin : m_Capacity * 2;
+	}
+
+	// Copies the elements of the other array into this empty array
+	void CopyFrom(const DynArray& other) {
+		ASSERT(m_Tail == 0);
+
+		if (other.m_Tail == 0) {
+			return;
+		}
+
+		Reserve(other.m_Tail);
+
+		T* data = GetData();
+		const T* otherData = (const T*)other.m_Data;
+
+		for (size_t i = 0; i < other.m_Tail; ++i) {
+			new(&data[i]) T(otherData[i]);
+		}
+
+		m_Tail = other.m_Tail;
+	}
+
+	// Takes over the memory of the other array, which MUST be the only
+	// memory left in this one, and leaves the other array empty
+	void MoveFrom(DynArray& other) {
+		ASSERT(m_Data == nullptr);
+
+		m_Allocator = other.m_Allocator;
+		m_Data = other.m_Data;
+		m_Capacity = other.m_Capacity;
+		m_Tail = other.m_Tail;
+
+		other.m_Data = nullptr;
+		other.m_Capacity = 0;
+		other.m_Tail = 0;
+	}
+
+	// Moves the elements to the new memory and deletes the old memory
+	void Reallocate(Storage* data, size_t capacity) {
+		if (m_Data != nullptr) {
+			ContainerRelocate((T*)data, GetData(), m_Tail);
+
+			m_Allocator->Dealloc(m_Data);
+		}
+
+		m_Data = data;
+		m_Capacity = capacity;
+	}
+
+	IAllocator* m_Allocator;
+
+	// Only the first m_Tail elements are constructed
+	Storage* m_Data;
 	size_t m_Capacity;
 
 	// Index of (last element in the array + 1)
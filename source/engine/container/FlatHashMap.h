@@ -0,0 +1,744 @@
+#ifndef FLATHASHMAP_H_
+#define FLATHASHMAP_H_
+
+#include "base_include.h"
+
+#include "ContainerGrowth.h"
+
+#include <new>
+#include <type_traits>
+
+// Group probing uses SSE2 on x86-64, else a scalar loop over the group
+#if !defined(EXT_FLATHASHMAP_NO_SIMD) && defined(__SSE2__)
+	#include <emmintrin.h>
+	#define FLATHASHMAP_SIMD_SSE2
+#endif
+
+// Number of control bytes probed at once
+const int kFlatHashGroupWidth = 16;
+
+// Control byte values; a full slot stores the low 7 bits of its hash instead
+const int8_t kFlatHashCtrlEmpty = -128;
+const int8_t kFlatHashCtrlDeleted = -2;
+
+//--------------------------------------------------
+//
+// FlatHashGroup
+//
+// Compares the control bytes of one group of slots at once
+//
+// Each match returns a bitmask where bit i is set if slot i of the group
+// matches
+//
+//--------------------------------------------------
+class FlatHashGroup {
+
+public:
+	explicit FlatHashGroup(const int8_t* ctrl) {
+#if defined(FLATHASHMAP_SIMD_SSE2)
+		m_Ctrl = _mm_loadu_si128((const __m128i*)ctrl);
+#else
+		m_Ctrl = ctrl;
+#endif
+	}
+
+	// Slots that are full and have the same 7 bit hash
+	uint32_t Match(int8_t hash) const {
+#if defined(FLATHASHMAP_SIMD_SSE2)
+		return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(m_Ctrl, _mm_set1_epi8(hash)));
+#else
+		uint32_t mask = 0;
+
+		for (int i = 0; i < kFlatHashGroupWidth; ++i) {
+			if (m_Ctrl[i] == hash) {
+				mask |= (1u << i);
+			}
+		}
+
+		return mask;
+#endif
+	}
+
+	uint32_t MatchEmpty() const {
+		return Match(kFlatHashCtrlEmpty);
+	}
+
+	// Empty and deleted slots are the only ones with the top bit set
+	uint32_t MatchEmptyOrDeleted() const {
+#if defined(FLATHASHMAP_SIMD_SSE2)
+		return (uint32_t)_mm_movemask_epi8(m_Ctrl);
+#else
+		uint32_t mask = 0;
+
+		for (int i = 0; i < kFlatHashGroupWidth; ++i) {
+			if (m_Ctrl[i] < 0) {
+				mask |= (1u << i);
+			}
+		}
+
+		return mask;
+#endif
+	}
+
+	// Index of the lowest set bit; mask must not be 0
+	static int LowestBit(uint32_t mask) {
+		ASSERT(mask != 0);
+
+#if defined(__GNUC__)
+		return __builtin_ctz(mask);
+#else
+		int index = 0;
+
+		while ((mask & 1u) == 0) {
+			mask >>= 1;
+			++index;
+		}
+
+		return index;
+#endif
+	}
+
+private:
+#if defined(FLATHASHMAP_SIMD_SSE2)
+	__m128i m_Ctrl;
+#else
+	const int8_t* m_Ctrl;
+#endif
+};
+
+//--------------------------------------------------
+//
+// FlatHashMap
+//
+// An associative container with the same interface as HashMap, where each key
+// corresponds to ONE value
+//
+// Keys and values are stored in place in one array of slots, and a separate
+// array holds one control byte per slot: empty, deleted, or 7 bits of the
+// hash of the key in the slot. A lookup probes the control bytes of a group
+// of 16 slots at once and only compares keys whose control byte matches, so
+// most lookups touch one cache line of control bytes and one slot
+//
+// Keys are compared with KeyEqual, see Equal in base_hash.h. Keys are stored
+// as they are, so a pointer key, such as a string, MUST outlive its entry
+//
+// Capacity is the max number of entries. The table is sized so that it is at
+// most 3/4 full, and empty slots are only filled until it is 7/8 full; the
+// slots in between are reclaimed from deleted slots by rebuilding the table,
+// which therefore happens at most once per 1/8 of the slots filled
+//
+// A growable map instead doubles its table when more than half of it is in
+// use, see ContainerGrowth.h. The old table is kept until each insert or
+// removal has moved a few of its groups into the new one, and lookups search
+// both tables until then
+//
+// Pointers to values and iterators stay valid until an insert that follows a
+// removal, or in a growable map until any insert or removal
+//
+//--------------------------------------------------
+template<typename Key, typename Value, typename KeyEqual = Equal<Key> >
+class FlatHashMap {
+
+// Forward declarations
+public:
+	class Iterator;
+	friend class Iterator;
+
+private:
+	struct Slot;
+	struct Table;
+
+public:
+	explicit FlatHashMap(int capacity) {
+		Init(capacity, kContainerGrowthFixed);
+	}
+
+	// If growth is kContainerGrowthAuto, capacity is only the initial size
+	FlatHashMap(int capacity, ContainerGrowth_t growth) {
+		Init(capacity, growth);
+	}
+
+	~FlatHashMap() {
+		FreeTable(&m_OldTable);
+		FreeTable(&m_Table);
+	}
+
+	// Inserts the key and value into the map
+	//
+	// Fails if the key is already inside the map
+	void Insert(const Key& key, const Value& value) {
+		if (m_Growth == kContainerGrowthAuto) {
+			MigrateStep();
+		}
+		else {
+			ASSERT(m_EntryCount < m_Capacity);
+		}
+
+		uint64_t hash = CalcHashForKey(key);
+
+		if (FindIndex(m_Table, key, hash) != -1 ||
+			(m_OldTable.slotCount > 0 && FindIndex(m_OldTable, key, hash) != -1)) {
+			ASSERT(0);
+			return;
+		}
+
+		int index = FindFreeIndex(m_Table, hash);
+
+		// Only filling an empty slot uses up the growth left. When it runs
+		// out, a growable map that is more than half in use grows, else the
+		// table is full of deleted slots and is rebuilt without them
+		if (m_Table.ctrl[index] == kFlatHashCtrlEmpty && m_Table.growthLeft == 0) {
+			if (m_Growth == kContainerGrowthAuto && (m_EntryCount - m_OldEntryCount) > m_Table.slotCount / 2) {
+				Grow();
+			}
+			else {
+				RehashInPlace();
+			}
+
+			index = FindFreeIndex(m_Table, hash);
+		}
+
+		new(FillSlot(&m_Table, index, hash)) Slot(key, value);
+
+		++m_EntryCount;
+	}
+
+	void Remove(const Key& key) {
+		if (m_Growth == kContainerGrowthAuto) {
+			MigrateStep();
+		}
+
+		uint64_t hash = CalcHashForKey(key);
+
+		int index = FindIndex(m_Table, key, hash);
+
+		if (index != -1) {
+			EmptySlot(&m_Table, index);
+		}
+		else if (m_OldTable.slotCount > 0) {
+			index = FindIndex(m_OldTable, key, hash);
+
+			if (index == -1) {
+				return;
+			}
+
+			EmptySlot(&m_OldTable, index);
+			--m_OldEntryCount;
+		}
+		else {
+			// Return since there is no such entry with the key
+			return;
+		}
+
+		--m_EntryCount;
+	}
+
+	// Returns an iterator to the entry with the specified key
+	//
+	// If there is not such key, returns an iterator to End()
+	Iterator Find(const Key& key) {
+		return Find(key, CalcHashForKey(key));
+	}
+
+	// Same as Find(key), with the hash of the key already known, so that a
+	// caller that looks up the same key often can hash it once
+	//
+	// key may be of any type that KeyEqual can compare with Key
+	template<typename LookupKey>
+	Iterator Find(const LookupKey& key, uint64_t hash) {
+		// Iterator indices cover the old table first, then the new one
+		int index = FindIndex(m_Table, key, hash);
+
+		if (index != -1) {
+			index += m_OldTable.slotCount;
+		}
+		else if (m_OldTable.slotCount > 0) {
+			index = FindIndex(m_OldTable, key, hash);
+		}
+
+		if (index == -1) {
+			return End();
+		}
+
+		int groupStart = index & ~(kFlatHashGroupWidth - 1);
+
+		// Full slots after index in the same group
+		uint32_t rest = ~FlatHashGroup(GetCtrl(groupStart)).MatchEmptyOrDeleted() & 0xFFFFu;
+		rest &= ~((2u << (index - groupStart)) - 1u);
+
+		Iterator it;
+
+		it.map = this;
+		it.index = index;
+		it.rest = rest;
+
+		return it;
+	}
+
+	void Clear() {
+		FreeTable(&m_OldTable);
+
+		DestroySlots(m_Table);
+
+		ClearCtrl(&m_Table);
+
+		m_Table.growthLeft = m_Table.slotCount / 8 * 7;
+
+		m_EntryCount = 0;
+		m_OldEntryCount = 0;
+	}
+
+	Iterator Begin() {
+		Iterator it;
+
+		it.map = this;
+		it.index = FindNextFull(0, &it.rest);
+
+		return it;
+	}
+
+	Iterator End() {
+		Iterator it;
+
+		it.map = this;
+		it.index = GetIndexEnd();
+
+		return it;
+	}
+
+	// A growable map is never full
+	bool IsFull() const {
+		return m_Growth == kContainerGrowthFixed && m_EntryCount == m_Capacity;
+	}
+
+	bool IsEmpty() const {
+		return m_EntryCount == 0;
+	}
+
+	bool IsRehashing() const {
+		return m_OldTable.slotCount > 0;
+	}
+
+public:
+	int GetSize() const {
+		return m_EntryCount;
+	}
+
+	int GetCapacity() const {
+		return m_Capacity;
+	}
+
+private:
+	void Init(int capacity, ContainerGrowth_t growth) {
+		ASSERT(capacity > 0);
+
+		// Smallest power of 2 number of groups that keeps the table 3/4 full
+		int slotCount = kFlatHashGroupWidth;
+
+		while (slotCount / 4 * 3 < capacity) {
+			slotCount *= 2;
+		}
+
+		AllocTable(&m_Table, slotCount);
+
+		m_OldTable.ctrl = nullptr;
+		m_OldTable.slots = nullptr;
+		m_OldTable.slotCount = 0;
+		m_OldTable.groupMask = 0;
+		m_OldTable.growthLeft = 0;
+
+		m_MigrateGroup = 0;
+
+		m_EntryCount = 0;
+		m_OldEntryCount = 0;
+
+		m_Capacity = capacity;
+		m_Growth = growth;
+	}
+
+	uint64_t CalcHashForKey(const Key& key) {
+		Hash<Key> hashClass;
+
+		return hashClass.HashFunc(key);
+	}
+
+	// Low 7 bits of the hash go in the control byte, and the rest pick the
+	// first group to probe
+	int8_t CalcCtrlForHash(uint64_t hash) const {
+		return (int8_t)(hash & 0x7F);
+	}
+
+	int CalcGroupForHash(const Table& table, uint64_t hash) const {
+		return (int)((hash >> 7) & (uint64_t)table.groupMask);
+	}
+
+	// Returns the index of the slot in the table with the key, or -1 if there
+	// is none
+	template<typename LookupKey>
+	int FindIndex(const Table& table, const LookupKey& key, uint64_t hash) const {
+		KeyEqual equalClass;
+
+		int8_t ctrl = CalcCtrlForHash(hash);
+		int group = CalcGroupForHash(table, hash);
+
+		// Triangular probing visits every group once since the number of
+		// groups is a power of 2
+		for (int step = 1; step <= table.groupMask + 1; ++step) {
+			int groupStart = group * kFlatHashGroupWidth;
+
+			FlatHashGroup probe(&table.ctrl[groupStart]);
+
+			uint32_t mask = probe.Match(ctrl);
+
+			while (mask != 0) {
+				int index = groupStart + FlatHashGroup::LowestBit(mask);
+
+				if (equalClass.EqualFunc(((Slot*)&table.slots[index])->key, key)) {
+					return index;
+				}
+
+				mask &= mask - 1;
+			}
+
+			// Key would have been placed in this group if it had room
+			if (probe.MatchEmpty() != 0) {
+				return -1;
+			}
+
+			group = (group + step) & table.groupMask;
+		}
+
+		return -1;
+	}
+
+	// Returns the index of the first empty or deleted slot along the probe
+	// sequence of the hash
+	int FindFreeIndex(const Table& table, uint64_t hash) const {
+		int group = CalcGroupForHash(table, hash);
+
+		for (int step = 1; ; ++step) {
+			int groupStart = group * kFlatHashGroupWidth;
+
+			uint32_t mask = FlatHashGroup(&table.ctrl[groupStart]).MatchEmptyOrDeleted();
+
+			if (mask != 0) {
+				return groupStart + FlatHashGroup::LowestBit(mask);
+			}
+
+			group = (group + step) & table.groupMask;
+		}
+	}
+
+	// Marks the empty or deleted slot as full and returns it for the entry
+	// to be constructed in
+	Slot* FillSlot(Table* table, int index, uint64_t hash) {
+		if (table->ctrl[index] == kFlatHashCtrlEmpty) {
+			--table->growthLeft;
+		}
+
+		table->ctrl[index] = CalcCtrlForHash(hash);
+
+		return (Slot*)&table->slots[index];
+	}
+
+	// Destroys the entry in the slot
+	void EmptySlot(Table* table, int index) {
+		((Slot*)&table->slots[index])->~Slot();
+
+		// Probes only continue past a group that has no empty slot, so the
+		// slot can be emptied if its group still has one. Else it is marked
+		// deleted so that probes continue past it
+		int groupStart = index & ~(kFlatHashGroupWidth - 1);
+
+		if (FlatHashGroup(&table->ctrl[groupStart]).MatchEmpty() != 0) {
+			table->ctrl[index] = kFlatHashCtrlEmpty;
+			++table->growthLeft;
+		}
+		else {
+			table->ctrl[index] = kFlatHashCtrlDeleted;
+		}
+	}
+
+	// Control byte and slot at an iterator index, which covers the old table
+	// first, then the new one
+	const int8_t* GetCtrl(int index) const {
+		if (index < m_OldTable.slotCount) {
+			return &m_OldTable.ctrl[index];
+		}
+
+		return &m_Table.ctrl[index - m_OldTable.slotCount];
+	}
+
+	Slot* GetSlot(int index) const {
+		if (index < m_OldTable.slotCount) {
+			return (Slot*)&m_OldTable.slots[index];
+		}
+
+		return (Slot*)&m_Table.slots[index - m_OldTable.slotCount];
+	}
+
+	int GetIndexEnd() const {
+		return m_OldTable.slotCount + m_Table.slotCount;
+	}
+
+	// Returns the index of the first full slot in or after the group, or the
+	// end index if there is none
+	//
+	// rest is set to the mask of the full slots in the same group after it
+	int FindNextFull(int groupStart, uint32_t* rest) const {
+		int indexEnd = GetIndexEnd();
+
+		while (groupStart < indexEnd) {
+			uint32_t mask = ~FlatHashGroup(GetCtrl(groupStart)).MatchEmptyOrDeleted() & 0xFFFFu;
+
+			if (mask != 0) {
+				*rest = mask & (mask - 1);
+
+				return groupStart + FlatHashGroup::LowestBit(mask);
+			}
+
+			groupStart += kFlatHashGroupWidth;
+		}
+
+		*rest = 0;
+
+		return indexEnd;
+	}
+
+	// Moves the entry into the new table, destroying the old copy
+	void MoveSlot(Slot* slot) {
+		uint64_t hash = CalcHashForKey(slot->key);
+		int index = FindFreeIndex(m_Table, hash);
+
+		new(FillSlot(&m_Table, index, hash)) Slot(*slot);
+
+		slot->~Slot();
+	}
+
+	// Reinserts all entries to clear out the deleted slots
+	void RehashInPlace() {
+		int entryCount = m_EntryCount - m_OldEntryCount;
+
+		SlotStorage* storage = MEM_NEW SlotStorage[entryCount];
+		Slot* entries = (Slot*)storage;
+		int movedCount = 0;
+
+		for (int i = 0; i < m_Table.slotCount; ++i) {
+			if (m_Table.ctrl[i] >= 0) {
+				Slot* slot = (Slot*)&m_Table.slots[i];
+
+				new(&entries[movedCount]) Slot(*slot);
+				slot->~Slot();
+
+				++movedCount;
+			}
+		}
+
+		ASSERT(movedCount == entryCount);
+
+		ClearCtrl(&m_Table);
+
+		m_Table.growthLeft = m_Table.slotCount / 8 * 7;
+
+		for (int i = 0; i < movedCount; ++i) {
+			MoveSlot(&entries[i]);
+		}
+
+		MEM_DELETE_ARR(storage);
+	}
+
+	// Starts moving the entries into a table with twice as many slots
+	void Grow() {
+		// Growth happens after at least 1/8 of the new table is filled, and
+		// each insert moves several groups, so the previous move is already
+		// done by now
+		while (m_OldTable.slotCount > 0) {
+			MigrateStep();
+		}
+
+		m_OldTable = m_Table;
+		m_OldEntryCount = m_EntryCount;
+		m_MigrateGroup = 0;
+
+		AllocTable(&m_Table, m_OldTable.slotCount * 2);
+	}
+
+	// Moves a bounded number of groups from the old table to the new one
+	void MigrateStep() {
+		if (m_OldTable.slotCount == 0) {
+			return;
+		}
+
+		int groupEnd = m_MigrateGroup + kContainerRehashStep;
+
+		if (groupEnd > m_OldTable.groupMask + 1) {
+			groupEnd = m_OldTable.groupMask + 1;
+		}
+
+		for (; m_MigrateGroup < groupEnd; ++m_MigrateGroup) {
+			int groupStart = m_MigrateGroup * kFlatHashGroupWidth;
+
+			for (int i = groupStart; i < groupStart + kFlatHashGroupWidth; ++i) {
+				if (m_OldTable.ctrl[i] >= 0) {
+					MoveSlot((Slot*)&m_OldTable.slots[i]);
+
+					// Marked deleted, not empty, so that probes for entries
+					// in later groups still continue past it
+					m_OldTable.ctrl[i] = kFlatHashCtrlDeleted;
+
+					--m_OldEntryCount;
+				}
+			}
+		}
+
+		if (m_MigrateGroup == m_OldTable.groupMask + 1) {
+			ASSERT(m_OldEntryCount == 0);
+
+			FreeTable(&m_OldTable);
+		}
+	}
+
+	void AllocTable(Table* table, int slotCount) {
+		table->ctrl = MEM_NEW int8_t[slotCount];
+		table->slots = MEM_NEW SlotStorage[slotCount];
+		table->slotCount = slotCount;
+		table->groupMask = (slotCount / kFlatHashGroupWidth) - 1;
+		table->growthLeft = slotCount / 8 * 7;
+
+		ClearCtrl(table);
+	}
+
+	// Marks every slot of the table as empty. The count is checked here, not
+	// only asserted, so that the compiler can see the size is never negative
+	void ClearCtrl(Table* table) {
+		if (table->slotCount > 0) {
+			memset((void*)table->ctrl, (int)kFlatHashCtrlEmpty, (size_t)table->slotCount);
+		}
+	}
+
+	// Destroys the entries of the table and frees it
+	void FreeTable(Table* table) {
+		if (table->ctrl == nullptr) {
+			return;
+		}
+
+		DestroySlots(*table);
+
+		MEM_DELETE_ARR(table->slots);
+		MEM_DELETE_ARR(table->ctrl);
+
+		table->slotCount = 0;
+		table->groupMask = 0;
+		table->growthLeft = 0;
+	}
+
+	void DestroySlots(const Table& table) {
+		for (int i = 0; i < table.slotCount; ++i) {
+			if (table.ctrl[i] >= 0) {
+				((Slot*)&table.slots[i])->~Slot();
+			}
+		}
+	}
+
+private:
+	struct Slot {
+		Slot(const Key& key, const Value& value): key(key), value(value) {}
+
+		Key key;
+		Value value;
+	};
+
+	typedef typename std::aligned_storage<sizeof(Slot), alignof(Slot)>::type SlotStorage;
+
+	struct Table {
+		int8_t* ctrl; // Control byte of each slot
+		SlotStorage* slots; // Key and value of each slot; only valid if the slot is full
+
+		int slotCount; // Number of slots; a multiple of the group width
+		int groupMask; // Number of groups - 1
+
+		int growthLeft; // Number of empty slots that can still be filled
+	};
+
+	Table m_Table;
+
+	// Table being moved into m_Table while growing; has no slots otherwise
+	//
+	// Groups before m_MigrateGroup have already been moved
+	Table m_OldTable;
+	int m_MigrateGroup;
+
+	int m_EntryCount; // Number of entries in both tables
+	int m_OldEntryCount; // Number of entries still in the old table
+
+	int m_Capacity; // Max number of entries, or the initial number if growable
+
+	ContainerGrowth_t m_Growth;
+
+public:
+	class Iterator {
+		friend class FlatHashMap;
+
+	public:
+		Iterator() {
+			map = nullptr;
+			index = 0;
+			rest = 0;
+		}
+
+		const Key& GetKey() {
+			ASSERT(map != nullptr && index < map->GetIndexEnd());
+			return map->GetSlot(index)->key;
+		}
+
+		Value& GetValue() {
+			ASSERT(map != nullptr && index < map->GetIndexEnd());
+			return map->GetSlot(index)->value;
+		}
+
+		Iterator& operator++() {
+			if (map != nullptr && index < map->GetIndexEnd()) {
+				int groupStart = index & ~(kFlatHashGroupWidth - 1);
+
+				// Takes the next full slot of the same group before scanning
+				// the following groups
+				if (rest != 0) {
+					index = groupStart + FlatHashGroup::LowestBit(rest);
+					rest &= rest - 1;
+				}
+				else {
+					index = map->FindNextFull(groupStart + kFlatHashGroupWidth, &rest);
+				}
+			}
+
+			return *this;
+		}
+
+		Iterator operator++(int) {
+			Iterator temp = *this;
+
+			++(*this);
+
+			return temp;
+		}
+
+		bool operator==(const Iterator& it) {
+			return map == it.map && index == it.index;
+		}
+
+		bool operator!=(const Iterator& it) {
+			return !(*this == it);
+		}
+
+	private:
+		FlatHashMap* map;
+		int index;
+		uint32_t rest; // Full slots after index in the same group
+	};
+
+private:
+	FlatHashMap(const FlatHashMap&);
+	FlatHashMap& operator=(const FlatHashMap&);
+};
+
+#endif
\ No newline at end of file
@@ -5,6 +5,10 @@
 
 #include "allocator/PoolAllocator.h"
 
+#include "ContainerGrowth.h"
+
+#include <new>
+
 //--------------------------------------------------
 //
 // HashMap
@@ -23,8 +27,23 @@
 //
 // Entries with the same index are placed in the repeated index list
 //
+// Each entry stores its key and hash. Keys are compared with KeyEqual, see
+// Equal in base_hash.h; the hash is compared first so that most mismatches
+// never touch the key
+//
+// Keys are stored as they are, so a pointer key, such as a string, MUST
+// outlive its entry
+//
+// A growable map doubles its table when there are as many entries as buckets,
+// see ContainerGrowth.h. Entries never move, so iterators stay valid while
+// the map grows
+//
+// The table and the entries are allocated from an IAllocator, the default
+// allocator unless one is given. Entries are constructed in the pool memory
+// on insert and destroyed on removal
+//
 //--------------------------------------------------
-template<typename Key, typename Value>
+template<typename Key, typename Value, typename KeyEqual = Equal<Key> >
 class HashMap {
 
 // Forward declarations
@@ -37,18 +56,29 @@ private:
 
 public:
     HashMap(int capacity): m_EntryAlloc(capacity) {
-		m_Table = MEM_NEW Entry*[capacity];
-		m_Capacity = capacity;
-		m_EntryCount = 0;
+		Init(capacity, kContainerGrowthFixed, GetDefaultAllocator());
+	}
 
-		m_ListHead = nullptr;
-		m_ListTail = nullptr;
+	// If growth is kContainerGrowthAuto, capacity is only the initial size
+	HashMap(int capacity, ContainerGrowth_t growth): m_EntryAlloc(capacity, growth == kContainerGrowthAuto) {
+		Init(capacity, growth, GetDefaultAllocator());
+	}
 
-		memset((void*)m_Table, 0, sizeof(Entry*) * capacity);
+	// All memory of the map is allocated from allocator, which MUST outlive
+	// the map
+	HashMap(int capacity, ContainerGrowth_t growth, IAllocator* allocator):
+		m_EntryAlloc(capacity, growth == kContainerGrowthAuto, allocator) {
+		Init(capacity, growth, allocator);
 	}
 
 	~HashMap() {
-		MEM_DELETE_ARR(m_Table);
+		DestroyEntries();
+
+		m_Allocator->Dealloc(m_Table);
+		m_Table = nullptr;
+
+		FreeOldTable();
+
 		m_EntryAlloc.Clear();
 	}
 
@@ -56,36 +86,37 @@ public:
 	//
 	// Fails if the key is already inside the map
 	void Insert(const Key& key, const Value& value) {
-		ASSERT(m_EntryCount < m_Capacity);
-
-		uint64_t hash = CalcHashForKey(key);
-		int index = CalcIndexForHash(hash);
-
-		// Refers to the previous pointer so that it can modified during
-		// insertion or removal in a singly-linked list
-		Entry** prevPtr = &m_Table[index];
+		Insert(key, CalcHashForKey(key), value);
+	}
 
-		Entry* entry = m_Table[index];
+	// Same as Insert(key, value), with the hash of the key already known
+	void Insert(const Key& key, uint64_t hash, const Value& value) {
+		if (m_Growth == kContainerGrowthAuto) {
+			RehashStep();
 
-		// Traverses through the entry linked list to check if the entry 
-		// already exists
-		if (entry != nullptr) {
-			while (entry != nullptr && entry->hash != hash) {
-				prevPtr = &(entry->next);
-				entry = entry->next;
+			if (m_EntryCount >= m_TableSize) {
+				Grow();
 			}
 		}
+		else {
+			ASSERT(m_EntryCount < m_Capacity);
+		}
+
+		// Refers to the previous pointer so that it can modified during
+		// insertion or removal in a singly-linked list
+		Entry** prevPtr = FindEntryPtr(key, hash);
 
 		// Insertion fails if the key is already in the map
-		if (entry != nullptr && entry->hash == hash) {
+		if (*prevPtr != nullptr) {
 			ASSERT(0);
 			return;
 		}
 
 		// Creates an entry
-		entry = m_EntryAlloc.Alloc();
+		Entry* entry = new(m_EntryAlloc.Alloc()) Entry();
 		++m_EntryCount;
 
+		entry->key = key;
 		entry->value = value;
 		entry->hash = hash;
 		entry->next = nullptr;
@@ -112,26 +143,26 @@ public:
 	}
 
 	void Remove(const Key& key) {
-		uint64_t hash = CalcHashForKey(key);
-		int index = CalcIndexForHash(hash);
+		Remove(key, CalcHashForKey(key));
+	}
+
+	// Same as Remove(key), with the hash of the key already known
+	//
+	// key may be of any type that KeyEqual can compare with Key
+	template<typename LookupKey>
+	void Remove(const LookupKey& key, uint64_t hash) {
+		if (m_Growth == kContainerGrowthAuto) {
+			RehashStep();
+		}
 
 		// Refers to the previous pointer so that it can modified during
 		// insertion or removal in a singly-linked list
-		Entry** prevPtr = &m_Table[index];
+		Entry** prevPtr = FindEntryPtr(key, hash);
 
-		Entry* entry = m_Table[index];
-		
-		// Traverses through the entry linked list to find the entry with the
-		// specified key
-		if (entry != nullptr) {
-			while (entry != nullptr && entry->hash != hash) {
-				prevPtr = &entry->next;
-				entry = entry->next;
-			}
-		}
+		Entry* entry = *prevPtr;
 
 		if (entry == nullptr) {
-			// Return since there is no such entry with the hash
+			// Return since there is no such entry with the key
 			return;
 		}
 
@@ -143,7 +174,7 @@ public:
 			m_ListHead = entry->nextValue;
 		}
 		if (m_ListTail == entry) {
-			m_ListTail = entry->nextValue;
+			m_ListTail = entry->prevValue;
 		}
 		if (entry->prevValue != nullptr) {
 			entry->prevValue->nextValue = entry->nextValue;
@@ -152,6 +183,7 @@ public:
 			entry->nextValue->prevValue = entry->prevValue;
 		}
 
+		entry->~Entry();
 		m_EntryAlloc.Dealloc(entry);
 		--m_EntryCount;
 	}
@@ -160,30 +192,25 @@ public:
 	//
 	// If there is not such key, returns an iterator to End()
 	Iterator Find(const Key& key) {
-		uint64_t hash = CalcHashForKey(key);
-		int index = CalcIndexForHash(hash);
-
-		Entry* entry = m_Table[index];
-
-		if (entry != nullptr) {
-			while (entry != nullptr && entry->hash != hash) {
-				entry = entry->next;
-			}
-		}
+		return Find(key, CalcHashForKey(key));
+	}
 
-		if (entry != nullptr) {
-			Iterator it;
+	// Same as Find(key), with the hash of the key already known, so that a
+	// caller that looks up the same key often can hash it once
+	//
+	// key may be of any type that KeyEqual can compare with Key
+	template<typename LookupKey>
+	Iterator Find(const LookupKey& key, uint64_t hash) {
+		Iterator it;
 
-			it.entry = entry;
+		it.entry = *FindEntryPtr(key, hash);
 
-			return it;
-		}
-		else {
-			return End();
-		}
+		return it;
 	}
 
 	void Clear() {
+		DestroyEntries();
+
 		m_EntryAlloc.Clear();
 
 		m_EntryCount = 0;
@@ -191,7 +218,9 @@ public:
 		m_ListHead = nullptr;
 		m_ListTail = nullptr;
 
-		memset((void*)m_Table, 0, sizeof(Entry*) * m_Capacity);
+		FreeOldTable();
+
+		memset((void*)m_Table, 0, sizeof(Entry*) * m_TableSize);
 	}
 
 	Iterator Begin() {
@@ -210,12 +239,13 @@ public:
 		return it;
 	}
 
+	// A growable map is never full
 	bool IsFull() const {
-		return m_EntryCount == m_Capacity;
+		return m_Growth == kContainerGrowthFixed && m_EntryCount == m_Capacity;
 	}
 
 	bool IsEmpty() const {
-		return m_EntryCount < m_Capacity;
+		return m_EntryCount == 0;
 	}
 
 public:
@@ -223,9 +253,150 @@ public:
 		return m_EntryCount;
 	}
 
+	bool IsRehashing() const {
+		return m_OldTable != nullptr;
+	}
+
+	IAllocator* GetAllocator() const {
+		return m_Allocator;
+	}
+
 private:
-	int CalcIndexForHash(uint64_t hash) {
-		return (int)(hash % (uint64_t)(m_Capacity));
+	void Init(int capacity, ContainerGrowth_t growth, IAllocator* allocator) {
+		m_Allocator = allocator;
+
+		m_Table = AllocArray<Entry*>(m_Allocator, capacity);
+		m_TableSize = capacity;
+		m_Capacity = capacity;
+		m_EntryCount = 0;
+
+		m_Growth = growth;
+
+		m_OldTable = nullptr;
+		m_OldTableSize = 0;
+		m_RehashIndex = 0;
+
+		m_ListHead = nullptr;
+		m_ListTail = nullptr;
+
+		memset((void*)m_Table, 0, sizeof(Entry*) * capacity);
+	}
+
+	// Destroys all entries; their memory is left to the pool
+	void DestroyEntries() {
+		Entry* entry = m_ListHead;
+
+		while (entry != nullptr) {
+			Entry* next = entry->nextValue;
+
+			entry->~Entry();
+
+			entry = next;
+		}
+	}
+
+	// Returns the pointer to the entry with the key, which points to nullptr
+	// at the end of the repeated index list if there is no such entry
+	//
+	// While rehashing, buckets of the old table that have not been moved yet
+	// are searched first. Entries missing from both tables are always added
+	// to the new one
+	template<typename LookupKey>
+	Entry** FindEntryPtr(const LookupKey& key, uint64_t hash) {
+		if (m_OldTable != nullptr) {
+			int oldIndex = CalcIndexForHash(hash, m_OldTableSize);
+
+			if (oldIndex >= m_RehashIndex) {
+				Entry** prevPtr = FindEntryPtrInList(&m_OldTable[oldIndex], key, hash);
+
+				if (*prevPtr != nullptr) {
+					return prevPtr;
+				}
+			}
+		}
+
+		return FindEntryPtrInList(&m_Table[CalcIndexForHash(hash, m_TableSize)], key, hash);
+	}
+
+	template<typename LookupKey>
+	Entry** FindEntryPtrInList(Entry** prevPtr, const LookupKey& key, uint64_t hash) {
+		KeyEqual equalClass;
+
+		while (*prevPtr != nullptr) {
+			Entry* entry = *prevPtr;
+
+			if (entry->hash == hash && equalClass.EqualFunc(entry->key, key)) {
+				break;
+			}
+
+			prevPtr = &entry->next;
+		}
+
+		return prevPtr;
+	}
+
+	// Starts moving the entries into a table with twice as many buckets
+	void Grow() {
+		// Growth happens after at least as many inserts as the old table has
+		// buckets, and each insert moves several buckets, so the previous
+		// rehash is already done by now
+		while (m_OldTable != nullptr) {
+			RehashStep();
+		}
+
+		m_OldTable = m_Table;
+		m_OldTableSize = m_TableSize;
+		m_RehashIndex = 0;
+
+		m_TableSize *= 2;
+		m_Table = AllocArray<Entry*>(m_Allocator, m_TableSize);
+
+		memset((void*)m_Table, 0, sizeof(Entry*) * m_TableSize);
+	}
+
+	// Moves a bounded number of buckets from the old table to the new one
+	void RehashStep() {
+		if (m_OldTable == nullptr) {
+			return;
+		}
+
+		int endIndex = m_RehashIndex + kContainerRehashStep;
+
+		if (endIndex > m_OldTableSize) {
+			endIndex = m_OldTableSize;
+		}
+
+		for (; m_RehashIndex < endIndex; ++m_RehashIndex) {
+			Entry* entry = m_OldTable[m_RehashIndex];
+
+			while (entry != nullptr) {
+				Entry* next = entry->next;
+
+				int index = CalcIndexForHash(entry->hash, m_TableSize);
+
+				entry->next = m_Table[index];
+				m_Table[index] = entry;
+
+				entry = next;
+			}
+
+			m_OldTable[m_RehashIndex] = nullptr;
+		}
+
+		if (m_RehashIndex == m_OldTableSize) {
+			FreeOldTable();
+		}
+	}
+
+	void FreeOldTable() {
+		if (m_OldTable != nullptr) {
+			m_Allocator->Dealloc(m_OldTable);
+			m_OldTable = nullptr;
+		}
+	}
+
+	int CalcIndexForHash(uint64_t hash, int tableSize) {
+		return (int)(hash % (uint64_t)(tableSize));
 	}
 
 	uint64_t CalcHashForKey(const Key& key) {
@@ -236,9 +407,19 @@ private:
 
 
 private:	
+	IAllocator* m_Allocator; // Allocates the tables
+
 	PoolAllocator<Entry> m_EntryAlloc; // Allocates all table entries. Each entry corresponds to a bucket
 
 	Entry** m_Table; // m_Table[key] points to the head of the entry linked list
+	int m_TableSize; // Number of buckets in the table
+
+	// Table being moved into m_Table while growing; nullptr otherwise
+	//
+	// Buckets before m_RehashIndex have already been moved
+	Entry** m_OldTable;
+	int m_OldTableSize;
+	int m_RehashIndex;
 
 	// Head and tail of the map linked list; used for traversal
 	Entry* m_ListHead;
@@ -246,7 +427,9 @@ private:
 
 	int m_EntryCount; // Number of entries in the table
 
-	int m_Capacity; // Max number of nodes that the table can use
+	int m_Capacity; // Max number of nodes that the table can use, or the initial number if growable
+
+	ContainerGrowth_t m_Growth;
 
 private:
 	struct Entry {
@@ -254,6 +437,7 @@ private:
 		Entry* nextValue; // Next entry in the map linked list
 
 		Entry* next; // Next entry that has the same index
+		Key key;
 		Value value;
 		uint64_t hash;
     };
@@ -267,6 +451,11 @@ public:
 			entry = nullptr;
 		}
 
+		const Key& GetKey() {
+			ASSERT(entry != nullptr);
+			return entry->key;
+		}
+
 		Value& GetValue() {
 			ASSERT(entry != nullptr);
 			return entry->value;
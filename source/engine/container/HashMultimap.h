@@ -5,7 +5,10 @@
 
 #include "allocator/PoolAllocator.h"
 
+#include "ContainerGrowth.h"
+
 #include <cstring>
+#include <new>
 
 //--------------------------------------------------
 //
@@ -22,8 +25,22 @@
 //
 // Bucket is implemented as a linked list
 //
+// Each entry stores its key and hash. Keys are compared with KeyEqual, see
+// Equal in base_hash.h; the hash is compared first so that most mismatches
+// never touch the key
+//
+// Keys are stored as they are, so a pointer key, such as a string, MUST
+// outlive its bucket
+//
+// A growable map doubles its table when there are as many keys as buckets,
+// see ContainerGrowth.h
+//
+// The table, entries and nodes are allocated from an IAllocator, the
+// default allocator unless one is given. Entries and nodes are constructed
+// in the pool memory on insert and destroyed on removal
+//
 //--------------------------------------------------
-template<typename Key, typename Value>
+template<typename Key, typename Value, typename KeyEqual = Equal<Key> >
 class HashMultimap {
 
 // Forware declarations
@@ -38,15 +55,32 @@ private:
 
 public:
 	HashMultimap(int capacity) : m_NodeAlloc(capacity), m_EntryAlloc(capacity) {
-		m_Table = MEM_NEW Entry*[capacity];
-		m_Capacity = capacity;
-		m_NodeCount = 0;
+		Init(capacity, kContainerGrowthFixed, GetDefaultAllocator());
+	}
 
-		memset((void*)m_Table, 0, sizeof(Entry*) * capacity);
+	// If growth is kContainerGrowthAuto, capacity is only the initial size
+	HashMultimap(int capacity, ContainerGrowth_t growth) :
+	m_NodeAlloc(capacity, growth == kContainerGrowthAuto),
+	m_EntryAlloc(capacity, growth == kContainerGrowthAuto) {
+		Init(capacity, growth, GetDefaultAllocator());
+	}
+
+	// All memory of the map is allocated from allocator, which MUST outlive
+	// the map
+	HashMultimap(int capacity, ContainerGrowth_t growth, IAllocator* allocator) :
+	m_NodeAlloc(capacity, growth == kContainerGrowthAuto, allocator),
+	m_EntryAlloc(capacity, growth == kContainerGrowthAuto, allocator) {
+		Init(capacity, growth, allocator);
 	}
 
 	~HashMultimap() {
-		MEM_DELETE_ARR(m_Table);
+		DestroyEntries();
+
+		m_Allocator->Dealloc(m_Table);
+		m_Table = nullptr;
+
+		FreeOldTable();
+
 		m_EntryAlloc.Clear();
 		m_NodeAlloc.Clear();
 	}
@@ -55,24 +89,25 @@ public:
 	//
 	// Fails if there is already a key or value in the bucket
 	void Insert(const Key& key, const Value& value) {
-		ASSERT(m_NodeCount < m_Capacity);
-
-		uint64_t hash = CalcHashForKey(key);
-		int index = CalcIndexForHash(hash);
+		if (m_Growth == kContainerGrowthAuto) {
+			RehashStep();
 
-		Entry** prevPtr = &m_Table[index];
-		Entry* entry = m_Table[index];
+			if (m_EntryCount >= m_TableSize) {
+				Grow();
+			}
+		}
+		else {
+			ASSERT(m_NodeCount < m_Capacity);
+		}
 
-		bool newEntry = false;
+		uint64_t hash = CalcHashForKey(key);
 
 		// Traverses through the entry linked list to check if the entry 
 		// already exists
-		if (entry != nullptr) {
-			while (entry != nullptr && entry->hash != hash) {
-				prevPtr = &(entry->next);
-				entry = entry->next;
-			}
-		}
+		Entry** prevPtr = FindEntryPtr(key, hash);
+		Entry* entry = *prevPtr;
+
+		bool newEntry = false;
 
 		// Insertion fails if there is already a value in the bucket
 		if (entry != nullptr && HasValueInEntry(entry, value)) {
@@ -82,19 +117,21 @@ public:
 
 		// Creates an entry if it does not exist yet
 		if (entry == nullptr) {
-			entry = m_EntryAlloc.Alloc();
+			entry = new(m_EntryAlloc.Alloc()) Entry();
 
+			entry->key = key;
 			entry->hash = hash;
 			entry->next = nullptr;
 
 			// Links the last entry in the list to the new entry
 			*prevPtr = entry;
+			++m_EntryCount;
 
 			newEntry = true;
 		}
 		
 		// Create the new value
-		Node* node = m_NodeAlloc.Alloc();
+		Node* node = new(m_NodeAlloc.Alloc()) Node();
 		++m_NodeCount;
 		node->value = value;
 
@@ -122,22 +159,15 @@ public:
 
 	// Remove node with the specified key and value
 	void Remove(const Key& key, const Value& value) {
-
-		uint64_t hash = CalcHashForKey(key);
-		int index = CalcIndexForHash(hash);
-
-		Entry** prevPtr = &m_Table[index];
-		Entry* entry = m_Table[index];
-
-		if (entry != nullptr) {
-			while (entry != nullptr && entry->hash != hash) {
-				prevPtr = &entry->next;
-				entry = entry->next;
-			}
+		if (m_Growth == kContainerGrowthAuto) {
+			RehashStep();
 		}
 
+		Entry** prevPtr = FindEntryPtr(key, CalcHashForKey(key));
+		Entry* entry = *prevPtr;
+
 		if (entry == nullptr) {
-			// Return since there is no such entry with the hash
+			// Return since there is no such entry with the key
 			return;
 		}
 
@@ -165,6 +195,7 @@ public:
 			node->next->prev = node->prev;
 		}
 
+		node->~Node();
 		m_NodeAlloc.Dealloc(node);
 		--m_NodeCount;
 
@@ -172,27 +203,31 @@ public:
 		if (entry->head == nullptr && entry->tail == nullptr) {
 			*prevPtr = entry->next;
 
+			entry->~Entry();
 			m_EntryAlloc.Dealloc(entry);
+			--m_EntryCount;
 		}
 	}
 
 	// Removes all values from the bucket with the corresponding key
 	void RemoveKey(const Key& key) {
-		uint64_t hash = CalcHashForKey(key);
-		int index = CalcIndexForHash(hash);
-
-		Entry** prevPtr = &m_Table[index];
-		Entry* entry = m_Table[index];
+		RemoveKey(key, CalcHashForKey(key));
+	}
 
-		if (entry != nullptr) {
-			while (entry != nullptr && entry->hash != hash) {
-				prevPtr = &entry->next;
-				entry = entry->next;
-			}
+	// Same as RemoveKey(key), with the hash of the key already known
+	//
+	// key may be of any type that KeyEqual can compare with Key
+	template<typename LookupKey>
+	void RemoveKey(const LookupKey& key, uint64_t hash) {
+		if (m_Growth == kContainerGrowthAuto) {
+			RehashStep();
 		}
 
+		Entry** prevPtr = FindEntryPtr(key, hash);
+		Entry* entry = *prevPtr;
+
 		if (entry == nullptr) {
-			// Return since there is no such entry with the hash
+			// Return since there is no such entry with the key
 			return;
 		}
 
@@ -202,6 +237,7 @@ public:
 		while (node != nullptr) {
 			Node* nextNode = node->next;
 
+			node->~Node();
 			m_NodeAlloc.Dealloc(node);
 			--m_NodeCount;
 
@@ -214,28 +250,37 @@ public:
 		// Removes the entry since there are no more values in it
 		*prevPtr = entry->next;
 
+		entry->~Entry();
 		m_EntryAlloc.Dealloc(entry);
+		--m_EntryCount;
 	}
 
 	void Clear() {
+		DestroyEntries();
+
 		m_NodeAlloc.Clear();
 		m_EntryAlloc.Clear();
 
 		m_NodeCount = 0;
+		m_EntryCount = 0;
+
+		FreeOldTable();
 
-		memset((void*)m_Table, 0, sizeof(Entry*) * m_Capacity);
+		memset((void*)m_Table, 0, sizeof(Entry*) * m_TableSize);
 	}
 
 	// Returns an iterator to the beginning of the bucket corresponding with 
 	// key
 	LocalIterator Begin(const Key& key) {
-		uint64_t hash = CalcHashForKey(key);
-        int index = CalcIndexForHash(hash);
-        Entry* entry = m_Table[index];
-        
-        while (entry != nullptr && entry->hash != hash) {
-            entry = entry->next;
-        }
+		return Begin(key, CalcHashForKey(key));
+	}
+
+	// Same as Begin(key), with the hash of the key already known
+	//
+	// key may be of any type that KeyEqual can compare with Key
+	template<typename LookupKey>
+	LocalIterator Begin(const LookupKey& key, uint64_t hash) {
+		Entry* entry = *FindEntryPtr(key, hash);
 
 		LocalIterator it;
 		
@@ -274,7 +319,170 @@ public:
 		return m_NodeCount;
 	}
 
+	// Number of keys with at least one value
+	int GetKeyCount() const {
+		return m_EntryCount;
+	}
+
+	bool IsRehashing() const {
+		return m_OldTable != nullptr;
+	}
+
+	IAllocator* GetAllocator() const {
+		return m_Allocator;
+	}
+
 private:
+	void Init(int capacity, ContainerGrowth_t growth, IAllocator* allocator) {
+		m_Allocator = allocator;
+
+		m_Table = AllocArray<Entry*>(m_Allocator, capacity);
+		m_TableSize = capacity;
+		m_Capacity = capacity;
+		m_NodeCount = 0;
+		m_EntryCount = 0;
+
+		m_Growth = growth;
+
+		m_OldTable = nullptr;
+		m_OldTableSize = 0;
+		m_RehashIndex = 0;
+
+		memset((void*)m_Table, 0, sizeof(Entry*) * capacity);
+	}
+
+	// Returns the pointer to the entry with the key, which points to nullptr
+	// at the end of the entry linked list if there is no such entry
+	//
+	// While rehashing, buckets of the old table that have not been moved yet
+	// are searched first. Entries missing from both tables are always added
+	// to the new one
+	template<typename LookupKey>
+	Entry** FindEntryPtr(const LookupKey& key, uint64_t hash) {
+		if (m_OldTable != nullptr) {
+			int oldIndex = CalcIndexForHash(hash, m_OldTableSize);
+
+			if (oldIndex >= m_RehashIndex) {
+				Entry** prevPtr = FindEntryPtrInList(&m_OldTable[oldIndex], key, hash);
+
+				if (*prevPtr != nullptr) {
+					return prevPtr;
+				}
+			}
+		}
+
+		return FindEntryPtrInList(&m_Table[CalcIndexForHash(hash, m_TableSize)], key, hash);
+	}
+
+	template<typename LookupKey>
+	Entry** FindEntryPtrInList(Entry** prevPtr, const LookupKey& key, uint64_t hash) {
+		KeyEqual equalClass;
+
+		while (*prevPtr != nullptr) {
+			Entry* entry = *prevPtr;
+
+			if (entry->hash == hash && equalClass.EqualFunc(entry->key, key)) {
+				break;
+			}
+
+			prevPtr = &entry->next;
+		}
+
+		return prevPtr;
+	}
+
+	// Starts moving the entries into a table with twice as many buckets
+	void Grow() {
+		// Growth happens after at least as many new keys as the old table has
+		// buckets, and each insert moves several buckets, so the previous
+		// rehash is already done by now
+		while (m_OldTable != nullptr) {
+			RehashStep();
+		}
+
+		m_OldTable = m_Table;
+		m_OldTableSize = m_TableSize;
+		m_RehashIndex = 0;
+
+		m_TableSize *= 2;
+		m_Table = AllocArray<Entry*>(m_Allocator, m_TableSize);
+
+		memset((void*)m_Table, 0, sizeof(Entry*) * m_TableSize);
+	}
+
+	// Moves a bounded number of buckets from the old table to the new one
+	void RehashStep() {
+		if (m_OldTable == nullptr) {
+			return;
+		}
+
+		int endIndex = m_RehashIndex + kContainerRehashStep;
+
+		if (endIndex > m_OldTableSize) {
+			endIndex = m_OldTableSize;
+		}
+
+		for (; m_RehashIndex < endIndex; ++m_RehashIndex) {
+			Entry* entry = m_OldTable[m_RehashIndex];
+
+			while (entry != nullptr) {
+				Entry* next = entry->next;
+
+				int index = CalcIndexForHash(entry->hash, m_TableSize);
+
+				entry->next = m_Table[index];
+				m_Table[index] = entry;
+
+				entry = next;
+			}
+
+			m_OldTable[m_RehashIndex] = nullptr;
+		}
+
+		if (m_RehashIndex == m_OldTableSize) {
+			FreeOldTable();
+		}
+	}
+
+	void FreeOldTable() {
+		if (m_OldTable != nullptr) {
+			m_Allocator->Dealloc(m_OldTable);
+			m_OldTable = nullptr;
+		}
+	}
+
+	// Destroys all entries and nodes; their memory is left to the pools
+	void DestroyEntries() {
+		for (int i = 0; i < m_TableSize; ++i) {
+			DestroyEntryList(m_Table[i]);
+		}
+
+		// Buckets before the rehash index were already moved and are empty
+		if (m_OldTable != nullptr) {
+			for (int i = m_RehashIndex; i < m_OldTableSize; ++i) {
+				DestroyEntryList(m_OldTable[i]);
+			}
+		}
+	}
+
+	void DestroyEntryList(Entry* entry) {
+		while (entry != nullptr) {
+			Entry* nextEntry = entry->next;
+			Node* node = entry->head;
+
+			while (node != nullptr) {
+				Node* nextNode = node->next;
+
+				node->~Node();
+
+				node = nextNode;
+			}
+
+			entry->~Entry();
+
+			entry = nextEntry;
+		}
+	}
 
 	// Tests if the entry already contains the value
 	bool HasValueInEntry(Entry* entry, const Value& value) {
@@ -293,8 +501,8 @@ private:
 		return false;
 	}
 
-	int CalcIndexForHash(uint64_t hash) {
-		return (int)(hash % (uint64_t)(m_Capacity));
+	int CalcIndexForHash(uint64_t hash, int tableSize) {
+		return (int)(hash % (uint64_t)(tableSize));
 	}
 
 	uint64_t CalcHashForKey(const Key& key) {
@@ -304,14 +512,27 @@ private:
 	}
 
 private:	
+	IAllocator* m_Allocator; // Allocates the tables
+
 	PoolAllocator<Node> m_NodeAlloc; // Allocates all nodes
 	PoolAllocator<Entry> m_EntryAlloc; // Allocates all table entries. Each entry corresponds to a bucket
 
 	Entry** m_Table; // m_Table[key] points to the head of the entry linked list
+	int m_TableSize; // Number of buckets in the table
+
+	// Table being moved into m_Table while growing; nullptr otherwise
+	//
+	// Buckets before m_RehashIndex have already been moved
+	Entry** m_OldTable;
+	int m_OldTableSize;
+	int m_RehashIndex;
 
 	int m_NodeCount; // Number of nodes of the table being used
+	int m_EntryCount; // Number of entries, one per key
+
+	int m_Capacity; // Max number of nodes that the table can use, or the initial number if growable
 
-	int m_Capacity; // Max number of nodes that the table can use
+	ContainerGrowth_t m_Growth;
 
 private:
 	// Stores the value
@@ -326,6 +547,7 @@ private:
 		Node* head;
 		Node* tail;
 		Entry* next;
+		Key key;
 		uint64_t hash; 
 	};
 
@@ -0,0 +1,155 @@
+#ifndef MPMCQUEUE_H_
+#define MPMCQUEUE_H_
+
+#include "base_include.h"
+
+#include "SpscQueue.h"
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//--------------------------------------------------
+//
+// MpmcQueue
+//
+// Bounded lock-free FIFO for any number of producer and consumer threads
+//
+// Capacity MUST be a power of 2. Every cell has a sequence number that tells
+// whether it is ready to be written or read in the current lap around the
+// buffer, so producers and consumers only contend on the index they move
+// (Vyukov's bounded queue)
+//
+//--------------------------------------------------
+template<typename T>
+class MpmcQueue {
+
+public:
+	explicit MpmcQueue(size_t capacity) {
+		ASSERT(capacity > 1 && (capacity & (capacity - 1)) == 0);
+
+		m_Cells = MEM_NEW Cell[capacity];
+		m_Mask = capacity - 1;
+
+		for (size_t i = 0; i < capacity; ++i) {
+			m_Cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		m_Head = 0;
+		m_Tail = 0;
+	}
+
+	// No other thread may use the queue any more, so every cell from the head
+	// to the tail holds an element, which is destroyed in place
+	~MpmcQueue() {
+		size_t tail = m_Tail.load(std::memory_order_acquire);
+
+		for (size_t i = m_Head.load(std::memory_order_relaxed); i != tail; ++i) {
+			reinterpret_cast<T*>(&m_Cells[i & m_Mask].data)->~T();
+		}
+
+		MEM_DELETE_ARR(m_Cells);
+	}
+
+	// Adds the element to the back. Any thread
+	//
+	// Returns false if the queue is full
+	bool TryPush(const T& data) {
+		size_t tail = m_Tail.load(std::memory_order_relaxed);
+
+		while (true) {
+			Cell* cell = &m_Cells[tail & m_Mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+
+			intptr_t diff = (intptr_t)sequence - (intptr_t)tail;
+
+			if (diff == 0) {
+				// Cell is free in this lap; claims it
+				if (m_Tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed)) {
+					new(&cell->data) T(data);
+
+					cell->sequence.store(tail + 1, std::memory_order_release);
+
+					return true;
+				}
+			}
+			else if (diff < 0) {
+				// Cell still holds the element from the previous lap
+				return false;
+			}
+			else {
+				// Another producer claimed the cell
+				tail = m_Tail.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// Moves the front element into data and removes it. Any thread
+	//
+	// Returns false if the queue is empty
+	bool TryPop(T* data) {
+		ASSERT(data != nullptr);
+
+		size_t head = m_Head.load(std::memory_order_relaxed);
+
+		while (true) {
+			Cell* cell = &m_Cells[head & m_Mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+
+			intptr_t diff = (intptr_t)sequence - (intptr_t)(head + 1);
+
+			if (diff == 0) {
+				// Cell was written in this lap; claims it
+				if (m_Head.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) {
+					T* element = reinterpret_cast<T*>(&cell->data);
+
+					*data = std::move(*element);
+					element->~T();
+
+					// Frees the cell for the next lap
+					cell->sequence.store(head + m_Mask + 1, std::memory_order_release);
+
+					return true;
+				}
+			}
+			else if (diff < 0) {
+				// Cell has not been written yet
+				return false;
+			}
+			else {
+				// Another consumer claimed the cell
+				head = m_Head.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	size_t GetCapacity() const { return m_Mask + 1; }
+
+private:
+	struct Cell {
+		std::atomic<size_t> sequence;
+		typename std::aligned_storage<sizeof(T), alignof(T)>::type data;
+	};
+
+	Cell* m_Cells;
+	size_t m_Mask;
+
+	char m_PadHead[kQueueCacheLineSize];
+
+	// Index of the next cell to read. Moved by the consumers
+	std::atomic<size_t> m_Head;
+
+	char m_PadTail[kQueueCacheLineSize - sizeof(std::atomic<size_t>)];
+
+	// Index of the next cell to write. Moved by the producers
+	std::atomic<size_t> m_Tail;
+
+	char m_PadEnd[kQueueCacheLineSize - sizeof(std::atomic<size_t>)];
+
+private:
+	MpmcQueue(const MpmcQueue&);
+	MpmcQueue& operator=(const MpmcQueue&);
+};
+
+#endif
\ No newline at end of file
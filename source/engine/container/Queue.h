@@ -3,31 +3,44 @@
 
 #include "base_include.h"
 
+#include "allocator/Allocator.h"
+
+#include <new>
+
 //--------------------------------------------------
 //
 // Queue
 //
 // A FIFO container that supports queuing in one direction
 //
+// The elements are allocated from an IAllocator, the default allocator
+// unless one is given. All elements are constructed with the queue
+//
 //--------------------------------------------------
 template<typename T>
 class Queue {
 
 public:
 	Queue(int capacity) {
-		// Stores one more unused entry for head and tail indexing to work
-		m_Data = MEM_NEW T[capacity + 1];
+		Init(capacity, GetDefaultAllocator());
+	}
 
-		m_Capacity = capacity;
-		m_Head = 0;
-		m_Tail = 0;
+	// Elements are allocated from allocator, which MUST outlive the queue
+	Queue(int capacity, IAllocator* allocator) {
+		Init(capacity, allocator);
 	}
 
 	~Queue() {
+		for (int i = 0; i < m_Capacity + 1; ++i) {
+			m_Data[i].~T();
+		}
+
 		m_Tail = 0;
 		m_Head = 0;
 		m_Capacity = 0;
-		MEM_DELETE_ARR(m_Data);
+
+		m_Allocator->Dealloc(m_Data);
+		m_Data = nullptr;
 	}
 
 	void PushBack(const T& data) {
@@ -64,7 +77,27 @@ public:
 	bool IsFull() const { return (m_Head == (m_Tail + 1) % (m_Capacity + 1)); }
 	bool IsEmpty() const { return (m_Head == m_Tail); }
 
+	IAllocator* GetAllocator() const { return m_Allocator; }
+
 private:
+	void Init(int capacity, IAllocator* allocator) {
+		m_Allocator = allocator;
+
+		// Stores one more unused entry for head and tail indexing to work
+		m_Data = AllocArray<T>(m_Allocator, capacity + 1);
+
+		for (int i = 0; i < capacity + 1; ++i) {
+			new(&m_Data[i]) T();
+		}
+
+		m_Capacity = capacity;
+		m_Head = 0;
+		m_Tail = 0;
+	}
+
+private:
+	IAllocator* m_Allocator;
+
 	T* m_Data;
 	int m_Capacity; // Actual data size if m_Capacity + 1
 	int m_Head; // Index of first element
@@ -0,0 +1,402 @@
+#ifndef SLOTMAP_H_
+#define SLOTMAP_H_
+
+#include "base_include.h"
+
+#include "ContainerGrowth.h"
+#include "ContainerRelocate.h"
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//--------------------------------------------------
+//
+// SlotHandle
+//
+// Handle to an element of a SlotMap
+//
+// Packs the index of the slot in the low kIndexBits bits and the generation
+// of the slot in the others. The generation changes each time the element
+// in the slot is removed, so a handle to a removed element is detected even
+// after the slot is reused
+//
+// A handle with a value of 0 is never returned by a map and is used as the
+// invalid handle
+//
+//--------------------------------------------------
+template<typename Int, int kIndexBits>
+struct SlotHandle {
+	typedef Int IntType;
+
+	static const Int kIndexMask = ((Int)1 << kIndexBits) - 1;
+	static const Int kGenerationMask = (Int)~(Int)0 >> kIndexBits;
+
+	// Max number of slots that a handle can refer to
+	static const Int kIndexMax = kIndexMask + 1;
+
+	SlotHandle(): value(0) {}
+
+	SlotHandle(Int index, Int generation): value((generation << kIndexBits) | index) {}
+
+	Int GetIndex() const {
+		return value & kIndexMask;
+	}
+
+	Int GetGeneration() const {
+		return value >> kIndexBits;
+	}
+
+	bool IsValid() const {
+		return value != 0;
+	}
+
+	bool operator==(const SlotHandle& other) const {
+		return value == other.value;
+	}
+
+	bool operator!=(const SlotHandle& other) const {
+		return value != other.value;
+	}
+
+	Int value;
+};
+
+// Up to 1M slots, and 4095 removals from the same slot before a stale
+// handle to it may be mistaken for a live one
+typedef SlotHandle<uint32_t, 20> SlotHandle32;
+
+// Up to 4G slots; generations practically never repeat
+typedef SlotHandle<uint64_t, 32> SlotHandle64;
+
+//--------------------------------------------------
+//
+// SlotMap
+//
+// Array of elements that are referred to by generational handles
+//
+// Insert(), Remove() and Find() take constant time. Elements are packed at
+// the front of an array like in a DynArray, so iterating over them with
+// operator[] and GetSize() reads only live elements in sequence. Removing
+// an element moves the last element into its place, which changes the index
+// but not the handle of that element
+//
+// Find() returns nullptr for a handle to a removed element, so holding a
+// handle instead of a pointer never leaves a dangling pointer
+//
+// Freed slots are reused oldest first, so that the generation of a slot
+// wraps around as late as possible
+//
+// A growable map allocates larger arrays when it is full, see
+// ContainerGrowth.h. Pointers to the elements are invalidated when the map
+// grows and when an element is removed, the handles are not
+//
+//--------------------------------------------------
+template<typename T, typename Handle>
+class SlotMap {
+
+public:
+	explicit SlotMap(int capacity) {
+		Init(capacity, kContainerGrowthFixed);
+	}
+
+	// If growth is kContainerGrowthAuto, capacity is only the initial size
+	SlotMap(int capacity, ContainerGrowth_t growth) {
+		Init(capacity, growth);
+	}
+
+	~SlotMap() {
+		Clear();
+
+		MEM_DELETE_ARR(m_Slots);
+		MEM_DELETE_ARR(m_Handles);
+		MEM_DELETE_ARR(m_Data);
+	}
+
+	// Adds the element at the end of the array and returns its handle
+	Handle Insert(const T& element) {
+		if (m_Size == m_Capacity) {
+			ASSERT(m_Growth == kContainerGrowthAuto);
+
+			Grow();
+		}
+
+		// Takes the slot that was freed first
+		int slotIndex = m_FreeHead;
+		Slot& slot = m_Slots[slotIndex];
+
+		m_FreeHead = slot.index;
+
+		if (m_FreeHead < 0) {
+			m_FreeTail = -1;
+		}
+
+		int index = m_Size;
+		++m_Size;
+
+		new(&GetData()[index]) T(element);
+
+		slot.index = index;
+
+		Handle handle((typename Handle::IntType)slotIndex, slot.generation);
+		m_Handles[index] = handle;
+
+		return handle;
+	}
+
+	// Removes the element by moving the last element into its place
+	//
+	// The handle MUST refer to an element in the map
+	void Remove(Handle handle) {
+		int index = GetIndex(handle);
+
+		ASSERT(index >= 0);
+
+		if (index < 0) {
+			return;
+		}
+
+		RemoveAt(index);
+	}
+
+	// Same as Remove(GetHandle(index))
+	void RemoveAt(int index) {
+		ASSERT(index >= 0 && index < m_Size);
+
+		T* data = GetData();
+		int last = m_Size - 1;
+
+		int slotIndex = (int)m_Handles[index].GetIndex();
+
+		if (index != last) {
+			data[index] = std::move(data[last]);
+
+			m_Handles[index] = m_Handles[last];
+			m_Slots[m_Handles[index].GetIndex()].index = index;
+		}
+
+		data[last].~T();
+
+		FreeSlot(slotIndex);
+
+		m_Size = last;
+	}
+
+	// Returns the element of the handle, or nullptr if the element was
+	// removed
+	T* Find(Handle handle) {
+		int index = GetIndex(handle);
+
+		if (index < 0) {
+			return nullptr;
+		}
+
+		return &GetData()[index];
+	}
+
+	bool Contains(Handle handle) const {
+		return GetIndex(handle) >= 0;
+	}
+
+	// Returns the index of the element of the handle in the array, or -1 if
+	// the element was removed
+	int GetIndex(Handle handle) const {
+		int slotIndex = (int)handle.GetIndex();
+
+		if (slotIndex >= m_SlotCount) {
+			return -1;
+		}
+
+		const Slot& slot = m_Slots[slotIndex];
+
+		if (slot.generation != handle.GetGeneration()) {
+			return -1;
+		}
+
+		return slot.index;
+	}
+
+	// Returns the handle of the element at the index
+	Handle GetHandle(int index) const {
+		ASSERT(index >= 0 && index < m_Size);
+
+		return m_Handles[index];
+	}
+
+	// Elements are in range [0, GetSize())
+	T& operator[](int index) {
+		ASSERT(index >= 0 && index < m_Size);
+
+		return GetData()[index];
+	}
+
+	const T& operator[](int index) const {
+		ASSERT(index >= 0 && index < m_Size);
+
+		return GetData()[index];
+	}
+
+	// Removes all elements; handles to them are no longer valid
+	void Clear() {
+		while (m_Size > 0) {
+			RemoveAt(m_Size - 1);
+		}
+	}
+
+	int GetSize() const {
+		return m_Size;
+	}
+
+	int GetCapacity() const {
+		return m_Capacity;
+	}
+
+	bool IsEmpty() const {
+		return m_Size == 0;
+	}
+
+	bool IsFull() const {
+		return m_Growth == kContainerGrowthFixed && m_Size == m_Capacity;
+	}
+
+private:
+	typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+	typedef typename Handle::IntType Int;
+
+	struct Slot {
+		// Index of the element in the array if the slot is used, or the next
+		// slot in the free list if it is free. -1 ends the free list
+		int index;
+
+		// Generation of the element in the slot, never 0
+		Int generation;
+	};
+
+	void Init(int capacity, ContainerGrowth_t growth) {
+		ASSERT(capacity > 0);
+		ASSERT((Int)capacity <= Handle::kIndexMax);
+
+		m_Growth = growth;
+
+		m_Capacity = capacity;
+		m_Size = 0;
+
+		m_Data = MEM_NEW Storage[capacity];
+		m_Handles = MEM_NEW Handle[capacity];
+
+		m_SlotCount = capacity;
+		m_Slots = MEM_NEW Slot[capacity];
+
+		for (int i = 0; i < capacity; ++i) {
+			m_Slots[i].index = i + 1;
+			m_Slots[i].generation = 1;
+		}
+
+		m_Slots[capacity - 1].index = -1;
+
+		m_FreeHead = 0;
+		m_FreeTail = capacity - 1;
+	}
+
+	T* GetData() {
+		return (T*)m_Data;
+	}
+
+	const T* GetData() const {
+		return (const T*)m_Data;
+	}
+
+	// Doubles the arrays; the new slots are added to the end of the free
+	// list
+	void Grow() {
+		int capacity = m_Capacity * 2;
+
+		ASSERT((Int)capacity <= Handle::kIndexMax);
+
+		Storage* data = MEM_NEW Storage[capacity];
+		ContainerRelocate((T*)data, GetData(), m_Size);
+
+		MEM_DELETE_ARR(m_Data);
+		m_Data = data;
+
+		Handle* handles = MEM_NEW Handle[capacity];
+
+		for (int i = 0; i < m_Size; ++i) {
+			handles[i] = m_Handles[i];
+		}
+
+		MEM_DELETE_ARR(m_Handles);
+		m_Handles = handles;
+
+		Slot* slots = MEM_NEW Slot[capacity];
+
+		for (int i = 0; i < m_SlotCount; ++i) {
+			slots[i] = m_Slots[i];
+		}
+
+		MEM_DELETE_ARR(m_Slots);
+		m_Slots = slots;
+
+		int slotCount = m_SlotCount;
+		m_SlotCount = capacity;
+
+		for (int i = slotCount; i < capacity; ++i) {
+			m_Slots[i].generation = 1;
+
+			AppendFreeSlot(i);
+		}
+
+		m_Capacity = capacity;
+	}
+
+	// Gives the slot a new generation, so that its handles become stale,
+	// and adds it to the free list
+	void FreeSlot(int slotIndex) {
+		Slot& slot = m_Slots[slotIndex];
+
+		slot.generation = (slot.generation + 1) & Handle::kGenerationMask;
+
+		if (slot.generation == 0) {
+			slot.generation = 1;
+		}
+
+		AppendFreeSlot(slotIndex);
+	}
+
+	void AppendFreeSlot(int slotIndex) {
+		m_Slots[slotIndex].index = -1;
+
+		if (m_FreeTail < 0) {
+			m_FreeHead = slotIndex;
+		}
+		else {
+			m_Slots[m_FreeTail].index = slotIndex;
+		}
+
+		m_FreeTail = slotIndex;
+	}
+
+	ContainerGrowth_t m_Growth;
+
+	// Elements and their handles, packed at the front; only the first
+	// m_Size elements are constructed
+	Storage* m_Data;
+	Handle* m_Handles;
+
+	int m_Capacity;
+	int m_Size;
+
+	Slot* m_Slots;
+	int m_SlotCount;
+
+	// Free list of slots, reused from the head and added to at the tail
+	int m_FreeHead;
+	int m_FreeTail;
+
+private:
+	// Slot map is uncopyable
+	SlotMap(const SlotMap&);
+	SlotMap& operator=(const SlotMap&);
+};
+
+#endif
\ No newline at end of file
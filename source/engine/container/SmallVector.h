@@ -0,0 +1,315 @@
+#ifndef SMALLVECTOR_H_
+#define SMALLVECTOR_H_
+
+#include "base_include.h"
+
+#include "allocator/Allocator.h"
+
+#include "ContainerRelocate.h"
+
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//--------------------------------------------------
+//
+// SmallVector
+//
+// Resizable array that stores its first N elements inside the object
+//
+// For the small collections that most objects own, e.g. the clips of a
+// sprite, creating the object then allocates nothing. When more than N
+// elements are added, the elements move to memory on the heap, which doubles
+// in size whenever it is full like a DynArray. That memory comes from an
+// IAllocator, the default allocator unless one is given
+//
+// References to the elements are invalidated when the array grows
+//
+// Copies copy every element. Moving takes over the heap memory and the
+// allocator of the other array, or moves its elements one by one while they
+// are inline
+//
+//--------------------------------------------------
+template<typename T, int N>
+class SmallVector {
+
+public:
+	SmallVector() {
+		Init(GetDefaultAllocator());
+	}
+
+	// Reserves the capacity up front; stays inline if it is at most N
+	explicit SmallVector(size_t capacity) {
+		Init(GetDefaultAllocator());
+
+		Reserve(capacity);
+	}
+
+	// Heap memory is allocated from allocator, which MUST outlive the array
+	explicit SmallVector(IAllocator* allocator) {
+		Init(allocator);
+	}
+
+	SmallVector(size_t capacity, IAllocator* allocator) {
+		Init(allocator);
+
+		Reserve(capacity);
+	}
+
+	// Copy allocates from the same allocator as the other array
+	SmallVector(const SmallVector& other) {
+		Init(other.m_Allocator);
+
+		CopyFrom(other);
+	}
+
+	SmallVector(SmallVector&& other) {
+		Init(other.m_Allocator);
+
+		MoveFrom(other);
+	}
+
+	~SmallVector() {
+		Clear();
+
+		m_Allocator->Dealloc(m_Heap);
+	}
+
+	// Keeps the capacity of this array if it is large enough
+	SmallVector& operator=(const SmallVector& other) {
+		if (this != &other) {
+			Clear();
+			CopyFrom(other);
+		}
+
+		return *this;
+	}
+
+	SmallVector& operator=(SmallVector&& other) {
+		if (this != &other) {
+			Clear();
+			MoveFrom(other);
+		}
+
+		return *this;
+	}
+
+	T& operator[](int index) {
+		ASSERT(index >= 0 && (size_t)index < m_Size);
+
+		return GetData()[index];
+	}
+
+	const T& operator[](int index) const {
+		ASSERT(index >= 0 && (size_t)index < m_Size);
+
+		return GetData()[index];
+	}
+
+	void PushBack(const T& element) {
+		EmplaceBack(element);
+	}
+
+	void PushBack(T&& element) {
+		EmplaceBack(std::move(element));
+	}
+
+	// Constructs the element in place at the end of the array from the
+	// arguments
+	template<typename... Args>
+	T& EmplaceBack(Args&&... args) {
+		if (m_Size == m_Capacity) {
+			// New element is constructed before the old elements are moved,
+			// since the arguments may refer to them
+			size_t capacity = m_Capacity * 2;
+
+			Storage* heap = AllocArray<Storage>(m_Allocator, capacity);
+			T* element = new(&heap[m_Size]) T(std::forward<Args>(args)...);
+
+			Reallocate(heap, capacity);
+
+			++m_Size;
+
+			return *element;
+		}
+
+		T* element = new(&GetData()[m_Size]) T(std::forward<Args>(args)...);
+
+		++m_Size;
+
+		return *element;
+	}
+
+	void PopBack() {
+		ASSERT(!IsEmpty());
+
+		--m_Size;
+
+		GetData()[m_Size].~T();
+	}
+
+	// Removes the element at index, shifting the following elements down to
+	// keep their order
+	void Remove(int index) {
+		ASSERT(index >= 0 && (size_t)index < m_Size);
+
+		T* data = GetData();
+
+		std::move(&data[index + 1], &data[m_Size], &data[index]);
+
+		PopBack();
+	}
+
+	// Removes the element at index by moving the last element into its place
+	//
+	// Constant time, but does NOT keep the order of the elements
+	void SwapRemove(int index) {
+		ASSERT(index >= 0 && (size_t)index < m_Size);
+
+		T* data = GetData();
+
+		if ((size_t)index != m_Size - 1) {
+			data[index] = std::move(data[m_Size - 1]);
+		}
+
+		PopBack();
+	}
+
+	// Removes all elements; capacity is unchanged
+	void Clear() {
+		T* data = GetData();
+
+		if (!std::is_trivially_destructible<T>::value) {
+			for (size_t i = 0; i < m_Size; ++i) {
+				data[i].~T();
+			}
+		}
+
+		m_Size = 0;
+	}
+
+	// Makes sure that the capacity is at least the specified capacity
+	void Reserve(size_t capacity) {
+		if (capacity > m_Capacity) {
+			Reallocate(AllocArray<Storage>(m_Allocator, capacity), capacity);
+		}
+	}
+
+	T& GetBack() {
+		ASSERT(!IsEmpty());
+
+		return GetData()[m_Size - 1];
+	}
+
+	T& GetFront() {
+		ASSERT(!IsEmpty());
+
+		return GetData()[0];
+	}
+
+	size_t GetCapacity() const {
+		return m_Capacity;
+	}
+
+	size_t GetSize() const {
+		return m_Size;
+	}
+
+	bool IsEmpty() const {
+		return m_Size == 0;
+	}
+
+	// Returns true if the elements are still stored inside the object
+	bool IsInline() const {
+		return m_Heap == nullptr;
+	}
+
+	IAllocator* GetAllocator() const {
+		return m_Allocator;
+	}
+
+private:
+	typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+
+	void Init(IAllocator* allocator) {
+		ASSERT(allocator != nullptr);
+
+		m_Allocator = allocator;
+
+		m_Heap = nullptr;
+		m_Capacity = N;
+		m_Size = 0;
+	}
+
+	T* GetData() {
+		return (T*)(m_Heap != nullptr ? m_Heap : m_Inline);
+	}
+
+	const T* GetData() const {
+		return (const T*)(m_Heap != nullptr ? m_Heap : m_Inline);
+	}
+
+	// Copies the elements of the other array into this empty array
+	void CopyFrom(const SmallVector& other) {
+		ASSERT(m_Size == 0);
+
+		Reserve(other.m_Size);
+
+		T* data = GetData();
+		const T* otherData = other.GetData();
+
+		for (size_t i = 0; i < other.m_Size; ++i) {
+			new(&data[i]) T(otherData[i]);
+		}
+
+		m_Size = other.m_Size;
+	}
+
+	// Moves the elements of the other array into this empty array, leaving
+	// the other array empty and inline
+	void MoveFrom(SmallVector& other) {
+		ASSERT(m_Size == 0);
+
+		if (other.m_Heap != nullptr) {
+			m_Allocator->Dealloc(m_Heap);
+
+			m_Allocator = other.m_Allocator;
+			m_Heap = other.m_Heap;
+			m_Capacity = other.m_Capacity;
+			m_Size = other.m_Size;
+		}
+		else {
+			ContainerRelocate(GetData(), other.GetData(), other.m_Size);
+
+			m_Size = other.m_Size;
+		}
+
+		other.m_Heap = nullptr;
+		other.m_Capacity = N;
+		other.m_Size = 0;
+	}
+
+	// Moves the elements to the new heap memory and deletes the old one
+	void Reallocate(Storage* heap, size_t capacity) {
+		ContainerRelocate((T*)heap, GetData(), m_Size);
+
+		m_Allocator->Dealloc(m_Heap);
+
+		m_Heap = heap;
+		m_Capacity = capacity;
+	}
+
+	// Only the first m_Size elements are constructed
+	Storage m_Inline[N];
+
+	// nullptr while the elements are in m_Inline
+	Storage* m_Heap;
+
+	IAllocator* m_Allocator; // Allocates m_Heap
+
+	size_t m_Capacity;
+	size_t m_Size;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,140 @@
+#ifndef SPSCQUEUE_H_
+#define SPSCQUEUE_H_
+
+#include "base_include.h"
+
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Size of a cache line, used to keep indices written by different threads
+// apart
+const size_t kQueueCacheLineSize = 64;
+
+//--------------------------------------------------
+//
+// SpscQueue
+//
+// Bounded lock-free FIFO for exactly one producer thread and one consumer
+// thread
+//
+// Capacity MUST be a power of 2. Elements are constructed when pushed and
+// destroyed when popped, so T does not need a default constructor
+//
+// Each side keeps a cached copy of the other side's index, so it only reads
+// the other thread's cache line when the queue looks full or empty
+//
+//--------------------------------------------------
+template<typename T>
+class SpscQueue {
+
+public:
+	explicit SpscQueue(size_t capacity) {
+		ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0);
+
+		m_Data = MEM_NEW Storage[capacity];
+		m_Mask = capacity - 1;
+
+		m_Head = 0;
+		m_Tail = 0;
+		m_CachedHead = 0;
+		m_CachedTail = 0;
+	}
+
+	// No other thread may use the queue any more, so the elements left in it
+	// are destroyed in place
+	~SpscQueue() {
+		size_t tail = m_Tail.load(std::memory_order_acquire);
+
+		for (size_t i = m_Head.load(std::memory_order_relaxed); i != tail; ++i) {
+			reinterpret_cast<T*>(&m_Data[i & m_Mask])->~T();
+		}
+
+		MEM_DELETE_ARR(m_Data);
+	}
+
+	// Adds the element to the back. Producer thread only
+	//
+	// Returns false if the queue is full
+	bool TryPush(const T& data) {
+		size_t tail = m_Tail.load(std::memory_order_relaxed);
+
+		if (tail - m_CachedHead > m_Mask) {
+			m_CachedHead = m_Head.load(std::memory_order_acquire);
+
+			if (tail - m_CachedHead > m_Mask) {
+				return false;
+			}
+		}
+
+		new(&m_Data[tail & m_Mask]) T(data);
+
+		m_Tail.store(tail + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	// Moves the front element into data and removes it. Consumer thread only
+	//
+	// Returns false if the queue is empty
+	bool TryPop(T* data) {
+		ASSERT(data != nullptr);
+
+		size_t head = m_Head.load(std::memory_order_relaxed);
+
+		if (head == m_CachedTail) {
+			m_CachedTail = m_Tail.load(std::memory_order_acquire);
+
+			if (head == m_CachedTail) {
+				return false;
+			}
+		}
+
+		T* element = reinterpret_cast<T*>(&m_Data[head & m_Mask]);
+
+		*data = std::move(*element);
+		element->~T();
+
+		m_Head.store(head + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	// Only exact when called by the consumer
+	bool IsEmpty() const {
+		return m_Head.load(std::memory_order_acquire) == m_Tail.load(std::memory_order_acquire);
+	}
+
+	size_t GetCapacity() const { return m_Mask + 1; }
+
+private:
+	typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+
+	Storage* m_Data;
+	size_t m_Mask;
+
+	char m_PadHead[kQueueCacheLineSize];
+
+	// Index of the front element. Written by the consumer
+	std::atomic<size_t> m_Head;
+
+	// Copy of m_Tail last read by the consumer
+	size_t m_CachedTail;
+
+	char m_PadTail[kQueueCacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+	// Index after the back element. Written by the producer
+	std::atomic<size_t> m_Tail;
+
+	// Copy of m_Head last read by the producer
+	size_t m_CachedHead;
+
+	char m_PadEnd[kQueueCacheLineSize - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+private:
+	SpscQueue(const SpscQueue&);
+	SpscQueue& operator=(const SpscQueue&);
+};
+
+#endif
\ No newline at end of file
@@ -3,29 +3,43 @@
 
 #include "base_include.h"
 
+#include "allocator/Allocator.h"
+
+#include <new>
+
 //--------------------------------------------------
 //
 // Stack
 //
 // A LIFO container
 //
+// The elements are allocated from an IAllocator, the default allocator
+// unless one is given. All elements are constructed with the stack
+//
 //--------------------------------------------------
 template<typename T>
 class Stack {
 
 public:
     explicit Stack(int capacity) {
-        ASSERT(capacity > 0);
+        Init(capacity, GetDefaultAllocator());
+    }
 
-        m_Capacity = capacity;
-        m_Data = MEM_NEW T[capacity];
-        m_Top = 0;
+    // Elements are allocated from allocator, which MUST outlive the stack
+    Stack(int capacity, IAllocator* allocator) {
+        Init(capacity, allocator);
     }
 
     ~Stack() {
+        for (int i = 0; i < m_Capacity; ++i) {
+            m_Data[i].~T();
+        }
+
         m_Top = 0;
         m_Capacity = 0;
-        MEM_DELETE_ARR(m_Data);
+
+        m_Allocator->Dealloc(m_Data);
+        m_Data = nullptr;
     }
 
     void Push(const T& data) {
@@ -62,7 +76,26 @@ public:
     bool IsFull() const { return (m_Top == m_Capacity); }
     bool IsEmpty() const { return (m_Top == 0); }
 
+    IAllocator* GetAllocator() const { return m_Allocator; }
+
 private:
+    void Init(int capacity, IAllocator* allocator) {
+        ASSERT(capacity > 0);
+
+        m_Allocator = allocator;
+
+        m_Capacity = capacity;
+        m_Data = AllocArray<T>(m_Allocator, capacity);
+        m_Top = 0;
+
+        for (int i = 0; i < capacity; ++i) {
+            new(&m_Data[i]) T();
+        }
+    }
+
+private:
+    IAllocator* m_Allocator;
+
     T* m_Data;
     int m_Capacity;
 
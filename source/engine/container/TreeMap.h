@@ -5,6 +5,10 @@
 
 #include "allocator/PoolAllocator.h"
 
+#include "ContainerGrowth.h"
+
+#include <new>
+
 //--------------------------------------------------
 //
 // TreeMap
@@ -20,6 +24,13 @@
 // Implemented as a red black tree; implementation adapted from Introduction 
 // to Algorithms, 3rd Edition by CLRS
 //
+// A growable map allocates more nodes when it is full, see ContainerGrowth.h.
+// Nodes never move, so iterators stay valid while the map grows
+//
+// Nodes are allocated from an IAllocator, the default allocator unless one
+// is given. Nodes are constructed in the pool memory on insert and destroyed
+// on removal
+//
 //--------------------------------------------------
 template<typename Key, typename Value>
 class TreeMap {
@@ -34,19 +45,23 @@ private:
 
 public:
 	TreeMap(int capacity): m_NodeAlloc(capacity) {
-		m_NodeAlloc.Clear();
-		m_Capacity = capacity;
-
-		m_NullNode.red = false;
-		m_NullNode.parent = m_NullNode.left = m_NullNode.right = nullptr;
+		Init(capacity, kContainerGrowthFixed);
+	}
 
-		m_Null = &m_NullNode;
-		m_Root = m_Null;
+	// If growth is kContainerGrowthAuto, capacity is only the initial size
+	TreeMap(int capacity, ContainerGrowth_t growth): m_NodeAlloc(capacity, growth == kContainerGrowthAuto) {
+		Init(capacity, growth);
+	}
 
-		m_NodeCount = 0;
+	// Nodes are allocated from allocator, which MUST outlive the map
+	TreeMap(int capacity, ContainerGrowth_t growth, IAllocator* allocator):
+		m_NodeAlloc(capacity, growth == kContainerGrowthAuto, allocator) {
+		Init(capacity, growth);
 	}
 
 	~TreeMap() {
+		DestroySubtree(m_Root);
+
 		m_Root = nullptr;
 		m_Null = nullptr;
 		m_NodeAlloc.Clear();
@@ -56,9 +71,9 @@ public:
 	//
 	// The value is NOT inserted if the key already exists in the map
 	void Insert(const Key& key, const Value& value) {
-		ASSERT(m_NodeCount < m_Capacity);
+		ASSERT(m_Growth == kContainerGrowthAuto || m_NodeCount < m_Capacity);
 
-		Node* node = m_NodeAlloc.Alloc();
+		Node* node = new(m_NodeAlloc.Alloc()) Node();
 
 		node->key = key;
 		node->value = value;
@@ -72,6 +87,10 @@ public:
 			// If key already exists, method does NOT insert the new value
 			if (key == it->key) {
 				ASSERT(0);
+
+				node->~Node();
+				m_NodeAlloc.Dealloc(node);
+
 				return;
 			}
 			if (node->key < it->key) {
@@ -152,6 +171,7 @@ public:
 			RemoveFixup(x);
 		}
         
+        z->~Node();
         m_NodeAlloc.Dealloc(z);
         --m_NodeCount;
 	}
@@ -190,6 +210,8 @@ public:
 	}
 
 	void Clear() {
+		DestroySubtree(m_Root);
+
 		m_NodeCount = 0;
 
 		m_Root = m_Null;
@@ -215,7 +237,25 @@ public:
 		return it;
 	}
 
+	IAllocator* GetAllocator() const {
+		return m_NodeAlloc.GetAllocator();
+	}
+
 private:
+	void Init(int capacity, ContainerGrowth_t growth) {
+		m_NodeAlloc.Clear();
+		m_Capacity = capacity;
+		m_Growth = growth;
+
+		m_NullNode.red = false;
+		m_NullNode.parent = m_NullNode.left = m_NullNode.right = nullptr;
+
+		m_Null = &m_NullNode;
+		m_Root = m_Null;
+
+		m_NodeCount = 0;
+	}
+
 	// Red Black tree internal routines
 
 	void LeftRotate(Node* node) {
@@ -431,6 +471,18 @@ private:
 		return x;
 	}
 
+	// Destroys all nodes under node; their memory is left to the pool
+	void DestroySubtree(Node* node) {
+		if (node == m_Null) {
+			return;
+		}
+
+		DestroySubtree(node->left);
+		DestroySubtree(node->right);
+
+		node->~Node();
+	}
+
 	Node* FindSuccessor(Node* node) {
 		Node* x = node;
 
@@ -456,7 +508,9 @@ private:
 
 	int m_NodeCount;
 
-	int m_Capacity;
+	int m_Capacity; // Max number of nodes, or the initial number if growable
+
+	ContainerGrowth_t m_Growth;
 
 	// Represents null; is colored black
 	Node m_NullNode;
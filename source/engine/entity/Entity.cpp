@@ -30,6 +30,8 @@ Entity::Entity() {
 	m_Body = nullptr;
 
 	UpdateAllTransform();
+
+	m_PrevWorldTransform = m_WorldTransform;
 }
 
 Entity::~Entity() {
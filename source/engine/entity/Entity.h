@@ -5,10 +5,17 @@
 
 #include "math/Vector.h"
 #include "math/Matrix.h"
+#include "container/SlotMap.h"
 
 
 typedef uint64_t EntityId_t;
 
+// Generational handle to an entity in its EntityManager
+//
+// Unlike an Entity pointer, a handle to a destroyed entity is detected, see
+// EntityManager::GetEntity()
+typedef SlotHandle32 EntityHandle;
+
 
 #define ABSTRACT_PROTOTYPE(classname)	\
 public:	\
@@ -111,6 +118,10 @@ public:
 	bool GetFlipY() const;
 
 	EntityId_t GetId() const { return m_Id; }
+
+	// Invalid if the entity was not created by an EntityManager
+	EntityHandle GetHandle() const { return m_Handle; }
+
 	Sprite* GetSprite() { return m_Sprite.get(); }
 
 	Mat3 GetWorldTransform() const { return m_WorldTransform; }
@@ -143,6 +154,9 @@ protected:
 	// Unique id of the entity; assigned during construction
 	EntityId_t m_Id;
 
+	// Assigned by the EntityManager that created the entity
+	EntityHandle m_Handle;
+
 
 	Entity* m_Parent;
 	// Points to the head of the children list
@@ -163,6 +177,11 @@ protected:
 	// world transform is changed
 	Mat3 m_WorldTransform;
 
+	// World transform at the start of the current simulation step
+	//
+	// Rendering interpolates between this and m_WorldTransform
+	Mat3 m_PrevWorldTransform;
+
 
 	// Pointer to sprite if present
 	SharedPtr<Sprite> m_Sprite;
@@ -4,25 +4,34 @@
 #include "Entity.h"
 
 // Definition of type table
-HashMap<const char*, TypeInfo*> EntityManager::m_TypeTable(kEntityTypeMax);
+HashMap<StringId, TypeInfo*> EntityManager::m_TypeTable(kEntityTypeMax);
 
 void EntityManager::AddType(const char* name, TypeInfo* type) {
-	m_TypeTable.Insert(name, type);
+	m_TypeTable.Insert(InternString(name), type);
 }
 
-EntityManager::EntityManager(PhysWorld* physWorld) {
+EntityManager::EntityManager(PhysWorld* physWorld): m_Entities(kEntityCountMax, kContainerGrowthAuto) {
 	m_PhysWorldPtr = physWorld;
 }
 
 EntityManager::~EntityManager() {
+	// Destroys the entities that the game did not destroy
+	while (!m_Entities.IsEmpty()) {
+		DestroyEntity(m_Entities[m_Entities.GetSize() - 1]);
+	}
+
 	m_PhysWorldPtr = nullptr;
 }
 
 Entity* EntityManager::CreateEntity(const char* classname) {
+	return CreateEntity(StringId(classname));
+}
+
+Entity* EntityManager::CreateEntity(StringId classname) {
 	auto it = m_TypeTable.Find(classname);
 
 	if (it == m_TypeTable.End()) {
-		LOG_ERROR("EntityManager: class \'%s\' could not be found", classname);
+		LOG_ERROR("EntityManager: class \'%s\' could not be found", classname.GetString());
 		return nullptr;
 	}
 
@@ -30,10 +39,15 @@ Entity* EntityManager::CreateEntity(const char* classname) {
 
 	Entity* entity = (*(type->CreateInstance))();
 
+	entity->m_Handle = m_Entities.Insert(entity);
+
 	return entity;
 }
 
 void EntityManager::DestroyEntity(Entity* entity) {
+	m_Entities.Remove(entity->m_Handle);
+	entity->m_Handle = EntityHandle();
+
 	PhysBody* body = entity->m_Body;
 
 	if (body != nullptr) {
@@ -46,6 +60,20 @@ void EntityManager::DestroyEntity(Entity* entity) {
 	(*(type->DestroyInstance))(entity);
 }
 
+void EntityManager::DestroyEntity(EntityHandle handle) {
+	Entity* entity = GetEntity(handle);
+
+	if (entity != nullptr) {
+		DestroyEntity(entity);
+	}
+}
+
+Entity* EntityManager::GetEntity(EntityHandle handle) {
+	Entity** entity = m_Entities.Find(handle);
+
+	return entity != nullptr ? *entity : nullptr;
+}
+
 Sprite* EntityManager::CreateSprite(Entity* entity, Texture* texture, int clipCount) {
 	ASSERT(entity->m_Sprite.get() == nullptr);
 
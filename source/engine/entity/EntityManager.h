@@ -4,20 +4,32 @@
 #include "base_include.h"
 
 #include "container/HashMap.h"
+#include "container/SlotMap.h"
 
+#include "entity/Entity.h"
 #include "entity/Sprite.h"
 #include "physics/PhysWorld.h"
 
 // Max number of subclasses of entity
 const int kEntityTypeMax = 64;
 
-// Max number of entities
+// Initial number of entities; the manager grows past it
 const int kEntityCountMax = 1024;
 
 // Forward declarations
 class TypeInfo;
-class Entity;
 
+//--------------------------------------------------
+//
+// EntityManager
+//
+// Creates and destroys the entities and their components
+//
+// Live entities are kept in a SlotMap, so code that may outlive an entity
+// should hold its EntityHandle and look it up with GetEntity(), which
+// returns nullptr once the entity is destroyed
+//
+//--------------------------------------------------
 class EntityManager {
 
 public:
@@ -29,18 +41,35 @@ public:
 
 	Entity* CreateEntity(const char* classname);
 
+	// Same as CreateEntity(classname) without hashing the name, e.g. with
+	// STRING_ID("Player")
+	Entity* CreateEntity(StringId classname);
+
 	// Function will destroy any PhysBody attached to the entity
 	void DestroyEntity(Entity* entity);
 
+	// Does nothing if the entity was already destroyed
+	void DestroyEntity(EntityHandle handle);
+
+	// Returns the entity of the handle, or nullptr if it was destroyed
+	Entity* GetEntity(EntityHandle handle);
+
+	// Live entities are packed in range [0, GetEntityCount())
+	int GetEntityCount() const { return m_Entities.GetSize(); }
+	Entity* GetEntityAt(int index) { return m_Entities[index]; }
+
 	Sprite* CreateSprite(Entity* entity, Texture* texture, int clipCount);
 
 	// Creates and attaches a PhysBody to the specified entity
 	PhysBody* CreatePhysBody(Entity* entity, PhysBodyType_t type, uint16_t layer);
 
 private:
-	static HashMap<const char*, TypeInfo*> m_TypeTable;
+	// Keyed by the id of the class name
+	static HashMap<StringId, TypeInfo*> m_TypeTable;
 
 	PhysWorld* m_PhysWorldPtr;
+
+	SlotMap<Entity*, EntityHandle> m_Entities;
 };
 
 #endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Entity.h"
 #include "Sprite.h"
 
+#include "job/JobSystem.h"
 #include "math/Rect.h"
 #include "platform/PlatformWindow.h"
 
@@ -10,8 +11,9 @@
 
 #include <cstring>
 
-Scene::Scene(PlatformWindow* window) {
+Scene::Scene(PlatformWindow* window): m_UpdateSprites(kSceneSpriteRangeSize) {
 	m_WindowPtr = window;
+	m_JobSystemPtr = nullptr;
 
 	m_ViewScale = 1.0;
 
@@ -21,15 +23,40 @@ Scene::Scene(PlatformWindow* window) {
 }
 
 Scene::~Scene() {
+	m_JobSystemPtr = nullptr;
 	m_WindowPtr = nullptr;
 }
 
+static void UpdateSpriteRangeTask(void* context, size_t begin, size_t end) {
+	((Scene*)context)->UpdateSpriteRange(begin, end);
+}
+
 void Scene::Update() {
+	m_UpdateSprites.Clear();
+
 	for (int i = 0; i < kSceneLayerMax; ++i) {
 		if (m_Layers[i].head != nullptr) {
 			UpdateInternal(m_Layers[i].head);
 		}
 	}
+
+	// Each sprite only changes its own animation state
+	if (m_JobSystemPtr != nullptr) {
+		m_JobSystemPtr->ParallelFor(&UpdateSpriteRangeTask, (void*)this, m_UpdateSprites.GetSize(), kSceneSpriteRangeSize);
+	}
+	else {
+		UpdateSpriteRange(0, m_UpdateSprites.GetSize());
+	}
+}
+
+void Scene::UpdateSpriteRange(size_t begin, size_t end) {
+	for (size_t i = begin; i < end; ++i) {
+		m_UpdateSprites[i]->Update();
+	}
+}
+
+void Scene::SetJobSystem(JobSystem* jobSystem) {
+	m_JobSystemPtr = jobSystem;
 }
 
 void Scene::UpdateInternal(Entity* entity) {
@@ -42,7 +69,7 @@ void Scene::UpdateInternal(Entity* entity) {
 	entity->EntityUpdate();
 
 	if (entity->HasSprite()) {
-		entity->GetSprite()->Update();
+		m_UpdateSprites.PushBack(entity->GetSprite());
 	}
 
 	// Updates the entity's siblins after the entity
@@ -51,18 +78,54 @@ void Scene::UpdateInternal(Entity* entity) {
 	}
 }
 
-void Scene::Render() {
+void Scene::StoreRenderState() {
+	for (int i = 0; i < kSceneLayerMax; ++i) {
+		if (m_Layers[i].head != nullptr) {
+			StoreRenderStateInternal(m_Layers[i].head);
+		}
+	}
+}
+
+void Scene::StoreRenderStateInternal(Entity* entity) {
+	if (entity->m_Children != nullptr) {
+		StoreRenderStateInternal(entity->m_Children);
+	}
+
+	entity->m_PrevWorldTransform = entity->m_WorldTransform;
+
+	if (entity->m_Sibling != nullptr) {
+		StoreRenderStateInternal(entity->m_Sibling);
+	}
+}
+
+// Returns the transform between the 2 transforms
+//
+// Only the translation is interpolated. Rotation is taken from the current
+// transform, since blending the rotation parts of the matrices would also
+// scale the entity
+static Mat3 InterpolateTransform(const Mat3& prev, const Mat3& current, double alpha) {
+	double prevX = prev.GetRow1().GetZ();
+	double prevY = prev.GetRow2().GetZ();
+	double currentX = current.GetRow1().GetZ();
+	double currentY = current.GetRow2().GetZ();
+
+	return Mat3(current.GetRow1().GetX(), current.GetRow1().GetY(), prevX + (currentX - prevX) * alpha,
+				current.GetRow2().GetX(), current.GetRow2().GetY(), prevY + (currentY - prevY) * alpha,
+				0.0, 0.0, 1.0);
+}
+
+void Scene::Render(double alpha) {
 	for (int i = kSceneLayerMax - 1; i >= 0; --i) {
 		if (m_Layers[i].head != nullptr) {
-			RenderInternal(m_Layers[i].head);
+			RenderInternal(m_Layers[i].head, alpha);
 		}
 	}
 }
 
-void Scene::RenderInternal(Entity* entity) {
+void Scene::RenderInternal(Entity* entity, double alpha) {
 	// Renders the entity's children first
 	if (entity->m_Children != nullptr) {
-		RenderInternal(entity->m_Children);
+		RenderInternal(entity->m_Children, alpha);
 	}
 
 	// Render the entity
@@ -86,7 +149,7 @@ void Scene::RenderInternal(Entity* entity) {
 									-spriteOrigin.GetY() + frame.GetH(), 1.0);
 
 
-		Mat3 worldTransform = entity->GetWorldTransform();
+		Mat3 worldTransform = InterpolateTransform(entity->m_PrevWorldTransform, entity->m_WorldTransform, alpha);
 
 		if (sprite->GetFlipY()) {
 			worldTransform = worldTransform * Mat3(-1.0, 0.0, 0.0,
@@ -185,7 +248,7 @@ void Scene::RenderInternal(Entity* entity) {
 
 	// Renders the entity's siblings after the entity
 	if (entity->m_Sibling != nullptr) {
-		RenderInternal(entity->m_Sibling);
+		RenderInternal(entity->m_Sibling, alpha);
 	}
 }
 
@@ -218,6 +281,14 @@ void Scene::AddEntity(Entity* entity, int layerIndex) {
 	}
 
 	entity->SetLayerIndex(layerIndex);
+
+	// Entity was placed before it was added, so it is not interpolated from
+	// wherever it was created
+	entity->m_PrevWorldTransform = entity->m_WorldTransform;
+
+	if (entity->m_Children != nullptr) {
+		StoreRenderStateInternal(entity->m_Children);
+	}
 }
 
 void Scene::RemoveEntity(Entity* entity) {
@@ -3,14 +3,20 @@
 
 #include "base_include.h"
 
+#include "container/DynArray.h"
 #include "math/Rect.h"
 #include "math/Vector.h"
 #include "render/QuadShader.h"
 
 const int kSceneLayerMax = 16;
 
+// Number of sprites animated together by one job
+const size_t kSceneSpriteRangeSize = 256;
+
 // Forward declarations
 class Entity;
+class Sprite;
+class JobSystem;
 
 struct SceneLayer {
 	Entity* head;
@@ -34,10 +40,27 @@ public:
 	~Scene();
 
 	// Update the entities on each frame
+	//
+	// Entities are updated in order on the calling thread. Sprite animations
+	// are then advanced on the job system if there is one
 	void Update();
 
+	// Sets the job system used to animate the sprites. nullptr animates them
+	// on the calling thread
+	void SetJobSystem(JobSystem* jobSystem);
+
+	// Saves the world transform of every entity as the start of the next
+	// simulation step
+	//
+	// MUST be called once before each step
+	void StoreRenderState();
+
 	// Render all entities with sprites
-	void Render();
+	//
+	// alpha is how far the current time is between the previous step and
+	// the last step, in range [0, 1]. Entity positions are interpolated
+	// between the two steps
+	void Render(double alpha);
 	
 
 	// Only add or remove entity that is not a child to another entity
@@ -76,12 +99,27 @@ private:
 	// Recursive function called by Update()
 	void UpdateInternal(Entity* entity);
 
+	// Recursive function called by StoreRenderState()
+	void StoreRenderStateInternal(Entity* entity);
+
 	// Recursive function called by Render()
-	void RenderInternal(Entity* entity);
+	void RenderInternal(Entity* entity, double alpha);
+
+public:
+	// Advances the animation of the sprites in range [begin, end) of the
+	// sprites collected by Update()
+	//
+	// Called by the jobs of Update(). Should not be called directly
+	void UpdateSpriteRange(size_t begin, size_t end);
 
 private:
 	PlatformWindow* m_WindowPtr;
 
+	JobSystem* m_JobSystemPtr;
+
+	// Sprites of the entities updated in the current Update()
+	DynArray<Sprite*> m_UpdateSprites;
+
 	QuadShader m_SpriteShader;
 
 
@@ -2,7 +2,7 @@
 
 #include "render/Texture.h"
 
-Sprite::Sprite(Texture* texture, int clipCount): m_ClipTable(clipCount) {
+Sprite::Sprite(Texture* texture, int clipCount): m_Clips(clipCount), m_ClipNames(clipCount) {
 	m_TexturePtr = texture;
 
 	m_Origin = Vec2(0.0, 0.0);
@@ -10,7 +10,7 @@ Sprite::Sprite(Texture* texture, int clipCount): m_ClipTable(clipCount) {
 	m_FlipX = false;
 	m_FlipY = false;
 
-	m_CurrentClip = nullptr;
+	m_CurrentClip = -1;
 
 	m_CurrentFrame = 0;
 
@@ -22,14 +22,14 @@ Sprite::Sprite(Texture* texture, int clipCount): m_ClipTable(clipCount) {
 Sprite::~Sprite() {
 	m_TexturePtr = nullptr;
 
-	m_CurrentClip = nullptr;
+	m_CurrentClip = -1;
 }
 
 void Sprite::Update() {
 
-	if (m_CurrentClip != nullptr) {
+	if (m_CurrentClip >= 0) {
 		if (m_Playing && !m_Paused) {
-			if (m_CurrentFrame < (m_CurrentClip->frameCount - 1)) {
+			if (m_CurrentFrame < (m_Clips[m_CurrentClip].frameCount - 1)) {
 				++m_CurrentFrame;
 			}
 			else if (m_Repeat) {
@@ -45,7 +45,9 @@ void Sprite::Update() {
 
 void Sprite::AddClip(const char* name, int startX, int startY, int width, int height, int columnCount, int rowCount, int frameCount) {
 
-	ASSERT(!m_ClipTable.IsFull());
+	StringId key = InternString(name);
+
+	ASSERT(FindClip(key) < 0);
 
 	SpriteClip clip;
 	clip.startX = startX;
@@ -56,22 +58,27 @@ void Sprite::AddClip(const char* name, int startX, int startY, int width, int he
 	clip.rowCount = rowCount;
 	clip.frameCount = frameCount;
 
-	m_ClipTable.Insert(name, clip);
+	m_Clips.PushBack(clip);
+	m_ClipNames.PushBack(key);
 
-	if (m_CurrentClip == nullptr) {
-		m_CurrentClip = &m_ClipTable.Find(name).GetValue();
+	if (m_CurrentClip < 0) {
+		m_CurrentClip = 0;
 	}
 }
 
 void Sprite::PlayClip(const char* name, bool repeat) {
-	auto it = m_ClipTable.Find(name);
+	PlayClip(StringId(name), repeat);
+}
+
+void Sprite::PlayClip(StringId name, bool repeat) {
+	int clipIndex = FindClip(name);
 
-	if (it == m_ClipTable.End()) {
-		LOG_ERROR("Sprite: could not find clip \'%s\'", name);
+	if (clipIndex < 0) {
+		LOG_ERROR("Sprite: could not find clip \'%s\'", name.GetString());
 		return;
 	}
 
-	m_CurrentClip = &it.GetValue();
+	m_CurrentClip = clipIndex;
 
 	m_Playing = true;
 	m_Paused = false;
@@ -95,14 +102,26 @@ void Sprite::ResumeClip() {
 }
 
 Rect Sprite::GetFrame() const {
-	if (m_CurrentClip == nullptr) {
+	if (m_CurrentClip < 0) {
 		return Rect(0.0, 0.0, 0.0, 0.0);
 	}
 
-	int rowIndex = m_CurrentFrame / m_CurrentClip->columnCount;
-	int colIndex = m_CurrentFrame % m_CurrentClip->columnCount;
+	const SpriteClip& clip = m_Clips[m_CurrentClip];
+
+	int rowIndex = m_CurrentFrame / clip.columnCount;
+	int colIndex = m_CurrentFrame % clip.columnCount;
+
+	return Rect(clip.startX + colIndex * clip.width,
+				clip.startY + rowIndex * clip.height,
+				clip.width, clip.height);
+}
+
+int Sprite::FindClip(StringId name) const {
+	for (size_t i = 0; i < m_ClipNames.GetSize(); ++i) {
+		if (m_ClipNames[(int)i] == name) {
+			return (int)i;
+		}
+	}
 
-	return Rect(m_CurrentClip->startX + colIndex * m_CurrentClip->width,
-				m_CurrentClip->startY + rowIndex * m_CurrentClip->height,
-				m_CurrentClip->width, m_CurrentClip->height);
+	return -1;
 }
\ No newline at end of file
@@ -5,7 +5,7 @@
 
 #include "math/Vector.h"
 #include "math/Rect.h"
-#include "container/HashMap.h"
+#include "container/SmallVector.h"
 
 //--------------------------------------------------
 //
@@ -40,6 +40,9 @@ struct SpriteClip {
 	int frameCount;
 };
 
+// Number of clips that a sprite stores without allocating
+const int kSpriteClipInline = 4;
+
 
 // Forward declarations
 class Texture;
@@ -54,6 +57,7 @@ class Texture;
 class Sprite {
 
 public:
+	// Clips beyond kSpriteClipInline are allocated on the heap
 	Sprite(Texture* texture, int clipCount);
 	~Sprite();
 
@@ -63,6 +67,10 @@ public:
 	void AddClip(const char* name, int startX, int startY, int width, int height, int columnCount, int rowCount, int frameCount);
 
 	void PlayClip(const char* name, bool repeat);
+
+	// Same as PlayClip(name, repeat) without hashing the name, e.g. with
+	// STRING_ID("idle")
+	void PlayClip(StringId name, bool repeat);
 	void StopClip();
 
 	void PauseClip();
@@ -87,8 +95,13 @@ private:
 	// Pointer to the texture containing the sprite graphics
 	Texture* m_TexturePtr;
 
-	// Table containing all sprite clips
-	HashMap<const char*, SpriteClip> m_ClipTable;
+	// Returns the index of the clip with the name, or -1 if there is none
+	int FindClip(StringId name) const;
+
+	// Sprites have few clips, so they are searched in order instead of
+	// hashed
+	SmallVector<SpriteClip, kSpriteClipInline> m_Clips;
+	SmallVector<StringId, kSpriteClipInline> m_ClipNames;
 
 	// Point in the sprite that will be aligned to the entity
 	//
@@ -100,7 +113,9 @@ private:
 	bool m_FlipY;
 
 	// Variables for running sprite clip
-	SpriteClip* m_CurrentClip;
+	//
+	// Index of the clip in m_Clips, or -1 if there is no clip
+	int m_CurrentClip;
 
 	int m_CurrentFrame;
 
@@ -0,0 +1,133 @@
+#ifndef JOBDEQUE_H_
+#define JOBDEQUE_H_
+
+#include "base_include.h"
+
+#include <atomic>
+
+// Size of a cache line, used to keep values written by different threads
+// apart
+const size_t kJobCacheLineSize = 64;
+
+// Forward declarations
+struct Job;
+
+//--------------------------------------------------
+//
+// JobDeque
+//
+// Lock-free work stealing deque of jobs (Chase-Lev)
+//
+// Only the thread that owns the deque may call Push() and Pop(), which work
+// on the bottom of the deque. Any thread may call Steal(), which takes from
+// the top. Capacity is fixed and MUST be a power of 2
+//
+//--------------------------------------------------
+class JobDeque {
+
+public:
+	explicit JobDeque(size_t capacity) {
+		ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0);
+
+		m_Mask = capacity - 1;
+		m_Jobs = MEM_NEW std::atomic<Job*>[capacity];
+
+		m_Top = 0;
+		m_Bottom = 0;
+	}
+
+	~JobDeque() {
+		MEM_DELETE_ARR(m_Jobs);
+	}
+
+	// Adds a job to the bottom. Owner thread only
+	void Push(Job* job) {
+		int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+
+		ASSERT(bottom - m_Top.load(std::memory_order_acquire) <= (int64_t)m_Mask);
+
+		m_Jobs[bottom & m_Mask].store(job, std::memory_order_relaxed);
+
+		// Publishes the job before the thieves can see the new bottom
+		m_Bottom.store(bottom + 1, std::memory_order_release);
+	}
+
+	// Takes the job at the bottom. Owner thread only
+	//
+	// Returns nullptr if the deque is empty or a thief took the last job
+	Job* Pop() {
+		int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+
+		// Reserves the bottom job before reading top. Both MUST be sequentially
+		// consistent so that a thief cannot take the same job
+		m_Bottom.store(bottom, std::memory_order_seq_cst);
+		int64_t top = m_Top.load(std::memory_order_seq_cst);
+
+		if (top > bottom) {
+			// Deque was empty
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+
+			return nullptr;
+		}
+
+		Job* job = m_Jobs[bottom & m_Mask].load(std::memory_order_relaxed);
+
+		if (top == bottom) {
+			// Last job; races the thieves for it
+			if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				job = nullptr;
+			}
+
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		return job;
+	}
+
+	// Takes the job at the top. Any thread
+	//
+	// Returns nullptr if the deque is empty or another thread took the job
+	Job* Steal() {
+		int64_t top = m_Top.load(std::memory_order_seq_cst);
+		int64_t bottom = m_Bottom.load(std::memory_order_seq_cst);
+
+		if (top >= bottom) {
+			return nullptr;
+		}
+
+		Job* job = m_Jobs[top & m_Mask].load(std::memory_order_relaxed);
+
+		if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return nullptr;
+		}
+
+		return job;
+	}
+
+	// Number of jobs in the deque. Only exact when no other thread uses it
+	size_t GetSize() const {
+		int64_t size = m_Bottom.load(std::memory_order_relaxed) - m_Top.load(std::memory_order_relaxed);
+
+		return size > 0 ? (size_t)size : 0;
+	}
+
+	size_t GetCapacity() const { return m_Mask + 1; }
+
+private:
+	std::atomic<Job*>* m_Jobs;
+	size_t m_Mask;
+
+	// Top is written by thieves and bottom by the owner, so they are kept
+	// on separate cache lines
+	char m_PadTop[kJobCacheLineSize];
+	std::atomic<int64_t> m_Top;
+	char m_PadBottom[kJobCacheLineSize - sizeof(std::atomic<int64_t>)];
+	std::atomic<int64_t> m_Bottom;
+	char m_PadEnd[kJobCacheLineSize - sizeof(std::atomic<int64_t>)];
+
+private:
+	JobDeque(const JobDeque&);
+	JobDeque& operator=(const JobDeque&);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,318 @@
+#include "JobSystem.h"
+
+// System and index of the calling thread if it is a worker
+static thread_local JobSystem* s_WorkerSystem = nullptr;
+static thread_local int s_WorkerIndex = -1;
+
+//--------------------------------------------------
+//
+// JobCounter
+//
+//--------------------------------------------------
+JobCounter::JobCounter() {
+	m_Count = 0;
+	m_Lock = 0;
+	m_Waiting = nullptr;
+}
+
+JobCounter::~JobCounter() {
+	ASSERT(IsDone());
+}
+
+bool JobCounter::IsDone() const {
+	return m_Count.load() == 0 && m_Lock.load() == 0;
+}
+
+void JobCounter::Lock() {
+	while (m_Lock.exchange(1, std::memory_order_acquire) != 0) {
+		std::this_thread::yield();
+	}
+}
+
+void JobCounter::Unlock() {
+	m_Lock.store(0, std::memory_order_release);
+}
+
+//--------------------------------------------------
+//
+// JobSystem
+//
+//--------------------------------------------------
+JobSystem::JobSystem(int workerCount) {
+	ASSERT(workerCount >= 0);
+
+	m_WorkerCount = workerCount;
+	m_ThreadCount = workerCount + 1;
+
+	m_Deques = MEM_NEW JobDeque*[m_ThreadCount];
+
+	for (int i = 0; i < m_ThreadCount; ++i) {
+		m_Deques[i] = MEM_NEW JobDeque(kJobSystemJobMax);
+	}
+
+	m_Jobs = MEM_NEW Job[m_ThreadCount * kJobSystemJobMax];
+	m_NextJob = MEM_NEW size_t[m_ThreadCount];
+
+	for (int i = 0; i < m_ThreadCount; ++i) {
+		m_NextJob[i] = 0;
+	}
+
+	for (size_t i = 0; i < m_ThreadCount * kJobSystemJobMax; ++i) {
+		m_Jobs[i].busy = false;
+	}
+
+	m_PendingCount = 0;
+	m_SleepingCount = 0;
+	m_Quit = false;
+
+	m_MainThreadId = std::this_thread::get_id();
+
+	m_Workers = MEM_NEW std::thread[m_WorkerCount > 0 ? m_WorkerCount : 1];
+
+	for (int i = 0; i < m_WorkerCount; ++i) {
+		m_Workers[i] = std::thread(&JobSystem::WorkerMain, this, i + 1);
+	}
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Quit = true;
+	}
+
+	m_WakeCond.notify_all();
+
+	for (int i = 0; i < m_WorkerCount; ++i) {
+		m_Workers[i].join();
+	}
+
+	MEM_DELETE_ARR(m_Workers);
+
+	MEM_DELETE_ARR(m_NextJob);
+	MEM_DELETE_ARR(m_Jobs);
+
+	for (int i = 0; i < m_ThreadCount; ++i) {
+		MEM_DELETE(m_Deques[i]);
+	}
+
+	MEM_DELETE_ARR(m_Deques);
+}
+
+void JobSystem::Submit(JobFunc_t func, void* context, size_t begin, size_t end, JobCounter* counter) {
+	Submit(func, context, begin, end, counter, nullptr);
+}
+
+void JobSystem::Submit(JobFunc_t func, void* context, size_t begin, size_t end, JobCounter* counter,
+					   JobCounter* dependency) {
+	ASSERT(func != nullptr);
+
+	int threadIndex = GetThreadIndex();
+
+	Job* job = &m_Jobs[threadIndex * kJobSystemJobMax + m_NextJob[threadIndex]];
+
+	// Ring is full, so jobs are run here until the oldest one is done. Jobs
+	// run here may submit jobs themselves, so the slot is read again
+	while (job->busy.load(std::memory_order_acquire)) {
+		if (!RunPendingJob()) {
+			std::this_thread::yield();
+		}
+
+		job = &m_Jobs[threadIndex * kJobSystemJobMax + m_NextJob[threadIndex]];
+	}
+
+	m_NextJob[threadIndex] = (m_NextJob[threadIndex] + 1) & (kJobSystemJobMax - 1);
+
+	job->busy = true;
+	job->func = func;
+	job->context = context;
+	job->begin = begin;
+	job->end = end;
+	job->counter = counter;
+	job->next = nullptr;
+
+	if (counter != nullptr) {
+		counter->Lock();
+		++counter->m_Count;
+		counter->Unlock();
+	}
+
+	if (dependency != nullptr) {
+		dependency->Lock();
+
+		// Job is pushed by the last job of the dependency
+		if (dependency->m_Count > 0) {
+			job->next = dependency->m_Waiting;
+			dependency->m_Waiting = job;
+
+			dependency->Unlock();
+
+			return;
+		}
+
+		dependency->Unlock();
+	}
+
+	PushJob(threadIndex, job);
+}
+
+void JobSystem::Wait(JobCounter* counter) {
+	ASSERT(counter != nullptr);
+
+	int threadIndex = GetThreadIndex();
+
+	while (!counter->IsDone()) {
+		Job* job = TakeJob(threadIndex);
+
+		if (job != nullptr) {
+			RunJob(threadIndex, job);
+		}
+		else {
+			// Remaining jobs are running on other threads
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool JobSystem::RunPendingJob() {
+	int threadIndex = GetThreadIndex();
+
+	Job* job = TakeJob(threadIndex);
+
+	if (job == nullptr) {
+		return false;
+	}
+
+	RunJob(threadIndex, job);
+
+	return true;
+}
+
+void JobSystem::ParallelFor(JobFunc_t func, void* context, size_t count, size_t rangeSize) {
+	ASSERT(func != nullptr);
+	ASSERT(rangeSize > 0);
+
+	if (count == 0) {
+		return;
+	}
+
+	if (m_WorkerCount == 0 || count <= rangeSize) {
+		(*func)(context, 0, count);
+		return;
+	}
+
+	// Keeps the number of jobs within half of the ring of this thread
+	size_t rangeMax = kJobSystemJobMax / 2;
+
+	if ((count + rangeSize - 1) / rangeSize > rangeMax) {
+		rangeSize = (count + rangeMax - 1) / rangeMax;
+	}
+
+	JobCounter counter;
+
+	for (size_t begin = rangeSize; begin < count; begin += rangeSize) {
+		size_t end = begin + rangeSize < count ? begin + rangeSize : count;
+
+		Submit(func, context, begin, end, &counter);
+	}
+
+	// Runs the first range here while the workers take the others
+	(*func)(context, 0, rangeSize);
+
+	Wait(&counter);
+}
+
+void JobSystem::WorkerMain(JobSystem* system, int threadIndex) {
+	s_WorkerSystem = system;
+	s_WorkerIndex = threadIndex;
+
+	while (!system->m_Quit) {
+		Job* job = system->TakeJob(threadIndex);
+
+		if (job != nullptr) {
+			system->RunJob(threadIndex, job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(system->m_Mutex);
+
+		// Submitters only notify if a worker is sleeping, so the count is
+		// raised before the pending count is checked
+		++system->m_SleepingCount;
+
+		while (system->m_PendingCount == 0 && !system->m_Quit) {
+			system->m_WakeCond.wait(lock);
+		}
+
+		--system->m_SleepingCount;
+	}
+}
+
+int JobSystem::GetThreadIndex() const {
+	if (s_WorkerSystem == this) {
+		return s_WorkerIndex;
+	}
+
+	ASSERT(std::this_thread::get_id() == m_MainThreadId);
+
+	return 0;
+}
+
+Job* JobSystem::TakeJob(int threadIndex) {
+	Job* job = m_Deques[threadIndex]->Pop();
+
+	// Steals from the other threads, starting with the next one so that the
+	// thieves spread out
+	for (int i = 1; job == nullptr && i < m_ThreadCount; ++i) {
+		job = m_Deques[(threadIndex + i) % m_ThreadCount]->Steal();
+	}
+
+	if (job != nullptr) {
+		--m_PendingCount;
+	}
+
+	return job;
+}
+
+void JobSystem::PushJob(int threadIndex, Job* job) {
+	m_Deques[threadIndex]->Push(job);
+
+	++m_PendingCount;
+
+	if (m_SleepingCount > 0) {
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_WakeCond.notify_one();
+	}
+}
+
+void JobSystem::RunJob(int threadIndex, Job* job) {
+	(*job->func)(job->context, job->begin, job->end);
+
+	JobCounter* counter = job->counter;
+
+	// Slot may be reused by its thread from here on
+	job->busy.store(false, std::memory_order_release);
+
+	if (counter == nullptr) {
+		return;
+	}
+
+	Job* waiting = nullptr;
+
+	counter->Lock();
+
+	if (--counter->m_Count == 0) {
+		waiting = counter->m_Waiting;
+		counter->m_Waiting = nullptr;
+	}
+
+	// A waiting thread may destroy the counter right after this
+	counter->Unlock();
+
+	while (waiting != nullptr) {
+		Job* next = waiting->next;
+
+		PushJob(threadIndex, waiting);
+
+		waiting = next;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+#ifndef JOBSYSTEM_H_
+#define JOBSYSTEM_H_
+
+#include "base_include.h"
+
+#include "JobDeque.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Max number of jobs that each thread can have submitted and not finished
+//
+// Jobs are allocated from a ring on each thread. A thread that submits more
+// jobs than this runs jobs until the oldest one finishes and frees its slot
+const size_t kJobSystemJobMax = 4096;
+
+// Function run by a job on the range [begin, end) of its work items
+typedef void (*JobFunc_t)(void* context, size_t begin, size_t end);
+
+// Forward declarations
+class JobCounter;
+
+//--------------------------------------------------
+//
+// Job
+//
+// Unit of work run by the job system
+//
+//--------------------------------------------------
+struct Job {
+	JobFunc_t func;
+	void* context;
+	size_t begin;
+	size_t end;
+
+	// Decremented when the job finishes. May be nullptr
+	JobCounter* counter;
+
+	// Next job waiting for the same counter
+	Job* next;
+
+	// Set from submission until the job finishes, while its slot in the ring
+	// cannot be reused
+	std::atomic<bool> busy;
+};
+
+//--------------------------------------------------
+//
+// JobCounter
+//
+// Counts the unfinished jobs that were submitted with it
+//
+// Jobs can be submitted to run only after a counter is done, and threads
+// can wait on a counter. A counter MUST be done before it is destroyed or
+// reused
+//
+//--------------------------------------------------
+class JobCounter {
+	friend class JobSystem;
+
+public:
+	JobCounter();
+	~JobCounter();
+
+	// Returns true if all jobs submitted with the counter have finished
+	bool IsDone() const;
+
+private:
+	// Spins until this thread holds the lock of the counter
+	void Lock();
+	void Unlock();
+
+private:
+	// Only changed while the lock is held
+	std::atomic<int> m_Count;
+
+	// Held while the count or the waiting list is changed. Releasing it is
+	// the last access of a finishing job to the counter, so a counter is
+	// only done once it is released
+	std::atomic<int> m_Lock;
+
+	// Jobs waiting for the counter to be done
+	Job* m_Waiting;
+
+private:
+	JobCounter(const JobCounter&);
+	JobCounter& operator=(const JobCounter&);
+};
+
+//--------------------------------------------------
+//
+// JobSystem
+//
+// Runs jobs on a fixed set of worker threads
+//
+// Every thread has its own deque of jobs. Threads run the jobs of their own
+// deque first and steal from the other deques when it is empty. Idle workers
+// sleep until a job is submitted
+//
+// The thread that creates the system is thread 0 and runs jobs while it
+// waits. Jobs may only be submitted from that thread or from inside a job
+//
+//--------------------------------------------------
+class JobSystem {
+
+public:
+	// Creates workerCount threads in addition to the calling thread
+	//
+	// 0 runs all jobs on the calling thread when it waits
+	explicit JobSystem(int workerCount);
+	~JobSystem();
+
+	// Submits a job that calls func on [begin, end)
+	//
+	// counter is incremented now and decremented when the job finishes. May
+	// be nullptr
+	void Submit(JobFunc_t func, void* context, size_t begin, size_t end, JobCounter* counter);
+
+	// Submits a job that only starts after dependency is done
+	void Submit(JobFunc_t func, void* context, size_t begin, size_t end, JobCounter* counter,
+				JobCounter* dependency);
+
+	// Runs jobs on this thread until counter is done
+	void Wait(JobCounter* counter);
+
+	// Runs one job on this thread if there is one to take. Returns false if
+	// there was none
+	//
+	// Lets thread 0 make progress on its own jobs without blocking on a
+	// counter, since workers may be busy or absent
+	bool RunPendingJob();
+
+	// Calls func on every range of rangeSize items in [0, count) and returns
+	// once all ranges are done
+	//
+	// Ranges may run in any order and on any thread, including this one.
+	// rangeSize is raised if count needs more jobs than half of the ring
+	void ParallelFor(JobFunc_t func, void* context, size_t count, size_t rangeSize);
+
+	int GetWorkerCount() const { return m_WorkerCount; }
+
+private:
+	static void WorkerMain(JobSystem* system, int threadIndex);
+
+	// Returns the index of the calling thread in this system
+	int GetThreadIndex() const;
+
+	// Takes a job from the deque of the thread, or steals one from another
+	// thread. Returns nullptr if there are none
+	Job* TakeJob(int threadIndex);
+
+	// Adds the job to the deque of the thread and wakes up a worker
+	void PushJob(int threadIndex, Job* job);
+
+	// Runs the job, then pushes the jobs waiting for its counter if it was
+	// the last job of the counter
+	void RunJob(int threadIndex, Job* job);
+
+private:
+	std::thread* m_Workers;
+	int m_WorkerCount;
+
+	// Worker threads plus the thread that created the system
+	int m_ThreadCount;
+
+	// One deque per thread, indexed by thread index
+	JobDeque** m_Deques;
+
+	// Jobs of each thread, used as a ring. Thread i allocates from
+	// m_Jobs[i * kJobSystemJobMax]
+	Job* m_Jobs;
+	size_t* m_NextJob;
+
+	// Number of jobs in all deques
+	std::atomic<int> m_PendingCount;
+
+	// Number of workers waiting on m_WakeCond
+	std::atomic<int> m_SleepingCount;
+
+	std::mutex m_Mutex;
+	std::condition_variable m_WakeCond;
+
+	std::atomic<bool> m_Quit;
+
+	std::thread::id m_MainThreadId;
+
+private:
+	JobSystem(const JobSystem&);
+	JobSystem& operator=(const JobSystem&);
+};
+
+#endif
\ No newline at end of file
@@ -2,6 +2,176 @@
 
 #include <cmath>
 
+// Picks the widest instruction set enabled at compile time for the batched
+// AABB tests. Defining EXT_COLLISION_NO_SIMD forces the scalar version
+#if !defined(EXT_COLLISION_NO_SIMD) && defined(__AVX2__)
+	#include <immintrin.h>
+	#define COLLISION_SIMD_AVX2
+#elif !defined(EXT_COLLISION_NO_SIMD) && defined(__SSE2__)
+	#include <emmintrin.h>
+	#define COLLISION_SIMD_SSE2
+#endif
+
+
+//--------------------------------------------------
+//
+// Lane helpers
+//
+// Thin wrappers over the intrinsics so that the batched AABB test is
+// written once for both instruction sets. Comparisons return a mask with
+// all bits set in the lanes where the comparison is true
+//
+//--------------------------------------------------
+
+#if defined(COLLISION_SIMD_AVX2)
+
+typedef __m256d CollisionLane_t;
+
+const int kCollisionLaneWidth = 4;
+
+static inline CollisionLane_t LaneLoad(const double* ptr) { return _mm256_loadu_pd(ptr); }
+static inline void LaneStore(double* ptr, CollisionLane_t a) { _mm256_storeu_pd(ptr, a); }
+static inline CollisionLane_t LaneSet(double value) { return _mm256_set1_pd(value); }
+static inline CollisionLane_t LaneZero() { return _mm256_setzero_pd(); }
+
+static inline CollisionLane_t LaneSub(CollisionLane_t a, CollisionLane_t b) { return _mm256_sub_pd(a, b); }
+static inline CollisionLane_t LaneLess(CollisionLane_t a, CollisionLane_t b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+static inline CollisionLane_t LaneLessEqual(CollisionLane_t a, CollisionLane_t b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+static inline CollisionLane_t LaneEqual(CollisionLane_t a, CollisionLane_t b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+static inline CollisionLane_t LaneNotEqual(CollisionLane_t a, CollisionLane_t b) { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); }
+
+static inline CollisionLane_t LaneAnd(CollisionLane_t a, CollisionLane_t b) { return _mm256_and_pd(a, b); }
+static inline CollisionLane_t LaneOr(CollisionLane_t a, CollisionLane_t b) { return _mm256_or_pd(a, b); }
+
+// Returns b in the lanes where a is not set
+static inline CollisionLane_t LaneAndNot(CollisionLane_t a, CollisionLane_t b) { return _mm256_andnot_pd(a, b); }
+
+// Returns a in the lanes where mask is set, else b
+static inline CollisionLane_t LaneSelect(CollisionLane_t mask, CollisionLane_t a, CollisionLane_t b) { return _mm256_blendv_pd(b, a, mask); }
+
+// Bit i of the result is set if lane i of the mask is set
+static inline int LaneMoveMask(CollisionLane_t mask) { return _mm256_movemask_pd(mask); }
+
+#elif defined(COLLISION_SIMD_SSE2)
+
+typedef __m128d CollisionLane_t;
+
+const int kCollisionLaneWidth = 2;
+
+static inline CollisionLane_t LaneLoad(const double* ptr) { return _mm_loadu_pd(ptr); }
+static inline void LaneStore(double* ptr, CollisionLane_t a) { _mm_storeu_pd(ptr, a); }
+static inline CollisionLane_t LaneSet(double value) { return _mm_set1_pd(value); }
+static inline CollisionLane_t LaneZero() { return _mm_setzero_pd(); }
+
+static inline CollisionLane_t LaneSub(CollisionLane_t a, CollisionLane_t b) { return _mm_sub_pd(a, b); }
+static inline CollisionLane_t LaneLess(CollisionLane_t a, CollisionLane_t b) { return _mm_cmplt_pd(a, b); }
+static inline CollisionLane_t LaneLessEqual(CollisionLane_t a, CollisionLane_t b) { return _mm_cmple_pd(a, b); }
+static inline CollisionLane_t LaneEqual(CollisionLane_t a, CollisionLane_t b) { return _mm_cmpeq_pd(a, b); }
+static inline CollisionLane_t LaneNotEqual(CollisionLane_t a, CollisionLane_t b) { return _mm_cmpneq_pd(a, b); }
+
+static inline CollisionLane_t LaneAnd(CollisionLane_t a, CollisionLane_t b) { return _mm_and_pd(a, b); }
+static inline CollisionLane_t LaneOr(CollisionLane_t a, CollisionLane_t b) { return _mm_or_pd(a, b); }
+
+// Returns b in the lanes where a is not set
+static inline CollisionLane_t LaneAndNot(CollisionLane_t a, CollisionLane_t b) { return _mm_andnot_pd(a, b); }
+
+// Returns a in the lanes where mask is set, else b
+static inline CollisionLane_t LaneSelect(CollisionLane_t mask, CollisionLane_t a, CollisionLane_t b) {
+	return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+
+// Bit i of the result is set if lane i of the mask is set
+static inline int LaneMoveMask(CollisionLane_t mask) { return _mm_movemask_pd(mask); }
+
+#endif
+
+#if defined(COLLISION_SIMD_AVX2) || defined(COLLISION_SIMD_SSE2)
+
+// Tests kCollisionLaneWidth pairs of AABBs at once
+//
+// Gives the same result as AABBToAABB() in each lane. Returns the collision
+// mask of the lanes as bits
+static inline int TestAABBLanes(CollisionLane_t minX1, CollisionLane_t minY1, CollisionLane_t maxX1, CollisionLane_t maxY1,
+								CollisionLane_t minX2, CollisionLane_t minY2, CollisionLane_t maxX2, CollisionLane_t maxY2,
+								CollisionLane_t* mtvX, CollisionLane_t* mtvY) {
+
+	CollisionLane_t zero = LaneZero();
+
+	// AABBs with no width and height never collide
+	CollisionLane_t empty = LaneOr(LaneAnd(LaneEqual(minX1, maxX1), LaneEqual(minY1, maxY1)),
+								   LaneAnd(LaneEqual(minX2, maxX2), LaneEqual(minY2, maxY2)));
+
+	CollisionLane_t separate = LaneOr(LaneOr(LaneLess(maxX1, minX2), LaneLess(maxY1, minY2)),
+									  LaneOr(LaneLess(maxX2, minX1), LaneLess(maxY2, minY1)));
+
+	separate = LaneOr(separate, empty);
+
+	// Potential resolution offsets
+	CollisionLane_t negX = LaneSub(maxX1, minX2);
+	CollisionLane_t posX = LaneSub(maxX2, minX1);
+	CollisionLane_t negY = LaneSub(maxY1, minY2);
+	CollisionLane_t posY = LaneSub(maxY2, minY1);
+
+	// Same order of preference as AABBToAABB() when offsets are equal
+	CollisionLane_t useNegX = LaneAnd(LaneAnd(LaneLessEqual(negX, posX), LaneLessEqual(negX, negY)),
+									  LaneLessEqual(negX, posY));
+	CollisionLane_t usePosX = LaneAnd(LaneLessEqual(posX, negY), LaneLessEqual(posX, posY));
+	CollisionLane_t useNegY = LaneLessEqual(negY, posY);
+
+	CollisionLane_t x = LaneSelect(useNegX, LaneSub(zero, negX), LaneAnd(usePosX, posX));
+	CollisionLane_t y = LaneSelect(useNegY, LaneSub(zero, negY), posY);
+	y = LaneAndNot(LaneOr(useNegX, usePosX), y);
+
+	x = LaneAndNot(separate, x);
+	y = LaneAndNot(separate, y);
+
+	*mtvX = x;
+	*mtvY = y;
+
+	CollisionLane_t collision = LaneOr(LaneNotEqual(x, zero), LaneNotEqual(y, zero));
+
+	return LaneMoveMask(collision);
+}
+
+#endif
+
+// Scalar version of TestAABBLanes() for the remaining AABBs of a batch, or
+// for all AABBs if no instruction set is enabled
+static inline bool TestAABBScalar(double minX1, double minY1, double maxX1, double maxY1,
+								  double minX2, double minY2, double maxX2, double maxY2,
+								  double* mtvX, double* mtvY) {
+	*mtvX = 0.0;
+	*mtvY = 0.0;
+
+	if ((minX1 == maxX1 && minY1 == maxY1) || (minX2 == maxX2 && minY2 == maxY2)) {
+		return false;
+	}
+
+	if (maxX1 < minX2 || maxY1 < minY2 || maxX2 < minX1 || maxY2 < minY1) {
+		return false;
+	}
+
+	double negX = maxX1 - minX2;
+	double posX = maxX2 - minX1;
+	double negY = maxY1 - minY2;
+	double posY = maxY2 - minY1;
+
+	if (negX <= posX && negX <= negY && negX <= posY) {
+		*mtvX = -negX;
+	}
+	else if (posX <= negY && posX <= posY) {
+		*mtvX = posX;
+	}
+	else if (negY <= posY) {
+		*mtvY = -negY;
+	}
+	else {
+		*mtvY = posY;
+	}
+
+	return *mtvX != 0.0 || *mtvY != 0.0;
+}
+
 bool CollisionDetector::PointToAABB(const Vec2& pt, const Rect& rect) {
 	return CheckPointIntersectRect(pt.GetX(), pt.GetY(), rect); // Function from Rect.h
 }
@@ -111,6 +281,148 @@ Vec2 CollisionDetector::AABBToAABB(const Rect& rect1, const Rect& rect2) {
 	return Vec2(0.0, 0.0);
 }
 
+bool CollisionDetector::SweptAABBToAABB(const Rect& rect1, const Vec2& vel, const Rect& rect2, double* toi) {
+	ASSERT(toi != nullptr);
+
+	// Same as the line from the center of rect1 tested against rect2 grown
+	// by the half size of rect1, done one axis at a time
+
+	double min1[2] = { rect1.GetX(), rect1.GetY() };
+	double max1[2] = { rect1.GetX() + rect1.GetW(), rect1.GetY() + rect1.GetH() };
+	double min2[2] = { rect2.GetX(), rect2.GetY() };
+	double max2[2] = { rect2.GetX() + rect2.GetW(), rect2.GetY() + rect2.GetH() };
+	double move[2] = { vel.GetX(), vel.GetY() };
+
+	// Times at which the AABBs start and stop overlapping on both axes
+	double entry = -HUGE_VAL;
+	double exit = HUGE_VAL;
+
+	for (int axis = 0; axis < 2; ++axis) {
+		double axisEntry;
+		double axisExit;
+
+		if (move[axis] > 0.0) {
+			axisEntry = (min2[axis] - max1[axis]) / move[axis];
+			axisExit = (max2[axis] - min1[axis]) / move[axis];
+		}
+		else if (move[axis] < 0.0) {
+			axisEntry = (max2[axis] - min1[axis]) / move[axis];
+			axisExit = (min2[axis] - max1[axis]) / move[axis];
+		}
+		else {
+			// Never overlaps on this axis if the AABBs are apart, else
+			// always overlaps
+			if (max1[axis] <= min2[axis] || max2[axis] <= min1[axis]) {
+				return false;
+			}
+
+			continue;
+		}
+
+		entry = axisEntry > entry ? axisEntry : entry;
+		exit = axisExit < exit ? axisExit : exit;
+	}
+
+	// Touching without overlapping is not a hit, like in AABBToAABB()
+	if (entry >= exit || entry < 0.0 || entry > 1.0) {
+		return false;
+	}
+
+	*toi = entry;
+
+	return true;
+}
+
+void CollisionDetector::AABBToAABBBatch(const Rect& rect, const CollisionAABBArray& rects, int count,
+										uint8_t* collisions, double* mtvX, double* mtvY) {
+	double minX1 = rect.GetX();
+	double minY1 = rect.GetY();
+	double maxX1 = rect.GetX() + rect.GetW();
+	double maxY1 = rect.GetY() + rect.GetH();
+
+	// Local copies, as the compiler must otherwise reload the pointers after
+	// every write to collisions
+	const double* minX2 = rects.minX;
+	const double* minY2 = rects.minY;
+	const double* maxX2 = rects.maxX;
+	const double* maxY2 = rects.maxY;
+
+	int i = 0;
+
+#if defined(COLLISION_SIMD_AVX2) || defined(COLLISION_SIMD_SSE2)
+	CollisionLane_t laneMinX1 = LaneSet(minX1);
+	CollisionLane_t laneMinY1 = LaneSet(minY1);
+	CollisionLane_t laneMaxX1 = LaneSet(maxX1);
+	CollisionLane_t laneMaxY1 = LaneSet(maxY1);
+
+	for (; i + kCollisionLaneWidth <= count; i += kCollisionLaneWidth) {
+		CollisionLane_t laneMtvX;
+		CollisionLane_t laneMtvY;
+
+		int mask = TestAABBLanes(laneMinX1, laneMinY1, laneMaxX1, laneMaxY1,
+								 LaneLoad(minX2 + i), LaneLoad(minY2 + i),
+								 LaneLoad(maxX2 + i), LaneLoad(maxY2 + i),
+								 &laneMtvX, &laneMtvY);
+
+		LaneStore(mtvX + i, laneMtvX);
+		LaneStore(mtvY + i, laneMtvY);
+
+		for (int lane = 0; lane < kCollisionLaneWidth; ++lane) {
+			collisions[i + lane] = (uint8_t)((mask >> lane) & 1);
+		}
+	}
+#endif
+
+	for (; i < count; ++i) {
+		collisions[i] = TestAABBScalar(minX1, minY1, maxX1, maxY1,
+									   minX2[i], minY2[i], maxX2[i], maxY2[i],
+									   &mtvX[i], &mtvY[i]) ? 1 : 0;
+	}
+}
+
+void CollisionDetector::AABBToAABBBatch(const CollisionAABBArray& rects1, const CollisionAABBArray& rects2, int count,
+										uint8_t* collisions, double* mtvX, double* mtvY) {
+	// Local copies, as the compiler must otherwise reload the pointers after
+	// every write to collisions
+	const double* minX1 = rects1.minX;
+	const double* minY1 = rects1.minY;
+	const double* maxX1 = rects1.maxX;
+	const double* maxY1 = rects1.maxY;
+
+	const double* minX2 = rects2.minX;
+	const double* minY2 = rects2.minY;
+	const double* maxX2 = rects2.maxX;
+	const double* maxY2 = rects2.maxY;
+
+	int i = 0;
+
+#if defined(COLLISION_SIMD_AVX2) || defined(COLLISION_SIMD_SSE2)
+	for (; i + kCollisionLaneWidth <= count; i += kCollisionLaneWidth) {
+		CollisionLane_t laneMtvX;
+		CollisionLane_t laneMtvY;
+
+		int mask = TestAABBLanes(LaneLoad(minX1 + i), LaneLoad(minY1 + i),
+								 LaneLoad(maxX1 + i), LaneLoad(maxY1 + i),
+								 LaneLoad(minX2 + i), LaneLoad(minY2 + i),
+								 LaneLoad(maxX2 + i), LaneLoad(maxY2 + i),
+								 &laneMtvX, &laneMtvY);
+
+		LaneStore(mtvX + i, laneMtvX);
+		LaneStore(mtvY + i, laneMtvY);
+
+		for (int lane = 0; lane < kCollisionLaneWidth; ++lane) {
+			collisions[i + lane] = (uint8_t)((mask >> lane) & 1);
+		}
+	}
+#endif
+
+	for (; i < count; ++i) {
+		collisions[i] = TestAABBScalar(minX1[i], minY1[i], maxX1[i], maxY1[i],
+									   minX2[i], minY2[i], maxX2[i], maxY2[i],
+									   &mtvX[i], &mtvY[i]) ? 1 : 0;
+	}
+}
+
 Vec2 CollisionDetector::QuadToQuad(const Vec2 quad1[4], const Vec2 quad2[4]) {
 	Vec2 normals[8];
 
@@ -150,14 +462,22 @@ Vec2 CollisionDetector::QuadToQuad(const Vec2 quad1[4], const Vec2 quad2[4]) {
 		}
 	}
 
+	// Points the vector away from quad2 so that it moves quad1 out of quad2
+	Vec2 center1 = (quad1[0] + quad1[2]) * 0.5;
+	Vec2 center2 = (quad2[0] + quad2[2]) * 0.5;
+
+	if (Vec2::Dot(center1 - center2, normals[minOverlapNorm]) < 0.0) {
+		return normals[minOverlapNorm] * -minOverlap;
+	}
+
 	return normals[minOverlapNorm] * minOverlap;
 }
 
 CollisionProjection CollisionDetector::ProjectQuadToAxis(const Vec2 quad[4], const Vec2& axis) {
-	double min = 0.0;
-	double max = 0.0;
+	double min = Vec2::Dot(quad[0], axis);
+	double max = min;
 
-	for (int i = 0; i < 4; ++i) {
+	for (int i = 1; i < 4; ++i) {
 		double length = Vec2::Dot(quad[i], axis);
 		if (length < min) {
 			min = length;
@@ -179,10 +499,9 @@ double CollisionDetector::TestProjectionOverlap(const CollisionProjection& proj1
 		return 0.0;
 	}
 
-	if (proj1.max > proj2.min) {
-		return proj1.max - proj2.min;
-	}
-	else {
-		return proj2.max - proj1.min;
-	}
+	// Smaller of the distances to push the projections apart on either side
+	double overlap1 = proj1.max - proj2.min;
+	double overlap2 = proj2.max - proj1.min;
+
+	return overlap1 < overlap2 ? overlap1 : overlap2;
 }
\ No newline at end of file
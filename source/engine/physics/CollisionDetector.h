@@ -16,6 +16,20 @@ struct CollisionProjection {
 	double max;
 };
 
+//--------------------------------------------------
+//
+// Packed AABBs used by the batched tests
+//
+// AABB i spans from (minX[i], minY[i]) to (maxX[i], maxY[i])
+//
+//--------------------------------------------------
+struct CollisionAABBArray {
+	const double* minX;
+	const double* minY;
+	const double* maxX;
+	const double* maxY;
+};
+
 //--------------------------------------------------
 //
 // CollisionDetector
@@ -41,9 +55,35 @@ public:
 	// Parameter rect1 must be the AABB after the object moved
 	Vec2 AABBToAABB(const Rect& rect1, const Rect& rect2);
 
+	// Checks collision between an AABB moving by vel and a non moving AABB
+	//
+	// Returns true if rect1 hits rect2 during the move, and writes the
+	// fraction of vel that rect1 moves before the hit to toi
+	// Parameter rect1 must be the AABB before the object moved
+	// Returns false if the AABBs already overlap before the move, which
+	// should be tested with AABBToAABB()
+	bool SweptAABBToAABB(const Rect& rect1, const Vec2& vel, const Rect& rect2, double* toi);
+
+	// Batched versions of AABBToAABB()
+	//
+	// Element i of the outputs is the result of test i. collisions[i] is 1
+	// if AABBToAABB() would return a non-zero vector, else 0. The min
+	// translation vector is written to mtvX[i] and mtvY[i] and is w.r.t the
+	// first AABB of the test
+	//
+	// Uses AVX2 or SSE2 if enabled at compile time
+
+	// Tests the AABB against each of the packed AABBs
+	void AABBToAABBBatch(const Rect& rect, const CollisionAABBArray& rects, int count,
+						 uint8_t* collisions, double* mtvX, double* mtvY);
+
+	// Tests AABB i of rects1 against AABB i of rects2
+	void AABBToAABBBatch(const CollisionAABBArray& rects1, const CollisionAABBArray& rects2, int count,
+						 uint8_t* collisions, double* mtvX, double* mtvY);
+
 	// Checks collision between two quads of specified size
 	//
-	// Returns the min translation vector
+	// Returns the min translation vector w.r.t quad1
 	// Quads need not be axis-aligned
 	//
 	// Uses the separating axis thereoem
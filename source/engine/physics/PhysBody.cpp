@@ -1,39 +1,32 @@
 #include "PhysBody.h"
 
+#include "PhysBodyStore.h"
+
 #include "entity/Entity.h"
 
 PhysBody::PhysBody() {
-	m_Type = kPhysBodyNone;
 	m_EntityPtr = nullptr;
 
-	m_Layer = 0;
-
-	m_Origin = Vec2(0.0, 0.0);
-	m_Width = 0.0;
-	m_Height = 0.0;
+	m_Store = nullptr;
 }
 
-PhysBody::PhysBody(PhysBodyType_t type, uint16_t layer, Entity* entity) {
-	m_Type = type;
-	m_EntityPtr = entity;
+PhysBody::PhysBody(PhysBodyStore* store, PhysBodyHandle handle, Entity* entity) {
+	ASSERT(store != nullptr);
+	ASSERT(store->bodies.Contains(handle));
 
-	m_Layer = layer;
+	m_EntityPtr = entity;
 
-	m_Origin = Vec2(0.0, 0.0);
-	m_Width = 0.0;
-	m_Height = 0.0;
+	m_Store = store;
+	m_Handle = handle;
 
 	UpdateFromEntity();
 }
 
 PhysBody::~PhysBody() {
 	m_EntityPtr = nullptr;
-}
 
-void PhysBody::Update() {
-	if (m_Velocity != Vec2(0.0, 0.0)) {
-		TranslateBy(m_Velocity);
-	}
+	m_Store = nullptr;
+	m_Handle = PhysBodyHandle();
 }
 
 void PhysBody::TranslateBy(const Vec2& vec) {
@@ -49,5 +42,140 @@ void PhysBody::TranslateTo(const Vec2& vec) {
 }
 
 void PhysBody::UpdateFromEntity() {
-	m_Transform = m_EntityPtr->GetWorldTransform();
+	int index = GetIndex();
+
+	Mat3 transform = m_EntityPtr->GetWorldTransform();
+
+	m_Store->posX[index] = transform.GetRow1().GetZ();
+	m_Store->posY[index] = transform.GetRow2().GetZ();
+
+	m_Store->rotXX[index] = transform.GetRow1().GetX();
+	m_Store->rotXY[index] = transform.GetRow1().GetY();
+	m_Store->rotYX[index] = transform.GetRow2().GetX();
+	m_Store->rotYY[index] = transform.GetRow2().GetY();
+
+	WakeUp();
+}
+
+Rect PhysBody::CalcAABB() const {
+	Mat3 transform = GetTransform();
+
+	Vec2 origin = GetOrigin();
+	double width = GetWidth();
+	double height = GetHeight();
+
+	Vec3 corners[4];
+	corners[0] = transform * Vec3(-origin.GetX(), -origin.GetY(), 1.0);
+	corners[1] = transform * Vec3(-origin.GetX() + width, -origin.GetY(), 1.0);
+	corners[2] = transform * Vec3(-origin.GetX() + width, -origin.GetY() + height, 1.0);
+	corners[3] = transform * Vec3(-origin.GetX(), -origin.GetY() + height, 1.0);
+
+	double minX = corners[0].GetX();
+	double minY = corners[0].GetY();
+	double maxX = corners[0].GetX();
+	double maxY = corners[0].GetY();
+
+	for (int i = 1; i < 4; ++i) {
+		minX = corners[i].GetX() < minX ? corners[i].GetX() : minX;
+		minY = corners[i].GetY() < minY ? corners[i].GetY() : minY;
+		maxX = corners[i].GetX() > maxX ? corners[i].GetX() : maxX;
+		maxY = corners[i].GetY() > maxY ? corners[i].GetY() : maxY;
+	}
+
+	return Rect(minX, minY, maxX - minX, maxY - minY);
+}
+
+void PhysBody::WakeUp() {
+	int index = GetIndex();
+
+	m_Store->idleSteps[index] = 0;
+
+	if (m_Store->asleep[index]) {
+		m_Store->asleep[index] = 0;
+		m_Store->restingDirty = true;
+	}
+}
+
+bool PhysBody::IsAsleep() const {
+	return m_Store->asleep[GetIndex()] != 0;
+}
+
+void PhysBody::SetVelocity(const Vec2& vec) {
+	int index = GetIndex();
+
+	m_Store->velX[index] = vec.GetX();
+	m_Store->velY[index] = vec.GetY();
+
+	if (vec != Vec2(0.0, 0.0)) {
+		WakeUp();
+	}
+}
+
+void PhysBody::SetBullet(bool bullet) {
+	m_Store->bullets[GetIndex()] = bullet ? 1 : 0;
+}
+
+void PhysBody::SetOrigin(const Vec2& vec) {
+	int index = GetIndex();
+
+	m_Store->originX[index] = vec.GetX();
+	m_Store->originY[index] = vec.GetY();
+
+	WakeUp();
+}
+
+void PhysBody::SetWidth(double width) {
+	m_Store->halfW[GetIndex()] = width * 0.5;
+
+	WakeUp();
+}
+
+void PhysBody::SetHeight(double height) {
+	m_Store->halfH[GetIndex()] = height * 0.5;
+
+	WakeUp();
+}
+
+uint16_t PhysBody::GetLayer() const {
+	return m_Store->layers[GetIndex()];
+}
+
+bool PhysBody::IsBullet() const {
+	return m_Store->bullets[GetIndex()] != 0;
+}
+
+Mat3 PhysBody::GetTransform() const {
+	int index = GetIndex();
+
+	return Mat3(m_Store->rotXX[index], m_Store->rotXY[index], m_Store->posX[index],
+				m_Store->rotYX[index], m_Store->rotYY[index], m_Store->posY[index],
+				0.0, 0.0, 1.0);
+}
+
+Vec2 PhysBody::GetVelocity() const {
+	int index = GetIndex();
+
+	return Vec2(m_Store->velX[index], m_Store->velY[index]);
+}
+
+Vec2 PhysBody::GetOrigin() const {
+	int index = GetIndex();
+
+	return Vec2(m_Store->originX[index], m_Store->originY[index]);
+}
+
+double PhysBody::GetWidth() const {
+	return m_Store->halfW[GetIndex()] * 2.0;
+}
+
+double PhysBody::GetHeight() const {
+	return m_Store->halfH[GetIndex()] * 2.0;
+}
+
+int PhysBody::GetIndex() const {
+	int index = m_Store->bodies.GetIndex(m_Handle);
+
+	ASSERT(index >= 0);
+
+	return index;
 }
\ No newline at end of file
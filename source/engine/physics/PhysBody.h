@@ -5,6 +5,9 @@
 
 #include "math/Vector.h"
 #include "math/Matrix.h"
+#include "math/Rect.h"
+
+#include "container/SlotMap.h"
 
 // static - not affected by physics
 // dynamic - affected by physics
@@ -16,9 +19,16 @@ enum PhysBodyType_t {
 	kPhysBodyControlled
 };
 
+// Generational handle to a body in its world
+//
+// Unlike a PhysBody pointer, a handle to a destroyed body is detected, see
+// PhysWorld::GetBody()
+typedef SlotHandle32 PhysBodyHandle;
+
 // Forward declarations
 class Entity;
 class PhysWorld;
+struct PhysBodyStore;
 
 //--------------------------------------------------
 //
@@ -26,19 +36,23 @@ class PhysWorld;
 //
 // Object in the physics engine
 //
+// Handle to the properties of the body in the PhysBodyStore of its world.
+// The handle stays at the same address for the lifetime of the body, while
+// the properties can move within the store. The body finds its properties
+// through its PhysBodyHandle
+//
 // Child entities should NOT have a PhysBody
 //
 //--------------------------------------------------
 class PhysBody {
 	friend class PhysWorld;
+	friend struct PhysBodyStore;
 
 public:
 	PhysBody();
-	PhysBody(PhysBodyType_t type, uint16_t layer, Entity* entity);
+	PhysBody(PhysBodyStore* store, PhysBodyHandle handle, Entity* entity);
 	~PhysBody();
 
-	void Update();
-
 	// Updates the body properties using information from the entity
 	void UpdateFromEntity();
 
@@ -46,46 +60,52 @@ public:
 	void TranslateBy(const Vec2& vec);
 	void TranslateTo(const Vec2& vec);
 
-	void SetVelocity(const Vec2& vec) { m_Velocity = vec; }
+	// Calculates the AABB that bounds the transformed body
+	Rect CalcAABB() const;
 
-	void SetOrigin(const Vec2& vec) { m_Origin = vec; }
-	void SetWidth(double width) { m_Width = width; }
-	void SetHeight(double height) { m_Height = height; }
+	// Wakes the body up if it is asleep and restarts its idle count
+	//
+	// Bodies are woken up automatically when they are moved, given a
+	// velocity or resized, and when another body collides with them
+	void WakeUp();
 
-	uint16_t GetLayer() const { return m_Layer; }
+	bool IsAsleep() const;
 
-	Mat3 GetTransform() const { return m_Transform; }
+	void SetVelocity(const Vec2& vec);
 
-	Vec2 GetOrigin() const { return m_Origin; }
-	double GetWidth() const { return m_Width; }
-	double GetHeight() const { return m_Height; }
+	// Bullets are tested over their whole move each step so that they
+	// cannot pass through thin static bodies. A bullet stops at the first
+	// static body it hits
+	void SetBullet(bool bullet);
 
-	
-private:
-	Entity* m_EntityPtr;
+	void SetOrigin(const Vec2& vec);
+	void SetWidth(double width);
+	void SetHeight(double height);
 
-	PhysBodyType_t m_Type;
+	uint16_t GetLayer() const;
 
-	// Index of layer that the body is in
-	uint16_t m_Layer;
+	bool IsBullet() const;
 
-	// PhysBody list pointers
-	PhysBody* m_Next;
-	PhysBody* m_Prev;
+	Mat3 GetTransform() const;
 
-	// Point in the sprite that will be aligned to the entity
-	//
-	// Offset from the top left corner
-	Vec2 m_Origin;
+	Vec2 GetVelocity() const;
+
+	Vec2 GetOrigin() const;
+	double GetWidth() const;
+	double GetHeight() const;
+
+	PhysBodyHandle GetHandle() const { return m_Handle; }
 
-	// Transform of the entity
-	Mat3 m_Transform;
+	
+private:
+	// Index of the body properties in the store
+	int GetIndex() const;
+
+	Entity* m_EntityPtr;
 
-	Vec2 m_Velocity;
-	//Vec2 m_Acceleration;
+	PhysBodyStore* m_Store;
 
-	double m_Width;
-	double m_Height;
+	PhysBodyHandle m_Handle;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,134 @@
+#include "PhysBodyStore.h"
+
+PhysBodyStore::PhysBodyStore(int capacity): bodies(capacity) {
+	ASSERT(capacity > 0);
+
+	this->capacity = capacity;
+	size = 0;
+
+	types = MEM_NEW PhysBodyType_t[capacity];
+	layers = MEM_NEW uint16_t[capacity];
+	bullets = MEM_NEW uint8_t[capacity];
+
+	asleep = MEM_NEW uint8_t[capacity];
+	idleSteps = MEM_NEW uint16_t[capacity];
+
+	posX = MEM_NEW double[capacity];
+	posY = MEM_NEW double[capacity];
+
+	rotXX = MEM_NEW double[capacity];
+	rotXY = MEM_NEW double[capacity];
+	rotYX = MEM_NEW double[capacity];
+	rotYY = MEM_NEW double[capacity];
+
+	velX = MEM_NEW double[capacity];
+	velY = MEM_NEW double[capacity];
+
+	originX = MEM_NEW double[capacity];
+	originY = MEM_NEW double[capacity];
+
+	halfW = MEM_NEW double[capacity];
+	halfH = MEM_NEW double[capacity];
+
+	restingDirty = false;
+}
+
+PhysBodyStore::~PhysBodyStore() {
+	MEM_DELETE_ARR(halfH);
+	MEM_DELETE_ARR(halfW);
+
+	MEM_DELETE_ARR(originY);
+	MEM_DELETE_ARR(originX);
+
+	MEM_DELETE_ARR(velY);
+	MEM_DELETE_ARR(velX);
+
+	MEM_DELETE_ARR(rotYY);
+	MEM_DELETE_ARR(rotYX);
+	MEM_DELETE_ARR(rotXY);
+	MEM_DELETE_ARR(rotXX);
+
+	MEM_DELETE_ARR(posY);
+	MEM_DELETE_ARR(posX);
+
+	MEM_DELETE_ARR(idleSteps);
+	MEM_DELETE_ARR(asleep);
+
+	MEM_DELETE_ARR(bullets);
+	MEM_DELETE_ARR(layers);
+	MEM_DELETE_ARR(types);
+}
+
+int PhysBodyStore::Add(PhysBody* body) {
+	ASSERT(size < capacity);
+
+	int index = size;
+	++size;
+
+	bodies.Insert(body);
+
+	types[index] = kPhysBodyNone;
+	layers[index] = 0;
+	bullets[index] = 0;
+
+	asleep[index] = 0;
+	idleSteps[index] = 0;
+
+	posX[index] = 0.0;
+	posY[index] = 0.0;
+
+	rotXX[index] = 1.0;
+	rotXY[index] = 0.0;
+	rotYX[index] = 0.0;
+	rotYY[index] = 1.0;
+
+	velX[index] = 0.0;
+	velY[index] = 0.0;
+
+	originX[index] = 0.0;
+	originY[index] = 0.0;
+
+	halfW[index] = 0.0;
+	halfH[index] = 0.0;
+
+	return index;
+}
+
+void PhysBodyStore::Remove(int index) {
+	ASSERT(index >= 0 && index < size);
+
+	// Moves the last body the same way as the other arrays
+	bodies.RemoveAt(index);
+
+	--size;
+
+	if (index == size) {
+		return;
+	}
+
+	int last = size;
+
+	types[index] = types[last];
+	layers[index] = layers[last];
+	bullets[index] = bullets[last];
+
+	asleep[index] = asleep[last];
+	idleSteps[index] = idleSteps[last];
+
+	posX[index] = posX[last];
+	posY[index] = posY[last];
+
+	rotXX[index] = rotXX[last];
+	rotXY[index] = rotXY[last];
+	rotYX[index] = rotYX[last];
+	rotYY[index] = rotYY[last];
+
+	velX[index] = velX[last];
+	velY[index] = velY[last];
+
+	originX[index] = originX[last];
+	originY[index] = originY[last];
+
+	halfW[index] = halfW[last];
+	halfH[index] = halfH[last];
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef PHYSBODYSTORE_H_
+#define PHYSBODYSTORE_H_
+
+#include "base_include.h"
+
+#include "PhysBody.h"
+
+//--------------------------------------------------
+//
+// PhysBodyStore
+//
+// Packed structure of arrays holding the properties of all bodies in a
+// world that are used every step
+//
+// Element i of every array belongs to the same body. Bodies are packed at
+// the front of the arrays, so removing a body moves the last body into its
+// place and changes the index of that body
+//
+// Rotation is the upper left 2x2 part of the entity world transform and
+// position is its translation
+//
+//--------------------------------------------------
+struct PhysBodyStore {
+
+	explicit PhysBodyStore(int capacity);
+	~PhysBodyStore();
+
+	// Adds a body at the end of the arrays and returns its index
+	//
+	// Handle of the body is bodies.GetHandle(index)
+	int Add(PhysBody* body);
+
+	// Removes the body at the index by moving the last body into its place
+	void Remove(int index);
+
+	int capacity;
+	int size;
+
+	// PhysBody object of each body, in the same order as the other arrays
+	//
+	// Finds the index of a body from its handle as the body moves
+	SlotMap<PhysBody*, PhysBodyHandle> bodies;
+
+	PhysBodyType_t* types;
+	uint16_t* layers;
+
+	// Set if the body is swept over its whole move each step
+	uint8_t* bullets;
+
+	// Set if the body is resting. Resting bodies are not moved or tested
+	// against each other until they are woken up
+	uint8_t* asleep;
+
+	// Number of steps in a row that the body has not moved
+	uint16_t* idleSteps;
+
+	double* posX;
+	double* posY;
+
+	double* rotXX;
+	double* rotXY;
+	double* rotYX;
+	double* rotYY;
+
+	double* velX;
+	double* velY;
+
+	// Offset of the origin from the top left corner of the body
+	double* originX;
+	double* originY;
+
+	double* halfW;
+	double* halfH;
+
+	// Set when a body falls asleep, wakes up or a resting body changes, so
+	// that the world rebuilds its grid of resting bodies
+	bool restingDirty;
+
+private:
+	PhysBodyStore(const PhysBodyStore&);
+	PhysBodyStore& operator=(const PhysBodyStore&);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,276 @@
+#include "PhysBroadPhase.h"
+
+#include <cmath>
+#include <cstring>
+
+PhysBroadPhase::PhysBroadPhase(int bodyMax, double cellSize):
+m_Entries(bodyMax * kPhysBroadPhaseEntriesPerBody)
+{
+	ASSERT(bodyMax > 0);
+
+	m_BodyMax = bodyMax;
+
+	SetCellSize(cellSize);
+
+	// Uses at least twice as many buckets as bodies to keep hash collisions
+	// between cells low
+	m_BucketCount = 1;
+	while (m_BucketCount < bodyMax * 2) {
+		m_BucketCount <<= 1;
+	}
+	m_BucketMask = m_BucketCount - 1;
+
+	m_MinX = MEM_NEW double[bodyMax];
+	m_MinY = MEM_NEW double[bodyMax];
+	m_MaxX = MEM_NEW double[bodyMax];
+	m_MaxY = MEM_NEW double[bodyMax];
+
+	m_SortedCapacity = m_Entries.GetCapacity();
+	m_SortedIndices = MEM_NEW int[m_SortedCapacity];
+
+	m_BucketStart = MEM_NEW int[m_BucketCount + 1];
+
+	m_Built = false;
+}
+
+PhysBroadPhase::~PhysBroadPhase() {
+	MEM_DELETE_ARR(m_BucketStart);
+	MEM_DELETE_ARR(m_SortedIndices);
+
+	MEM_DELETE_ARR(m_MaxY);
+	MEM_DELETE_ARR(m_MaxX);
+	MEM_DELETE_ARR(m_MinY);
+	MEM_DELETE_ARR(m_MinX);
+}
+
+void PhysBroadPhase::Clear() {
+	m_Entries.Clear();
+
+	m_Built = false;
+}
+
+void PhysBroadPhase::Insert(int index, const Rect& aabb) {
+	ASSERT(index >= 0 && index < m_BodyMax);
+
+	m_MinX[index] = aabb.GetX();
+	m_MinY[index] = aabb.GetY();
+	m_MaxX[index] = aabb.GetX() + aabb.GetW();
+	m_MaxY[index] = aabb.GetY() + aabb.GetH();
+
+	int cellMinX = CalcCellCoord(m_MinX[index]);
+	int cellMinY = CalcCellCoord(m_MinY[index]);
+	int cellMaxX = CalcCellCoord(m_MaxX[index]);
+	int cellMaxY = CalcCellCoord(m_MaxY[index]);
+
+	m_Built = false;
+
+	// First entry of this body
+	size_t entryStart = m_Entries.GetSize();
+
+	for (int cellY = cellMinY; cellY <= cellMaxY; ++cellY) {
+		for (int cellX = cellMinX; cellX <= cellMaxX; ++cellX) {
+			int bucket = CalcBucket(cellX, cellY);
+
+			// Skips the bucket if another cell of this body already hashed
+			// to it, so that a body is never in a bucket twice
+			bool duplicate = false;
+
+			for (size_t i = entryStart; i < m_Entries.GetSize(); ++i) {
+				if (m_Entries[i].bucket == bucket) {
+					duplicate = true;
+					break;
+				}
+			}
+
+			if (duplicate) {
+				continue;
+			}
+
+			PhysGridEntry entry;
+			entry.bucket = bucket;
+			entry.index = index;
+
+			m_Entries.PushBack(entry);
+		}
+	}
+}
+
+void PhysBroadPhase::Build() {
+	size_t entryCount = m_Entries.GetSize();
+
+	// Sorts the body indices by bucket using a counting sort
+
+	memset((void*)m_BucketStart, 0, sizeof(int) * (m_BucketCount + 1));
+
+	for (size_t i = 0; i < entryCount; ++i) {
+		++m_BucketStart[m_Entries[i].bucket + 1];
+	}
+
+	for (int i = 0; i < m_BucketCount; ++i) {
+		m_BucketStart[i + 1] += m_BucketStart[i];
+	}
+
+	if (m_SortedCapacity < entryCount) {
+		MEM_DELETE_ARR(m_SortedIndices);
+
+		m_SortedCapacity = m_Entries.GetCapacity();
+		m_SortedIndices = MEM_NEW int[m_SortedCapacity];
+	}
+
+	// m_BucketStart[b] is used as the insertion point of bucket b, which
+	// moves it to the start of bucket b + 1. Shifted back after the loop
+	for (size_t i = 0; i < entryCount; ++i) {
+		int bucket = m_Entries[i].bucket;
+
+		m_SortedIndices[m_BucketStart[bucket]] = m_Entries[i].index;
+		++m_BucketStart[bucket];
+	}
+
+	for (int i = m_BucketCount; i > 0; --i) {
+		m_BucketStart[i] = m_BucketStart[i - 1];
+	}
+	m_BucketStart[0] = 0;
+
+	m_Built = true;
+}
+
+void PhysBroadPhase::FindPairs(DynArray<PhysPair>* pairs) {
+	ASSERT(pairs != nullptr);
+
+	pairs->Clear();
+
+	if (m_Entries.GetSize() == 0) {
+		return;
+	}
+
+	Build();
+
+	// Tests all bodies that share a bucket
+	for (int bucket = 0; bucket < m_BucketCount; ++bucket) {
+		int start = m_BucketStart[bucket];
+		int end = m_BucketStart[bucket + 1];
+
+		for (int i = start; i < end; ++i) {
+			for (int j = i + 1; j < end; ++j) {
+				int index1 = m_SortedIndices[i];
+				int index2 = m_SortedIndices[j];
+
+				if (!TestOverlap(index1, index2)) {
+					continue;
+				}
+
+				// Only reports the pair from the bucket of the cell that
+				// contains the top left corner of the overlap
+				double overlapX = m_MinX[index1] > m_MinX[index2] ? m_MinX[index1] : m_MinX[index2];
+				double overlapY = m_MinY[index1] > m_MinY[index2] ? m_MinY[index1] : m_MinY[index2];
+
+				if (CalcBucket(CalcCellCoord(overlapX), CalcCellCoord(overlapY)) != bucket) {
+					continue;
+				}
+
+				AddPair(index1, index2, pairs);
+			}
+		}
+	}
+}
+
+void PhysBroadPhase::Query(int index, const Rect& aabb, DynArray<PhysPair>* pairs) {
+	ASSERT(pairs != nullptr);
+
+	if (m_Entries.GetSize() == 0) {
+		return;
+	}
+
+	ASSERT(m_Built);
+
+	double minX = aabb.GetX();
+	double minY = aabb.GetY();
+	double maxX = aabb.GetX() + aabb.GetW();
+	double maxY = aabb.GetY() + aabb.GetH();
+
+	int cellMinX = CalcCellCoord(minX);
+	int cellMinY = CalcCellCoord(minY);
+	int cellMaxX = CalcCellCoord(maxX);
+	int cellMaxY = CalcCellCoord(maxY);
+
+	m_QueryBuckets.Clear();
+
+	for (int cellY = cellMinY; cellY <= cellMaxY; ++cellY) {
+		for (int cellX = cellMinX; cellX <= cellMaxX; ++cellX) {
+			int bucket = CalcBucket(cellX, cellY);
+
+			// Visits each bucket once even if several cells hash to it
+			bool visited = false;
+
+			for (size_t i = 0; i < m_QueryBuckets.GetSize(); ++i) {
+				if (m_QueryBuckets[i] == bucket) {
+					visited = true;
+					break;
+				}
+			}
+
+			if (visited) {
+				continue;
+			}
+
+			m_QueryBuckets.PushBack(bucket);
+
+			for (int i = m_BucketStart[bucket]; i < m_BucketStart[bucket + 1]; ++i) {
+				int other = m_SortedIndices[i];
+
+				if (maxX < m_MinX[other] || maxY < m_MinY[other] ||
+					m_MaxX[other] < minX || m_MaxY[other] < minY) {
+					continue;
+				}
+
+				// Same rule as FindPairs() so that each body is reported once
+				double overlapX = minX > m_MinX[other] ? minX : m_MinX[other];
+				double overlapY = minY > m_MinY[other] ? minY : m_MinY[other];
+
+				if (CalcBucket(CalcCellCoord(overlapX), CalcCellCoord(overlapY)) != bucket) {
+					continue;
+				}
+
+				AddPair(index, other, pairs);
+			}
+		}
+	}
+}
+
+void PhysBroadPhase::SetCellSize(double cellSize) {
+	ASSERT(cellSize > 0.0);
+
+	m_CellSize = cellSize;
+	m_InvCellSize = 1.0 / cellSize;
+}
+
+int PhysBroadPhase::CalcCellCoord(double x) const {
+	return (int)floor(x * m_InvCellSize);
+}
+
+int PhysBroadPhase::CalcBucket(int cellX, int cellY) const {
+	// Large primes spread neighbouring cells across the buckets
+	uint32_t hash = ((uint32_t)cellX * 73856093u) ^ ((uint32_t)cellY * 19349663u);
+
+	return (int)(hash & (uint32_t)m_BucketMask);
+}
+
+bool PhysBroadPhase::TestOverlap(int index1, int index2) const {
+	if (m_MaxX[index1] < m_MinX[index2] || m_MaxY[index1] < m_MinY[index2]) {
+		return false;
+	}
+
+	if (m_MaxX[index2] < m_MinX[index1] || m_MaxY[index2] < m_MinY[index1]) {
+		return false;
+	}
+
+	return true;
+}
+
+void PhysBroadPhase::AddPair(int index1, int index2, DynArray<PhysPair>* pairs) {
+	PhysPair pair;
+	pair.index1 = index1 < index2 ? index1 : index2;
+	pair.index2 = index1 < index2 ? index2 : index1;
+
+	pairs->PushBack(pair);
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#ifndef PHYSBROADPHASE_H_
+#define PHYSBROADPHASE_H_
+
+#include "base_include.h"
+
+#include "container/DynArray.h"
+#include "container/SmallVector.h"
+#include "math/Rect.h"
+
+// Default length of each side of a grid cell in world units
+const double kPhysBroadPhaseCellSizeDefault = 64.0;
+
+// Number of grid entries each body is expected to use
+const int kPhysBroadPhaseEntriesPerBody = 4;
+
+//--------------------------------------------------
+//
+// PhysPair
+//
+// Pair of body indices whose AABBs overlap
+//
+// index1 is always smaller than index2
+//
+//--------------------------------------------------
+struct PhysPair {
+	int index1;
+	int index2;
+};
+
+// Body index and the bucket of one cell that the body overlaps
+struct PhysGridEntry {
+	int bucket;
+	int index;
+};
+
+//--------------------------------------------------
+//
+// PhysBroadPhase
+//
+// Uniform grid that finds the pairs of bodies that may be colliding
+//
+// Cells are hashed into a fixed number of buckets so the grid has no bounds.
+// Each body is added to every cell that its AABB overlaps. A pair is only
+// reported by the cell containing the top left corner of the overlap between
+// the two AABBs, so each pair is reported once even if the bodies share
+// many cells
+//
+// The cell size should be about the size of the common body; bodies that are
+// much larger than a cell are added to many cells
+//
+//--------------------------------------------------
+class PhysBroadPhase {
+
+public:
+	// Indices of bodies added to the grid must be in range [0, bodyMax)
+	PhysBroadPhase(int bodyMax, double cellSize);
+	~PhysBroadPhase();
+
+	// Removes all bodies from the grid
+	void Clear();
+
+	// Adds the body with the specified index and AABB to the grid
+	//
+	// Each index must only be added once between calls to Clear()
+	void Insert(int index, const Rect& aabb);
+
+	// Sorts the bodies into their buckets
+	//
+	// Must be called after the last Insert() and before Query(). The grid
+	// can be queried until it is changed again
+	void Build();
+
+	// Builds the grid, then writes all pairs of bodies with overlapping AABBs
+	// into pairs
+	//
+	// Pairs are written in bucket order. Clears pairs before writing
+	void FindPairs(DynArray<PhysPair>* pairs);
+
+	// Adds a pair to pairs for every body in the grid whose AABB overlaps the
+	// AABB of the body with the specified index
+	//
+	// Body with the index must NOT be in this grid. Does not clear pairs
+	void Query(int index, const Rect& aabb, DynArray<PhysPair>* pairs);
+
+	// Cell size must be greater than 0
+	void SetCellSize(double cellSize);
+
+	double GetCellSize() const { return m_CellSize; }
+
+private:
+	// Returns the index of the cell along one axis that contains x
+	int CalcCellCoord(double x) const;
+
+	int CalcBucket(int cellX, int cellY) const;
+
+	// Tests if the AABBs of both bodies overlap. Touching AABBs overlap
+	bool TestOverlap(int index1, int index2) const;
+
+	// Adds the pair to pairs with the smaller index first
+	void AddPair(int index1, int index2, DynArray<PhysPair>* pairs);
+
+private:
+	int m_BodyMax;
+
+	double m_CellSize;
+	double m_InvCellSize;
+
+	// Number of buckets is a power of 2
+	int m_BucketCount;
+	int m_BucketMask;
+
+	// AABB of each body in the grid, indexed by body index
+	double* m_MinX;
+	double* m_MinY;
+	double* m_MaxX;
+	double* m_MaxY;
+
+	// One entry for every cell overlapped by each body
+	DynArray<PhysGridEntry> m_Entries;
+
+	// Body indices sorted by bucket
+	//
+	// Bodies in bucket b are in range [m_BucketStart[b], m_BucketStart[b+1])
+	int* m_SortedIndices;
+	size_t m_SortedCapacity;
+
+	int* m_BucketStart;
+
+	// True if the buckets match the bodies in the grid
+	bool m_Built;
+
+	// Buckets already visited by the current query
+	SmallVector<int, kPhysBroadPhaseEntriesPerBody> m_QueryBuckets;
+
+private:
+	// Broad phase is uncopyable
+	PhysBroadPhase(const PhysBroadPhase&);
+	PhysBroadPhase& operator=(const PhysBroadPhase&);
+};
+
+#endif
\ No newline at end of file
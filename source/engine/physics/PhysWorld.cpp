@@ -2,154 +2,601 @@
 
 #include "entity/Entity.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
-PhysWorld::PhysWorld(): m_BodyPool(kPhysWorldBodyMax) {
-	m_ListHead = nullptr;
-	m_ListTail = nullptr;
+PhysWorld::PhysWorld(): PhysWorld(kPhysWorldBodyMax) {
+
+}
+
+PhysWorld::PhysWorld(int bodyMax): 
+m_Store(bodyMax),
+m_BodyPool(bodyMax),
+m_BroadPhase(bodyMax, kPhysBroadPhaseCellSizeDefault),
+m_RestingBroadPhase(bodyMax, kPhysBroadPhaseCellSizeDefault),
+m_Pairs(bodyMax)
+{
+	m_JobSystemPtr = nullptr;
+
+	m_AABBMinX = MEM_NEW double[bodyMax];
+	m_AABBMinY = MEM_NEW double[bodyMax];
+	m_AABBMaxX = MEM_NEW double[bodyMax];
+	m_AABBMaxY = MEM_NEW double[bodyMax];
+
+	m_Quads = MEM_NEW Vec2[bodyMax * 4];
+	m_Rotated = MEM_NEW uint8_t[bodyMax];
+	m_Resolved = MEM_NEW uint8_t[bodyMax];
+
+	m_PairCapacity = m_Pairs.GetCapacity();
+
+	m_PairBounds = MEM_NEW double[m_PairCapacity * 8];
+	m_PairCollisions = MEM_NEW uint8_t[m_PairCapacity];
+	m_PairMtvX = MEM_NEW double[m_PairCapacity];
+	m_PairMtvY = MEM_NEW double[m_PairCapacity];
+	m_PairToi = MEM_NEW double[m_PairCapacity];
+
+	m_BulletContacts = MEM_NEW int[bodyMax];
+
+	for (int i = 0; i < bodyMax; ++i) {
+		m_BulletContacts[i] = -1;
+	}
 
 	memset((void*)m_LayerIgnoreMask, 0, sizeof(uint16_t) * kPhysWorldLayerMax);
 }
 
 PhysWorld::~PhysWorld() {
+	m_JobSystemPtr = nullptr;
+
+	MEM_DELETE_ARR(m_BulletContacts);
+
+	MEM_DELETE_ARR(m_PairToi);
+	MEM_DELETE_ARR(m_PairMtvY);
+	MEM_DELETE_ARR(m_PairMtvX);
+	MEM_DELETE_ARR(m_PairCollisions);
+	MEM_DELETE_ARR(m_PairBounds);
+
+	MEM_DELETE_ARR(m_Resolved);
+	MEM_DELETE_ARR(m_Rotated);
+	MEM_DELETE_ARR(m_Quads);
+
+	MEM_DELETE_ARR(m_AABBMaxY);
+	MEM_DELETE_ARR(m_AABBMaxX);
+	MEM_DELETE_ARR(m_AABBMinY);
+	MEM_DELETE_ARR(m_AABBMinX);
+
 	m_BodyPool.Clear();
 }
 
 void PhysWorld::Update() {
-	PhysBody* it = m_ListHead;
+	IntegrateBodies();
+
+	CalcBodyShapes();
+
+	UpdateRestingBroadPhase();
+
+	// Collision checking is only done for bodies with overlapping AABBs
+	FindPairs();
+
+	// Tests all pairs, on the worker threads if there are any
+	TestPairs();
+
+	// Collects the pairs that collided, sorted by body index
+	BuildContacts();
+
+	// Resolves the contacts and calls the collision callbacks in order on
+	// this thread
+	for (size_t i = 0; i < m_Contacts.GetSize(); ++i) {
+		ResolveContact(m_Contacts[i]);
+	}
+
+	UpdateSleep();
+}
+
+void PhysWorld::UpdateRestingBroadPhase() {
+	if (!m_Store.restingDirty) {
+		return;
+	}
+
+	m_RestingBroadPhase.Clear();
+
+	// Sleeping bodies do not move, so their AABBs stay valid until one of
+	// them wakes up and marks the grid dirty
+	for (int i = 0; i < m_Store.size; ++i) {
+		if (m_Store.asleep[i]) {
+			m_RestingBroadPhase.Insert(i, CalcBroadPhaseAABB(i));
+		}
+	}
+
+	m_RestingBroadPhase.Build();
+
+	m_Store.restingDirty = false;
+}
+
+void PhysWorld::FindPairs() {
+	int bodyCount = m_Store.size;
+
+	const uint8_t* asleep = m_Store.asleep;
+
+	m_BroadPhase.Clear();
+
+	for (int i = 0; i < bodyCount; ++i) {
+		if (!asleep[i]) {
+			m_BroadPhase.Insert(i, CalcBroadPhaseAABB(i));
+		}
+	}
+
+	m_BroadPhase.FindPairs(&m_Pairs);
+
+	// Sleeping bodies are never paired with each other
+	for (int i = 0; i < bodyCount; ++i) {
+		if (asleep[i]) {
+			continue;
+		}
+
+		size_t pairStart = m_Pairs.GetSize();
+
+		m_RestingBroadPhase.Query(i, CalcBroadPhaseAABB(i), &m_Pairs);
+
+		if (m_Store.types[i] != kPhysBodyStatic) {
+			continue;
+		}
+
+		// Static body that moved this step. Drops its pairs with the resting
+		// static bodies, which are never resolved
+		size_t pairCount = pairStart;
 
-	while (it != nullptr) {
-		it->Update();
+		for (size_t j = pairStart; j < m_Pairs.GetSize(); ++j) {
+			int other = m_Pairs[j].index1 == i ? m_Pairs[j].index2 : m_Pairs[j].index1;
 
-		// Collision checking
-		PhysBody* it2 = it->m_Next;
-		while (it2 != nullptr) {
-			CheckCollision(it, it2);
-			it2 = it2->m_Next;
+			if (m_Store.types[other] != kPhysBodyStatic) {
+				m_Pairs[pairCount] = m_Pairs[j];
+				++pairCount;
+			}
 		}
 
-		it = it->m_Next;
+		while (m_Pairs.GetSize() > pairCount) {
+			m_Pairs.PopBack();
+		}
 	}
 }
 
-void PhysWorld::CheckCollision(PhysBody* body1, PhysBody* body2) {
+void PhysWorld::UpdateSleep() {
+	int bodyCount = m_Store.size;
 
-	// Stops collision detection if both bodies are on layers that ignore each
-	// other
-	if ((m_LayerIgnoreMask[body1->m_Layer] & (1 << body2->m_Layer)) != 0) {
-		return;
+	const PhysBodyType_t* types = m_Store.types;
+	const double* velX = m_Store.velX;
+	const double* velY = m_Store.velY;
+	uint8_t* asleep = m_Store.asleep;
+	uint16_t* idleSteps = m_Store.idleSteps;
+
+	// Bodies that moved this step were woken up, which reset their count
+	for (int i = 0; i < bodyCount; ++i) {
+		if (asleep[i]) {
+			continue;
+		}
+
+		if (velX[i] != 0.0 || velY[i] != 0.0) {
+			idleSteps[i] = 0;
+			continue;
+		}
+
+		++idleSteps[i];
+
+		uint16_t sleepSteps = types[i] == kPhysBodyStatic ? 1 : kPhysWorldSleepSteps;
+
+		if (idleSteps[i] >= sleepSteps) {
+			asleep[i] = 1;
+			m_Store.restingDirty = true;
+		}
+	}
+}
+
+void PhysWorld::IntegrateBodies() {
+	int bodyCount = m_Store.size;
+
+	double* posX = m_Store.posX;
+	double* posY = m_Store.posY;
+	const double* velX = m_Store.velX;
+	const double* velY = m_Store.velY;
+
+	for (int i = 0; i < bodyCount; ++i) {
+		posX[i] += velX[i];
+		posY[i] += velY[i];
 	}
 
-	Mat3 transform1 = body1->GetTransform();
+	// Entities are only touched if their body moved. Bodies belong to root
+	// entities, so the world position of the body is the entity position
+	for (int i = 0; i < bodyCount; ++i) {
+		if (velX[i] != 0.0 || velY[i] != 0.0) {
+			m_Store.bodies[i]->m_EntityPtr->TranslateTo(Vec2(posX[i], posY[i]));
+		}
+	}
+}
 
-	Vec2 origin1 = body1->m_Origin;
-	double width1 = body1->m_Width;
-	double height1 = body1->m_Height;
+void PhysWorld::CalcBodyShapes() {
+	int bodyCount = m_Store.size;
+
+	const double* posX = m_Store.posX;
+	const double* posY = m_Store.posY;
+	const double* rotXX = m_Store.rotXX;
+	const double* rotXY = m_Store.rotXY;
+	const double* rotYX = m_Store.rotYX;
+	const double* rotYY = m_Store.rotYY;
+	const double* originX = m_Store.originX;
+	const double* originY = m_Store.originY;
+	const double* halfW = m_Store.halfW;
+	const double* halfH = m_Store.halfH;
+
+	// Same calculation for rotated and unrotated bodies so that the loop has
+	// no branches
+	for (int i = 0; i < bodyCount; ++i) {
+		// Center of the body relative to the origin, before rotation
+		double localX = halfW[i] - originX[i];
+		double localY = halfH[i] - originY[i];
+
+		double centerX = posX[i] + rotXX[i] * localX + rotXY[i] * localY;
+		double centerY = posY[i] + rotYX[i] * localX + rotYY[i] * localY;
+
+		// Half extents of the rotated body along the world axes
+		double extentX = fabs(rotXX[i]) * halfW[i] + fabs(rotXY[i]) * halfH[i];
+		double extentY = fabs(rotYX[i]) * halfW[i] + fabs(rotYY[i]) * halfH[i];
+
+		m_AABBMinX[i] = centerX - extentX;
+		m_AABBMinY[i] = centerY - extentY;
+		m_AABBMaxX[i] = centerX + extentX;
+		m_AABBMaxY[i] = centerY + extentY;
+
+		m_Rotated[i] = (rotXY[i] != 0.0 || rotYX[i] != 0.0) ? 1 : 0;
+		m_Resolved[i] = 0;
+	}
 
-	// Calculate quad coordinates for body1
-	Vec3 topLeft1 = transform1 * Vec3(		-origin1.GetX(),
-											-origin1.GetY(), 1.0);
-	Vec3 topRight1 = transform1 * Vec3( 	-origin1.GetX() + width1,
-											-origin1.GetY(), 1.0);
-	Vec3 botRight1 = transform1 * Vec3( 	-origin1.GetX() + width1,
-											-origin1.GetY() + height1, 1.0);
-	Vec3 botLeft1 = transform1 * Vec3( 		-origin1.GetX(),
-											-origin1.GetY() + height1, 1.0);
+	// Corners in clockwise order from the top left, as used by QuadToQuad()
+	for (int i = 0; i < bodyCount; ++i) {
+		double left = -originX[i];
+		double top = -originY[i];
+		double right = left + halfW[i] * 2.0;
+		double bottom = top + halfH[i] * 2.0;
 
-	Mat3 transform2 = body2->GetTransform();
+		Vec2* quad = &m_Quads[i * 4];
 
-	Vec2 origin2 = body2->m_Origin;
-	double width2 = body2->m_Width;
-	double height2 = body2->m_Height;
+		quad[0] = Vec2(posX[i] + rotXX[i] * left + rotXY[i] * top, posY[i] + rotYX[i] * left + rotYY[i] * top);
+		quad[1] = Vec2(posX[i] + rotXX[i] * right + rotXY[i] * top, posY[i] + rotYX[i] * right + rotYY[i] * top);
+		quad[2] = Vec2(posX[i] + rotXX[i] * right + rotXY[i] * bottom, posY[i] + rotYX[i] * right + rotYY[i] * bottom);
+		quad[3] = Vec2(posX[i] + rotXX[i] * left + rotXY[i] * bottom, posY[i] + rotYX[i] * left + rotYY[i] * bottom);
+	}
+}
 
-	// Calculate quad coordinates for body2
-	Vec3 topLeft2 = transform2 * Vec3(		-origin2.GetX(),
-											-origin2.GetY(), 1.0);
-	Vec3 topRight2 = transform2 * Vec3( 	-origin2.GetX() + width1,
-											-origin2.GetY(), 1.0);
-	Vec3 botRight2 = transform2 * Vec3( 	-origin2.GetX() + width1,
-											-origin2.GetY() + height1, 1.0);
-	Vec3 botLeft2 = transform2 * Vec3( 		-origin2.GetX(),
-											-origin2.GetY() + height1, 1.0);
+void PhysWorld::SetCellSize(double cellSize) {
+	m_BroadPhase.SetCellSize(cellSize);
+	m_RestingBroadPhase.SetCellSize(cellSize);
 
+	m_Store.restingDirty = true;
+}
 
-	// Use quad collision detection if either bodies are rotated
-	bool useQuadCol = false;
+void PhysWorld::SetJobSystem(JobSystem* jobSystem) {
+	m_JobSystemPtr = jobSystem;
+}
 
-	if (transform1.GetRow1().GetY() != 0.0 ||
-		transform1.GetRow2().GetX() != 0.0 ||
-		transform2.GetRow1().GetY() != 0.0 ||
-		transform2.GetRow2().GetX() != 0.0) {
+// Returns true if a collision between the types moves one of the bodies
+//
+// Only static-dynamic and static-controlled collisions are resolved
+static bool CheckResolvable(PhysBodyType_t type1, PhysBodyType_t type2) {
+	if (type1 == kPhysBodyStatic) {
+		return type2 == kPhysBodyDynamic || type2 == kPhysBodyControlled;
+	}
 
-		useQuadCol = true;
+	if (type2 == kPhysBodyStatic) {
+		return type1 == kPhysBodyDynamic || type1 == kPhysBodyControlled;
 	}
 
-	// Minimum translation vector
-	Vec2 mtv;
+	return false;
+}
+
+// Orders contacts by the indices of their bodies
+static bool CompareContacts(const PhysContact& contact1, const PhysContact& contact2) {
+	if (contact1.index1 != contact2.index1) {
+		return contact1.index1 < contact2.index1;
+	}
+
+	return contact1.index2 < contact2.index2;
+}
+
+Rect PhysWorld::CalcBroadPhaseAABB(int index) const {
+	double minX = m_AABBMinX[index];
+	double minY = m_AABBMinY[index];
+	double maxX = m_AABBMaxX[index];
+	double maxY = m_AABBMaxY[index];
+
+	if (m_Store.bullets[index]) {
+		// Grows the AABB back to where the bullet started the step
+		double velX = m_Store.velX[index];
+		double velY = m_Store.velY[index];
+
+		minX = velX > 0.0 ? minX - velX : minX;
+		maxX = velX < 0.0 ? maxX - velX : maxX;
+		minY = velY > 0.0 ? minY - velY : minY;
+		maxY = velY < 0.0 ? maxY - velY : maxY;
+	}
+
+	return Rect(minX, minY, maxX - minX, maxY - minY);
+}
+
+static void TestPairRangeTask(void* context, size_t begin, size_t end) {
+	((PhysWorld*)context)->TestPairRange(begin, end);
+}
 
-	// Collision detection
-	if (!useQuadCol) {
+void PhysWorld::TestPairs() {
+	size_t pairCount = m_Pairs.GetSize();
 
-		// Use AABB collision
+	if (m_PairCapacity < pairCount) {
+		MEM_DELETE_ARR(m_PairToi);
+		MEM_DELETE_ARR(m_PairMtvY);
+		MEM_DELETE_ARR(m_PairMtvX);
+		MEM_DELETE_ARR(m_PairCollisions);
+		MEM_DELETE_ARR(m_PairBounds);
 
-		Rect rect1(topLeft1.GetX(), topLeft1.GetY(), width1, height1);
-		Rect rect2(topLeft2.GetX(), topLeft2.GetY(), width2, height2);
+		m_PairCapacity = m_Pairs.GetCapacity();
 
-		mtv = m_Detector.AABBToAABB(rect1, rect2);
+		m_PairBounds = MEM_NEW double[m_PairCapacity * 8];
+		m_PairCollisions = MEM_NEW uint8_t[m_PairCapacity];
+		m_PairMtvX = MEM_NEW double[m_PairCapacity];
+		m_PairMtvY = MEM_NEW double[m_PairCapacity];
+		m_PairToi = MEM_NEW double[m_PairCapacity];
+	}
+
+	// Each pair only writes its own results, so the results are the same
+	// however the pairs are split between threads
+	if (m_JobSystemPtr != nullptr) {
+		m_JobSystemPtr->ParallelFor(&TestPairRangeTask, (void*)this, pairCount, kPhysWorldPairRangeSize);
 	}
 	else {
+		TestPairRange(0, pairCount);
+	}
+}
+
+void PhysWorld::TestPairRange(size_t begin, size_t end) {
+	size_t count = end - begin;
+
+	// Packs the AABBs of both bodies of each pair. Pairs with rotated bodies
+	// are packed as well and their results are replaced below
+	double* minX1 = m_PairBounds + begin;
+	double* minY1 = m_PairBounds + m_PairCapacity + begin;
+	double* maxX1 = m_PairBounds + m_PairCapacity * 2 + begin;
+	double* maxY1 = m_PairBounds + m_PairCapacity * 3 + begin;
+	double* minX2 = m_PairBounds + m_PairCapacity * 4 + begin;
+	double* minY2 = m_PairBounds + m_PairCapacity * 5 + begin;
+	double* maxX2 = m_PairBounds + m_PairCapacity * 6 + begin;
+	double* maxY2 = m_PairBounds + m_PairCapacity * 7 + begin;
+
+	for (size_t i = 0; i < count; ++i) {
+		int index1 = m_Pairs[begin + i].index1;
+		int index2 = m_Pairs[begin + i].index2;
+
+		minX1[i] = m_AABBMinX[index1];
+		minY1[i] = m_AABBMinY[index1];
+		maxX1[i] = m_AABBMaxX[index1];
+		maxY1[i] = m_AABBMaxY[index1];
+
+		minX2[i] = m_AABBMinX[index2];
+		minY2[i] = m_AABBMinY[index2];
+		maxX2[i] = m_AABBMaxX[index2];
+		maxY2[i] = m_AABBMaxY[index2];
+	}
 
-		// Use Quad Collision
+	CollisionAABBArray rects1;
+	rects1.minX = minX1;
+	rects1.minY = minY1;
+	rects1.maxX = maxX1;
+	rects1.maxY = maxY1;
 
-		Vec2 quad1[4];
-		quad1[0] = Vec2(topLeft1.GetX(), topLeft1.GetY());
-		quad1[1] = Vec2(topRight1.GetX(), topRight1.GetY());
-		quad1[2] = Vec2(botRight1.GetX(), botRight1.GetY());
-		quad1[3] = Vec2(botLeft1.GetX(), botLeft1.GetY());
+	CollisionAABBArray rects2;
+	rects2.minX = minX2;
+	rects2.minY = minY2;
+	rects2.maxX = maxX2;
+	rects2.maxY = maxY2;
+
+	m_Detector.AABBToAABBBatch(rects1, rects2, (int)count,
+							   m_PairCollisions + begin, m_PairMtvX + begin, m_PairMtvY + begin);
+
+	for (size_t i = begin; i < end; ++i) {
+		int index1 = m_Pairs[i].index1;
+		int index2 = m_Pairs[i].index2;
+
+		// Drops pairs on layers that ignore each other and pairs whose
+		// collision would not be resolved
+		if ((m_LayerIgnoreMask[m_Store.layers[index1]] & (1 << m_Store.layers[index2])) != 0 ||
+			!CheckResolvable(m_Store.types[index1], m_Store.types[index2])) {
+
+			m_PairCollisions[i] = 0;
+			continue;
+		}
 
-		Vec2 quad2[4];
-		quad2[0] = Vec2(topLeft2.GetX(), topLeft2.GetY());
-		quad2[1] = Vec2(topRight2.GetX(), topRight2.GetY());
-		quad2[2] = Vec2(botRight2.GetX(), botRight2.GetY());
-		quad2[3] = Vec2(botLeft2.GetX(), botLeft2.GetY());
+		m_PairToi[i] = -1.0;
 
-		mtv = m_Detector.QuadToQuad(quad1, quad2);
+		// Use quad collision if either bodies are rotated
+		if (m_Rotated[index1] || m_Rotated[index2]) {
+			Vec2 mtv = m_Detector.QuadToQuad(&m_Quads[index1 * 4], &m_Quads[index2 * 4]);
+
+			m_PairCollisions[i] = (mtv != Vec2(0.0, 0.0)) ? 1 : 0;
+			m_PairMtvX[i] = mtv.GetX();
+			m_PairMtvY[i] = mtv.GetY();
+		}
+
+		// Pair is resolvable, so the body that is not a bullet is static
+		if (m_Store.bullets[index1] && m_Store.types[index1] != kPhysBodyStatic) {
+			TestBulletPair(i, index1, index2);
+		}
+		else if (m_Store.bullets[index2] && m_Store.types[index2] != kPhysBodyStatic) {
+			TestBulletPair(i, index2, index1);
+		}
 	}
+}
+
+void PhysWorld::TestBulletPair(size_t pairIndex, int bulletIndex, int staticIndex) {
+	Vec2 vel(m_Store.velX[bulletIndex], m_Store.velY[bulletIndex]);
+
+	// Bullet AABB before it moved this step
+	Rect start(m_AABBMinX[bulletIndex] - vel.GetX(), m_AABBMinY[bulletIndex] - vel.GetY(),
+			   m_AABBMaxX[bulletIndex] - m_AABBMinX[bulletIndex], m_AABBMaxY[bulletIndex] - m_AABBMinY[bulletIndex]);
+
+	Rect rect(m_AABBMinX[staticIndex], m_AABBMinY[staticIndex],
+			  m_AABBMaxX[staticIndex] - m_AABBMinX[staticIndex], m_AABBMaxY[staticIndex] - m_AABBMinY[staticIndex]);
+
+	double toi = 0.0;
 
-	// Returns if there is no collision
-	if (mtv == Vec2(0.0, 0.0)) {
+	// Keeps the result of the normal test if the bullet started the step
+	// inside the static body
+	if (!m_Detector.SweptAABBToAABB(start, vel, rect, &toi)) {
 		return;
 	}
 
-	// True if a collision has occurred
-	bool collision = false;
+	// Moves the bullet back to where it hit the static body
+	Vec2 mtv = vel * -(1.0 - toi);
 
+	if (bulletIndex == m_Pairs[pairIndex].index2) {
+		mtv = -mtv;
+	}
 
-	// Collision resolution for static-dynamic and static-controlled
+	m_PairCollisions[pairIndex] = 1;
+	m_PairMtvX[pairIndex] = mtv.GetX();
+	m_PairMtvY[pairIndex] = mtv.GetY();
+	m_PairToi[pairIndex] = toi;
+}
+
+void PhysWorld::BuildContacts() {
+	m_Contacts.Clear();
+
+	for (size_t i = 0; i < m_Pairs.GetSize(); ++i) {
+		if (!m_PairCollisions[i]) {
+			continue;
+		}
+
+		PhysContact contact;
+		contact.index1 = m_Pairs[i].index1;
+		contact.index2 = m_Pairs[i].index2;
+		contact.mtv = Vec2(m_PairMtvX[i], m_PairMtvY[i]);
+		contact.toi = m_PairToi[i];
+
+		m_Contacts.PushBack(contact);
+	}
+
+	// Resolution order only depends on the bodies, not on the order that the
+	// broad phase found the pairs in
+	if (m_Contacts.GetSize() > 1) {
+		std::sort(&m_Contacts[0], &m_Contacts[0] + m_Contacts.GetSize(), &CompareContacts);
+	}
+
+	// Finds the earliest hit of each bullet. Contacts are sorted, so the
+	// first of equally early hits is kept
+	for (size_t i = 0; i < m_Contacts.GetSize(); ++i) {
+		if (m_Contacts[i].toi < 0.0) {
+			continue;
+		}
+
+		int bullet = GetContactBullet(m_Contacts[i]);
+
+		int earliest = m_BulletContacts[bullet];
+
+		if (earliest < 0 || m_Contacts[i].toi < m_Contacts[earliest].toi) {
+			m_BulletContacts[bullet] = (int)i;
+		}
+	}
+
+	// Removes the later hits while keeping the order of the contacts
+	size_t contactCount = 0;
+
+	for (size_t i = 0; i < m_Contacts.GetSize(); ++i) {
+		if (m_Contacts[i].toi >= 0.0) {
+			int bullet = GetContactBullet(m_Contacts[i]);
+
+			if (m_BulletContacts[bullet] != (int)i) {
+				continue;
+			}
+		}
 
-	if (body1->m_Type == kPhysBodyStatic) {
-		if (body2->m_Type == kPhysBodyDynamic || 
-			body2->m_Type == kPhysBodyControlled) {
+		m_Contacts[contactCount] = m_Contacts[i];
+		++contactCount;
+	}
 
-			body2->TranslateBy(-mtv);
+	for (size_t i = 0; i < contactCount; ++i) {
+		if (m_Contacts[i].toi >= 0.0) {
+			int bullet = GetContactBullet(m_Contacts[i]);
 
-			collision = true;
+			m_BulletContacts[bullet] = -1;
 		}
 	}
-	else if (body2->m_Type == kPhysBodyStatic) {
-		if (body1->m_Type == kPhysBodyDynamic || 
-			body1->m_Type == kPhysBodyControlled) {
 
-			body1->TranslateBy(mtv);
+	while (m_Contacts.GetSize() > contactCount) {
+		m_Contacts.PopBack();
+	}
+}
+
+int PhysWorld::GetContactBullet(const PhysContact& contact) const {
+	return m_Store.types[contact.index1] == kPhysBodyStatic ? contact.index2 : contact.index1;
+}
 
-			collision = true;
+void PhysWorld::ResolveContact(const PhysContact& contact) {
+	int index1 = contact.index1;
+	int index2 = contact.index2;
+
+	PhysBody* body1 = m_Store.bodies[index1];
+	PhysBody* body2 = m_Store.bodies[index2];
+
+	// Minimum translation vector
+	Vec2 mtv = contact.mtv;
+
+	// Result of the test is out of date if an earlier contact in this step
+	// moved either body
+	if (m_Resolved[index1] || m_Resolved[index2]) {
+		if (m_Rotated[index1] || m_Rotated[index2]) {
+			mtv = m_Detector.QuadToQuad(&m_Quads[index1 * 4], &m_Quads[index2 * 4]);
 		}
+		else {
+			Rect rect1(m_AABBMinX[index1], m_AABBMinY[index1],
+					   m_AABBMaxX[index1] - m_AABBMinX[index1], m_AABBMaxY[index1] - m_AABBMinY[index1]);
+			Rect rect2(m_AABBMinX[index2], m_AABBMinY[index2],
+					   m_AABBMaxX[index2] - m_AABBMinX[index2], m_AABBMaxY[index2] - m_AABBMinY[index2]);
+
+			mtv = m_Detector.AABBToAABB(rect1, rect2);
+		}
+
+		// Returns if there is no collision
+		if (mtv == Vec2(0.0, 0.0)) {
+			return;
+		}
+	}
+
+	// Collision resolution for static-dynamic and static-controlled
+	//
+	// Moving the body that is not static also wakes it up
+
+	if (m_Store.types[index1] == kPhysBodyStatic) {
+		body2->TranslateBy(-mtv);
+		MoveBodyShape(index2, -mtv);
 	}
+	else {
+		body1->TranslateBy(mtv);
+		MoveBodyShape(index1, mtv);
+	}
+
+	body1->m_EntityPtr->OnCollision(body2->m_EntityPtr);
+	body2->m_EntityPtr->OnCollision(body1->m_EntityPtr);
+}
+
+void PhysWorld::MoveBodyShape(int index, const Vec2& vec) {
+	m_AABBMinX[index] += vec.GetX();
+	m_AABBMinY[index] += vec.GetY();
+	m_AABBMaxX[index] += vec.GetX();
+	m_AABBMaxY[index] += vec.GetY();
+
+	Vec2* quad = &m_Quads[index * 4];
 
-	if (collision) {
-		body1->m_EntityPtr->OnCollision(body2->m_EntityPtr);
-		body2->m_EntityPtr->OnCollision(body1->m_EntityPtr);
+	for (int i = 0; i < 4; ++i) {
+		quad[i] += vec;
 	}
+
+	m_Resolved[index] = 1;
 }
 
 void PhysWorld::AddLayerIgnore(uint16_t layer1, uint16_t layer2) {
@@ -165,50 +612,46 @@ void PhysWorld::ResetAllLayerIgnore() {
 }
 
 PhysBody* PhysWorld::CreateBody(PhysBodyType_t type, uint16_t layer, Entity* entity) {
-	PhysBody* mem = m_BodyPool.Alloc();
-
-	PhysBody* body = new(mem) PhysBody(type, layer, entity);
+	ASSERT(layer < kPhysWorldLayerMax);
 
-	// Adds the body to the list
+	PhysBody* mem = m_BodyPool.Alloc();
 
-	if (m_ListHead == nullptr) {
-		body->m_Next = nullptr;
-		body->m_Prev = nullptr;
+	int index = m_Store.Add(mem);
+	m_Store.types[index] = type;
+	m_Store.layers[index] = layer;
 
-		m_ListHead = body;
-		m_ListTail = body;
-	}
-	else {
-		body->m_Next = nullptr;
-		body->m_Prev = m_ListTail;
-		m_ListTail->m_Next = body;
-
-		m_ListTail = body;
-	}
+	PhysBody* body = new(mem) PhysBody(&m_Store, m_Store.bodies.GetHandle(index), entity);
 
 	return body;
 }
 
 void PhysWorld::DestroyBody(PhysBody* body) {
-	// Removes the body from the list
+	int index = body->GetIndex();
+	int last = m_Store.size - 1;
 
-	if (m_ListHead == body) {
-		m_ListHead = body->m_Next;
-	}
-	if (m_ListTail == body) {
-		m_ListTail = body->m_Prev;
-	}
-	if (body->m_Prev != nullptr) {
-		body->m_Prev->m_Next = body->m_Next;
-	}
-	if (body->m_Next != nullptr) {
-		body->m_Next->m_Prev = body->m_Prev;
+	// Resting grid refers to the bodies by their index
+	if (m_Store.asleep[index] || m_Store.asleep[last]) {
+		m_Store.restingDirty = true;
 	}
 
-	body->m_Next = nullptr;
-	body->m_Prev = nullptr;
+	// Moves the last body of the store into the place of this body
+	m_Store.Remove(index);
 
 	body->~PhysBody();
 
 	m_BodyPool.Dealloc(body);
+}
+
+void PhysWorld::DestroyBody(PhysBodyHandle handle) {
+	PhysBody* body = GetBody(handle);
+
+	if (body != nullptr) {
+		DestroyBody(body);
+	}
+}
+
+PhysBody* PhysWorld::GetBody(PhysBodyHandle handle) {
+	PhysBody** body = m_Store.bodies.Find(handle);
+
+	return body != nullptr ? *body : nullptr;
 }
\ No newline at end of file
@@ -4,14 +4,52 @@
 #include "base_include.h"
 
 #include "allocator/PoolAllocator.h"
+#include "container/DynArray.h"
+#include "container/SmallVector.h"
+#include "job/JobSystem.h"
 
 #include "PhysBody.h"
+#include "PhysBodyStore.h"
+#include "PhysBroadPhase.h"
 #include "CollisionDetector.h"
 
 
 const int kPhysWorldBodyMax = 1024;
 const int kPhysWorldLayerMax = 16;
 
+// Number of pairs tested together by one thread
+//
+// Multiple of the SIMD width used by the batched AABB test
+const size_t kPhysWorldPairRangeSize = 256;
+
+// Number of steps that a dynamic or controlled body must stay still before
+// it falls asleep
+//
+// Static bodies fall asleep after one step without moving
+const uint16_t kPhysWorldSleepSteps = 60;
+
+// Number of contacts per step that are stored without allocating
+const int kPhysWorldContactInline = 64;
+
+//--------------------------------------------------
+//
+// Pair of bodies whose collision will be resolved in the current step
+//
+// Bodies are specified by their index in the store
+//
+//--------------------------------------------------
+struct PhysContact {
+	int index1;
+	int index2;
+
+	// Min translation vector w.r.t body1 when the pair was tested
+	Vec2 mtv;
+
+	// Fraction of the move of the bullet before it hit the other body, if
+	// the pair was swept. Negative for other pairs
+	double toi;
+};
+
 // Forward declarations
 class Entity;
 
@@ -26,10 +64,34 @@ class PhysWorld {
 
 public:
 	PhysWorld();
+
+	// World can hold up to bodyMax bodies
+	explicit PhysWorld(int bodyMax);
+
 	~PhysWorld();
 
+	// Moves all bodies, then tests and resolves collisions between bodies
+	// that are near each other
+	//
+	// Bodies are processed in the order of the store. Sleeping bodies are
+	// only tested against bodies that are awake
 	void Update();
 
+	// Sets the size of each cell in the broad phase grid
+	//
+	// Should be about the size of the most common body
+	void SetCellSize(double cellSize);
+
+	double GetCellSize() const { return m_BroadPhase.GetCellSize(); }
+
+	// Sets the job system that the pair tests are split across
+	//
+	// nullptr tests all pairs on the thread calling Update(). Results are the
+	// same for any number of threads
+	void SetJobSystem(JobSystem* jobSystem);
+
+	JobSystem* GetJobSystem() const { return m_JobSystemPtr; }
+
 	// Causes the bodies on the 2 layers to ignore each other
 	void AddLayerIgnore(uint16_t layer1, uint16_t layer2);
 
@@ -37,20 +99,131 @@ public:
 	void ResetAllLayerIgnore();
 
 	PhysBody* CreateBody(PhysBodyType_t type, uint16_t layer, Entity* entity);
-	void DestroyBody(PhysBody* body); 
+	void DestroyBody(PhysBody* body);
+
+	// Does nothing if the body was already destroyed
+	void DestroyBody(PhysBodyHandle handle);
+
+	// Returns the body of the handle, or nullptr if it was destroyed
+	PhysBody* GetBody(PhysBodyHandle handle);
+
+public:
+	// Tests the pairs in range [begin, end)
+	//
+	// Called by the jobs of TestPairs(). Should not be called directly
+	void TestPairRange(size_t begin, size_t end);
 
 private:
-	void CheckCollision(PhysBody* body1, PhysBody* body2);
+	// Moves all bodies by their velocity and moves their entities to match
+	void IntegrateBodies();
+
+	// Rebuilds the grid of resting bodies if any body fell asleep, woke up
+	// or was destroyed since it was last built
+	void UpdateRestingBroadPhase();
+
+	// Finds the candidate pairs between bodies that are awake, and between
+	// bodies that are awake and resting bodies
+	void FindPairs();
+
+	// Counts the steps that each body has not moved for and puts the bodies
+	// that stayed still long enough to sleep
+	void UpdateSleep();
+
+	// Calculates the world quad, AABB and rotated flag of every body
+	//
+	// Done once per step after the bodies are moved. Collision tests only
+	// read these results
+	void CalcBodyShapes();
+
+	// Returns the AABB of the body added to the broad phase
+	//
+	// AABB of a bullet covers its whole move in the current step
+	Rect CalcBroadPhaseAABB(int index) const;
+
+	// Sweeps the bullet of the pair against the static body of the pair
+	//
+	// Only replaces the result of the pair if the bullet hits the static body
+	// during its move
+	void TestBulletPair(size_t pairIndex, int bulletIndex, int staticIndex);
+
+	// Tests all pairs found by the broad phase for collisions
+	//
+	// Only reads the body shapes, which are not changed until the contacts
+	// are resolved
+	void TestPairs();
+
+	// Builds the contact list from the pairs that collided
+	void BuildContacts();
+
+	// Returns the index of the bullet of a swept contact
+	int GetContactBullet(const PhysContact& contact) const;
+
+	// Moves the bodies of the contact apart and calls their collision
+	// callbacks
+	void ResolveContact(const PhysContact& contact);
+
+	// Moves the step quad and AABB of the body after the body was moved to
+	// resolve a collision
+	void MoveBodyShape(int index, const Vec2& vec);
 
 private:
 	CollisionDetector m_Detector;
+
+	// Declared before the pool so that the store outlives the handles
+	PhysBodyStore m_Store;
 	PoolAllocator<PhysBody> m_BodyPool;
 
-	uint16_t m_LayerIgnoreMask[kPhysWorldLayerMax];
+	// Grid of the bodies that are awake, rebuilt every step
+	PhysBroadPhase m_BroadPhase;
+
+	// Grid of the sleeping bodies, which includes most static bodies. Only
+	// rebuilt when the set of sleeping bodies changes, and only queried by
+	// bodies that are awake
+	PhysBroadPhase m_RestingBroadPhase;
+
+	// AABB of each body in the current step, indexed by the store index
+	double* m_AABBMinX;
+	double* m_AABBMinY;
+	double* m_AABBMaxX;
+	double* m_AABBMaxY;
 
-	// List containing all bodies
-	PhysBody* m_ListHead;
-	PhysBody* m_ListTail;
+	// World quad of each body in the current step. The 4 corners of the
+	// body at index i start at element i * 4
+	Vec2* m_Quads;
+
+	// Set if the body is rotated in the current step
+	uint8_t* m_Rotated;
+
+	// Set if the body was moved to resolve a collision in the current step
+	uint8_t* m_Resolved;
+
+	// Candidate pairs found by the broad phase in the current step
+	DynArray<PhysPair> m_Pairs;
+
+	// Results of the pair tests, one element per pair
+	//
+	// m_PairBounds holds the packed AABBs of both bodies of each pair
+	size_t m_PairCapacity;
+	double* m_PairBounds;
+	uint8_t* m_PairCollisions;
+	double* m_PairMtvX;
+	double* m_PairMtvY;
+	double* m_PairToi;
+
+	// Pairs that collided in the current step, sorted by body index
+	//
+	// Few bodies touch in most steps, so the contacts are usually inline
+	SmallVector<PhysContact, kPhysWorldContactInline> m_Contacts;
+
+	// Index of the earliest swept contact of each bullet while the contacts
+	// are built. -1 if the bullet has no swept contact
+	int* m_BulletContacts;
+
+	// Runs the pair tests. nullptr if all pairs are tested on the thread
+	// calling Update()
+	JobSystem* m_JobSystemPtr;
+
+	uint16_t m_LayerIgnoreMask[kPhysWorldLayerMax];
 };
 
 #endif
\ No newline at end of file
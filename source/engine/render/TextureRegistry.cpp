@@ -19,12 +19,16 @@ Texture* TextureRegistry::CreateTexture(const char* name, TextureColor_t colorTy
 
 	texture->CreateFromBuffer(colorType, width, height, data);
 
-	m_TexTable.Insert(name, texture);
+	m_TexTable.Insert(InternString(name), texture);
 
 	return texture.get();
 }
 
 Texture* TextureRegistry::GetTexture(const char* name) {
+	return GetTexture(StringId(name));
+}
+
+Texture* TextureRegistry::GetTexture(StringId name) {
 	auto it = m_TexTable.Find(name);
 
 	if (it == m_TexTable.End()) {
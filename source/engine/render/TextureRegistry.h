@@ -5,7 +5,7 @@
 
 #include "Texture.h"
 
-#include "container/HashMap.h"
+#include "container/FlatHashMap.h"
 
 //--------------------------------------------------
 //
@@ -24,8 +24,13 @@ public:
 
 	Texture* GetTexture(const char* name);
 
+	// Same as GetTexture(name) without hashing the name, e.g. with
+	// STRING_ID("player.png")
+	Texture* GetTexture(StringId name);
+
 private:
-	HashMap<const char*, SharedPtr<Texture> > m_TexTable;
+	// Keyed by the id of the texture name
+	FlatHashMap<StringId, SharedPtr<Texture> > m_TexTable;
 };
 
 #endif
\ No newline at end of file
@@ -3,7 +3,8 @@
 
 #include "base_include.h"
 
-typedef uint64_t ResourceId_t;
+// Id of the path of the resource
+typedef StringId ResourceId_t;
 
 // Type of resource being loaded; determines post-load processing if needed
 enum ResourceType_t {
@@ -47,6 +48,9 @@ private:
 	// Pointer to the data
 	//
 	// Data can point to nullptr though resource is valid; e.g. png resource
+	//
+	// Points into the memory of the resource manager, which updates it when
+	// it moves the data to defragment the memory
 	byte_t* m_Data;
 
 	// Counts the number of handles being used
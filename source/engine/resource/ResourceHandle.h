@@ -15,6 +15,13 @@ class Resource;
 // Handle increments the resource usage counter when created, and decrements
 // the counter when it is destroyed
 //
+// Resources stay in place while other resources are loaded and unloaded, so
+// a handle stays valid until its own resource is unloaded
+//
+// Data is looked up through the resource on every call, since the resource
+// manager moves the data while it defragments its memory. The pointer
+// returned by GetData() MUST NOT be kept past the current frame
+//
 //--------------------------------------------------
 class ResourceHandle {
 	friend class Resource;
@@ -28,7 +35,7 @@ public:
 	ResourceHandle(const ResourceHandle& handle);
 	~ResourceHandle();
 
-	const byte_t* GetData() const { return m_DataPtr; }
+	const byte_t* GetData() const;
 
 	// Returns true if handle points to a valid resource
 	bool IsValid() const { return (m_ResourcePtr != nullptr); }
@@ -36,9 +43,6 @@ public:
 private:
 	// Pointer to the resource
 	Resource* m_ResourcePtr;
-
-	// Pointer to the resource data
-	const byte_t* m_DataPtr;
 };
 
 #endif
\ No newline at end of file
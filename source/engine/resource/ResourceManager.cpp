@@ -6,9 +6,14 @@
 #include "ResourceStream.h"
 #include "image/PngReader.h"
 
+#include <new>
+
+static_assert(sizeof(ResourceDataHeader) <= kResourceDataHeaderSize, "Header must fit in front of the data");
+
 ResourceManager::ResourceManager(PlatformFileSystem* fileSys, TextureRegistry* texRegistry): 
-m_Allocator(kResourceAllocatorBlockSize, kResourceAllocatorBlockCount),
-m_Registry(kResourceManagerResourceMax),
+m_Allocator(kResourceAllocatorCapacity),
+m_ResourcePool(kResourceManagerResourceInit, true),
+m_Registry(kResourceManagerResourceInit, kContainerGrowthAuto),
 m_ReqStack(128)
 {
 	
@@ -19,10 +24,29 @@ m_ReqStack(128)
 
 	m_Stream = new ResourceStream(this, fileSys);
 
+	m_JobSystemPtr = nullptr;
+	m_PngDecoding = false;
+
 	m_Registry.Clear();
 }
 
 ResourceManager::~ResourceManager() {
+	// Decode job uses the buffer of the stream
+	if (m_PngDecoding) {
+		m_JobSystemPtr->Wait(&m_PngCounter);
+
+		delete[] m_PngDecode.data;
+	}
+
+	m_JobSystemPtr = nullptr;
+
+	for (auto it = m_Registry.Begin(); it != m_Registry.End(); ++it) {
+		Resource* resource = it.GetValue();
+
+		resource->~Resource();
+		m_ResourcePool.Dealloc(resource);
+	}
+
 	m_Registry.Clear();
 
 	delete m_Stream;
@@ -39,6 +63,18 @@ void ResourceManager::Update() {
     	
     // Handle the current request if it has finished loading
     HandleRequestCompletion();
+
+    // A single free block means that there are no holes to fill. Holes may
+    // also be left behind data too large to move in one frame
+    if (m_Allocator.GetFreeBlockCount() > 1 && m_Allocator.CanDefragment()) {
+    	m_Allocator.Defragment(kResourceDefragFrameSize, &ResourceManager::RelocateData, (void*)this);
+    }
+}
+
+void ResourceManager::SetJobSystem(JobSystem* jobSystem) {
+	ASSERT(!m_PngDecoding);
+
+	m_JobSystemPtr = jobSystem;
 }
 
 void ResourceManager::HandleNextRequest() {
@@ -63,6 +99,21 @@ void ResourceManager::HandleNextRequest() {
 }
 
 void ResourceManager::HandleRequestCompletion() {
+	// Buffer of the stream is held until the png in it is decoded
+	if (m_PngDecoding) {
+		// Decode job sits in the deque of this thread until a worker steals
+		// it, so it is run here if the workers are all busy
+		if (!m_PngCounter.IsDone()) {
+			m_JobSystemPtr->RunPendingJob();
+		}
+
+		if (!m_PngCounter.IsDone()) {
+			return;
+		}
+
+		FinishPngDecode();
+	}
+
 	if (!m_Stream->IsComplete()) {
 		return;
 	}
@@ -78,68 +129,124 @@ void ResourceManager::HandleRequestCompletion() {
     	ResourceType_t type = bufHandle.GetType();
 
     	if (type == kResourceTypePng) {
-    		// Creates a texture from the png data; png data is discarded
+    		// Creates a texture from the png data once it is decoded; png data
+    		// is discarded
+    		StartPngDecode(bufHandle);
 
-    		// Reads the png data
+    		return;
+    	}
+    	else {
 
-    		PngReader reader;
+    		// Stores all other types of data in a resource
 
-			reader.InitReader(bufHandle.GetData(), bufHandle.GetSize());
+    		ResourceId_t id = InternString(bufHandle.GetPath());
 
-			ImageHeader header;
-			bool headerRead = reader.ReadHeader(&header);
-			ASSERT(headerRead);
+    		void* allocMem = m_Allocator.Alloc(kResourceDataHeaderSize + bufHandle.GetSize());
 
-			size_t pngDataSize = header.size;
+    		if (allocMem == nullptr) {
+    			LOG_ERROR("ResourceManager: No memory for \'%s\' (%zu of %zu bytes used)", bufHandle.GetPath(),
+    					  m_Allocator.GetUsedSize(), m_Allocator.GetCapacity());
 
-			byte_t* pngData = new byte_t[pngDataSize];
+    			m_Stream->ReleaseBufferHandle(bufHandle);
+    			return;
+    		}
 
-			bool dataRead = reader.ReadData(pngData);
-			ASSERT(dataRead);
+    		ResourceDataHeader* header = (ResourceDataHeader*)allocMem;
+    		header->id = id;
 
+    		byte_t* data = (byte_t*)allocMem + kResourceDataHeaderSize;
 
-			// Creates the texture with the data
-			if (header.colorType == kImageColorRGBA) {
-				m_TexRegistryPtr->CreateTexture(bufHandle.GetPath(), kTextureColorRGBA, header.width, header.height, (const void*)pngData);
-			}
-			else if (header.colorType == kImageColorRGB) {
-				m_TexRegistryPtr->CreateTexture(bufHandle.GetPath(), kTextureColorRGB, header.width, header.height, (const void*)pngData);
-			}
+    		memcpy((void*)data, (void*)bufHandle.GetData(), bufHandle.GetSize());
 
+	    	AddResource(id, data);
+    	}
+    }
+    else {
+    	LOG_PRINT("ResourceManager: error loading \'%s\' during async io", bufHandle.GetPath());
+    	return;
+    }
 
-			// Stores the png resource as a resource with null data
+    // Unlocks the buffer handle
+    m_Stream->ReleaseBufferHandle(bufHandle);
+}
 
-			ResourceId_t id = CreateResourceId(bufHandle.GetPath());
+// Reads the png data
+static void DecodePngTask(void* context, size_t begin, size_t end) {
+	ResourcePngDecode* decode = (ResourcePngDecode*)context;
 
-			Resource res;
-			res.m_Data = nullptr;
+	decode->data = nullptr;
 
-			m_Registry.Insert(id, res);
+	PngReader reader;
 
-			delete[] pngData;
-    	}
-    	else {
+	reader.InitReader(decode->source, decode->sourceSize);
 
-    		// Stores all other types of data in a resource
+	if (!reader.ReadHeader(&decode->header)) {
+		return;
+	}
 
-    		ResourceId_t id = CreateResourceId(bufHandle.GetPath());
+	byte_t* pngData = new byte_t[decode->header.size];
 
-    		void* allocMem = m_Allocator.Alloc(bufHandle.GetSize());
-    		memcpy(allocMem, (void*)bufHandle.GetData(), bufHandle.GetSize());
+	if (!reader.ReadData(pngData)) {
+		delete[] pngData;
+		return;
+	}
 
-	    	Resource res;
-	    	res.m_Data = (byte_t*)allocMem;
-	    	
-	    	m_Registry.Insert(id, res);
-    	}
-    }
-    else {
-    	LOG_PRINT("ResourceManager: error loading \'%s\' during async io", bufHandle.GetPath());
-    	return;
-    }
+	decode->data = pngData;
+}
 
-    // Unlocks the buffer handle
-    m_Stream->ReleaseBufferHandle(bufHandle);
+void ResourceManager::StartPngDecode(const ResourceBufferHandle& bufHandle) {
+	ASSERT(!m_PngDecoding);
+
+	m_PngHandle = bufHandle;
+
+	m_PngDecode.source = m_PngHandle.GetData();
+	m_PngDecode.sourceSize = m_PngHandle.GetSize();
+	m_PngDecode.data = nullptr;
+
+	m_PngDecoding = true;
+
+	// Without workers the job could only run on this thread anyway
+	if (m_JobSystemPtr != nullptr && m_JobSystemPtr->GetWorkerCount() > 0) {
+		m_JobSystemPtr->Submit(&DecodePngTask, (void*)&m_PngDecode, 0, 1, &m_PngCounter);
+	}
+	else {
+		DecodePngTask((void*)&m_PngDecode, 0, 1);
+
+		FinishPngDecode();
+	}
+}
+
+void ResourceManager::FinishPngDecode() {
+	ASSERT(m_PngDecoding);
+
+	ImageHeader& header = m_PngDecode.header;
+
+	if (m_PngDecode.data != nullptr) {
+		// Creates the texture with the data
+		if (header.colorType == kImageColorRGBA) {
+			m_TexRegistryPtr->CreateTexture(m_PngHandle.GetPath(), kTextureColorRGBA, header.width, header.height, (const void*)m_PngDecode.data);
+		}
+		else if (header.colorType == kImageColorRGB) {
+			m_TexRegistryPtr->CreateTexture(m_PngHandle.GetPath(), kTextureColorRGB, header.width, header.height, (const void*)m_PngDecode.data);
+		}
+
+		// Stores the png resource as a resource with null data
+
+		ResourceId_t id = InternString(m_PngHandle.GetPath());
+
+		AddResource(id, nullptr);
+
+		delete[] m_PngDecode.data;
+		m_PngDecode.data = nullptr;
+	}
+	else {
+		LOG_ERROR("ResourceManager: png \'%s\' could not be decoded", m_PngHandle.GetPath());
+	}
+
+	m_PngDecoding = false;
+
+	// Unlocks the buffer handle
+	m_Stream->ReleaseBufferHandle(m_PngHandle);
 }
 
 void ResourceManager::LoadResourceFromFile(const char* path, ResourceType_t type) {
@@ -159,7 +266,16 @@ void ResourceManager::UnloadResource(const char* path) {
 		return;
 	}
 
+	// Data is nullptr for resources that only keep their data elsewhere, e.g.
+	// pngs
+	if (resource->m_Data != nullptr) {
+		m_Allocator.Dealloc(resource->m_Data - kResourceDataHeaderSize);
+	}
+
 	m_Registry.Remove(id);
+
+	resource->~Resource();
+	m_ResourcePool.Dealloc(resource);
 }
 
 ResourceHandle ResourceManager::GetResource(const char* name) {
@@ -175,7 +291,7 @@ ResourceHandle ResourceManager::GetResource(ResourceId_t id) {
 		return ResourceHandle();
 	}
 	else {
-		return it.GetValue().CreateHandle();
+		return it.GetValue()->CreateHandle();
 	}
 }
 
@@ -197,10 +313,31 @@ Resource* ResourceManager::GetRawResource(ResourceId_t id) {
 		return nullptr;
 	}
 	else {
-		return &it.GetValue();
+		return it.GetValue();
 	}
 }
 
+void ResourceManager::AddResource(ResourceId_t id, byte_t* data) {
+	Resource* resource = new(m_ResourcePool.Alloc()) Resource();
+	resource->m_Data = data;
+
+	m_Registry.Insert(id, resource);
+}
+
+void ResourceManager::RelocateData(void* context, void* oldPtr, void* newPtr) {
+	ResourceManager* manager = (ResourceManager*)context;
+
+	// Header moved with the data
+	ResourceDataHeader* header = (ResourceDataHeader*)newPtr;
+
+	Resource* resource = manager->GetRawResource(header->id);
+
+	ASSERT(resource != nullptr);
+	ASSERT(resource->m_Data == (byte_t*)oldPtr + kResourceDataHeaderSize);
+
+	resource->m_Data = (byte_t*)newPtr + kResourceDataHeaderSize;
+}
+
 ResourceId_t ResourceManager::CreateResourceId(const char* name) {
-	return HashString(name);
+	return StringId(name);
 }
\ No newline at end of file
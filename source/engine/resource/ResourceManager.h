@@ -3,24 +3,40 @@
 
 #include "base_include.h"
 
-#include "container/HashMap.h"
+#include "container/FlatHashMap.h"
 #include "container/Stack.h"
 
-#include "allocator/BlockAllocator.h"
+#include "allocator/PoolAllocator.h"
+#include "allocator/TlsfAllocator.h"
+#include "job/JobSystem.h"
 
 #include "Resource.h"
 #include "ResourceHandle.h"
+#include "ResourceStream.h"
+#include "image/IImageReader.h"
 
-// Max number of resources that can be stored in resource manager
-const int kResourceManagerResourceMax = 1024;
+// Initial number of resources in the resource manager; the registry grows
+// past it as more resources are loaded
+const int kResourceManagerResourceInit = 128;
 
-const int kResourceAllocatorBlockSize = MEGABYTES_TO_BYTES(2);
-const int kResourceAllocatorBlockCount = 128;
+// Bytes of memory for the data of all loaded resources
+const size_t kResourceAllocatorCapacity = MEGABYTES_TO_BYTES(256);
+
+// Max bytes of resource data moved in one frame to defragment the memory
+const size_t kResourceDefragFrameSize = KILOBYTES_TO_BYTES(256);
+
+// Stored in front of the data of every resource, so that the resource can
+// be found when its data is moved
+struct ResourceDataHeader {
+	ResourceId_t id;
+};
+
+// Keeps the data after the header aligned
+const size_t kResourceDataHeaderSize = kTlsfAlignment;
 
 // Forward declarations
 class PlatformFileSystem;
 class TextureRegistry;
-class ResourceStream;
 
 // Resource load request
 struct ResourceLoadReq {
@@ -28,12 +44,30 @@ struct ResourceLoadReq {
 	ResourceType_t type;
 };
 
+// PNG decoded by a job into pixel data
+struct ResourcePngDecode {
+	const byte_t* source;
+	size_t sourceSize;
+
+	ImageHeader header;
+
+	// Pixel data allocated by the decode. nullptr if the decode failed
+	byte_t* data;
+};
+
 //--------------------------------------------------
 //
 // ResourceManager
 //
 // Controls loading, storing and access of all resources in the game
 //
+// Unloading resources leaves holes in the memory of the resource data. Each
+// Update() moves up to kResourceDefragFrameSize bytes of data into the holes
+// in front of it, and points the resources to the new place of their data,
+// so that a long session of loads and unloads does not run out of space
+// that is only free in pieces. Data larger than that stays in place, and
+// once nothing can move the manager stops until the next load or unload
+//
 //--------------------------------------------------
 class ResourceManager {
 
@@ -44,11 +78,18 @@ public:
 	// Called on each frame
 	void Update();
 
+	// Sets the job system that decodes images. nullptr decodes them on the
+	// thread calling Update()
+	void SetJobSystem(JobSystem* jobSystem);
+
 	void LoadResourceFromFile(const char* path, ResourceType_t type);
 
 	void UnloadResource(const char* path);
 
 	ResourceHandle GetResource(const char* name);
+
+	// Same as GetResource(name) without hashing the name, e.g. with
+	// STRING_ID("sprites/player.png")
 	ResourceHandle GetResource(ResourceId_t id);
 
 	bool HasResource(const char* name);
@@ -57,9 +98,22 @@ private:
 	void HandleNextRequest();
 	void HandleRequestCompletion();
 
+	// Decodes the png in the buffer on the job system. The buffer is held
+	// until the decode finishes
+	void StartPngDecode(const ResourceBufferHandle& bufHandle);
+
+	// Creates the texture from the decoded png and releases its buffer
+	void FinishPngDecode();
+
 	Resource* GetRawResource(ResourceId_t id);
 
-	// Uses a hash function to create the id
+	// Creates a resource with the data and adds it to the registry
+	void AddResource(ResourceId_t id, byte_t* data);
+
+	// Called by the allocator when it moves the data of a resource
+	static void RelocateData(void* context, void* oldPtr, void* newPtr);
+
+	// Id of the name, without interning the name
 	ResourceId_t CreateResourceId(const char* name);
 
 private:
@@ -69,13 +123,27 @@ private:
 	TextureRegistry* m_TexRegistryPtr;
 
 	// Components
-	BlockAllocator m_Allocator;
+	TlsfAllocator m_Allocator; // Data of all resources; freed when a resource is unloaded
 	ResourceStream* m_Stream;
 
-	// Contains all resources, indexed by resource id
-	HashMap<ResourceId_t, Resource> m_Registry;
+	// Resources live in the pool, which never moves them, so handles point
+	// to the same resource while the registry grows or rehashes
+	PoolAllocator<Resource> m_ResourcePool;
+
+	// Points to all resources, indexed by resource id
+	FlatHashMap<ResourceId_t, Resource*> m_Registry;
 
 	Stack<ResourceLoadReq> m_ReqStack;
+
+	JobSystem* m_JobSystemPtr;
+
+	// Png being decoded and the buffer that it is decoded from
+	ResourcePngDecode m_PngDecode;
+	ResourceBufferHandle m_PngHandle;
+	JobCounter m_PngCounter;
+
+	// True from the start of a png decode until its texture is created
+	bool m_PngDecoding;
 };
 
 #endif
\ No newline at end of file
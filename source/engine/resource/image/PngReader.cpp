@@ -1,13 +1,5 @@
 #include "PngReader.h"
 
-struct PngBufferRead {
-	const byte_t* buffer;
-	uint32_t offset;
-};
-
-// Used with libpng to track the position in the buffer
-static PngBufferRead pngBufRead;
-
 // Read function to use with libpng
 void PngReadFunc(png_structp png_ptr, png_bytep data, png_size_t length);
 
@@ -70,16 +62,16 @@ bool PngReader::ReadHeader(ImageHeader* header) {
 	// needs to return false on an error
 	*header = m_Header;
 
-	pngBufRead.buffer = m_SrcBuf;
-	pngBufRead.offset = 0;
+	m_BufRead.buffer = m_SrcBuf;
+	m_BufRead.offset = 0;
 
 	// Fails if the PNG image has an incorrect signature
-	if (!png_check_sig(pngBufRead.buffer, 8)) {
+	if (!png_check_sig(m_BufRead.buffer, 8)) {
 		return false;
 	}
 
 	// Setup libpng with the png and info struct
-	png_set_read_fn(m_Png, (void*)&pngBufRead, PngReadFunc);
+	png_set_read_fn(m_Png, (void*)&m_BufRead, PngReadFunc);
 	png_read_info(m_Png, m_Info);
 
 	// Deals with errors during header read
@@ -181,6 +173,8 @@ bool PngReader::ReadData(byte_t* buffer) {
 
 
 void PngReadFunc(png_structp png_ptr, png_bytep data, png_size_t length) {
-	memcpy(data, pngBufRead.buffer + pngBufRead.offset, length);
-	pngBufRead.offset += length;
+	PngBufferRead* bufRead = (PngBufferRead*)png_get_io_ptr(png_ptr);
+
+	memcpy(data, bufRead->buffer + bufRead->offset, length);
+	bufRead->offset += length;
 }
\ No newline at end of file
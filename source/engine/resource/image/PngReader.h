@@ -7,6 +7,12 @@
 
 #include <png.h>
 
+// Position of libpng in the source buffer of a reader
+struct PngBufferRead {
+	const byte_t* buffer;
+	uint32_t offset;
+};
+
 //--------------------------------------------------
 //
 // PngReader
@@ -42,6 +48,10 @@ private:
 	const byte_t* m_SrcBuf;
 	size_t m_SrcLength;
 
+	// Owned by each reader so that readers on different threads can decode
+	// at the same time
+	PngBufferRead m_BufRead;
+
 	ImageHeader m_Header;
 
 	bool m_Init; // True if the reader has been properly initialized
@@ -0,0 +1,61 @@
+#include "GameClock.h"
+
+#include <cmath>
+
+GameClock::GameClock(): GameClock(kGameClockStepTimeDefault, kGameClockMaxStepsDefault) {
+
+}
+
+GameClock::GameClock(double stepTime, int maxSteps) {
+	ASSERT(stepTime > 0.0);
+	ASSERT(maxSteps > 0);
+
+	m_StepTime = stepTime;
+	m_MaxSteps = maxSteps;
+
+	m_StepCount = 0;
+	m_DroppedTime = 0.0;
+
+	Reset();
+}
+
+void GameClock::Reset() {
+	m_Accumulator = 0.0;
+
+	m_LastTick = std::chrono::steady_clock::now();
+}
+
+int GameClock::Tick() {
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	std::chrono::duration<double> elapsed = now - m_LastTick;
+	m_LastTick = now;
+
+	return Advance(elapsed.count());
+}
+
+int GameClock::Advance(double elapsedTime) {
+	ASSERT(elapsedTime >= 0.0);
+
+	m_Accumulator += elapsedTime;
+
+	int stepCount = 0;
+
+	while (m_Accumulator >= m_StepTime && stepCount < m_MaxSteps) {
+		m_Accumulator -= m_StepTime;
+		++stepCount;
+	}
+
+	// Drops the whole steps that did not fit in this frame and keeps the
+	// fraction of a step for interpolation
+	if (m_Accumulator >= m_StepTime) {
+		double fraction = fmod(m_Accumulator, m_StepTime);
+
+		m_DroppedTime += m_Accumulator - fraction;
+		m_Accumulator = fraction;
+	}
+
+	m_StepCount += (uint64_t)stepCount;
+
+	return stepCount;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef GAMECLOCK_H_
+#define GAMECLOCK_H_
+
+#include "base_include.h"
+
+#include <chrono>
+
+// Length of one simulation step in seconds
+const double kGameClockStepTimeDefault = 1.0 / 60.0;
+
+// Maximum number of steps simulated for one rendered frame
+const int kGameClockMaxStepsDefault = 5;
+
+//--------------------------------------------------
+//
+// GameClock
+//
+// Fixed timestep simulation clock
+//
+// Real time that passes between frames is added to an accumulator, and the
+// simulation is stepped once for every whole step in the accumulator. The
+// remaining fraction of a step is used to interpolate the rendered state
+// between the last two steps
+//
+// At most maxSteps steps are run per frame. Time beyond that is dropped, so
+// the simulation slows down instead of falling further behind when a frame
+// takes too long
+//
+//--------------------------------------------------
+class GameClock {
+
+public:
+	GameClock();
+	GameClock(double stepTime, int maxSteps);
+
+	// Restarts measuring real time from now and empties the accumulator
+	void Reset();
+
+	// Adds the real time since the last Tick() or Reset() and returns the
+	// number of steps to simulate this frame
+	int Tick();
+
+	// Adds the elapsed time in seconds and returns the number of steps to
+	// simulate this frame
+	//
+	// Called by Tick(). Use directly to drive the clock manually
+	int Advance(double elapsedTime);
+
+	// Returns how far the current time is between the last step and the
+	// next step, in range [0, 1)
+	double GetAlpha() const { return m_Accumulator / m_StepTime; }
+
+	double GetStepTime() const { return m_StepTime; }
+	int GetMaxSteps() const { return m_MaxSteps; }
+
+	// Total number of steps returned since the clock was created
+	uint64_t GetStepCount() const { return m_StepCount; }
+
+	// Total time in seconds dropped because of the step limit
+	double GetDroppedTime() const { return m_DroppedTime; }
+
+private:
+	double m_StepTime;
+	int m_MaxSteps;
+
+	// Real time that has not been simulated yet. Always less than one step
+	// between calls
+	double m_Accumulator;
+
+	uint64_t m_StepCount;
+	double m_DroppedTime;
+
+	std::chrono::steady_clock::time_point m_LastTick;
+};
+
+#endif
\ No newline at end of file
@@ -14,9 +14,9 @@ GameLoadState::~GameLoadState() {
 
 void GameLoadState::Update() {
 
-	if (m_ResourcePtr->GetResource("metalslug.png").IsValid() &&
-		m_ResourcePtr->GetResource("projectile.png").IsValid() &&
-		m_ResourcePtr->GetResource("ms_enemy.png").IsValid()) 
+	if (m_ResourcePtr->GetResource(STRING_ID("metalslug.png")).IsValid() &&
+		m_ResourcePtr->GetResource(STRING_ID("projectile.png")).IsValid() &&
+		m_ResourcePtr->GetResource(STRING_ID("ms_enemy.png")).IsValid()) 
 	{
 		m_LoadingDone = true;
 	}
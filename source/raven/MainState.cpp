@@ -5,9 +5,7 @@
 #include "render/TextureRegistry.h"
 
 
-MainState::MainState(GameEngine* engine): BaseGameState(engine),
-m_ProjectileArray(kProjectileMax)
-{
+MainState::MainState(GameEngine* engine): BaseGameState(engine) {
 	m_EntityManagerPtr = engine->GetEntityManager();
 	m_PhysWorldPtr = engine->GetPhysWorld();
 
@@ -18,14 +16,14 @@ m_ProjectileArray(kProjectileMax)
 
 
 	// Creates the player entity
-	m_Player = (Player*)m_EntityManagerPtr->CreateEntity("Player");
+	m_Player = (Player*)m_EntityManagerPtr->CreateEntity(STRING_ID("Player"));
 	
 
 	// Creates the player sprite
-	Texture* playerTex = m_EnginePtr->GetTextureRegistry()->GetTexture("metalslug.png");
+	Texture* playerTex = m_EnginePtr->GetTextureRegistry()->GetTexture(STRING_ID("metalslug.png"));
 	Sprite* playerSprite = m_EntityManagerPtr->CreateSprite((Entity*)m_Player, playerTex, 1);
 	playerSprite->AddClip("idle", 5, 0, 30, 40, 1, 1, 1);
-	playerSprite->PlayClip("idle", true);
+	playerSprite->PlayClip(STRING_ID("idle"), true);
 	playerSprite->SetOrigin(Vec2(15, 20));
 
 
@@ -37,15 +35,15 @@ m_ProjectileArray(kProjectileMax)
 
 
 	// Creates the enemy entity
-	m_Enemy = (Enemy*)m_EntityManagerPtr->CreateEntity("Enemy");
+	m_Enemy = (Enemy*)m_EntityManagerPtr->CreateEntity(STRING_ID("Enemy"));
 	m_Enemy->TranslateTo(Vec2(200.0, 0.0));
 	
 
 	// Creates the enemy sprite
-	Texture* enemyTex = m_EnginePtr->GetTextureRegistry()->GetTexture("ms_enemy.png");
+	Texture* enemyTex = m_EnginePtr->GetTextureRegistry()->GetTexture(STRING_ID("ms_enemy.png"));
 	Sprite* enemySprite = m_EntityManagerPtr->CreateSprite((Entity*)m_Enemy, enemyTex, 1);
 	enemySprite->AddClip("idle", 0, 4, 30, 40, 1, 1, 1);
-	enemySprite->PlayClip("idle", true);
+	enemySprite->PlayClip(STRING_ID("idle"), true);
 	enemySprite->SetOrigin(Vec2(15, 20));
 
 
@@ -74,6 +72,10 @@ m_ProjectileArray(kProjectileMax)
 }
 
 MainState::~MainState() {
+	while (!m_ProjectileArray.IsEmpty()) {
+		DestroyProjectile((int)m_ProjectileArray.GetSize() - 1);
+	}
+
 	m_EntityManagerPtr->DestroyEntity((Entity*)m_Enemy);
 	m_EntityManagerPtr->DestroyEntity((Entity*)m_Player);
 
@@ -85,6 +87,8 @@ MainState::~MainState() {
 
 void MainState::Update() {
 	// Moves the player in the specified direction
+	//
+	// Called once per fixed step, so speeds are in pixels per step
 	if (m_PlayerDirState[kPlayerDirLeft]) {
 		m_Player->TranslateBy(Vec2(-5.0, 0.0));
 	}
@@ -98,10 +102,20 @@ void MainState::Update() {
 		m_Player->TranslateBy(Vec2(0.0, 5.0));
 	}
 
-	for (int i = 0; i < m_ProjectileArray.GetSize(); ++i) {
-		Rect screenRect = m_EnginePtr->GetScene()->GetScreenRect();
+	Rect screenRect = m_EnginePtr->GetScene()->GetScreenRect();
 
-		Projectile* projectile = m_ProjectileArray[i];
+	// Destroys the projectiles that left the screen, and forgets the ones
+	// that were already destroyed
+	//
+	// Iterates backwards since destroying a projectile moves the last one
+	// into its place
+	for (int i = (int)m_ProjectileArray.GetSize() - 1; i >= 0; --i) {
+		Entity* projectile = m_EntityManagerPtr->GetEntity(m_ProjectileArray[i]);
+
+		if (projectile == nullptr) {
+			m_ProjectileArray.SwapRemove(i);
+			continue;
+		}
 
 		Vec2 pos = projectile->GetWorldPosition();
 
@@ -110,7 +124,7 @@ void MainState::Update() {
 			pos.GetY() < screenRect.GetY() ||
 			pos.GetY() > (screenRect.GetY() + screenRect.GetH())) {
 
-			LOG_PRINT("removed");
+			DestroyProjectile(i);
 		}
 	}
 }
@@ -158,13 +172,11 @@ void MainState::FireProjectile() {
 		return;
 	}
 
-	// (TODO:) manage projectiles; they are currently causing memory leaks
-	
-	Projectile* projectile = (Projectile*)m_EnginePtr->GetEntityManager()->CreateEntity("Projectile");
+	Projectile* projectile = (Projectile*)m_EnginePtr->GetEntityManager()->CreateEntity(STRING_ID("Projectile"));
 	projectile->TranslateTo(m_Player->GetWorldPosition());
 
 
-	Texture* tex = m_EnginePtr->GetTextureRegistry()->GetTexture("projectile.png");
+	Texture* tex = m_EnginePtr->GetTextureRegistry()->GetTexture(STRING_ID("projectile.png"));
 	Sprite* sprite = m_EntityManagerPtr->CreateSprite((Entity*)projectile, tex, 1);
 	sprite->AddClip("idle", 0, 0, 30, 5, 1, 1, 1);
 	sprite->SetOrigin(Vec2(0, 3));
@@ -174,6 +186,7 @@ void MainState::FireProjectile() {
 	body->SetOrigin(Vec2(0, 3));
 	body->SetWidth(30.0);
 	body->SetHeight(5.0);
+	body->SetBullet(true);
 
 
 	if (m_Player->GetFlipY()) {
@@ -188,11 +201,22 @@ void MainState::FireProjectile() {
 	m_EnginePtr->GetScene()->AddEntity(projectile, 0);
 
 	// Adds the projectile to the projectile array
-	m_ProjectileArray.PushBack(projectile);
+	m_ProjectileArray.PushBack(projectile->GetHandle());
 
 	m_FireReady = false;
 }
 
 void MainState::ResetProjectile() {
 	m_FireReady = true;
+}
+
+void MainState::DestroyProjectile(int index) {
+	Entity* projectile = m_EntityManagerPtr->GetEntity(m_ProjectileArray[index]);
+
+	if (projectile != nullptr) {
+		m_EnginePtr->GetScene()->RemoveEntity(projectile);
+		m_EntityManagerPtr->DestroyEntity(projectile);
+	}
+
+	m_ProjectileArray.SwapRemove(index);
 }
\ No newline at end of file
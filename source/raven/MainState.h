@@ -25,8 +25,6 @@ enum PlayerDirection_t {
 	kPlayerDirRight = 3
 };
 
-const int kProjectileMax = 128;
-
 // Physics layers
 const uint16_t kPhysLayerFriend = 1;
 const uint16_t kPhysLayerEnemy = 2;
@@ -73,6 +71,10 @@ public:
 	void ResetProjectile();
 
 private:
+	// Removes the projectile at the index from the scene, destroys it and
+	// removes it from the projectile array
+	void DestroyProjectile(int index);
+
 	GameController* m_Controller;
 
 	EntityManager* m_EntityManagerPtr;
@@ -81,7 +83,8 @@ private:
 	Player* m_Player;
 	Enemy* m_Enemy;
 
-	DynArray<Projectile*> m_ProjectileArray;
+	// Handles of the projectiles that have been fired and not destroyed
+	DynArray<EntityHandle> m_ProjectileArray;
 	
 	// True for the corresponding direction if the key is down
 	bool m_PlayerDirState[4];
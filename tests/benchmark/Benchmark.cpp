@@ -0,0 +1,61 @@
+#include "Benchmark.h"
+
+#include <cstdio>
+#include <cstring>
+
+volatile uint64_t g_BenchmarkSink = 0;
+
+struct BenchmarkEntry {
+	const char* group;
+	const char* name;
+	BenchmarkFunc_t func;
+};
+
+// Returns the list of registered benchmarks
+//
+// List is a function static so that it is constructed before the first
+// registrar uses it
+static BenchmarkEntry* GetBenchmarkList(int** count) {
+	static BenchmarkEntry benchmarkList[kBenchmarkMax];
+	static int benchmarkCount = 0;
+
+	*count = &benchmarkCount;
+
+	return benchmarkList;
+}
+
+BenchmarkRegistrar::BenchmarkRegistrar(const char* group, const char* name, BenchmarkFunc_t func) {
+	int* count = nullptr;
+	BenchmarkEntry* list = GetBenchmarkList(&count);
+
+	ASSERT(*count < kBenchmarkMax);
+
+	list[*count].group = group;
+	list[*count].name = name;
+	list[*count].func = func;
+
+	++(*count);
+}
+
+void BenchmarkReport(const char* label, int iterations, double elapsedMs) {
+	ASSERT(iterations > 0);
+
+	double perIterUs = (elapsedMs * 1000.0) / (double)iterations;
+
+	printf("  %-48s %10.3f ms total %12.3f us/iter (%d iters)\n", label, elapsedMs, perIterUs, iterations);
+}
+
+void BenchmarkRunAll(const char* group) {
+	int* count = nullptr;
+	BenchmarkEntry* list = GetBenchmarkList(&count);
+
+	for (int i = 0; i < *count; ++i) {
+		if (group != nullptr && strcmp(group, list[i].group) != 0) {
+			continue;
+		}
+
+		printf("[%s.%s]\n", list[i].group, list[i].name);
+
+		(*(list[i].func))();
+	}
+}
\ No newline at end of file
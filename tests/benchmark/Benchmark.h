@@ -0,0 +1,86 @@
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include "base_include.h"
+
+#include <chrono>
+
+//--------------------------------------------------
+//
+// Benchmark.h
+//
+// Registration and timing utilities shared by all benchmarks
+//
+// Benchmarks are defined with the BENCHMARK macro and are registered during
+// static initialization. Each benchmark times its own loops with a
+// BenchmarkTimer and prints the results with BenchmarkReport()
+//
+//--------------------------------------------------
+
+// Max number of benchmarks that can be registered
+const int kBenchmarkMax = 128;
+
+typedef void (*BenchmarkFunc_t)();
+
+// Defines and registers a benchmark function
+#define BENCHMARK(group, name)	\
+static void Benchmark_##group##_##name();	\
+static BenchmarkRegistrar benchmarkRegistrar_##group##_##name(#group, #name, &Benchmark_##group##_##name);	\
+static void Benchmark_##group##_##name()
+
+
+//--------------------------------------------------
+//
+// BenchmarkRegistrar
+//
+// Adds a benchmark to the global benchmark list when constructed
+//
+//--------------------------------------------------
+class BenchmarkRegistrar {
+
+public:
+	BenchmarkRegistrar(const char* group, const char* name, BenchmarkFunc_t func);
+};
+
+//--------------------------------------------------
+//
+// BenchmarkTimer
+//
+// Measures the wall clock time since it was last started
+//
+//--------------------------------------------------
+class BenchmarkTimer {
+
+public:
+	BenchmarkTimer() { Start(); }
+
+	void Start() { m_Start = std::chrono::steady_clock::now(); }
+
+	// Returns the time elapsed since Start() in milliseconds
+	double GetElapsedMs() const {
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_Start;
+
+		return elapsed.count();
+	}
+
+private:
+	std::chrono::steady_clock::time_point m_Start;
+};
+
+// Prints the total and per iteration time of a measured loop
+void BenchmarkReport(const char* label, int iterations, double elapsedMs);
+
+// Runs all registered benchmarks in registration order
+//
+// Only runs the benchmarks in the specified group if group is not nullptr
+void BenchmarkRunAll(const char* group);
+
+// Written by BenchmarkUseValue(); defined in Benchmark.cpp
+extern volatile uint64_t g_BenchmarkSink;
+
+// Stops the compiler from optimizing away a result that is never used
+inline void BenchmarkUseValue(uint64_t value) {
+	g_BenchmarkSink = value;
+}
+
+#endif
\ No newline at end of file
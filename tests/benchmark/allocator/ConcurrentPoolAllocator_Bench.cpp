@@ -0,0 +1,221 @@
+#include "Benchmark.h"
+
+#include "allocator/ConcurrentPoolAllocator.h"
+#include "allocator/PoolAllocator.h"
+
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Chunks that each thread holds at once in a round
+const int kPoolBenchChunkCount = 1024;
+
+const int kPoolBenchRounds = 200;
+
+// About the size of a small node or body
+struct PoolBenchObject {
+	uint64_t data[8];
+};
+
+//--------------------------------------------------
+//
+// LockedPool
+//
+// PoolAllocator behind a mutex, the simplest pool that threads can share
+//
+//--------------------------------------------------
+class LockedPool {
+
+public:
+	LockedPool(): m_Pool(kPoolBenchChunkCount, true) {}
+
+	PoolBenchObject* Alloc() {
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		return m_Pool.Alloc();
+	}
+
+	void Dealloc(PoolBenchObject* ptr) {
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		m_Pool.Dealloc(ptr);
+	}
+
+private:
+	PoolAllocator<PoolBenchObject> m_Pool;
+	std::mutex m_Mutex;
+};
+
+//--------------------------------------------------
+//
+// HeapPool
+//
+// Allocates every chunk with the global operator new
+//
+//--------------------------------------------------
+class HeapPool {
+
+public:
+	PoolBenchObject* Alloc() {
+		return (PoolBenchObject*)::operator new(sizeof(PoolBenchObject));
+	}
+
+	void Dealloc(PoolBenchObject* ptr) {
+		::operator delete(ptr);
+	}
+};
+
+class ConcurrentPool {
+
+public:
+	ConcurrentPool(): m_Pool(kPoolBenchChunkCount) {}
+
+	PoolBenchObject* Alloc() {
+		return m_Pool.Alloc();
+	}
+
+	void Dealloc(PoolBenchObject* ptr) {
+		m_Pool.Dealloc(ptr);
+	}
+
+private:
+	ConcurrentPoolAllocator<PoolBenchObject> m_Pool;
+};
+
+// Allocates a round of chunks, touches them and deallocates them
+template<typename Pool>
+static void AllocFreeRounds(Pool* pool) {
+	PoolBenchObject* ptrs[kPoolBenchChunkCount];
+
+	uint64_t sum = 0;
+
+	for (int round = 0; round < kPoolBenchRounds; ++round) {
+		for (int i = 0; i < kPoolBenchChunkCount; ++i) {
+			ptrs[i] = pool->Alloc();
+			ptrs[i]->data[0] = i;
+		}
+
+		for (int i = 0; i < kPoolBenchChunkCount; ++i) {
+			sum += ptrs[i]->data[0];
+
+			pool->Dealloc(ptrs[i]);
+		}
+	}
+
+	BenchmarkUseValue(sum);
+}
+
+// Thread i deallocates the chunks that thread i - 1 allocated in the
+// previous round, so every chunk is freed on another thread
+template<typename Pool>
+static void CrossThreadRounds(Pool* pool, std::vector<PoolBenchObject*>* lists, int threadIndex, int threadCount,
+							  std::vector<std::mutex>* locks) {
+	int prev = (threadIndex + threadCount - 1) % threadCount;
+
+	for (int round = 0; round < kPoolBenchRounds; ++round) {
+		{
+			std::lock_guard<std::mutex> lock((*locks)[prev]);
+
+			std::vector<PoolBenchObject*>& list = lists[prev];
+
+			for (size_t i = 0; i < list.size(); ++i) {
+				pool->Dealloc(list[i]);
+			}
+
+			list.clear();
+		}
+
+		std::lock_guard<std::mutex> lock((*locks)[threadIndex]);
+
+		std::vector<PoolBenchObject*>& list = lists[threadIndex];
+
+		for (int i = 0; i < kPoolBenchChunkCount; ++i) {
+			PoolBenchObject* ptr = pool->Alloc();
+			ptr->data[0] = i;
+
+			list.push_back(ptr);
+		}
+	}
+}
+
+template<typename Pool>
+static void RunAllocFree(const char* name, int threadCount) {
+	Pool pool;
+
+	BenchmarkTimer timer;
+
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < threadCount; ++i) {
+		threads.push_back(std::thread(&AllocFreeRounds<Pool>, &pool));
+	}
+
+	for (int i = 0; i < threadCount; ++i) {
+		threads[i].join();
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %d threads", name, threadCount);
+
+	BenchmarkReport(label, kPoolBenchRounds * threadCount, elapsedMs);
+}
+
+template<typename Pool>
+static void RunCrossThread(const char* name, int threadCount) {
+	Pool pool;
+
+	std::vector<PoolBenchObject*>* lists = new std::vector<PoolBenchObject*>[threadCount];
+	std::vector<std::mutex> locks(threadCount);
+
+	BenchmarkTimer timer;
+
+	std::vector<std::thread> threads;
+
+	for (int i = 0; i < threadCount; ++i) {
+		threads.push_back(std::thread(&CrossThreadRounds<Pool>, &pool, lists, i, threadCount, &locks));
+	}
+
+	for (int i = 0; i < threadCount; ++i) {
+		threads[i].join();
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	for (int i = 0; i < threadCount; ++i) {
+		for (size_t j = 0; j < lists[i].size(); ++j) {
+			pool.Dealloc(lists[i][j]);
+		}
+	}
+
+	delete[] lists;
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %d threads", name, threadCount);
+
+	BenchmarkReport(label, kPoolBenchRounds * threadCount, elapsedMs);
+}
+
+// Every thread allocates and deallocates its own chunks
+BENCHMARK(ConcurrentPool, AllocFree) {
+	const int threadCounts[] = { 1, 2, 4, 8 };
+
+	for (int i = 0; i < 4; ++i) {
+		RunAllocFree<ConcurrentPool>("ConcurrentPoolAllocator", threadCounts[i]);
+		RunAllocFree<LockedPool>("PoolAllocator + mutex", threadCounts[i]);
+		RunAllocFree<HeapPool>("operator new", threadCounts[i]);
+	}
+}
+
+// Every chunk is deallocated on a different thread than it was allocated on
+BENCHMARK(ConcurrentPool, CrossThread) {
+	const int threadCounts[] = { 2, 4, 8 };
+
+	for (int i = 0; i < 3; ++i) {
+		RunCrossThread<ConcurrentPool>("ConcurrentPoolAllocator", threadCounts[i]);
+		RunCrossThread<LockedPool>("PoolAllocator + mutex", threadCounts[i]);
+		RunCrossThread<HeapPool>("operator new", threadCounts[i]);
+	}
+}
\ No newline at end of file
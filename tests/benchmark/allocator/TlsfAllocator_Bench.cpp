@@ -0,0 +1,139 @@
+#include "Benchmark.h"
+
+#include "allocator/BlockAllocator.h"
+#include "allocator/TlsfAllocator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Resources loaded at once during the session
+const int kTlsfBenchSlotCount = 256;
+
+// Loads and unloads in the session
+const int kTlsfBenchOpCount = 200000;
+
+// Sizes of the mid-sized assets, in bytes
+const size_t kTlsfBenchSizeMin = 4 * 1024;
+const size_t kTlsfBenchSizeMax = 256 * 1024;
+
+// Sizes of the assets that are larger than a block of the BlockAllocator
+const size_t kTlsfBenchLargeSizeMin = 256 * 1024;
+const size_t kTlsfBenchLargeSizeMax = 4 * 1024 * 1024;
+
+// Resources loaded at once during the session of large assets; about a
+// quarter of the memory
+const int kTlsfBenchLargeSlotCount = 32;
+
+// Same sizes as ResourceManager used for its BlockAllocator
+const size_t kTlsfBenchBlockSize = 2 * 1024 * 1024;
+const size_t kTlsfBenchBlockCount = 128;
+
+class TlsfBenchAllocator {
+
+public:
+	TlsfBenchAllocator(): m_Allocator(kTlsfBenchBlockSize * kTlsfBenchBlockCount) {}
+
+	void* Alloc(size_t size) { return m_Allocator.Alloc(size); }
+	void Dealloc(void* ptr) { m_Allocator.Dealloc(ptr); }
+
+private:
+	TlsfAllocator m_Allocator;
+};
+
+class BlockBenchAllocator {
+
+public:
+	BlockBenchAllocator(): m_Allocator(kTlsfBenchBlockSize, kTlsfBenchBlockCount) {}
+
+	void* Alloc(size_t size) { return m_Allocator.Alloc(size); }
+	void Dealloc(void* ptr) { m_Allocator.Dealloc(ptr); }
+
+private:
+	BlockAllocator m_Allocator;
+};
+
+class MallocBenchAllocator {
+
+public:
+	void* Alloc(size_t size) { return malloc(size); }
+	void Dealloc(void* ptr) { free(ptr); }
+};
+
+// Randomly loads and unloads assets, timing the first and the last part of
+// the session separately to show if the allocator slows down over time
+template<typename Allocator>
+static void RunSession(const char* name, int slotCount, size_t sizeMin, size_t sizeMax) {
+	Allocator* allocator = new Allocator();
+
+	std::vector<void*> slots(slotCount, nullptr);
+
+	srand(7);
+
+	const int partCount = 4;
+	const int opsPerPart = kTlsfBenchOpCount / partCount;
+
+	int failCount = 0;
+
+	for (int part = 0; part < partCount; ++part) {
+		BenchmarkTimer timer;
+
+		for (int i = 0; i < opsPerPart; ++i) {
+			int slot = rand() % slotCount;
+
+			if (slots[slot] != nullptr) {
+				allocator->Dealloc(slots[slot]);
+				slots[slot] = nullptr;
+			}
+			else {
+				size_t size = sizeMin + (size_t)rand() % (sizeMax - sizeMin);
+
+				slots[slot] = allocator->Alloc(size);
+
+				if (slots[slot] == nullptr) {
+					++failCount;
+				}
+				else {
+					*(byte_t*)slots[slot] = (byte_t)i;
+				}
+			}
+		}
+
+		double elapsedMs = timer.GetElapsedMs();
+
+		char label[64];
+		snprintf(label, sizeof(label), "%s, ops %d-%d", name, part * opsPerPart, (part + 1) * opsPerPart);
+
+		BenchmarkReport(label, opsPerPart, elapsedMs);
+	}
+
+	if (failCount > 0) {
+		printf("  %s: %d allocations failed\n", name, failCount);
+	}
+
+	for (int i = 0; i < slotCount; ++i) {
+		if (slots[i] != nullptr) {
+			allocator->Dealloc(slots[i]);
+		}
+	}
+
+	delete allocator;
+}
+
+// Session of loads and unloads of mid-sized assets, like the resource
+// manager sees over a play session
+BENCHMARK(TlsfAllocator, Session) {
+	RunSession<TlsfBenchAllocator>("TlsfAllocator", kTlsfBenchSlotCount, kTlsfBenchSizeMin, kTlsfBenchSizeMax);
+	RunSession<BlockBenchAllocator>("BlockAllocator", kTlsfBenchSlotCount, kTlsfBenchSizeMin, kTlsfBenchSizeMax);
+	RunSession<MallocBenchAllocator>("malloc", kTlsfBenchSlotCount, kTlsfBenchSizeMin, kTlsfBenchSizeMax);
+}
+
+// Same with assets of several blocks. BlockAllocator is left out: it only
+// takes multiple blocks from the top of its pool and never reuses them, so
+// it runs out of memory early in the session
+BENCHMARK(TlsfAllocator, LargeSession) {
+	RunSession<TlsfBenchAllocator>("TlsfAllocator", kTlsfBenchLargeSlotCount, kTlsfBenchLargeSizeMin,
+								   kTlsfBenchLargeSizeMax);
+	RunSession<MallocBenchAllocator>("malloc", kTlsfBenchLargeSlotCount, kTlsfBenchLargeSizeMin,
+									 kTlsfBenchLargeSizeMax);
+}
\ No newline at end of file
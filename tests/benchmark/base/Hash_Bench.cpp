@@ -0,0 +1,142 @@
+#include "Benchmark.h"
+
+#include "hash/MurmurHash2.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+// Number of bytes hashed in each throughput measurement
+const size_t kHashBenchBytes = 64 * 1024 * 1024;
+
+// Number of keys and buckets in each collision measurement
+const int kHashBenchKeyCount = 1 << 16;
+
+typedef uint64_t (*HashBenchFunc_t)(const void* data, size_t size);
+
+static uint64_t HashMurmur(const void* data, size_t size) {
+	return MurmurHash64A(data, (int)size, kHashSeed);
+}
+
+static uint64_t HashFast(const void* data, size_t size) {
+	return FastHash64(data, size, kHashSeed);
+}
+
+static uint64_t HashBulk(const void* data, size_t size) {
+	return FastHashBulk(data, size, kHashSeed);
+}
+
+// Times hashing a buffer of the specified size over and over, and reports
+// the throughput
+static void RunThroughput(const char* name, HashBenchFunc_t func, size_t size) {
+	unsigned char* buffer = new unsigned char[size + 1];
+
+	for (size_t i = 0; i <= size; ++i) {
+		buffer[i] = (unsigned char)rand();
+	}
+
+	int iterations = (int)(kHashBenchBytes / size);
+
+	uint64_t sum = 0;
+
+	BenchmarkTimer timer;
+
+	// Odd offsets so that every other read is unaligned
+	for (int i = 0; i < iterations; ++i) {
+		sum += func(buffer + (i & 1), size);
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	BenchmarkUseValue(sum);
+
+	double bytesPerSec = (double)iterations * (double)size / (elapsedMs / 1000.0);
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %zu bytes, %.2f GB/s", name, size, bytesPerSec / 1e9);
+
+	BenchmarkReport(label, iterations, elapsedMs);
+
+	delete[] buffer;
+}
+
+// Hashes a set of similar keys into as many buckets as keys, indexed by the
+// low bits of the hash like the hash containers do, and reports the longest
+// bucket and the ratio of the chi-squared statistic to its expected value,
+// which is near 1 for a uniform hash
+static void RunCollisions(const char* name, HashBenchFunc_t func, const char* keySet) {
+	int* bucketSizes = new int[kHashBenchKeyCount];
+	memset(bucketSizes, 0, sizeof(int) * kHashBenchKeyCount);
+
+	for (int i = 0; i < kHashBenchKeyCount; ++i) {
+		uint64_t hash;
+
+		if (strcmp(keySet, "ints") == 0) {
+			hash = func(&i, sizeof(i));
+		}
+		else if (strcmp(keySet, "pointers") == 0) {
+			// Addresses of 64 byte aligned objects
+			uint64_t address = 0x7F0000000000ULL + (uint64_t)i * 64;
+			hash = func(&address, sizeof(address));
+		}
+		else {
+			char name[32];
+			int length = snprintf(name, sizeof(name), "sprites/entity_%d.png", i);
+			hash = func(name, (size_t)length);
+		}
+
+		++bucketSizes[hash & (uint64_t)(kHashBenchKeyCount - 1)];
+	}
+
+	int maxSize = 0;
+	double chiSquared = 0.0;
+
+	// Expected size of each bucket is 1
+	for (int i = 0; i < kHashBenchKeyCount; ++i) {
+		if (bucketSizes[i] > maxSize) {
+			maxSize = bucketSizes[i];
+		}
+
+		chiSquared += (double)(bucketSizes[i] - 1) * (double)(bucketSizes[i] - 1);
+	}
+
+	printf("  %-48s longest bucket %d, chi-squared / expected %.3f\n",
+		   name, maxSize, chiSquared / (double)(kHashBenchKeyCount - 1));
+
+	delete[] bucketSizes;
+}
+
+// Short keys, such as ints, pointers and names
+BENCHMARK(Hash, ShortKeys) {
+	const size_t sizes[] = { 4, 8, 16, 32 };
+
+	for (int i = 0; i < 4; ++i) {
+		RunThroughput("MurmurHash64A", &HashMurmur, sizes[i]);
+		RunThroughput("FastHash64", &HashFast, sizes[i]);
+	}
+}
+
+// Long buffers, such as resource data
+BENCHMARK(Hash, Bulk) {
+	const size_t sizes[] = { 256, 4096, 1024 * 1024 };
+
+	for (int i = 0; i < 3; ++i) {
+		RunThroughput("MurmurHash64A", &HashMurmur, sizes[i]);
+		RunThroughput("FastHash64", &HashFast, sizes[i]);
+		RunThroughput("FastHashBulk", &HashBulk, sizes[i]);
+	}
+}
+
+// Distribution of keys that differ in only a few bits
+BENCHMARK(Hash, Collisions) {
+	const char* keySets[] = { "ints", "pointers", "strings" };
+
+	for (int i = 0; i < 3; ++i) {
+		char label[64];
+
+		snprintf(label, sizeof(label), "MurmurHash64A, %s", keySets[i]);
+		RunCollisions(label, &HashMurmur, keySets[i]);
+
+		snprintf(label, sizeof(label), "FastHash64, %s", keySets[i]);
+		RunCollisions(label, &HashFast, keySets[i]);
+	}
+}
\ No newline at end of file
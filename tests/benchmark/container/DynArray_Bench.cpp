@@ -0,0 +1,154 @@
+#include "Benchmark.h"
+
+#include "container/DynArray.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+const int kDynArrayBenchIterations = 10;
+
+// Number of elements in the arrays that elements are inserted into and
+// removed from
+const int kDynArrayBenchShiftCount = 4096;
+
+// Appends the elements to an array that either starts empty and grows, or
+// is allocated for all of them up front
+template<typename T>
+static void RunPushBack(const char* name, int elementCount, bool preallocate) {
+	BenchmarkTimer timer;
+
+	size_t sum = 0;
+
+	for (int i = 0; i < kDynArrayBenchIterations; ++i) {
+		DynArray<T> array;
+
+		if (preallocate) {
+			array.Reserve(elementCount);
+		}
+
+		for (int j = 0; j < elementCount; ++j) {
+			array.EmplaceBack(T());
+		}
+
+		sum += array.GetSize();
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	BenchmarkUseValue(sum);
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %s, %d elements", name,
+			 preallocate ? "preallocated" : "grown", elementCount);
+
+	BenchmarkReport(label, kDynArrayBenchIterations, elapsedMs);
+}
+
+// Inserts at the front by shifting one element at a time; how Insert() moved
+// the elements before it used memmove()
+static void InsertByAssignment(DynArray<int>* array, int element) {
+	array->PushBack(element);
+
+	for (int i = (int)array->GetSize() - 1; i > 0; --i) {
+		(*array)[i] = (*array)[i - 1];
+	}
+
+	(*array)[0] = element;
+}
+
+static void RunInsertFront(const char* name, bool assignment) {
+	BenchmarkTimer timer;
+
+	size_t sum = 0;
+
+	for (int i = 0; i < kDynArrayBenchIterations; ++i) {
+		DynArray<int> array(kDynArrayBenchShiftCount);
+
+		for (int j = 0; j < kDynArrayBenchShiftCount; ++j) {
+			if (assignment) {
+				InsertByAssignment(&array, j);
+			}
+			else {
+				array.Insert(j, 0);
+			}
+		}
+
+		sum += array[0];
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	BenchmarkUseValue(sum);
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %d elements", name, kDynArrayBenchShiftCount);
+
+	BenchmarkReport(label, kDynArrayBenchIterations, elapsedMs);
+}
+
+// Removes elements at random positions until the array is empty, like a
+// list of projectiles that are destroyed in any order
+static void RunRemove(const char* name, bool swap) {
+	BenchmarkTimer timer;
+
+	size_t sum = 0;
+
+	srand(1);
+
+	for (int i = 0; i < kDynArrayBenchIterations; ++i) {
+		DynArray<int> array(kDynArrayBenchShiftCount);
+
+		for (int j = 0; j < kDynArrayBenchShiftCount; ++j) {
+			array.PushBack(j);
+		}
+
+		while (!array.IsEmpty()) {
+			int index = rand() % (int)array.GetSize();
+
+			sum += array[index];
+
+			if (swap) {
+				array.SwapRemove(index);
+			}
+			else {
+				array.Remove(index);
+			}
+		}
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	BenchmarkUseValue(sum);
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %d elements", name, kDynArrayBenchShiftCount);
+
+	BenchmarkReport(label, kDynArrayBenchIterations, elapsedMs);
+}
+
+// Cost of growing instead of allocating for the worst case up front
+BENCHMARK(DynArray, PushBack) {
+	const int elementCounts[] = { 1024, 65536, 1048576 };
+
+	for (int i = 0; i < 3; ++i) {
+		RunPushBack<int>("int", elementCounts[i], true);
+		RunPushBack<int>("int", elementCounts[i], false);
+	}
+
+	// Strings are moved, not copied, when the array grows
+	for (int i = 0; i < 2; ++i) {
+		RunPushBack<std::string>("std::string", elementCounts[i], true);
+		RunPushBack<std::string>("std::string", elementCounts[i], false);
+	}
+}
+
+BENCHMARK(DynArray, InsertFront) {
+	RunInsertFront("Shifted by assignment", true);
+	RunInsertFront("Insert", false);
+}
+
+BENCHMARK(DynArray, Remove) {
+	RunRemove("Remove", false);
+	RunRemove("SwapRemove", true);
+}
\ No newline at end of file
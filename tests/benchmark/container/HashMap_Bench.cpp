@@ -0,0 +1,128 @@
+#include "Benchmark.h"
+
+#include "container/HashMap.h"
+#include "container/FlatHashMap.h"
+
+#include <cstdio>
+
+// Number of times each operation is repeated over the whole map
+const int kHashMapBenchIterations = 20;
+
+// Lookups and iteration results are summed into here so the loops are not
+// optimised out
+static volatile uint64_t s_HashMapBenchSink;
+
+// Keys are hashes of strings, like resource ids
+static uint64_t MakeKey(int i) {
+	Hash<int> hashClass;
+
+	return hashClass.HashFunc(i);
+}
+
+template<typename MapType>
+static void RunInsert(const char* name, int entryCount) {
+	BenchmarkTimer timer;
+
+	for (int i = 0; i < kHashMapBenchIterations; ++i) {
+		MapType map(entryCount);
+
+		for (int j = 0; j < entryCount; ++j) {
+			map.Insert(MakeKey(j), (uint64_t)j);
+		}
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %d entries", name, entryCount);
+
+	BenchmarkReport(label, kHashMapBenchIterations, elapsedMs);
+}
+
+// Half the lookups are for keys that are not in the map
+template<typename MapType>
+static void RunFind(const char* name, int entryCount) {
+	MapType map(entryCount);
+
+	for (int i = 0; i < entryCount; ++i) {
+		map.Insert(MakeKey(i), (uint64_t)i);
+	}
+
+	BenchmarkTimer timer;
+
+	uint64_t sum = 0;
+
+	for (int i = 0; i < kHashMapBenchIterations; ++i) {
+		for (int j = 0; j < entryCount * 2; ++j) {
+			auto it = map.Find(MakeKey(j));
+
+			if (it != map.End()) {
+				sum += it.GetValue();
+			}
+		}
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	s_HashMapBenchSink = sum;
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %d entries", name, entryCount);
+
+	BenchmarkReport(label, kHashMapBenchIterations, elapsedMs);
+}
+
+template<typename MapType>
+static void RunIterate(const char* name, int entryCount) {
+	MapType map(entryCount);
+
+	for (int i = 0; i < entryCount; ++i) {
+		map.Insert(MakeKey(i), (uint64_t)i);
+	}
+
+	BenchmarkTimer timer;
+
+	uint64_t sum = 0;
+
+	for (int i = 0; i < kHashMapBenchIterations; ++i) {
+		for (auto it = map.Begin(); it != map.End(); ++it) {
+			sum += it.GetValue();
+		}
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	s_HashMapBenchSink = sum;
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %d entries", name, entryCount);
+
+	BenchmarkReport(label, kHashMapBenchIterations, elapsedMs);
+}
+
+BENCHMARK(HashMap, Insert) {
+	const int entryCounts[] = { 1024, 65536 };
+
+	for (int i = 0; i < 2; ++i) {
+		RunInsert<HashMap<uint64_t, uint64_t> >("HashMap", entryCounts[i]);
+		RunInsert<FlatHashMap<uint64_t, uint64_t> >("FlatHashMap", entryCounts[i]);
+	}
+}
+
+BENCHMARK(HashMap, Find) {
+	const int entryCounts[] = { 1024, 65536 };
+
+	for (int i = 0; i < 2; ++i) {
+		RunFind<HashMap<uint64_t, uint64_t> >("HashMap", entryCounts[i]);
+		RunFind<FlatHashMap<uint64_t, uint64_t> >("FlatHashMap", entryCounts[i]);
+	}
+}
+
+BENCHMARK(HashMap, Iterate) {
+	const int entryCounts[] = { 1024, 65536 };
+
+	for (int i = 0; i < 2; ++i) {
+		RunIterate<HashMap<uint64_t, uint64_t> >("HashMap", entryCounts[i]);
+		RunIterate<FlatHashMap<uint64_t, uint64_t> >("FlatHashMap", entryCounts[i]);
+	}
+}
\ No newline at end of file
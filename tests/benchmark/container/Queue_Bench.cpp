@@ -0,0 +1,169 @@
+#include "Benchmark.h"
+
+#include "container/Queue.h"
+#include "container/SpscQueue.h"
+#include "container/MpmcQueue.h"
+
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+// Number of elements passed through the queue in each measurement
+const int kQueueBenchItemCount = 1 << 20;
+
+const int kQueueBenchCapacity = 1024;
+
+// Elements pushed before popping them in the single thread tests
+const int kQueueBenchBatchSize = 64;
+
+// Popped values are summed into here so the loops are not optimised out
+static volatile int s_QueueBenchSink;
+
+// Queue<T> with a mutex; what a cross-thread queue costs without the
+// lock-free ones
+class LockedQueue {
+
+public:
+	LockedQueue(int capacity): m_Queue(capacity) {}
+
+	bool TryPush(int data) {
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (m_Queue.IsFull()) {
+			return false;
+		}
+
+		m_Queue.PushBack(data);
+
+		return true;
+	}
+
+	bool TryPop(int* data) {
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		if (m_Queue.IsEmpty()) {
+			return false;
+		}
+
+		*data = m_Queue.GetFront();
+		m_Queue.PopFront();
+
+		return true;
+	}
+
+private:
+	Queue<int> m_Queue;
+	std::mutex m_Mutex;
+};
+
+// Pushes and pops batches of elements on one thread
+template<typename QueueType>
+static void RunSingleThread(const char* name, QueueType* queue) {
+	BenchmarkTimer timer;
+
+	int sum = 0;
+
+	for (int i = 0; i < kQueueBenchItemCount; i += kQueueBenchBatchSize) {
+		for (int j = 0; j < kQueueBenchBatchSize; ++j) {
+			queue->TryPush(i + j);
+		}
+
+		for (int j = 0; j < kQueueBenchBatchSize; ++j) {
+			int value = 0;
+			queue->TryPop(&value);
+			sum += value;
+		}
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	s_QueueBenchSink = sum;
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %d items", name, kQueueBenchItemCount);
+
+	BenchmarkReport(label, 1, elapsedMs);
+}
+
+// Passes elements from one producer thread to one consumer thread
+template<typename QueueType>
+static void RunProducerConsumer(const char* name, QueueType* queue) {
+	BenchmarkTimer timer;
+
+	std::thread producer([queue]() {
+		for (int i = 0; i < kQueueBenchItemCount; ++i) {
+			while (!queue->TryPush(i)) {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	int received = 0;
+
+	while (received < kQueueBenchItemCount) {
+		int value;
+
+		if (queue->TryPop(&value)) {
+			++received;
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+
+	producer.join();
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %d items", name, kQueueBenchItemCount);
+
+	BenchmarkReport(label, 1, elapsedMs);
+}
+
+// Cost of the queue operations without contention
+BENCHMARK(Queue, SingleThread) {
+	Queue<int> queue(kQueueBenchCapacity);
+
+	BenchmarkTimer timer;
+
+	int sum = 0;
+
+	for (int i = 0; i < kQueueBenchItemCount; i += kQueueBenchBatchSize) {
+		for (int j = 0; j < kQueueBenchBatchSize; ++j) {
+			queue.PushBack(i + j);
+		}
+
+		for (int j = 0; j < kQueueBenchBatchSize; ++j) {
+			sum += queue.GetFront();
+			queue.PopFront();
+		}
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	s_QueueBenchSink = sum;
+
+	char label[64];
+	snprintf(label, sizeof(label), "Queue, %d items", kQueueBenchItemCount);
+
+	BenchmarkReport(label, 1, elapsedMs);
+
+	SpscQueue<int> spscQueue(kQueueBenchCapacity);
+	RunSingleThread("SpscQueue", &spscQueue);
+
+	MpmcQueue<int> mpmcQueue(kQueueBenchCapacity);
+	RunSingleThread("MpmcQueue", &mpmcQueue);
+}
+
+// Cost of passing elements between two threads
+BENCHMARK(Queue, ProducerConsumer) {
+	LockedQueue lockedQueue(kQueueBenchCapacity);
+	RunProducerConsumer("Queue with mutex", &lockedQueue);
+
+	SpscQueue<int> spscQueue(kQueueBenchCapacity);
+	RunProducerConsumer("SpscQueue", &spscQueue);
+
+	MpmcQueue<int> mpmcQueue(kQueueBenchCapacity);
+	RunProducerConsumer("MpmcQueue", &mpmcQueue);
+}
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "Benchmark.h"
+
+#include "container/TreeMap.h"
+#include "container/BTreeMap.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+// Number of times each operation is repeated over the whole map
+const int kTreeMapBenchIterations = 10;
+
+// Number of entries visited by each range scan
+const int kTreeMapBenchRangeSize = 64;
+
+// Keys 0 to count - 1 in random order
+static int* MakeShuffledKeys(int count) {
+	int* keys = new int[count];
+
+	for (int i = 0; i < count; ++i) {
+		keys[i] = i;
+	}
+
+	srand(1);
+
+	for (int i = count - 1; i > 0; --i) {
+		int j = rand() % (i + 1);
+
+		int temp = keys[i];
+		keys[i] = keys[j];
+		keys[j] = temp;
+	}
+
+	return keys;
+}
+
+template<typename MapType>
+static void FillMap(MapType* map, const int* keys, int count) {
+	for (int i = 0; i < count; ++i) {
+		map->Insert(keys[i], (uint64_t)keys[i]);
+	}
+}
+
+template<typename MapType>
+static void RunInsert(const char* name, int entryCount) {
+	int* keys = MakeShuffledKeys(entryCount);
+
+	BenchmarkTimer timer;
+
+	for (int i = 0; i < kTreeMapBenchIterations; ++i) {
+		MapType map(entryCount);
+
+		FillMap(&map, keys, entryCount);
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %d entries", name, entryCount);
+
+	BenchmarkReport(label, kTreeMapBenchIterations, elapsedMs);
+
+	delete[] keys;
+}
+
+template<typename MapType>
+static void RunFind(const char* name, int entryCount) {
+	int* keys = MakeShuffledKeys(entryCount);
+
+	MapType map(entryCount);
+	FillMap(&map, keys, entryCount);
+
+	BenchmarkTimer timer;
+
+	uint64_t sum = 0;
+
+	for (int i = 0; i < kTreeMapBenchIterations; ++i) {
+		for (int j = 0; j < entryCount; ++j) {
+			sum += map.Find(keys[j]).GetValue();
+		}
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	BenchmarkUseValue(sum);
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %d entries", name, entryCount);
+
+	BenchmarkReport(label, kTreeMapBenchIterations, elapsedMs);
+
+	delete[] keys;
+}
+
+template<typename MapType>
+static void RunIterate(const char* name, int entryCount) {
+	int* keys = MakeShuffledKeys(entryCount);
+
+	MapType map(entryCount);
+	FillMap(&map, keys, entryCount);
+
+	BenchmarkTimer timer;
+
+	uint64_t sum = 0;
+
+	for (int i = 0; i < kTreeMapBenchIterations; ++i) {
+		for (auto it = map.Begin(); it != map.End(); ++it) {
+			sum += it.GetValue();
+		}
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	BenchmarkUseValue(sum);
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %d entries", name, entryCount);
+
+	BenchmarkReport(label, kTreeMapBenchIterations, elapsedMs);
+
+	delete[] keys;
+}
+
+// Visits a short run of entries from each key, like finding the timers that
+// are due
+template<typename MapType>
+static void RunRangeScan(const char* name, int entryCount) {
+	int* keys = MakeShuffledKeys(entryCount);
+
+	MapType map(entryCount);
+	FillMap(&map, keys, entryCount);
+
+	BenchmarkTimer timer;
+
+	uint64_t sum = 0;
+
+	for (int i = 0; i < kTreeMapBenchIterations; ++i) {
+		for (int j = 0; j < entryCount; j += kTreeMapBenchRangeSize) {
+			auto it = map.Find(keys[j]);
+
+			for (int k = 0; k < kTreeMapBenchRangeSize && it != map.End(); ++k, ++it) {
+				sum += it.GetValue();
+			}
+		}
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	BenchmarkUseValue(sum);
+
+	char label[64];
+	snprintf(label, sizeof(label), "%s, %d entries", name, entryCount);
+
+	BenchmarkReport(label, kTreeMapBenchIterations, elapsedMs);
+
+	delete[] keys;
+}
+
+BENCHMARK(TreeMap, Insert) {
+	const int entryCounts[] = { 1024, 65536, 1048576 };
+
+	for (int i = 0; i < 3; ++i) {
+		RunInsert<TreeMap<int, uint64_t> >("TreeMap", entryCounts[i]);
+		RunInsert<BTreeMap<int, uint64_t> >("BTreeMap", entryCounts[i]);
+	}
+}
+
+// Building from sorted input, compared with inserting it in order
+BENCHMARK(TreeMap, BulkLoad) {
+	const int entryCounts[] = { 1024, 65536, 1048576 };
+
+	for (int i = 0; i < 3; ++i) {
+		int entryCount = entryCounts[i];
+
+		int* keys = new int[entryCount];
+		uint64_t* values = new uint64_t[entryCount];
+
+		for (int j = 0; j < entryCount; ++j) {
+			keys[j] = j;
+			values[j] = (uint64_t)j;
+		}
+
+		char label[64];
+
+		BenchmarkTimer timer;
+
+		for (int j = 0; j < kTreeMapBenchIterations; ++j) {
+			BTreeMap<int, uint64_t> map(entryCount);
+
+			FillMap(&map, keys, entryCount);
+		}
+
+		snprintf(label, sizeof(label), "BTreeMap sorted inserts, %d entries", entryCount);
+		BenchmarkReport(label, kTreeMapBenchIterations, timer.GetElapsedMs());
+
+		timer.Start();
+
+		for (int j = 0; j < kTreeMapBenchIterations; ++j) {
+			BTreeMap<int, uint64_t> map(entryCount);
+
+			map.BulkLoad(keys, values, entryCount);
+		}
+
+		snprintf(label, sizeof(label), "BTreeMap bulk load, %d entries", entryCount);
+		BenchmarkReport(label, kTreeMapBenchIterations, timer.GetElapsedMs());
+
+		delete[] values;
+		delete[] keys;
+	}
+}
+
+BENCHMARK(TreeMap, Find) {
+	const int entryCounts[] = { 1024, 65536, 1048576 };
+
+	for (int i = 0; i < 3; ++i) {
+		RunFind<TreeMap<int, uint64_t> >("TreeMap", entryCounts[i]);
+		RunFind<BTreeMap<int, uint64_t> >("BTreeMap", entryCounts[i]);
+	}
+}
+
+BENCHMARK(TreeMap, Iterate) {
+	const int entryCounts[] = { 1024, 65536, 1048576 };
+
+	for (int i = 0; i < 3; ++i) {
+		RunIterate<TreeMap<int, uint64_t> >("TreeMap", entryCounts[i]);
+		RunIterate<BTreeMap<int, uint64_t> >("BTreeMap", entryCounts[i]);
+	}
+}
+
+BENCHMARK(TreeMap, RangeScan) {
+	const int entryCounts[] = { 1024, 65536, 1048576 };
+
+	for (int i = 0; i < 3; ++i) {
+		RunRangeScan<TreeMap<int, uint64_t> >("TreeMap", entryCounts[i]);
+		RunRangeScan<BTreeMap<int, uint64_t> >("BTreeMap", entryCounts[i]);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+
+#include "job/JobSystem.h"
+
+#include <cmath>
+#include <cstdio>
+
+// Number of items processed by ParallelFor in each iteration
+const size_t kJobBenchItemCount = 1 << 18;
+
+const int kJobBenchIterations = 50;
+
+// Number of empty jobs submitted in each iteration of the overhead test
+const size_t kJobBenchJobCount = 1024;
+
+// Does a few hundred cycles of work per item, about the cost of a pair test
+static void ComputeTask(void* context, size_t begin, size_t end) {
+	double* items = (double*)context;
+
+	for (size_t i = begin; i < end; ++i) {
+		double value = items[i];
+
+		for (int j = 0; j < 16; ++j) {
+			value = sqrt(value * value + 1.0);
+		}
+
+		items[i] = value;
+	}
+}
+
+static void EmptyTask(void* context, size_t begin, size_t end) {
+
+}
+
+// Time to run the same work on more threads
+BENCHMARK(JobSystem, ParallelFor) {
+	const int workerCounts[] = { 0, 1, 3, 7 };
+
+	double* items = new double[kJobBenchItemCount];
+
+	for (int i = 0; i < 4; ++i) {
+		JobSystem jobSystem(workerCounts[i]);
+
+		for (size_t j = 0; j < kJobBenchItemCount; ++j) {
+			items[j] = (double)j;
+		}
+
+		BenchmarkTimer timer;
+
+		for (int j = 0; j < kJobBenchIterations; ++j) {
+			jobSystem.ParallelFor(&ComputeTask, (void*)items, kJobBenchItemCount, 1024);
+		}
+
+		double elapsedMs = timer.GetElapsedMs();
+
+		char label[64];
+		snprintf(label, sizeof(label), "%zu items, %d workers", kJobBenchItemCount, workerCounts[i]);
+
+		BenchmarkReport(label, kJobBenchIterations, elapsedMs);
+	}
+
+	delete[] items;
+}
+
+// Cost of submitting and running jobs that do no work
+BENCHMARK(JobSystem, Overhead) {
+	const int workerCounts[] = { 0, 1, 3 };
+
+	for (int i = 0; i < 3; ++i) {
+		JobSystem jobSystem(workerCounts[i]);
+
+		BenchmarkTimer timer;
+
+		for (int j = 0; j < kJobBenchIterations; ++j) {
+			JobCounter counter;
+
+			for (size_t k = 0; k < kJobBenchJobCount; ++k) {
+				jobSystem.Submit(&EmptyTask, nullptr, k, k + 1, &counter);
+			}
+
+			jobSystem.Wait(&counter);
+		}
+
+		double elapsedMs = timer.GetElapsedMs();
+
+		char label[64];
+		snprintf(label, sizeof(label), "%zu jobs, %d workers", kJobBenchJobCount, workerCounts[i]);
+
+		BenchmarkReport(label, kJobBenchIterations, elapsedMs);
+	}
+}
\ No newline at end of file
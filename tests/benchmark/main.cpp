@@ -0,0 +1,13 @@
+#include "base_include.h"
+
+#include "Benchmark.h"
+
+int main(int argc, char* argv[]) {
+
+	// Runs only the benchmarks of one group if the group name is given
+	const char* group = (argc > 1) ? argv[1] : nullptr;
+
+	BenchmarkRunAll(group);
+
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "Benchmark.h"
+
+#include "physics/CollisionDetector.h"
+
+#include <cstdlib>
+
+// Number of AABB pairs tested in each iteration
+const int kCollisionBenchPairCount = 4096;
+
+const int kCollisionBenchIterations = 1000;
+
+// Returns a random number in range [0, 1]
+static double RandomUnit() {
+	return (double)rand() / (double)RAND_MAX;
+}
+
+// Pairs of 16x16 AABBs placed so that about half of them overlap, like the
+// pairs reported by the broad phase
+static void FillBenchRects(double* minX, double* minY, double* maxX, double* maxY, double spread) {
+	for (int i = 0; i < kCollisionBenchPairCount; ++i) {
+		minX[i] = RandomUnit() * spread;
+		minY[i] = RandomUnit() * spread;
+		maxX[i] = minX[i] + 16.0;
+		maxY[i] = minY[i] + 16.0;
+	}
+}
+
+// Compares testing the pairs one at a time with the batched test
+BENCHMARK(CollisionDetector, AABBToAABB) {
+	CollisionDetector detector;
+
+	double* bounds = new double[kCollisionBenchPairCount * 8];
+
+	double* minX1 = bounds;
+	double* minY1 = bounds + kCollisionBenchPairCount;
+	double* maxX1 = bounds + kCollisionBenchPairCount * 2;
+	double* maxY1 = bounds + kCollisionBenchPairCount * 3;
+	double* minX2 = bounds + kCollisionBenchPairCount * 4;
+	double* minY2 = bounds + kCollisionBenchPairCount * 5;
+	double* maxX2 = bounds + kCollisionBenchPairCount * 6;
+	double* maxY2 = bounds + kCollisionBenchPairCount * 7;
+
+	srand(1);
+
+	FillBenchRects(minX1, minY1, maxX1, maxY1, 24.0);
+	FillBenchRects(minX2, minY2, maxX2, maxY2, 24.0);
+
+	uint8_t* collisions = new uint8_t[kCollisionBenchPairCount];
+	double* mtvX = new double[kCollisionBenchPairCount];
+	double* mtvY = new double[kCollisionBenchPairCount];
+
+	uint64_t hitCount = 0;
+
+	// One pair at a time
+	BenchmarkTimer timer;
+
+	for (int iter = 0; iter < kCollisionBenchIterations; ++iter) {
+		for (int i = 0; i < kCollisionBenchPairCount; ++i) {
+			Rect rect1(minX1[i], minY1[i], maxX1[i] - minX1[i], maxY1[i] - minY1[i]);
+			Rect rect2(minX2[i], minY2[i], maxX2[i] - minX2[i], maxY2[i] - minY2[i]);
+
+			Vec2 mtv = detector.AABBToAABB(rect1, rect2);
+
+			if (mtv != Vec2(0.0, 0.0)) {
+				++hitCount;
+			}
+		}
+	}
+
+	BenchmarkReport("4096 pairs, one at a time", kCollisionBenchIterations, timer.GetElapsedMs());
+
+	// Batched
+	CollisionAABBArray rects1;
+	rects1.minX = minX1;
+	rects1.minY = minY1;
+	rects1.maxX = maxX1;
+	rects1.maxY = maxY1;
+
+	CollisionAABBArray rects2;
+	rects2.minX = minX2;
+	rects2.minY = minY2;
+	rects2.maxX = maxX2;
+	rects2.maxY = maxY2;
+
+	timer.Start();
+
+	for (int iter = 0; iter < kCollisionBenchIterations; ++iter) {
+		detector.AABBToAABBBatch(rects1, rects2, kCollisionBenchPairCount, collisions, mtvX, mtvY);
+
+		hitCount += collisions[iter % kCollisionBenchPairCount];
+	}
+
+	BenchmarkReport("4096 pairs, batched", kCollisionBenchIterations, timer.GetElapsedMs());
+
+	// One AABB against all AABBs of the second array
+	Rect rect(minX1[0], minY1[0], 16.0, 16.0);
+
+	timer.Start();
+
+	for (int iter = 0; iter < kCollisionBenchIterations; ++iter) {
+		detector.AABBToAABBBatch(rect, rects2, kCollisionBenchPairCount, collisions, mtvX, mtvY);
+
+		hitCount += collisions[iter % kCollisionBenchPairCount];
+	}
+
+	BenchmarkReport("1 against 4096, batched", kCollisionBenchIterations, timer.GetElapsedMs());
+
+	BenchmarkUseValue(hitCount);
+
+	delete[] mtvY;
+	delete[] mtvX;
+	delete[] collisions;
+	delete[] bounds;
+}
\ No newline at end of file
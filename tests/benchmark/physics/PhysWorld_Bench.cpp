@@ -0,0 +1,132 @@
+#include "Benchmark.h"
+
+#include "physics/PhysWorld.h"
+#include "entity/Entity.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// Number of frames simulated in each measurement
+const int kPhysBenchFrameCount = 60;
+
+// Average area of the world given to each body
+//
+// Keeps the density of bodies constant as the number of bodies grows
+const double kPhysBenchAreaPerBody = 64.0 * 64.0;
+
+const double kPhysBenchBodySize = 16.0;
+
+const uint16_t kPhysBenchLayerLevel = 0;
+const uint16_t kPhysBenchLayerProj = 1;
+
+// Entity that does nothing; only used to position the bodies
+class PhysBenchEntity: public Entity {
+
+public:
+	virtual void Spawn() {}
+	virtual void Update() {}
+	virtual void OnCollision(Entity* entity) {}
+};
+
+// Returns a random number in range [0, 1]
+static double RandomUnit() {
+	return (double)rand() / (double)RAND_MAX;
+}
+
+// Times PhysWorld::Update() for a world filled with the specified number of
+// bodies
+//
+// staticCount of every eight bodies are static level geometry, and the rest
+// are projectiles moving in random directions
+static void RunPhysWorldUpdate(int bodyCount, int staticCount, double cellSize, int workerCount) {
+	JobSystem jobSystem(workerCount);
+
+	PhysWorld world(bodyCount);
+	world.SetCellSize(cellSize);
+	world.SetJobSystem(&jobSystem);
+
+	// Projectiles ignore each other like in the game
+	world.AddLayerIgnore(kPhysBenchLayerProj, kPhysBenchLayerProj);
+
+	PhysBenchEntity* entities = new PhysBenchEntity[bodyCount];
+	PhysBody** bodies = new PhysBody*[bodyCount];
+
+	double worldSize = sqrt(kPhysBenchAreaPerBody * (double)bodyCount);
+
+	// Same seed for each run so that all runs simulate the same scene
+	srand(1);
+
+	for (int i = 0; i < bodyCount; ++i) {
+		entities[i].TranslateTo(Vec2(RandomUnit() * worldSize, RandomUnit() * worldSize));
+
+		if (i % 8 < staticCount) {
+			bodies[i] = world.CreateBody(kPhysBodyStatic, kPhysBenchLayerLevel, &entities[i]);
+		}
+		else {
+			bodies[i] = world.CreateBody(kPhysBodyDynamic, kPhysBenchLayerProj, &entities[i]);
+			bodies[i]->SetVelocity(Vec2(RandomUnit() * 4.0 - 2.0, RandomUnit() * 4.0 - 2.0));
+		}
+
+		bodies[i]->SetOrigin(Vec2(kPhysBenchBodySize / 2.0, kPhysBenchBodySize / 2.0));
+		bodies[i]->SetWidth(kPhysBenchBodySize);
+		bodies[i]->SetHeight(kPhysBenchBodySize);
+	}
+
+	BenchmarkTimer timer;
+
+	for (int i = 0; i < kPhysBenchFrameCount; ++i) {
+		world.Update();
+	}
+
+	double elapsedMs = timer.GetElapsedMs();
+
+	char label[64];
+	snprintf(label, sizeof(label), "%d bodies, %d/8 static, cell size %.0f, %d workers",
+			 bodyCount, staticCount, cellSize, workerCount);
+
+	BenchmarkReport(label, kPhysBenchFrameCount, elapsedMs);
+
+	for (int i = 0; i < bodyCount; ++i) {
+		world.DestroyBody(bodies[i]);
+	}
+
+	delete[] bodies;
+	delete[] entities;
+}
+
+// Frame time as the number of bodies grows
+BENCHMARK(PhysWorld, Update) {
+	const int bodyCounts[] = { 128, 1024, 8192 };
+
+	for (int i = 0; i < 3; ++i) {
+		RunPhysWorldUpdate(bodyCounts[i], 1, kPhysBroadPhaseCellSizeDefault, 0);
+	}
+}
+
+// Frame time for different broad phase cell sizes
+BENCHMARK(PhysWorld, CellSize) {
+	const double cellSizes[] = { 16.0, 32.0, 64.0, 128.0, 256.0 };
+
+	for (int i = 0; i < 5; ++i) {
+		RunPhysWorldUpdate(1024, 1, cellSizes[i], 0);
+	}
+}
+
+// Frame time as the pair tests are split between more threads
+BENCHMARK(PhysWorld, Workers) {
+	const int workerCounts[] = { 0, 1, 3, 7 };
+
+	for (int i = 0; i < 4; ++i) {
+		RunPhysWorldUpdate(8192, 1, kPhysBroadPhaseCellSizeDefault, workerCounts[i]);
+	}
+}
+
+// Frame time as more of the bodies are resting level geometry
+BENCHMARK(PhysWorld, StaticLevel) {
+	const int staticCounts[] = { 1, 4, 7 };
+
+	for (int i = 0; i < 3; ++i) {
+		RunPhysWorldUpdate(8192, staticCounts[i], kPhysBroadPhaseCellSizeDefault, 0);
+	}
+}
\ No newline at end of file
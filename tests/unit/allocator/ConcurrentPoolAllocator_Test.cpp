@@ -0,0 +1,124 @@
+#include "ConcurrentPoolAllocator_Test.h"
+
+#include <set>
+#include <thread>
+#include <vector>
+
+// Chunks deallocated on a thread are allocated again on the same thread
+TEST_F(ConcurrentPoolAllocatorTest, AllocDealloc) {
+	std::vector<ConcurrentPoolTestStruct*> ptrs;
+
+	for (int i = 0; i < kConcurrentPoolTestSize; ++i) {
+		ptrs.push_back(allocator.Alloc());
+	}
+
+	std::set<ConcurrentPoolTestStruct*> unique(ptrs.begin(), ptrs.end());
+
+	EXPECT_EQ(unique.size(), ptrs.size());
+	EXPECT_EQ(allocator.GetChunkNum(), (size_t)kConcurrentPoolTestSize);
+
+	for (int i = 0; i < kConcurrentPoolTestSize; ++i) {
+		allocator.Dealloc(ptrs[i]);
+	}
+
+	for (int i = 0; i < kConcurrentPoolTestSize; ++i) {
+		EXPECT_EQ(unique.count(allocator.Alloc()), 1u);
+	}
+
+	EXPECT_EQ(allocator.GetChunkNum(), (size_t)kConcurrentPoolTestSize);
+}
+
+// Pool adds blocks when all chunks are used, and chunks stay in place
+TEST_F(ConcurrentPoolAllocatorTest, Growth) {
+	const int count = kConcurrentPoolTestSize * 10;
+
+	std::vector<ConcurrentPoolTestStruct*> ptrs;
+
+	for (int i = 0; i < count; ++i) {
+		ConcurrentPoolTestStruct* ptr = allocator.Alloc();
+
+		ptr->value = i;
+		ptrs.push_back(ptr);
+	}
+
+	EXPECT_GE(allocator.GetChunkNum(), (size_t)count);
+
+	std::set<ConcurrentPoolTestStruct*> unique(ptrs.begin(), ptrs.end());
+
+	EXPECT_EQ(unique.size(), ptrs.size());
+
+	for (int i = 0; i < count; ++i) {
+		EXPECT_EQ(ptrs[i]->value, i);
+
+		allocator.Dealloc(ptrs[i]);
+	}
+}
+
+// No chunk is given to two threads at once
+TEST_F(ConcurrentPoolAllocatorTest, MultiThread) {
+	const int threadCount = 4;
+	const int countPerRound = 200;
+	const int roundCount = 200;
+
+	std::vector<int> errors(threadCount, 0);
+	std::vector<std::thread> threads;
+
+	for (int t = 0; t < threadCount; ++t) {
+		threads.push_back(std::thread([this, t, &errors]() {
+			ConcurrentPoolTestStruct* ptrs[countPerRound];
+
+			for (int round = 0; round < roundCount; ++round) {
+				for (int i = 0; i < countPerRound; ++i) {
+					ptrs[i] = allocator.Alloc();
+					ptrs[i]->owner = t;
+					ptrs[i]->value = i;
+				}
+
+				std::this_thread::yield();
+
+				for (int i = 0; i < countPerRound; ++i) {
+					if (ptrs[i]->owner != t || ptrs[i]->value != i) {
+						++errors[t];
+					}
+
+					allocator.Dealloc(ptrs[i]);
+				}
+			}
+		}));
+	}
+
+	for (int t = 0; t < threadCount; ++t) {
+		threads[t].join();
+	}
+
+	for (int t = 0; t < threadCount; ++t) {
+		EXPECT_EQ(errors[t], 0);
+	}
+}
+
+// Chunks allocated on one thread and deallocated on another are reused
+TEST_F(ConcurrentPoolAllocatorTest, CrossThreadDealloc) {
+	const int count = kConcurrentPoolTestSize * 4;
+
+	std::vector<ConcurrentPoolTestStruct*> ptrs;
+
+	for (int round = 0; round < 8; ++round) {
+		for (int i = 0; i < count; ++i) {
+			ptrs.push_back(allocator.Alloc());
+		}
+
+		std::thread thread([this, &ptrs]() {
+			for (size_t i = 0; i < ptrs.size(); ++i) {
+				allocator.Dealloc(ptrs[i]);
+			}
+		});
+
+		thread.join();
+
+		ptrs.clear();
+	}
+
+	// Freeing thread returned its batches, so the pool did not grow each
+	// round
+	EXPECT_LE(allocator.GetChunkNum(), (size_t)count * 2);
+}
\ No newline at end of file
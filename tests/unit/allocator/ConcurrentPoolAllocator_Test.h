@@ -0,0 +1,37 @@
+#ifndef CONCURRENTPOOLALLOCATOR_TEST_H_
+#define CONCURRENTPOOLALLOCATOR_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include "allocator/ConcurrentPoolAllocator.h"
+
+// Chunks in the first block of the pool
+const int kConcurrentPoolTestSize = 64;
+
+struct ConcurrentPoolTestStruct {
+	int owner;
+	int value;
+	double padding[2];
+};
+
+//--------------------------------------------------
+//
+// ConcurrentPoolAllocatorTest
+//
+// ConcurrentPoolAllocator unit test
+//
+//--------------------------------------------------
+class ConcurrentPoolAllocatorTest: public ::testing::Test {
+
+protected:
+	ConcurrentPoolAllocatorTest(): allocator(kConcurrentPoolTestSize) {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	ConcurrentPoolAllocator<ConcurrentPoolTestStruct> allocator;
+};
+
+#endif
\ No newline at end of file
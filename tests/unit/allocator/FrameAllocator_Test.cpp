@@ -38,8 +38,166 @@ TEST_F(FrameAllocatorTest, SmallAlloc) {
 	allocator.Clear();
 }
 
+// No bytes are skipped if the top is already aligned
 TEST_F(FrameAllocatorTest, AlignedAlloc) {
 	allocator.AllocAligned(16, 16);
 
-	EXPECT_EQ(allocator.GetSize(), 32);
+	EXPECT_EQ(allocator.GetSize(), 16);
+
+	allocator.Alloc(1);
+
+	void* ptr = allocator.AllocAligned(8, 64);
+
+	EXPECT_EQ((size_t)ptr % 64, 0);
+	EXPECT_EQ(allocator.Alloc(0), (void*)((size_t)ptr + 8));
+}
+
+// Allocations that do not fit return nullptr and leave the top in place
+TEST_F(FrameAllocatorTest, Overflow) {
+	EXPECT_NE(allocator.Alloc(kFrameAllocatorCapacity - 8), nullptr);
+
+	EXPECT_EQ(allocator.Alloc(16), nullptr);
+	EXPECT_EQ(allocator.AllocAligned(8, 16), nullptr);
+	EXPECT_EQ(allocator.Alloc((size_t)-1), nullptr);
+
+	EXPECT_EQ(allocator.GetSize(), kFrameAllocatorCapacity - 8);
+	EXPECT_EQ(allocator.GetOverflowCount(), 3);
+
+	EXPECT_NE(allocator.Alloc(8), nullptr);
+	EXPECT_EQ(allocator.GetSize(), kFrameAllocatorCapacity);
+}
+
+TEST_F(FrameAllocatorTest, Rewind) {
+	allocator.Alloc(100);
+
+	FrameMarker marker = allocator.GetMarker();
+
+	void* ptr = allocator.Alloc(200);
+
+	allocator.Rewind(marker);
+
+	EXPECT_EQ(allocator.GetSize(), 100);
+	EXPECT_EQ(allocator.GetAllocCount(), 1);
+	EXPECT_EQ(allocator.Alloc(200), ptr);
+
+	{
+		FrameAllocatorScope scope(&allocator);
+
+		allocator.Alloc(300);
+
+		EXPECT_EQ(allocator.GetSize(), 600);
+	}
+
+	EXPECT_EQ(allocator.GetSize(), 300);
+}
+
+// Peak size tracks the most bytes used at once, including memory that was
+// rewound
+TEST_F(FrameAllocatorTest, PeakSize) {
+	FrameMarker marker = allocator.GetMarker();
+
+	allocator.Alloc(500);
+	allocator.Rewind(marker);
+	allocator.Alloc(100);
+
+	EXPECT_EQ(allocator.GetPeakSize(), 500);
+
+	allocator.NextFrame();
+
+	EXPECT_EQ(allocator.GetSize(), 0);
+	EXPECT_EQ(allocator.GetPeakSize(), 0);
+	EXPECT_EQ(allocator.GetLastPeakSize(), 500);
+
+	allocator.Alloc(200);
+	allocator.NextFrame();
+
+	EXPECT_EQ(allocator.GetLastPeakSize(), 200);
+	EXPECT_EQ(allocator.GetMaxPeakSize(), 500);
+	EXPECT_EQ(allocator.GetFrame(), 2);
+}
+
+// Memory of a frame is still intact during the next frame
+TEST_F(FrameAllocatorTest, DoubleBuffered) {
+	FrameAllocator doubleAlloc(kFrameAllocatorCapacity, kFrameBufferingDouble);
+
+	int* prev = doubleAlloc.AllocArray<int>(4);
+
+	for (int i = 0; i < 4; ++i) {
+		prev[i] = i;
+	}
+
+	doubleAlloc.NextFrame();
+
+	int* current = doubleAlloc.AllocArray<int>(kFrameAllocatorCapacity / sizeof(int));
+
+	ASSERT_NE(current, nullptr);
+
+	for (int i = 0; i < kFrameAllocatorCapacity / (int)sizeof(int); ++i) {
+		current[i] = -1;
+	}
+
+	for (int i = 0; i < 4; ++i) {
+		EXPECT_EQ(prev[i], i);
+	}
+
+	// Third frame reuses the buffer of the first
+	doubleAlloc.NextFrame();
+
+	EXPECT_EQ(doubleAlloc.AllocArray<int>(4), prev);
+}
+
+// Only the last allocation is freed
+TEST_F(FrameAllocatorTest, DeallocLast) {
+	void* ptr1 = allocator.Alloc(100);
+	void* ptr2 = allocator.Alloc(50);
+
+	EXPECT_EQ(allocator.GetAllocCount(), 2);
+
+	allocator.Dealloc(ptr1);
+
+	EXPECT_EQ(allocator.GetUsedSize(), 150);
+
+	allocator.Dealloc(ptr2);
+
+	EXPECT_EQ(allocator.GetUsedSize(), 100);
+	EXPECT_EQ(allocator.GetAllocCount(), 1);
+
+	// ptr1 is no longer known to be the last allocation
+	allocator.Dealloc(ptr1);
+
+	EXPECT_EQ(allocator.GetUsedSize(), 100);
+	EXPECT_EQ(allocator.GetAllocCount(), 1);
+}
+
+TEST_F(FrameAllocatorTest, ReallocInPlace) {
+	IAllocator* iface = &allocator;
+
+	allocator.Alloc(8);
+
+	int* data = (int*)iface->AllocAligned(sizeof(int) * 4, alignof(int));
+
+	for (int i = 0; i < 4; ++i) {
+		data[i] = i;
+	}
+
+	// Last allocation grows in place
+	int* grown = (int*)iface->Realloc(data, sizeof(int) * 4, sizeof(int) * 32, alignof(int));
+
+	EXPECT_EQ(grown, data);
+	EXPECT_EQ(allocator.GetUsedSize(), 8 + sizeof(int) * 32);
+
+	// Any other allocation is copied to the top
+	allocator.Alloc(8);
+
+	int* moved = (int*)iface->Realloc(data, sizeof(int) * 32, sizeof(int) * 64, alignof(int));
+
+	ASSERT_NE(moved, nullptr);
+	EXPECT_NE(moved, data);
+
+	for (int i = 0; i < 4; ++i) {
+		EXPECT_EQ(moved[i], i);
+	}
+
+	EXPECT_EQ(iface->Realloc(moved, sizeof(int) * 64, kFrameAllocatorCapacity, alignof(int)), nullptr);
+	EXPECT_EQ(allocator.GetOverflowCount(), 1);
 }
\ No newline at end of file
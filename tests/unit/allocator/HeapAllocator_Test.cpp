@@ -0,0 +1,79 @@
+#include "HeapAllocator_Test.h"
+
+TEST_F(HeapAllocatorTest, AllocDealloc) {
+	void* ptr1 = allocator.Alloc(100);
+	void* ptr2 = allocator.Alloc(28);
+
+	ASSERT_NE(ptr1, nullptr);
+	ASSERT_NE(ptr2, nullptr);
+
+	EXPECT_EQ((size_t)ptr1 % kAllocatorDefaultAlignment, 0);
+	EXPECT_EQ((size_t)ptr2 % kAllocatorDefaultAlignment, 0);
+
+	EXPECT_EQ(allocator.GetUsedSize(), 128);
+	EXPECT_EQ(allocator.GetAllocCount(), 2);
+
+	allocator.Dealloc(ptr1);
+	allocator.Dealloc(nullptr);
+
+	EXPECT_EQ(allocator.GetUsedSize(), 28);
+	EXPECT_EQ(allocator.GetAllocCount(), 1);
+
+	allocator.Dealloc(ptr2);
+
+	EXPECT_EQ(allocator.GetUsedSize(), 0);
+	EXPECT_EQ(allocator.GetAllocCount(), 0);
+}
+
+TEST_F(HeapAllocatorTest, AlignedAlloc) {
+	for (size_t alignment = 1; alignment <= 4096; alignment *= 2) {
+		void* ptr = allocator.AllocAligned(24, alignment);
+
+		ASSERT_NE(ptr, nullptr);
+		EXPECT_EQ((size_t)ptr % alignment, 0);
+
+		memset(ptr, 0xff, 24);
+
+		allocator.Dealloc(ptr);
+	}
+
+	EXPECT_EQ(allocator.GetAllocCount(), 0);
+}
+
+// Default Realloc() keeps the contents of the memory
+TEST_F(HeapAllocatorTest, Realloc) {
+	int* data = (int*)allocator.Realloc(nullptr, 0, sizeof(int) * 4, alignof(int));
+
+	for (int i = 0; i < 4; ++i) {
+		data[i] = i;
+	}
+
+	data = (int*)allocator.Realloc(data, sizeof(int) * 4, sizeof(int) * 64, alignof(int));
+
+	ASSERT_NE(data, nullptr);
+
+	for (int i = 0; i < 4; ++i) {
+		EXPECT_EQ(data[i], i);
+	}
+
+	EXPECT_EQ(allocator.GetUsedSize(), sizeof(int) * 64);
+	EXPECT_EQ(allocator.GetAllocCount(), 1);
+
+	allocator.Dealloc(data);
+}
+
+TEST_F(HeapAllocatorTest, DefaultAllocator) {
+	IAllocator* defaultAlloc = GetDefaultAllocator();
+
+	EXPECT_EQ(defaultAlloc, GetDefaultAllocator());
+
+	size_t allocCount = defaultAlloc->GetAllocCount();
+
+	int* data = AllocArray<int>(defaultAlloc, 16);
+
+	EXPECT_EQ(defaultAlloc->GetAllocCount(), allocCount + 1);
+
+	defaultAlloc->Dealloc(data);
+
+	EXPECT_EQ(defaultAlloc->GetAllocCount(), allocCount);
+}
\ No newline at end of file
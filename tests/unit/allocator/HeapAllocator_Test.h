@@ -0,0 +1,26 @@
+#ifndef HEAPALLOCATOR_TEST_H_
+#define HEAPALLOCATOR_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include "allocator/HeapAllocator.h"
+
+//--------------------------------------------------
+// 
+// HeapAllocatorTest
+//
+// HeapAllocator unit test
+//
+//--------------------------------------------------
+class HeapAllocatorTest: public ::testing::Test {
+
+protected:
+	// virtual void SetUp() {}
+	// virtual void TearDown() {} 
+
+	HeapAllocator allocator;
+};
+
+#endif
\ No newline at end of file
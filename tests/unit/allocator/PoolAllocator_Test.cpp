@@ -110,4 +110,39 @@ TEST_F(PoolAllocatorTest, FreeEmpty) {
 	PoolTestStruct* ptr6 = allocator.Alloc();
 
 	EXPECT_EQ(ptr6, (ptr3 + 1));
+}
+
+// Growable pool adds blocks when all chunks are used, and chunks do not move
+TEST_F(PoolAllocatorTest, Growable) {
+	PoolAllocator<PoolTestStruct> pool(4, true);
+
+	const int allocCount = 100;
+
+	PoolTestStruct* ptrArr[allocCount];
+
+	for (int i = 0; i < allocCount; ++i) {
+		ptrArr[i] = pool.Alloc();
+		ptrArr[i]->x = (double)i;
+	}
+
+	EXPECT_GE(pool.GetChunkNum(), (size_t)allocCount);
+
+	for (int i = 0; i < allocCount; ++i) {
+		EXPECT_EQ(ptrArr[i]->x, (double)i);
+	}
+
+	for (int i = 0; i < allocCount; ++i) {
+		pool.Dealloc(ptrArr[i]);
+	}
+
+	size_t chunkNum = pool.GetChunkNum();
+
+	// Clear keeps the blocks, so allocating as much again does not grow
+	pool.Clear();
+
+	for (int i = 0; i < allocCount; ++i) {
+		ptrArr[i] = pool.Alloc();
+	}
+
+	EXPECT_EQ(pool.GetChunkNum(), chunkNum);
 }
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "TlsfAllocator_Test.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+TEST_F(TlsfAllocatorTest, AllocDealloc) {
+	const size_t sizes[] = { 1, 16, 17, 100, 255, 256, 1000, 4096, 100000 };
+	const int sizeCount = sizeof(sizes) / sizeof(sizes[0]);
+
+	void* ptrs[sizeCount];
+
+	for (int i = 0; i < sizeCount; ++i) {
+		ptrs[i] = allocator.Alloc(sizes[i]);
+
+		ASSERT_NE(ptrs[i], nullptr);
+		EXPECT_EQ((size_t)ptrs[i] % kTlsfAlignment, 0);
+		EXPECT_GE(allocator.GetAllocSize(ptrs[i]), sizes[i]);
+
+		memset(ptrs[i], i, sizes[i]);
+	}
+
+	EXPECT_EQ(allocator.GetAllocCount(), sizeCount);
+	EXPECT_TRUE(allocator.CheckBlocks());
+
+	for (int i = 0; i < sizeCount; ++i) {
+		for (size_t j = 0; j < sizes[i]; ++j) {
+			ASSERT_EQ(((byte_t*)ptrs[i])[j], (byte_t)i);
+		}
+	}
+
+	for (int i = 0; i < sizeCount; i += 2) {
+		allocator.Dealloc(ptrs[i]);
+	}
+
+	EXPECT_TRUE(allocator.CheckBlocks());
+
+	for (int i = 1; i < sizeCount; i += 2) {
+		allocator.Dealloc(ptrs[i]);
+	}
+
+	// All blocks merged back into one
+	EXPECT_TRUE(allocator.CheckBlocks());
+	EXPECT_EQ(allocator.GetAllocCount(), 0);
+	EXPECT_EQ(allocator.GetUsedSize(), 0);
+	EXPECT_EQ(allocator.GetFreeBlockCount(), 1);
+}
+
+// Freed space is merged, so one allocation can take all of it again
+TEST_F(TlsfAllocatorTest, Merge) {
+	std::vector<void*> ptrs;
+
+	void* ptr = allocator.Alloc(1000);
+
+	while (ptr != nullptr) {
+		ptrs.push_back(ptr);
+
+		ptr = allocator.Alloc(1000);
+	}
+
+	EXPECT_GT(ptrs.size(), kTlsfAllocatorCapacity / 1024 - 8);
+
+	// Frees in an order that merges with both neighbours
+	for (size_t i = 0; i < ptrs.size(); i += 2) {
+		allocator.Dealloc(ptrs[i]);
+	}
+
+	for (size_t i = 1; i < ptrs.size(); i += 2) {
+		allocator.Dealloc(ptrs[i]);
+	}
+
+	EXPECT_EQ(allocator.GetFreeBlockCount(), 1);
+	EXPECT_NE(allocator.Alloc(kTlsfAllocatorCapacity / 2), nullptr);
+	EXPECT_TRUE(allocator.CheckBlocks());
+}
+
+TEST_F(TlsfAllocatorTest, Exhaustion) {
+	EXPECT_EQ(allocator.Alloc(kTlsfAllocatorCapacity), nullptr);
+	EXPECT_EQ(allocator.Alloc((size_t)-1), nullptr);
+
+	void* ptr = allocator.Alloc(kTlsfAllocatorCapacity / 2);
+
+	ASSERT_NE(ptr, nullptr);
+	EXPECT_EQ(allocator.Alloc(kTlsfAllocatorCapacity / 2), nullptr);
+
+	allocator.Dealloc(ptr);
+
+	EXPECT_NE(allocator.Alloc(kTlsfAllocatorCapacity / 2), nullptr);
+}
+
+TEST_F(TlsfAllocatorTest, AllocAligned) {
+	const size_t alignments[] = { 4, 16, 32, 64, 256, 4096 };
+
+	std::vector<void*> ptrs;
+
+	for (int round = 0; round < 4; ++round) {
+		for (int i = 0; i < 6; ++i) {
+			void* ptr = allocator.AllocAligned(24 + round * 40, alignments[i]);
+
+			ASSERT_NE(ptr, nullptr);
+			EXPECT_EQ((size_t)ptr % alignments[i], 0);
+
+			ptrs.push_back(ptr);
+		}
+	}
+
+	EXPECT_TRUE(allocator.CheckBlocks());
+
+	for (size_t i = 0; i < ptrs.size(); ++i) {
+		allocator.Dealloc(ptrs[i]);
+	}
+
+	EXPECT_TRUE(allocator.CheckBlocks());
+	EXPECT_EQ(allocator.GetFreeBlockCount(), 1);
+}
+
+// Random loads and unloads of mid-sized data keep the blocks consistent
+TEST_F(TlsfAllocatorTest, RandomSession) {
+	const int slotCount = 64;
+
+	void* ptrs[slotCount] = {};
+
+	srand(1);
+
+	for (int i = 0; i < 5000; ++i) {
+		int slot = rand() % slotCount;
+
+		if (ptrs[slot] != nullptr) {
+			allocator.Dealloc(ptrs[slot]);
+			ptrs[slot] = nullptr;
+		}
+		else {
+			ptrs[slot] = allocator.Alloc(16 + rand() % 16000);
+		}
+
+		if (i % 500 == 0) {
+			ASSERT_TRUE(allocator.CheckBlocks());
+		}
+	}
+
+	for (int i = 0; i < slotCount; ++i) {
+		allocator.Dealloc(ptrs[i]);
+	}
+
+	EXPECT_TRUE(allocator.CheckBlocks());
+	EXPECT_EQ(allocator.GetFreeBlockCount(), 1);
+	EXPECT_GT(allocator.GetPeakUsedSize(), 0);
+}
+
+// Holes left by deallocations are moved to the end as one free block
+TEST_F(TlsfAllocatorTest, Defragment) {
+	TlsfDefragSlots slots = {};
+
+	for (int i = 0; i < kTlsfDefragSlotCount; ++i) {
+		slots.sizes[i] = 1000;
+		slots.ptrs[i] = allocator.Alloc(slots.sizes[i]);
+
+		memset(slots.ptrs[i], i, slots.sizes[i]);
+	}
+
+	for (int i = 0; i < kTlsfDefragSlotCount; i += 2) {
+		allocator.Dealloc(slots.ptrs[i]);
+		slots.ptrs[i] = nullptr;
+	}
+
+	EXPECT_EQ(allocator.GetFreeBlockCount(), kTlsfDefragSlotCount / 2 + 1);
+
+	size_t usedSize = allocator.GetUsedSize();
+
+	// One pass to the end of the memory, and one back at the front
+	allocator.Defragment(kTlsfAllocatorCapacity, &TlsfDefragRelocate, &slots);
+	EXPECT_EQ(allocator.Defragment(kTlsfAllocatorCapacity, &TlsfDefragRelocate, &slots), 0);
+
+	EXPECT_EQ(slots.moveCount, kTlsfDefragSlotCount / 2);
+	EXPECT_EQ(allocator.GetFreeBlockCount(), 1);
+	EXPECT_EQ(allocator.GetUsedSize(), usedSize);
+	EXPECT_TRUE(allocator.CheckBlocks());
+	EXPECT_TRUE(TlsfDefragCheckSlots(slots));
+
+	for (int i = 0; i < kTlsfDefragSlotCount; ++i) {
+		allocator.Dealloc(slots.ptrs[i]);
+	}
+
+	EXPECT_EQ(allocator.GetAllocCount(), 0);
+}
+
+// Each call moves no more than it is given
+TEST_F(TlsfAllocatorTest, DefragmentBounded) {
+	TlsfDefragSlots slots = {};
+
+	for (int i = 0; i < kTlsfDefragSlotCount; ++i) {
+		slots.sizes[i] = 1000;
+		slots.ptrs[i] = allocator.Alloc(slots.sizes[i]);
+
+		memset(slots.ptrs[i], i, slots.sizes[i]);
+	}
+
+	allocator.Dealloc(slots.ptrs[0]);
+	slots.ptrs[0] = nullptr;
+
+	const size_t byteMax = 2 * allocator.GetAllocSize(slots.ptrs[1]);
+
+	int callCount = 0;
+
+	while (allocator.GetFreeBlockCount() > 1) {
+		EXPECT_LE(allocator.Defragment(byteMax, &TlsfDefragRelocate, &slots), byteMax);
+		ASSERT_TRUE(allocator.CheckBlocks());
+
+		++callCount;
+
+		ASSERT_LT(callCount, kTlsfDefragSlotCount);
+	}
+
+	// Two of the allocations after the hole move in each call
+	EXPECT_EQ(callCount, kTlsfDefragSlotCount / 2);
+	EXPECT_TRUE(TlsfDefragCheckSlots(slots));
+
+	// Allocations larger than a call can move are left in place
+	void* large = allocator.Alloc(byteMax * 2);
+
+	allocator.Dealloc(slots.ptrs[kTlsfDefragSlotCount - 1]);
+	slots.ptrs[kTlsfDefragSlotCount - 1] = nullptr;
+
+	for (int i = 0; i < 4; ++i) {
+		allocator.Defragment(byteMax, &TlsfDefragRelocate, &slots);
+	}
+
+	EXPECT_EQ(allocator.GetFreeBlockCount(), 2);
+	EXPECT_TRUE(allocator.CheckBlocks());
+
+	// Nothing can move, so later calls stop walking the blocks
+	EXPECT_FALSE(allocator.CanDefragment());
+	EXPECT_EQ(allocator.Defragment(byteMax, &TlsfDefragRelocate, &slots), 0);
+
+	allocator.Dealloc(large);
+
+	EXPECT_TRUE(allocator.CanDefragment());
+}
+
+// Small steps between allocations, as the resource manager runs them
+TEST_F(TlsfAllocatorTest, DefragmentSession) {
+	TlsfDefragSlots slots = {};
+
+	srand(2);
+
+	for (int i = 0; i < 5000; ++i) {
+		int slot = rand() % kTlsfDefragSlotCount;
+
+		if (slots.ptrs[slot] != nullptr) {
+			allocator.Dealloc(slots.ptrs[slot]);
+			slots.ptrs[slot] = nullptr;
+		}
+		else {
+			slots.sizes[slot] = 16 + rand() % 8000;
+			slots.ptrs[slot] = allocator.Alloc(slots.sizes[slot]);
+
+			ASSERT_NE(slots.ptrs[slot], nullptr);
+
+			memset(slots.ptrs[slot], slot, slots.sizes[slot]);
+		}
+
+		allocator.Defragment(4096, &TlsfDefragRelocate, &slots);
+
+		if (i % 250 == 0) {
+			ASSERT_TRUE(allocator.CheckBlocks());
+			ASSERT_TRUE(TlsfDefragCheckSlots(slots));
+		}
+	}
+
+	EXPECT_GT(slots.moveCount, 0);
+	EXPECT_TRUE(allocator.CheckBlocks());
+	EXPECT_TRUE(TlsfDefragCheckSlots(slots));
+
+	for (int i = 0; i < kTlsfDefragSlotCount; ++i) {
+		allocator.Dealloc(slots.ptrs[i]);
+	}
+
+	EXPECT_EQ(allocator.GetFreeBlockCount(), 1);
+}
\ No newline at end of file
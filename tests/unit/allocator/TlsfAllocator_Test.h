@@ -0,0 +1,69 @@
+#ifndef TLSFALLOCATOR_TEST_H_
+#define TLSFALLOCATOR_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include "allocator/TlsfAllocator.h"
+
+const size_t kTlsfAllocatorCapacity = 1024 * 1024;
+
+const int kTlsfDefragSlotCount = 64;
+
+// Allocations of a defragmentation test, each filled with its own byte
+struct TlsfDefragSlots {
+	void* ptrs[kTlsfDefragSlotCount];
+	size_t sizes[kTlsfDefragSlotCount];
+
+	int moveCount;
+};
+
+// Points the slot of the moved allocation to its new place
+inline void TlsfDefragRelocate(void* context, void* oldPtr, void* newPtr) {
+	TlsfDefragSlots* slots = (TlsfDefragSlots*)context;
+
+	for (int i = 0; i < kTlsfDefragSlotCount; ++i) {
+		if (slots->ptrs[i] == oldPtr) {
+			slots->ptrs[i] = newPtr;
+			++slots->moveCount;
+			return;
+		}
+	}
+
+	ADD_FAILURE() << "Moved memory that is not in a slot";
+}
+
+inline bool TlsfDefragCheckSlots(const TlsfDefragSlots& slots) {
+	for (int i = 0; i < kTlsfDefragSlotCount; ++i) {
+		const byte_t* data = (const byte_t*)slots.ptrs[i];
+
+		for (size_t j = 0; data != nullptr && j < slots.sizes[i]; ++j) {
+			if (data[j] != (byte_t)i) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+//--------------------------------------------------
+//
+// TlsfAllocatorTest
+//
+// TlsfAllocator unit test
+//
+//--------------------------------------------------
+class TlsfAllocatorTest: public ::testing::Test {
+
+protected:
+	TlsfAllocatorTest(): allocator(kTlsfAllocatorCapacity) {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	TlsfAllocator allocator;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "Hash_Test.h"
+
+#include <set>
+
+// Results are the same for the scalar, SSE2 and AVX2 builds
+TEST_F(HashTest, KnownValues) {
+	EXPECT_EQ(FastHash64(buffer, 0, 0), 0x93228A4DE0EEC5A2ULL);
+	EXPECT_EQ(FastHash64(buffer, 3, 0), 0xE9609C2E635EB614ULL);
+	EXPECT_EQ(FastHash64(buffer, 8, 0), 0xCA9F70FC67BBEA6DULL);
+	EXPECT_EQ(FastHash64(buffer, 17, 0), 0xB3889B861F2AF496ULL);
+	EXPECT_EQ(FastHash64(buffer, 100, 0), 0x7E291C157D363FABULL);
+	EXPECT_EQ(FastHash64(buffer, 1000, 0), 0x8BD67E4D12B06C67ULL);
+
+	EXPECT_EQ(FastHashBulk(buffer, 100, 0), 0x7E291C157D363FABULL);
+	EXPECT_EQ(FastHashBulk(buffer, 256, 0), 0x400B8844A66A9784ULL);
+	EXPECT_EQ(FastHashBulk(buffer, 1000, 0), 0x716021F69E1E69EBULL);
+	EXPECT_EQ(FastHashBulk(buffer, 1024, 0), 0xBF15AC421528DAF0ULL);
+	EXPECT_EQ(FastHashBulk(buffer, 1025, 0), 0x2BF63148471EFDDEULL);
+	EXPECT_EQ(FastHashBulk(buffer, 5000, 0), 0x0C451645E6A82BC7ULL);
+}
+
+// Hash only depends on the bytes, not on their alignment
+TEST_F(HashTest, Unaligned) {
+	unsigned char* copy = new unsigned char[kHashTestBufferSize + 1];
+
+	memcpy(copy + 1, buffer, kHashTestBufferSize);
+
+	const size_t lengths[] = { 5, 16, 40, 300, 2049, kHashTestBufferSize };
+
+	for (int i = 0; i < 6; ++i) {
+		EXPECT_EQ(FastHash64(copy + 1, lengths[i], 0), FastHash64(buffer, lengths[i], 0));
+		EXPECT_EQ(FastHashBulk(copy + 1, lengths[i], 0), FastHashBulk(buffer, lengths[i], 0));
+	}
+
+	delete[] copy;
+}
+
+// Each prefix of the buffer and each seed gives a different hash
+TEST_F(HashTest, LengthAndSeed) {
+	std::set<uint64_t> hashes;
+
+	for (size_t len = 0; len <= 2100; ++len) {
+		hashes.insert(FastHashBulk(buffer, len, 0));
+		hashes.insert(FastHashBulk(buffer, len, 1));
+	}
+
+	EXPECT_EQ(hashes.size(), (size_t)2101 * 2);
+}
+
+// Changing any bit of the buffer changes the hash
+TEST_F(HashTest, BitFlip) {
+	const size_t len = 1100;
+
+	uint64_t hash = FastHashBulk(buffer, len, 0);
+
+	for (size_t i = 0; i < len * 8; i += 7) {
+		buffer[i / 8] ^= (unsigned char)(1 << (i % 8));
+
+		EXPECT_NE(FastHashBulk(buffer, len, 0), hash);
+
+		buffer[i / 8] ^= (unsigned char)(1 << (i % 8));
+	}
+
+	EXPECT_EQ(FastHashBulk(buffer, len, 0), hash);
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef HASH_TEST_H_
+#define HASH_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+const int kHashTestBufferSize = 5000;
+
+//--------------------------------------------------
+// 
+// HashTest
+//
+// FastHash unit test
+//
+//--------------------------------------------------
+class HashTest: public ::testing::Test {
+
+protected:
+	HashTest() {
+		for (int i = 0; i < kHashTestBufferSize; ++i) {
+			buffer[i] = (unsigned char)(i * 31 + 7);
+		}
+	}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	unsigned char buffer[kHashTestBufferSize];
+};
+
+#endif
\ No newline at end of file
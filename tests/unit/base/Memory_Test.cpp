@@ -0,0 +1,127 @@
+#include "Memory_Test.h"
+
+TEST_F(MemoryTest, TagScope) {
+	EXPECT_EQ(BaseMemGetTag(), kMemTagGeneral);
+
+	{
+		MemTagScope outer(kMemTagPhysics);
+
+		EXPECT_EQ(BaseMemGetTag(), kMemTagPhysics);
+
+		{
+			MemTagScope inner(kMemTagRender);
+
+			EXPECT_EQ(BaseMemGetTag(), kMemTagRender);
+		}
+
+		EXPECT_EQ(BaseMemGetTag(), kMemTagPhysics);
+	}
+
+	EXPECT_EQ(BaseMemGetTag(), kMemTagGeneral);
+
+	EXPECT_STREQ(BaseMemGetTagName(kMemTagResource), "Resource");
+}
+
+#if defined(_MEM_TRACKING)
+
+TEST_F(MemoryTest, TaggedStats) {
+	MemStats before;
+	BaseMemGetStats(kMemoryTestTag, &before);
+
+	int* data = nullptr;
+
+	{
+		MemTagScope tag(kMemoryTestTag);
+
+		data = MEM_NEW int[100];
+	}
+
+	MemStats stats;
+	BaseMemGetStats(kMemoryTestTag, &stats);
+
+	EXPECT_EQ(stats.size, before.size + sizeof(int) * 100);
+	EXPECT_EQ(stats.allocCount, before.allocCount + 1);
+	EXPECT_EQ(stats.totalAllocCount, before.totalAllocCount + 1);
+	EXPECT_GE(stats.peakSize, stats.size);
+
+	// Freed against the tag it was allocated with, whatever the current tag
+	MEM_DELETE_ARR(data);
+
+	BaseMemGetStats(kMemoryTestTag, &stats);
+
+	EXPECT_EQ(stats.size, before.size);
+	EXPECT_EQ(stats.allocCount, before.allocCount);
+}
+
+// Containers allocate through the default allocator, which is also tracked
+TEST_F(MemoryTest, ContainerStats) {
+	MemStats before;
+	BaseMemGetStats(kMemoryTestTag, &before);
+
+	{
+		MemTagScope tag(kMemoryTestTag);
+
+		DynArray<int> array(256);
+
+		MemStats stats;
+		BaseMemGetStats(kMemoryTestTag, &stats);
+
+		EXPECT_GE(stats.size, before.size + sizeof(int) * 256);
+	}
+
+	MemStats stats;
+	BaseMemGetStats(kMemoryTestTag, &stats);
+
+	EXPECT_EQ(stats.size, before.size);
+}
+
+TEST_F(MemoryTest, Budget) {
+	MemStats stats;
+	BaseMemGetStats(kMemoryTestTag, &stats);
+
+	BaseMemSetBudget(kMemoryTestTag, stats.size + 1000);
+
+	EXPECT_FALSE(BaseMemIsOverBudget(kMemoryTestTag));
+
+	MemTagScope tag(kMemoryTestTag);
+
+	byte_t* small = MEM_NEW byte_t[500];
+
+	EXPECT_FALSE(BaseMemIsOverBudget(kMemoryTestTag));
+
+	byte_t* large = MEM_NEW byte_t[1000];
+
+	EXPECT_TRUE(BaseMemIsOverBudget(kMemoryTestTag));
+
+	MEM_DELETE_ARR(large);
+
+	EXPECT_FALSE(BaseMemIsOverBudget(kMemoryTestTag));
+
+	MEM_DELETE_ARR(small);
+
+	BaseMemGetStats(kMemoryTestTag, &stats);
+
+	EXPECT_EQ(stats.budget, stats.size + 1000);
+}
+
+TEST_F(MemoryTest, ResetPeaks) {
+	MemTagScope tag(kMemoryTestTag);
+
+	byte_t* data = MEM_NEW byte_t[4096];
+
+	MEM_DELETE_ARR(data);
+
+	MemStats stats;
+	BaseMemGetStats(kMemoryTestTag, &stats);
+
+	EXPECT_GE(stats.peakSize, stats.size + 4096);
+
+	BaseMemResetPeaks();
+
+	BaseMemGetStats(kMemoryTestTag, &stats);
+
+	EXPECT_EQ(stats.peakSize, stats.size);
+	EXPECT_EQ(stats.totalAllocCount, stats.allocCount);
+}
+
+#endif
\ No newline at end of file
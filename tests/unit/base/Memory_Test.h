@@ -0,0 +1,32 @@
+#ifndef MEMORY_TEST_H_
+#define MEMORY_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include "container/DynArray.h"
+
+// Tag that nothing else in the tests allocates with
+const MemTag_t kMemoryTestTag = kMemTagEntity;
+
+//--------------------------------------------------
+// 
+// MemoryTest
+//
+// Memory tracking unit test
+//
+//--------------------------------------------------
+class MemoryTest: public ::testing::Test {
+
+protected:
+	MemoryTest() {}
+
+	// virtual void SetUp() {}
+
+	virtual void TearDown() {
+		BaseMemSetBudget(kMemoryTestTag, 0);
+	}
+};
+
+#endif
\ No newline at end of file
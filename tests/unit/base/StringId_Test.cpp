@@ -0,0 +1,45 @@
+#include "StringId_Test.h"
+
+// Compile time and run time hashes of a string are the same
+TEST_F(StringIdTest, ConstMatchesRuntime) {
+	const char* names[] = { "", "a", "idle", "sprites/player.png", "Projectile" };
+
+	EXPECT_EQ(STRING_ID("").GetHash(), StringId(names[0]).GetHash());
+	EXPECT_EQ(STRING_ID("a").GetHash(), StringId(names[1]).GetHash());
+	EXPECT_EQ(STRING_ID("idle").GetHash(), StringId(names[2]).GetHash());
+	EXPECT_EQ(STRING_ID("sprites/player.png").GetHash(), StringId(names[3]).GetHash());
+	EXPECT_EQ(STRING_ID("Projectile").GetHash(), StringId(names[4]).GetHash());
+
+	EXPECT_NE(STRING_ID("idle"), STRING_ID("idle2"));
+}
+
+// Interned strings can be found from their id, and interning the same string
+// twice gives the same id
+TEST_F(StringIdTest, Intern) {
+	char name[32];
+	strcpy(name, "StringIdTest.Intern");
+
+	StringId id = InternString(name);
+
+	// Table keeps its own copy
+	name[0] = 'X';
+
+	EXPECT_EQ(id, STRING_ID("StringIdTest.Intern"));
+	EXPECT_STREQ(id.GetString(), "StringIdTest.Intern");
+	EXPECT_EQ(InternString("StringIdTest.Intern"), id);
+
+	EXPECT_TRUE(FindInternedString(STRING_ID("StringIdTest.NotInterned")) == nullptr);
+	EXPECT_STREQ(STRING_ID("StringIdTest.NotInterned").GetString(), "<unknown>");
+}
+
+// Ids can be used as container keys
+TEST_F(StringIdTest, MapKey) {
+	FlatHashMap<StringId, int> map(16);
+
+	map.Insert(InternString("walk"), 1);
+	map.Insert(InternString("jump"), 2);
+
+	EXPECT_EQ(map.Find(STRING_ID("walk")).GetValue(), 1);
+	EXPECT_EQ(map.Find(STRING_ID("jump")).GetValue(), 2);
+	EXPECT_TRUE(map.Find(STRING_ID("run")) == map.End());
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#ifndef STRINGID_TEST_H_
+#define STRINGID_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include "container/FlatHashMap.h"
+
+//--------------------------------------------------
+// 
+// StringIdTest
+//
+// StringId unit test
+//
+//--------------------------------------------------
+class StringIdTest: public ::testing::Test {
+
+protected:
+	StringIdTest() {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+};
+
+#endif
\ No newline at end of file
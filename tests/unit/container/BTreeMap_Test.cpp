@@ -0,0 +1,248 @@
+#include "BTreeMap_Test.h"
+
+#include <cstdlib>
+#include <map>
+
+// Long enough to be allocated on the heap, so that an entry that is never
+// destroyed leaks and one that is never constructed is not a valid string
+static std::string MakeBTreeMapTestString(int i) {
+	return std::to_string(i) + std::string(48, '#');
+}
+
+// Checks that iteration visits the same entries as the reference map, in the
+// same order
+static void ExpectSameEntries(BTreeMap<int, int>& map, const std::map<int, int>& expected) {
+	ASSERT_EQ(map.GetSize(), (int)expected.size());
+
+	auto expectedIt = expected.begin();
+
+	for (auto it = map.Begin(); it != map.End(); ++it, ++expectedIt) {
+		ASSERT_TRUE(expectedIt != expected.end());
+		ASSERT_EQ(it.GetKey(), expectedIt->first);
+		ASSERT_EQ(it.GetValue(), expectedIt->second);
+	}
+
+	EXPECT_TRUE(expectedIt == expected.end());
+}
+
+TEST_F(BTreeMapTest, Find) {
+	for (int i = 0; i < kBTreeMapSize; ++i) {
+		map.Insert(i, i * 2);
+	}
+
+	EXPECT_TRUE(map.IsFull());
+	EXPECT_GT(map.GetDepth(), 1);
+
+	for (int i = 0; i < kBTreeMapSize; ++i) {
+		auto it = map.Find(i);
+
+		ASSERT_TRUE(it != map.End());
+		EXPECT_EQ(it.GetValue(), i * 2);
+	}
+
+	EXPECT_TRUE(map.Find(-1) == map.End());
+	EXPECT_TRUE(map.Find(kBTreeMapSize) == map.End());
+
+	for (int i = 0; i < kBTreeMapSize; ++i) {
+		map.Remove(i);
+	}
+
+	EXPECT_TRUE(map.IsEmpty());
+	EXPECT_EQ(map.GetDepth(), 0);
+	EXPECT_TRUE(map.Begin() == map.End());
+}
+
+// Random inserts and removals, checked against std::map
+TEST_F(BTreeMapTest, RandomOperations) {
+	std::map<int, int> expected;
+
+	srand(1);
+
+	for (int i = 0; i < 20000; ++i) {
+		int key = rand() % (kBTreeMapSize * 2);
+
+		// Inserts more than it removes until the map is half full
+		bool insert = (int)expected.size() < kBTreeMapSize / 2 ? (rand() % 3 != 0) : (rand() % 2 == 0);
+
+		if (insert && expected.find(key) == expected.end() && (int)expected.size() < kBTreeMapSize) {
+			map.Insert(key, i);
+			expected[key] = i;
+		}
+		else if (!insert) {
+			map.Remove(key);
+			expected.erase(key);
+		}
+	}
+
+	ExpectSameEntries(map, expected);
+
+	for (auto it = expected.begin(); it != expected.end(); ++it) {
+		EXPECT_EQ(map.Find(it->first).GetValue(), it->second);
+	}
+}
+
+// Removing from the end rebalances nodes with their left siblings
+TEST_F(BTreeMapTest, RemoveDescending) {
+	std::map<int, int> expected;
+
+	for (int i = 0; i < kBTreeMapSize; ++i) {
+		map.Insert(i, i);
+		expected[i] = i;
+	}
+
+	for (int i = kBTreeMapSize - 1; i >= 0; --i) {
+		if (i % 7 != 0) {
+			map.Remove(i);
+			expected.erase(i);
+		}
+	}
+
+	ExpectSameEntries(map, expected);
+
+	for (int i = kBTreeMapSize - 1; i >= 0; i -= 7) {
+		map.Remove(i - i % 7);
+		expected.erase(i - i % 7);
+
+		if (i % 140 == 0) {
+			ExpectSameEntries(map, expected);
+		}
+	}
+
+	EXPECT_TRUE(map.IsEmpty());
+}
+
+// Iterating from LowerBound() visits the keys of a range
+TEST_F(BTreeMapTest, RangeIteration) {
+	// Even keys only
+	for (int i = 0; i < 1000; ++i) {
+		map.Insert(i * 2, i);
+	}
+
+	int counter = 0;
+	for (auto it = map.LowerBound(101); it != map.End() && it.GetKey() < 201; ++it) {
+		EXPECT_EQ(it.GetKey(), 102 + counter * 2);
+		++counter;
+	}
+
+	EXPECT_EQ(counter, 50);
+
+	EXPECT_EQ(map.LowerBound(100).GetKey(), 100);
+	EXPECT_EQ(map.UpperBound(100).GetKey(), 102);
+	EXPECT_EQ(map.LowerBound(-5).GetKey(), 0);
+
+	EXPECT_TRUE(map.LowerBound(1999) == map.End());
+	EXPECT_TRUE(map.UpperBound(1998) == map.End());
+}
+
+// Bulk loaded map behaves like one built by inserts
+TEST_F(BTreeMapTest, BulkLoad) {
+	const int counts[] = { 0, 1, 10, 100, 1000, kBTreeMapSize };
+
+	int* keys = new int[kBTreeMapSize];
+	int* values = new int[kBTreeMapSize];
+
+	for (int i = 0; i < kBTreeMapSize; ++i) {
+		keys[i] = i * 3;
+		values[i] = -i;
+	}
+
+	for (int c = 0; c < 6; ++c) {
+		int count = counts[c];
+
+		map.BulkLoad(keys, values, count);
+
+		std::map<int, int> expected;
+
+		for (int i = 0; i < count; ++i) {
+			expected[keys[i]] = values[i];
+		}
+
+		ExpectSameEntries(map, expected);
+
+		// Removes every other entry and inserts others in between to check
+		// that the loaded nodes split and merge correctly
+		for (int i = 0; i < count; i += 2) {
+			map.Remove(keys[i]);
+			expected.erase(keys[i]);
+		}
+
+		for (int i = 0; i < count / 2; ++i) {
+			map.Insert(keys[i] + 1, i);
+			expected[keys[i] + 1] = i;
+		}
+
+		ExpectSameEntries(map, expected);
+	}
+
+	delete[] values;
+	delete[] keys;
+}
+
+TEST_F(BTreeMapTest, Clear) {
+	for (int i = 0; i < kBTreeMapSize; ++i) {
+		map.Insert(i, i);
+	}
+
+	map.Clear();
+
+	EXPECT_TRUE(map.IsEmpty());
+	EXPECT_TRUE(map.Find(0) == map.End());
+
+	for (int i = 0; i < kBTreeMapSize; ++i) {
+		map.Insert(i, i);
+	}
+
+	for (int i = 0; i < kBTreeMapSize; ++i) {
+		EXPECT_EQ(map.Find(i).GetValue(), i);
+	}
+}
+
+// Growable map is not limited by the initial number of nodes
+TEST_F(BTreeMapTest, Growth) {
+	BTreeMap<int, int> growMap(8, kContainerGrowthAuto);
+
+	const int entryCount = 20000;
+
+	// Descending so that every insert goes into the first leaf
+	for (int i = entryCount - 1; i >= 0; --i) {
+		growMap.Insert(i, i);
+	}
+
+	EXPECT_FALSE(growMap.IsFull());
+
+	int counter = 0;
+	for (auto it = growMap.Begin(); it != growMap.End(); ++it) {
+		EXPECT_EQ(it.GetKey(), counter);
+		++counter;
+	}
+
+	EXPECT_EQ(counter, entryCount);
+}
+
+// Values that own memory are constructed with their nodes and destroyed
+// with them, including nodes freed by merges
+TEST_F(BTreeMapTest, NonTrivialValue) {
+	BTreeMap<int, std::string> stringMap(8, kContainerGrowthAuto);
+
+	for (int i = 0; i < 2000; ++i) {
+		stringMap.Insert(i, MakeBTreeMapTestString(i));
+	}
+
+	for (int i = 0; i < 2000; ++i) {
+		if (i % 8 != 0) {
+			stringMap.Remove(i);
+		}
+	}
+
+	for (int i = 0; i < 2000; i += 8) {
+		EXPECT_EQ(stringMap.Find(i).GetValue(), MakeBTreeMapTestString(i));
+	}
+
+	stringMap.Clear();
+
+	for (int i = 0; i < 500; ++i) {
+		stringMap.Insert(i, MakeBTreeMapTestString(i));
+	}
+
+	EXPECT_EQ(stringMap.Find(499).GetValue(), MakeBTreeMapTestString(499));
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef BTREEMAP_TEST_H_
+#define BTREEMAP_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "container/BTreeMap.h"
+
+
+// Large enough for a tree with several levels of inner nodes
+const int kBTreeMapSize = 4096;
+
+//--------------------------------------------------
+//
+// BTreeMapTest
+//
+// BTreeMap unit test
+//
+//--------------------------------------------------
+class BTreeMapTest: public ::testing::Test {
+
+protected:
+	BTreeMapTest(): map(kBTreeMapSize) {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	BTreeMap<int, int> map;
+};
+
+#endif
\ No newline at end of file
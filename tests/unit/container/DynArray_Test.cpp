@@ -76,3 +76,179 @@ TEST_F(DynArrayTest, ResizeUp) {
 		EXPECT_EQ(array[i], i);
 	}
 }
+
+
+int DynArrayTestElement::liveCount = 0;
+
+TEST_F(DynArrayTest, Growth) {
+	DynArray<int> grown;
+
+	EXPECT_EQ(grown.GetCapacity(), 0);
+
+	for (int i = 0; i < kDynArraySizeMax * 4; ++i) {
+		grown.PushBack(i);
+	}
+
+	EXPECT_EQ(grown.GetSize(), kDynArraySizeMax * 4);
+	EXPECT_GE(grown.GetCapacity(), kDynArraySizeMax * 4);
+
+	for (int i = 0; i < kDynArraySizeMax * 4; ++i) {
+		EXPECT_EQ(grown[i], i);
+	}
+
+	// Fixed size array grows too once it is full
+	for (int i = 0; i < kDynArraySizeMax + 1; ++i) {
+		array.Insert(i, 0);
+	}
+
+	EXPECT_EQ(array.GetSize(), kDynArraySizeMax + 1);
+	EXPECT_EQ(array.GetCapacity(), kDynArraySizeMax * 2);
+	EXPECT_EQ(array.GetFront(), kDynArraySizeMax);
+	EXPECT_EQ(array.GetBack(), 0);
+}
+
+TEST_F(DynArrayTest, SwapRemove) {
+	for (int i = 0; i < 8; ++i) {
+		array.PushBack(i);
+	}
+
+	array.SwapRemove(2);
+
+	EXPECT_EQ(array.GetSize(), 7);
+	EXPECT_EQ(array[2], 7);
+	EXPECT_EQ(array.GetBack(), 6);
+
+	// Removing the last element only shrinks the array
+	array.SwapRemove(6);
+
+	EXPECT_EQ(array.GetSize(), 6);
+	EXPECT_EQ(array.GetBack(), 5);
+}
+
+TEST_F(DynArrayTest, NonTrivialElements) {
+	DynArrayTestElement::liveCount = 0;
+
+	{
+		DynArray<DynArrayTestElement> elements(4);
+
+		for (int i = 0; i < kDynArraySizeMax; ++i) {
+			elements.EmplaceBack(i);
+		}
+
+		EXPECT_EQ(DynArrayTestElement::liveCount, kDynArraySizeMax);
+
+		// Element from the array itself stays valid while the array grows
+		elements.Resize(elements.GetSize());
+		elements.PushBack(elements[0]);
+
+		EXPECT_EQ(elements.GetBack().name, "0");
+
+		elements.Insert(DynArrayTestElement(-1), 1);
+		elements.Remove(0);
+		elements.SwapRemove(1);
+
+		EXPECT_EQ(elements.GetSize(), kDynArraySizeMax);
+		EXPECT_EQ(elements[0].name, "-1");
+		EXPECT_EQ(elements[1].name, "0");
+		EXPECT_EQ(elements[2].name, "2");
+		EXPECT_EQ(elements.GetBack().name, std::to_string(kDynArraySizeMax - 1));
+
+		elements.Resize(16);
+
+		EXPECT_EQ(elements.GetSize(), 16);
+		EXPECT_EQ(DynArrayTestElement::liveCount, 16);
+
+		elements.Clear();
+
+		EXPECT_EQ(DynArrayTestElement::liveCount, 0);
+
+		elements.EmplaceBack(1);
+	}
+
+	EXPECT_EQ(DynArrayTestElement::liveCount, 0);
+}
+
+// All memory comes from the given allocator and is returned to it
+TEST_F(DynArrayTest, CustomAllocator) {
+	TlsfAllocator tlsf(64 * 1024);
+
+	{
+		DynArray<int> tlsfArray(&tlsf);
+
+		EXPECT_EQ(tlsfArray.GetAllocator(), &tlsf);
+		EXPECT_EQ(tlsf.GetAllocCount(), 0);
+
+		for (int i = 0; i < kDynArraySizeMax; ++i) {
+			tlsfArray.PushBack(i);
+		}
+
+		EXPECT_EQ(tlsf.GetAllocCount(), 1);
+
+		// Nothing follows the array in the allocator, so it grows in place
+		int* data = &tlsfArray[0];
+
+		tlsfArray.Resize(kDynArraySizeMax * 4);
+
+		EXPECT_EQ(&tlsfArray[0], data);
+		EXPECT_EQ(tlsf.GetAllocCount(), 1);
+
+		for (int i = 0; i < kDynArraySizeMax; ++i) {
+			EXPECT_EQ(tlsfArray[i], i);
+		}
+
+		DynArray<DynArrayTestElement> elements(16, &tlsf);
+
+		elements.EmplaceBack(1);
+		elements.Resize(64);
+
+		EXPECT_EQ(elements.GetBack().name, "1");
+		EXPECT_EQ(tlsf.GetAllocCount(), 2);
+	}
+
+	EXPECT_EQ(tlsf.GetAllocCount(), 0);
+	EXPECT_EQ(tlsf.GetUsedSize(), 0);
+	EXPECT_TRUE(tlsf.CheckBlocks());
+}
+
+// Arrays of arrays move their inner arrays when they grow, and copies own
+// their memory
+TEST_F(DynArrayTest, NestedArrays) {
+	DynArray<DynArray<int> > outer;
+
+	for (int i = 0; i < 100; ++i) {
+		DynArray<int> inner;
+
+		for (int j = 0; j <= i % 10; ++j) {
+			inner.PushBack(i + j);
+		}
+
+		outer.PushBack(std::move(inner));
+
+		EXPECT_TRUE(inner.IsEmpty());
+	}
+
+	outer.Insert(outer[50], 0);
+	outer.Remove(1);
+
+	EXPECT_EQ(outer.GetSize(), 100);
+	EXPECT_EQ(outer[0][0], 50);
+
+	DynArray<DynArray<int> > copy(outer);
+
+	copy[99][0] = -1;
+
+	EXPECT_EQ(outer[99][0], 99);
+	EXPECT_EQ(copy[98].GetSize(), 9);
+
+	DynArray<DynArray<int> > moved;
+	moved.PushBack(DynArray<int>());
+
+	moved = std::move(copy);
+
+	EXPECT_EQ(moved[99][0], -1);
+	EXPECT_TRUE(copy.IsEmpty());
+
+	copy = outer;
+
+	EXPECT_EQ(copy[99][0], 99);
+}
\ No newline at end of file
@@ -5,9 +5,47 @@
 
 #include "container/DynArray.h"
 
+#include "allocator/TlsfAllocator.h"
+
+#include <string>
+
 
 const int kDynArraySizeMax = 128;
 
+// Element that is not trivially copyable, and counts the live instances so
+// that the tests can check that each one is destroyed
+struct DynArrayTestElement {
+	static int liveCount;
+
+	DynArrayTestElement(int value): name(std::to_string(value)) {
+		++liveCount;
+	}
+
+	DynArrayTestElement(const DynArrayTestElement& other): name(other.name) {
+		++liveCount;
+	}
+
+	DynArrayTestElement(DynArrayTestElement&& other): name(std::move(other.name)) {
+		++liveCount;
+	}
+
+	~DynArrayTestElement() {
+		--liveCount;
+	}
+
+	DynArrayTestElement& operator=(const DynArrayTestElement& other) {
+		name = other.name;
+		return *this;
+	}
+
+	DynArrayTestElement& operator=(DynArrayTestElement&& other) {
+		name = std::move(other.name);
+		return *this;
+	}
+
+	std::string name;
+};
+
 //--------------------------------------------------
 //
 // StackTest
@@ -0,0 +1,225 @@
+#include "FlatHashMap_Test.h"
+
+#include <cstring>
+#include <memory>
+
+
+TEST_F(FlatHashMapTest, MaxLoad) {
+	for (int i = 0; i < kFlatHashMapSize; ++i) {
+		intMap.Insert(i, i);
+	}
+
+	EXPECT_TRUE(intMap.IsFull());
+
+	for (int i = 0; i < kFlatHashMapSize; ++i) {
+		auto it = intMap.Find(i);
+
+		ASSERT_TRUE(it != intMap.End());
+		EXPECT_EQ(it.GetValue(), i);
+	}
+
+	EXPECT_TRUE(intMap.Find(kFlatHashMapSize) == intMap.End());
+
+	for (int i = 0; i < kFlatHashMapSize; ++i) {
+		intMap.Remove(i);
+	}
+
+	EXPECT_TRUE(intMap.IsEmpty());
+
+	for (int i = 0; i < kFlatHashMapSize; ++i) {
+		EXPECT_TRUE(intMap.Find(i) == intMap.End());
+	}
+}
+
+TEST_F(FlatHashMapTest, IteratorTest) {
+	int counter = 0;
+	for (auto it = intMap.Begin(); it != intMap.End(); ++it) {
+		++counter;
+	}
+
+	EXPECT_EQ(counter, 0);
+
+	for (int i = 0; i < kFlatHashMapSize; ++i) {
+		intMap.Insert(i, i * 2);
+	}
+
+	counter = 0;
+	for (auto it = intMap.Begin(); it != intMap.End(); ++it) {
+		EXPECT_EQ(it.GetValue(), it.GetKey() * 2);
+		++counter;
+	}
+
+	EXPECT_EQ(counter, kFlatHashMapSize);
+}
+
+// Iterating from an entry returned by Find() visits the rest of the map
+TEST_F(FlatHashMapTest, IterateFromFind) {
+	for (int i = 0; i < kFlatHashMapSize; ++i) {
+		intMap.Insert(i, i);
+	}
+
+	int beforeCount = 0;
+	auto it = intMap.Begin();
+
+	while (it.GetKey() != 10) {
+		++beforeCount;
+		++it;
+	}
+
+	int afterCount = 0;
+
+	for (it = intMap.Find(10); it != intMap.End(); ++it) {
+		++afterCount;
+	}
+
+	EXPECT_EQ(beforeCount + afterCount, kFlatHashMapSize);
+}
+
+// Repeated removal and insertion in a nearly full map leaves deleted slots
+// behind, which must be cleared out without losing entries
+TEST_F(FlatHashMapTest, Churn) {
+	const int size = 192;
+
+	FlatHashMap<int, int> map(size);
+
+	for (int i = 0; i < size; ++i) {
+		map.Insert(i, i);
+	}
+
+	for (int i = size; i < size * 64; ++i) {
+		map.Remove(i - size);
+		map.Insert(i, i);
+
+		ASSERT_EQ(map.GetSize(), size);
+	}
+
+	for (int i = size * 63; i < size * 64; ++i) {
+		auto it = map.Find(i);
+
+		ASSERT_TRUE(it != map.End());
+		EXPECT_EQ(it.GetValue(), i);
+	}
+
+	EXPECT_TRUE(map.Find(0) == map.End());
+}
+
+TEST_F(FlatHashMapTest, Clear) {
+	for (int i = 0; i < kFlatHashMapSize; ++i) {
+		intMap.Insert(i, i);
+	}
+
+	intMap.Clear();
+
+	EXPECT_TRUE(intMap.IsEmpty());
+	EXPECT_TRUE(intMap.Begin() == intMap.End());
+
+	intMap.Insert(5, 10);
+
+	EXPECT_EQ(intMap.Find(5).GetValue(), 10);
+}
+
+// Values are destroyed when they are removed or the map is destroyed
+TEST_F(FlatHashMapTest, ValueLifetime) {
+	std::shared_ptr<int> value(new int(1));
+
+	{
+		FlatHashMap<int, std::shared_ptr<int> > map(16);
+
+		map.Insert(1, value);
+		map.Insert(2, value);
+
+		EXPECT_EQ(value.use_count(), 3);
+
+		map.Remove(1);
+
+		EXPECT_EQ(value.use_count(), 2);
+	}
+
+	EXPECT_EQ(value.use_count(), 1);
+}
+
+// Growable map keeps all entries reachable while the groups are moved to the
+// larger table
+TEST_F(FlatHashMapTest, Growth) {
+	FlatHashMap<int, int> map(8, kContainerGrowthAuto);
+
+	const int entryCount = 2000;
+
+	bool sawRehashing = false;
+
+	for (int i = 0; i < entryCount; ++i) {
+		map.Insert(i, i * 2);
+
+		sawRehashing = sawRehashing || map.IsRehashing();
+
+		// Checks a few earlier entries, which may still be in the old table
+		for (int j = i; j >= 0 && j > i - 8; --j) {
+			if (j % 3 == 1 && j < i) {
+				continue;
+			}
+
+			auto it = map.Find(j);
+
+			ASSERT_TRUE(it != map.End());
+			EXPECT_EQ(it.GetValue(), j * 2);
+		}
+
+		// Removes some entries so that both tables have deleted slots
+		if (i % 3 == 2) {
+			map.Remove(i - 1);
+		}
+	}
+
+	EXPECT_TRUE(sawRehashing);
+	EXPECT_FALSE(map.IsFull());
+
+	int expectedCount = entryCount - entryCount / 3;
+
+	EXPECT_EQ(map.GetSize(), expectedCount);
+
+	for (int i = 0; i < entryCount; ++i) {
+		auto it = map.Find(i);
+
+		EXPECT_EQ(it == map.End(), i % 3 == 1 && i + 1 < entryCount);
+	}
+}
+
+// Iteration visits every entry once while part of the entries are still in
+// the old table
+TEST_F(FlatHashMapTest, IterateWhileRehashing) {
+	FlatHashMap<int, int> map(8, kContainerGrowthAuto);
+
+	int entryCount = 0;
+
+	while (!map.IsRehashing() || entryCount < 100) {
+		map.Insert(entryCount, entryCount);
+		++entryCount;
+
+		ASSERT_LT(entryCount, 100000);
+	}
+
+	bool* seen = new bool[entryCount];
+	memset(seen, 0, entryCount);
+
+	int counter = 0;
+	for (auto it = map.Begin(); it != map.End(); ++it) {
+		ASSERT_EQ(it.GetKey(), it.GetValue());
+		ASSERT_FALSE(seen[it.GetKey()]);
+
+		seen[it.GetKey()] = true;
+		++counter;
+	}
+
+	EXPECT_EQ(counter, entryCount);
+
+	// Iterating from an entry in the old table continues into the new one
+	counter = 0;
+	for (auto it = map.Find(0); it != map.End(); ++it) {
+		++counter;
+	}
+
+	EXPECT_GT(counter, 0);
+	EXPECT_LE(counter, entryCount);
+
+	delete[] seen;
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef FLATHASHMAP_TEST_H_
+#define FLATHASHMAP_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include "container/FlatHashMap.h"
+
+
+const int kFlatHashMapSize = 128;
+
+//--------------------------------------------------
+//
+// FlatHashMapTest
+//
+// FlatHashMap unit test
+//
+//--------------------------------------------------
+class FlatHashMapTest: public ::testing::Test {
+
+protected:
+	FlatHashMapTest(): intMap(kFlatHashMapSize) {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	FlatHashMap<int, int> intMap;
+};
+
+
+#endif
\ No newline at end of file
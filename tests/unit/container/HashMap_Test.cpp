@@ -1,5 +1,11 @@
 #include "hashmap_test.h"
 
+// Long enough to be allocated on the heap, so that an entry that is never
+// destroyed leaks and one that is never constructed is not a valid string
+static std::string MakeHashMapTestString(int i) {
+	return std::to_string(i) + std::string(48, '#');
+}
+
 
 TEST_F(HashMapTest, MaxLoad) {
 	for (int i = 0; i < kHashMapSize; ++i) {
@@ -131,4 +137,174 @@ TEST_F(HashMapTest, PostfixIncrementTest) {
 	for (int i = 0; i < kHashMapSize; ++i) {
 		intMap.Remove(i);
 	}
+}
+
+// Strings are compared by content, not by address
+TEST_F(HashMapTest, StringCopyTest) {
+	map.Insert("texture.png", 1);
+
+	char path[32];
+	strcpy(path, "texture.png");
+
+	auto it = map.Find((const char*)path);
+
+	ASSERT_TRUE(it != map.End());
+	EXPECT_EQ(it.GetValue(), 1);
+	EXPECT_STREQ(it.GetKey(), "texture.png");
+
+	map.Remove((const char*)path);
+
+	EXPECT_TRUE(map.Find("texture.png") == map.End());
+}
+
+// Keys can be enumerated and removing the last entry keeps the map list
+// intact
+TEST_F(HashMapTest, KeyIteration) {
+	const char* keys[] = { "a", "b", "c" };
+
+	for (int i = 0; i < 3; ++i) {
+		map.Insert(keys[i], i);
+	}
+
+	map.Remove("c");
+	map.Insert("d", 3);
+
+	const char* expected[] = { "a", "b", "d" };
+
+	int counter = 0;
+	for (auto it = map.Begin(); it != map.End(); ++it) {
+		ASSERT_LT(counter, 3);
+		EXPECT_STREQ(it.GetKey(), expected[counter]);
+		++counter;
+	}
+
+	EXPECT_EQ(counter, 3);
+}
+
+// Lookup with another key type and a hash computed once by the caller
+TEST_F(HashMapTest, HeterogeneousLookup) {
+	HashMap<const char*, int, HashMapTestSpanEqual> spanMap(kHashMapSize);
+
+	spanMap.Insert("sprites/player.png", 1);
+	spanMap.Insert("sprites/enemy.png", 2);
+
+	const char* path = "sprites/enemy.png;sprites/player.png";
+
+	HashMapTestSpan span1 = { path, 17 };
+	HashMapTestSpan span2 = { path + 18, 18 };
+
+	uint64_t hash1 = HashString(span1.str, span1.length);
+	uint64_t hash2 = HashString(span2.str, span2.length);
+
+	EXPECT_EQ(hash1, HashString("sprites/enemy.png"));
+
+	EXPECT_EQ(spanMap.Find(span1, hash1).GetValue(), 2);
+	EXPECT_EQ(spanMap.Find(span2, hash2).GetValue(), 1);
+
+	// Same hash with a different key is not a match
+	HashMapTestSpan prefix = { path, 8 };
+
+	EXPECT_TRUE(spanMap.Find(prefix, hash1) == spanMap.End());
+
+	spanMap.Remove(span1, hash1);
+
+	EXPECT_TRUE(spanMap.Find("sprites/enemy.png") == spanMap.End());
+}
+
+// Growable map keeps all entries reachable while the buckets are moved to the
+// larger table
+TEST_F(HashMapTest, Growth) {
+	HashMap<int, int> growMap(8, kContainerGrowthAuto);
+
+	const int entryCount = 1000;
+
+	bool sawRehashing = false;
+
+	for (int i = 0; i < entryCount; ++i) {
+		growMap.Insert(i, i * 2);
+
+		sawRehashing = sawRehashing || growMap.IsRehashing();
+
+		// Checks a few earlier entries, which may still be in the old table
+		for (int j = i; j >= 0 && j > i - 8; --j) {
+			auto it = growMap.Find(j);
+
+			ASSERT_TRUE(it != growMap.End());
+			EXPECT_EQ(it.GetValue(), j * 2);
+		}
+	}
+
+	EXPECT_TRUE(sawRehashing);
+	EXPECT_FALSE(growMap.IsFull());
+	EXPECT_EQ(growMap.GetSize(), entryCount);
+
+	int counter = 0;
+	for (auto it = growMap.Begin(); it != growMap.End(); ++it) {
+		EXPECT_EQ(it.GetValue(), it.GetKey() * 2);
+		++counter;
+	}
+
+	EXPECT_EQ(counter, entryCount);
+
+	for (int i = 0; i < entryCount; i += 2) {
+		growMap.Remove(i);
+	}
+
+	for (int i = 0; i < entryCount; ++i) {
+		EXPECT_EQ(growMap.Find(i) == growMap.End(), i % 2 == 0);
+	}
+}
+
+// Table, old table and entries all come from the given allocator
+TEST_F(HashMapTest, CustomAllocator) {
+	TlsfAllocator tlsf(256 * 1024);
+
+	{
+		HashMap<int, int> tlsfMap(8, kContainerGrowthAuto, &tlsf);
+
+		EXPECT_EQ(tlsfMap.GetAllocator(), &tlsf);
+
+		// Table and the first block of entries
+		EXPECT_EQ(tlsf.GetAllocCount(), 2);
+
+		for (int i = 0; i < 1000; ++i) {
+			tlsfMap.Insert(i, i);
+		}
+
+		for (int i = 0; i < 1000; ++i) {
+			EXPECT_EQ(tlsfMap.Find(i).GetValue(), i);
+		}
+
+		EXPECT_GT(tlsf.GetAllocCount(), 2);
+	}
+
+	EXPECT_EQ(tlsf.GetAllocCount(), 0);
+	EXPECT_EQ(tlsf.GetUsedSize(), 0);
+}
+
+// Values that own memory are constructed on insert and destroyed on removal
+TEST_F(HashMapTest, NonTrivialValue) {
+	HashMap<int, std::string> stringMap(8, kContainerGrowthAuto);
+
+	for (int i = 0; i < 200; ++i) {
+		stringMap.Insert(i, MakeHashMapTestString(i));
+	}
+
+	for (int i = 0; i < 200; i += 2) {
+		stringMap.Remove(i);
+	}
+
+	for (int i = 1; i < 200; i += 2) {
+		EXPECT_EQ(stringMap.Find(i).GetValue(), MakeHashMapTestString(i));
+	}
+
+	stringMap.Clear();
+
+	EXPECT_TRUE(stringMap.IsEmpty());
+
+	for (int i = 0; i < 100; ++i) {
+		stringMap.Insert(i, MakeHashMapTestString(i));
+	}
+
+	EXPECT_EQ(stringMap.Find(99).GetValue(), MakeHashMapTestString(99));
 }
\ No newline at end of file
@@ -5,11 +5,34 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "container/HashMap.h"
 
+#include "allocator/TlsfAllocator.h"
+
 
 const int kHashMapSize = 128;
 
+// Part of a string, used to test lookups with a key type other than the
+// stored one
+struct HashMapTestSpan {
+	const char* str;
+	size_t length;
+};
+
+class HashMapTestSpanEqual {
+
+public:
+	bool EqualFunc(const char* key1, const char* key2) {
+		return strcmp(key1, key2) == 0;
+	}
+
+	bool EqualFunc(const char* key, const HashMapTestSpan& span) {
+		return strncmp(key, span.str, span.length) == 0 && key[span.length] == '\0';
+	}
+};
+
 //--------------------------------------------------
 // 
 // HashMapTest
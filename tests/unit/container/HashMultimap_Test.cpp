@@ -1,5 +1,12 @@
 #include "hashmultimap_test.h"
 
+// Long enough to be allocated on the heap, so that an entry that is never
+// destroyed leaks and one that is never constructed is not a valid string
+static std::string MakeHashMultimapTestString(int i) {
+	return std::to_string(i) + std::string(48, '#');
+}
+
+
 TEST_F(HashMultimapTest, BucketIteration) {
 
 	for (int i = 0; i < 5; ++i) {
@@ -110,4 +117,83 @@ TEST_F(HashMultimapTest, WorstCaseLoad) {
 	for (int i = 0; i < kHashMultimapSize; ++i) {
 		intMap.Remove(i, i);
 	}
+}
+
+// Strings are compared by content, not by address
+TEST_F(HashMultimapTest, StringCopyTest) {
+	map.Insert("a", 1);
+	map.Insert("a", 2);
+
+	char key[2] = { 'a', '\0' };
+
+	int counter = 0;
+	for (auto it = map.Begin((const char*)key); it != map.End((const char*)key); ++it) {
+		++counter;
+	}
+
+	EXPECT_EQ(counter, 2);
+
+	map.RemoveKey((const char*)key);
+
+	EXPECT_EQ(map.GetSize(), 0);
+}
+
+// Growable multimap keeps all values of each key while the buckets are moved
+// to the larger table
+TEST_F(HashMultimapTest, Growth) {
+	HashMultimap<int, int> growMap(8, kContainerGrowthAuto);
+
+	const int keyCount = 500;
+
+	for (int i = 0; i < keyCount; ++i) {
+		growMap.Insert(i, i);
+		growMap.Insert(i, i + keyCount);
+	}
+
+	EXPECT_EQ(growMap.GetKeyCount(), keyCount);
+
+	for (int i = 0; i < keyCount; ++i) {
+		int counter = 0;
+		for (auto it = growMap.Begin(i); it != growMap.End(i); ++it) {
+			EXPECT_TRUE(it.GetValue() == i || it.GetValue() == i + keyCount);
+			++counter;
+		}
+
+		EXPECT_EQ(counter, 2);
+	}
+
+	for (int i = 0; i < keyCount; ++i) {
+		growMap.RemoveKey(i);
+	}
+
+	EXPECT_EQ(growMap.GetSize(), 0);
+}
+
+// Values that own memory are constructed on insert and destroyed on removal
+TEST_F(HashMultimapTest, NonTrivialValue) {
+	HashMultimap<int, std::string> stringMap(8, kContainerGrowthAuto);
+
+	for (int i = 0; i < 200; ++i) {
+		stringMap.Insert(i, MakeHashMultimapTestString(i));
+		stringMap.Insert(i, MakeHashMultimapTestString(i + 200));
+	}
+
+	for (int i = 0; i < 200; i += 2) {
+		stringMap.RemoveKey(i);
+	}
+
+	for (int i = 1; i < 200; i += 4) {
+		stringMap.Remove(i, MakeHashMultimapTestString(i));
+	}
+
+	EXPECT_EQ(stringMap.Begin(1).GetValue(), MakeHashMultimapTestString(201));
+	EXPECT_EQ(stringMap.Begin(3).GetValue(), MakeHashMultimapTestString(3));
+
+	stringMap.Clear();
+
+	for (int i = 0; i < 100; ++i) {
+		stringMap.Insert(i, MakeHashMultimapTestString(i));
+	}
+
+	EXPECT_EQ(stringMap.Begin(99).GetValue(), MakeHashMultimapTestString(99));
 }
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "MpmcQueue_Test.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_F(MpmcQueueTest, Empty) {
+	int value;
+
+	EXPECT_FALSE(queue.TryPop(&value));
+	EXPECT_EQ(queue.GetCapacity(), 64u);
+}
+
+TEST_F(MpmcQueueTest, MaxLoad) {
+	int cap = (int)queue.GetCapacity();
+
+	for (int i = 0; i < cap; ++i) {
+		EXPECT_TRUE(queue.TryPush(i));
+	}
+
+	EXPECT_FALSE(queue.TryPush(cap));
+
+	for (int i = 0; i < cap; ++i) {
+		int value = -1;
+
+		EXPECT_TRUE(queue.TryPop(&value));
+		EXPECT_EQ(value, i);
+	}
+
+	int value;
+
+	EXPECT_FALSE(queue.TryPop(&value));
+}
+
+TEST_F(MpmcQueueTest, WrapAround) {
+	int expected = 0;
+
+	for (int i = 0; i < 1000; ++i) {
+		EXPECT_TRUE(queue.TryPush(i));
+
+		int value = -1;
+
+		EXPECT_TRUE(queue.TryPop(&value));
+		EXPECT_EQ(value, expected++);
+	}
+}
+
+// Every pushed element is popped exactly once, and elements from one
+// producer keep their order
+TEST_F(MpmcQueueTest, ProducersConsumers) {
+	const int threadCount = 3;
+	const int countPerProducer = 20000;
+
+	std::atomic<int> popCount(0);
+	std::vector<int> seen(threadCount * countPerProducer, 0);
+	std::vector<std::thread> threads;
+
+	for (int t = 0; t < threadCount; ++t) {
+		threads.push_back(std::thread([this, t, countPerProducer]() {
+			for (int i = 0; i < countPerProducer; ++i) {
+				while (!queue.TryPush(t * countPerProducer + i)) {
+					std::this_thread::yield();
+				}
+			}
+		}));
+	}
+
+	std::vector<int> seenPerThread[threadCount];
+
+	for (int t = 0; t < threadCount; ++t) {
+		threads.push_back(std::thread([this, t, threadCount, countPerProducer, &popCount, &seenPerThread]() {
+			while (popCount.load() < threadCount * countPerProducer) {
+				int value;
+
+				if (queue.TryPop(&value)) {
+					seenPerThread[t].push_back(value);
+					popCount.fetch_add(1);
+				}
+				else {
+					std::this_thread::yield();
+				}
+			}
+		}));
+	}
+
+	for (size_t i = 0; i < threads.size(); ++i) {
+		threads[i].join();
+	}
+
+	for (int t = 0; t < threadCount; ++t) {
+		int last[threadCount] = { -1, -1, -1 };
+
+		for (size_t i = 0; i < seenPerThread[t].size(); ++i) {
+			int value = seenPerThread[t][i];
+			int producer = value / countPerProducer;
+
+			EXPECT_GT(value, last[producer]);
+			last[producer] = value;
+
+			++seen[value];
+		}
+	}
+
+	for (size_t i = 0; i < seen.size(); ++i) {
+		EXPECT_EQ(seen[i], 1);
+	}
+}
+
+// Elements left in the queue are destroyed with it
+TEST_F(MpmcQueueTest, DestroyRemaining) {
+	int live = 0;
+
+	{
+		MpmcQueue<MpmcQueueTestCounted> countedQueue(8);
+
+		for (int i = 0; i < 5; ++i) {
+			EXPECT_TRUE(countedQueue.TryPush(MpmcQueueTestCounted(&live)));
+		}
+
+		MpmcQueueTestCounted popped(&live);
+
+		EXPECT_TRUE(countedQueue.TryPop(&popped));
+		EXPECT_EQ(live, 5);
+	}
+
+	EXPECT_EQ(live, 0);
+}
\ No newline at end of file
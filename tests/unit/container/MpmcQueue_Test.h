@@ -0,0 +1,52 @@
+#ifndef MPMCQUEUE_TEST_H_
+#define MPMCQUEUE_TEST_H_
+
+#include <gtest/gtest.h>
+
+#include "container/MpmcQueue.h"
+
+// Counts the live copies of itself, and has no default constructor
+struct MpmcQueueTestCounted {
+	explicit MpmcQueueTestCounted(int* liveCount): live(liveCount) {
+		++*live;
+	}
+
+	MpmcQueueTestCounted(const MpmcQueueTestCounted& other): live(other.live) {
+		++*live;
+	}
+
+	~MpmcQueueTestCounted() {
+		--*live;
+	}
+
+	MpmcQueueTestCounted& operator=(const MpmcQueueTestCounted& other) {
+		++*other.live;
+		--*live;
+		live = other.live;
+
+		return *this;
+	}
+
+	int* live;
+};
+
+//--------------------------------------------------
+//
+// MpmcQueueTest
+//
+// MpmcQueue unit test
+//
+//--------------------------------------------------
+class MpmcQueueTest: public ::testing::Test {
+
+protected:
+	MpmcQueueTest(): queue(64) {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	MpmcQueue<int> queue;
+
+};
+
+#endif
\ No newline at end of file
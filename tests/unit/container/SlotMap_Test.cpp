@@ -0,0 +1,103 @@
+#include "SlotMap_Test.h"
+
+#include <string>
+
+TEST_F(SlotMapTest, InsertFind) {
+	SlotHandle32 handles[kSlotMapSize];
+
+	for (int i = 0; i < kSlotMapSize; ++i) {
+		handles[i] = map.Insert(i);
+
+		EXPECT_TRUE(handles[i].IsValid());
+	}
+
+	EXPECT_EQ(map.GetSize(), kSlotMapSize);
+	EXPECT_TRUE(map.IsFull());
+
+	for (int i = 0; i < kSlotMapSize; ++i) {
+		ASSERT_NE(map.Find(handles[i]), nullptr);
+		EXPECT_EQ(*map.Find(handles[i]), i);
+		EXPECT_EQ(map.GetHandle(map.GetIndex(handles[i])), handles[i]);
+	}
+
+	EXPECT_EQ(map.Find(SlotHandle32()), nullptr);
+}
+
+// Removing an element moves the last one into its place, and its handle
+// still finds it
+TEST_F(SlotMapTest, RemoveKeepsHandles) {
+	SlotHandle32 handles[kSlotMapSize];
+
+	for (int i = 0; i < kSlotMapSize; ++i) {
+		handles[i] = map.Insert(i);
+	}
+
+	for (int i = 0; i < kSlotMapSize; i += 2) {
+		map.Remove(handles[i]);
+	}
+
+	EXPECT_EQ(map.GetSize(), kSlotMapSize / 2);
+
+	for (int i = 0; i < kSlotMapSize; ++i) {
+		if (i % 2 == 0) {
+			EXPECT_FALSE(map.Contains(handles[i]));
+			EXPECT_EQ(map.Find(handles[i]), nullptr);
+		}
+		else {
+			ASSERT_NE(map.Find(handles[i]), nullptr);
+			EXPECT_EQ(*map.Find(handles[i]), i);
+		}
+	}
+
+	// Live elements are packed at the front
+	int sum = 0;
+
+	for (int i = 0; i < map.GetSize(); ++i) {
+		sum += map[i];
+	}
+
+	EXPECT_EQ(sum, (kSlotMapSize / 2) * (kSlotMapSize / 2));
+}
+
+// Handle to a removed element stays stale after its slot is reused
+TEST_F(SlotMapTest, StaleHandle) {
+	SlotHandle32 first = map.Insert(1);
+
+	map.Remove(first);
+
+	for (int i = 0; i < kSlotMapSize * 4; ++i) {
+		SlotHandle32 handle = map.Insert(i);
+
+		EXPECT_NE(handle, first);
+		EXPECT_EQ(map.Find(first), nullptr);
+
+		map.Remove(handle);
+	}
+
+	EXPECT_TRUE(map.IsEmpty());
+}
+
+TEST_F(SlotMapTest, Growth) {
+	SlotMap<std::string, SlotHandle64> strings(2, kContainerGrowthAuto);
+
+	SlotHandle64 handles[kSlotMapSize];
+
+	for (int i = 0; i < kSlotMapSize; ++i) {
+		handles[i] = strings.Insert(std::to_string(i));
+	}
+
+	EXPECT_EQ(strings.GetSize(), kSlotMapSize);
+	EXPECT_GE(strings.GetCapacity(), kSlotMapSize);
+
+	strings.Remove(handles[0]);
+
+	for (int i = 1; i < kSlotMapSize; ++i) {
+		ASSERT_NE(strings.Find(handles[i]), nullptr);
+		EXPECT_EQ(*strings.Find(handles[i]), std::to_string(i));
+	}
+
+	strings.Clear();
+
+	EXPECT_TRUE(strings.IsEmpty());
+	EXPECT_EQ(strings.Find(handles[1]), nullptr);
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef SLOTMAP_TEST_H_
+#define SLOTMAP_TEST_H_
+
+#include <gtest/gtest.h>
+
+#include "container/SlotMap.h"
+
+
+const int kSlotMapSize = 64;
+
+//--------------------------------------------------
+//
+// SlotMapTest
+//
+// SlotMap unit test
+//
+//--------------------------------------------------
+class SlotMapTest: public ::testing::Test {
+
+protected:
+	SlotMapTest(): map(kSlotMapSize) {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	SlotMap<int, SlotHandle32> map;
+
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "SmallVector_Test.h"
+
+TEST_F(SmallVectorTest, InlineUntilFull) {
+	EXPECT_EQ(vector.GetCapacity(), kSmallVectorInline);
+	EXPECT_EQ(vector.IsEmpty(), true);
+	EXPECT_EQ(vector.IsInline(), true);
+
+	for (int i = 0; i < kSmallVectorInline; ++i) {
+		vector.PushBack(i);
+	}
+
+	EXPECT_EQ(vector.GetSize(), kSmallVectorInline);
+	EXPECT_EQ(vector.IsInline(), true);
+
+	EXPECT_EQ(vector.GetFront(), 0);
+	EXPECT_EQ(vector.GetBack(), kSmallVectorInline - 1);
+
+	for (int i = 0; i < kSmallVectorInline; ++i) {
+		vector.PopBack();
+	}
+
+	EXPECT_EQ(vector.IsEmpty(), true);
+}
+
+TEST_F(SmallVectorTest, SpillToHeap) {
+	for (int i = 0; i < kSmallVectorInline * 4; ++i) {
+		vector.PushBack(i);
+	}
+
+	EXPECT_EQ(vector.IsInline(), false);
+	EXPECT_EQ(vector.GetSize(), kSmallVectorInline * 4);
+	EXPECT_EQ(vector.GetCapacity(), kSmallVectorInline * 4);
+
+	for (int i = 0; i < kSmallVectorInline * 4; ++i) {
+		EXPECT_EQ(vector[i], i);
+	}
+
+	// Capacity is kept after clearing
+	vector.Clear();
+
+	EXPECT_EQ(vector.IsEmpty(), true);
+	EXPECT_EQ(vector.GetCapacity(), kSmallVectorInline * 4);
+
+	// Capacity up to the inline size does not allocate
+	SmallVector<int, kSmallVectorInline> reserved(kSmallVectorInline);
+
+	EXPECT_EQ(reserved.IsInline(), true);
+
+	SmallVector<int, kSmallVectorInline> spilled(kSmallVectorInline + 1);
+
+	EXPECT_EQ(spilled.IsInline(), false);
+	EXPECT_EQ(spilled.GetCapacity(), kSmallVectorInline + 1);
+}
+
+TEST_F(SmallVectorTest, Remove) {
+	for (int i = 0; i < kSmallVectorInline; ++i) {
+		vector.EmplaceBack(i);
+	}
+
+	vector.Remove(0);
+
+	EXPECT_EQ(vector.GetSize(), kSmallVectorInline - 1);
+
+	for (int i = 0; i < kSmallVectorInline - 1; ++i) {
+		EXPECT_EQ(vector[i], i + 1);
+	}
+
+	vector.SwapRemove(0);
+
+	EXPECT_EQ(vector.GetSize(), kSmallVectorInline - 2);
+	EXPECT_EQ(vector[0], kSmallVectorInline - 1);
+	EXPECT_EQ(vector.GetBack(), kSmallVectorInline - 2);
+}
+
+// Elements that are not trivially copyable are moved to the heap intact
+TEST_F(SmallVectorTest, NonTrivialElements) {
+	SmallVector<std::string, 2> strings;
+
+	strings.PushBack("first string that is too long for the string's own buffer");
+	strings.EmplaceBack(3, 'a');
+
+	EXPECT_EQ(strings.IsInline(), true);
+
+	// Element from the vector itself stays valid while the vector spills
+	strings.PushBack(strings[0]);
+
+	EXPECT_EQ(strings.IsInline(), false);
+	EXPECT_EQ(strings.GetSize(), 3);
+	EXPECT_EQ(strings[0], strings[2]);
+	EXPECT_EQ(strings[1], "aaa");
+
+	strings.Remove(0);
+
+	EXPECT_EQ(strings[0], "aaa");
+	EXPECT_EQ(strings.GetBack(), "first string that is too long for the string's own buffer");
+}
+
+// Copies own their elements, and moves leave the source empty
+TEST_F(SmallVectorTest, CopyAndMove) {
+	const char* longString = "string that is too long for the string's own buffer";
+
+	SmallVector<std::string, 2> inlineStrings;
+	inlineStrings.PushBack(longString);
+
+	SmallVector<std::string, 2> heapStrings;
+
+	for (int i = 0; i < 5; ++i) {
+		heapStrings.PushBack(longString);
+	}
+
+	EXPECT_FALSE(heapStrings.IsInline());
+
+	SmallVector<std::string, 2> inlineCopy(inlineStrings);
+	SmallVector<std::string, 2> heapCopy(heapStrings);
+
+	heapCopy[0] = "changed";
+
+	EXPECT_TRUE(inlineCopy.IsInline());
+	EXPECT_EQ(inlineCopy[0], longString);
+	EXPECT_EQ(heapCopy.GetSize(), 5);
+	EXPECT_EQ(heapStrings[0], longString);
+
+	// Assigning a spilled array to one with heap memory of its own
+	heapCopy = heapStrings;
+
+	EXPECT_EQ(heapCopy[0], longString);
+
+	SmallVector<std::string, 2> heapMoved(std::move(heapCopy));
+
+	EXPECT_FALSE(heapMoved.IsInline());
+	EXPECT_EQ(heapMoved.GetSize(), 5);
+	EXPECT_TRUE(heapCopy.IsEmpty());
+	EXPECT_TRUE(heapCopy.IsInline());
+
+	// Inline elements are moved into the heap memory of the target
+	heapMoved = std::move(inlineCopy);
+
+	EXPECT_EQ(heapMoved.GetSize(), 1);
+	EXPECT_EQ(heapMoved[0], longString);
+	EXPECT_TRUE(inlineCopy.IsEmpty());
+
+	inlineCopy = heapStrings;
+
+	EXPECT_EQ(inlineCopy.GetSize(), 5);
+	EXPECT_EQ(inlineCopy[4], longString);
+}
+
+// Heap memory comes from the given allocator and moves with the array
+TEST_F(SmallVectorTest, CustomAllocator) {
+	TlsfAllocator tlsf(64 * 1024);
+
+	{
+		SmallVector<int, 4> tlsfVector(&tlsf);
+
+		EXPECT_EQ(tlsfVector.GetAllocator(), &tlsf);
+
+		for (int i = 0; i < 4; ++i) {
+			tlsfVector.PushBack(i);
+		}
+
+		EXPECT_EQ(tlsf.GetAllocCount(), 0);
+
+		for (int i = 4; i < 100; ++i) {
+			tlsfVector.PushBack(i);
+		}
+
+		EXPECT_EQ(tlsf.GetAllocCount(), 1);
+
+		SmallVector<int, 4> moved(std::move(tlsfVector));
+
+		EXPECT_EQ(moved.GetAllocator(), &tlsf);
+		EXPECT_EQ(moved[99], 99);
+		EXPECT_EQ(tlsf.GetAllocCount(), 1);
+
+		SmallVector<int, 4> copy(moved);
+
+		EXPECT_EQ(copy.GetAllocator(), &tlsf);
+		EXPECT_EQ(tlsf.GetAllocCount(), 2);
+	}
+
+	EXPECT_EQ(tlsf.GetAllocCount(), 0);
+	EXPECT_EQ(tlsf.GetUsedSize(), 0);
+}
\ No newline at end of file
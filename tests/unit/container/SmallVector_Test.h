@@ -0,0 +1,34 @@
+#ifndef SMALLVECTOR_TEST_H_
+#define SMALLVECTOR_TEST_H_
+
+#include <gtest/gtest.h>
+
+#include "container/SmallVector.h"
+
+#include "allocator/TlsfAllocator.h"
+
+#include <string>
+
+
+const int kSmallVectorInline = 8;
+
+//--------------------------------------------------
+//
+// SmallVectorTest
+//
+// SmallVector unit test
+//
+//--------------------------------------------------
+class SmallVectorTest: public ::testing::Test {
+
+protected:
+	SmallVectorTest() {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	SmallVector<int, kSmallVectorInline> vector;
+
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "SpscQueue_Test.h"
+
+#include <thread>
+
+TEST_F(SpscQueueTest, Empty) {
+	int value;
+
+	EXPECT_TRUE(queue.IsEmpty());
+	EXPECT_FALSE(queue.TryPop(&value));
+	EXPECT_EQ(queue.GetCapacity(), 64u);
+}
+
+TEST_F(SpscQueueTest, MaxLoad) {
+	int cap = (int)queue.GetCapacity();
+
+	for (int i = 0; i < cap; ++i) {
+		EXPECT_TRUE(queue.TryPush(i));
+	}
+
+	EXPECT_FALSE(queue.TryPush(cap));
+
+	for (int i = 0; i < cap; ++i) {
+		int value = -1;
+
+		EXPECT_TRUE(queue.TryPop(&value));
+		EXPECT_EQ(value, i);
+	}
+
+	EXPECT_TRUE(queue.IsEmpty());
+}
+
+// Indices keep counting past the capacity and must still map to the right
+// slots
+TEST_F(SpscQueueTest, WrapAround) {
+	int next = 0;
+	int expected = 0;
+
+	// Keeps the queue partly filled so the elements straddle the end
+	for (int i = 0; i < 3; ++i) {
+		EXPECT_TRUE(queue.TryPush(next++));
+	}
+
+	for (int i = 0; i < 1000; ++i) {
+		EXPECT_TRUE(queue.TryPush(next++));
+
+		int value = -1;
+
+		EXPECT_TRUE(queue.TryPop(&value));
+		EXPECT_EQ(value, expected++);
+	}
+}
+
+// Consumer sees every element in the order it was pushed
+TEST_F(SpscQueueTest, ProducerConsumer) {
+	const int count = 100000;
+
+	std::thread producer([this, count]() {
+		for (int i = 0; i < count; ++i) {
+			while (!queue.TryPush(i)) {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	int expected = 0;
+
+	while (expected < count) {
+		int value;
+
+		if (queue.TryPop(&value)) {
+			ASSERT_EQ(value, expected);
+			++expected;
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+
+	producer.join();
+
+	EXPECT_TRUE(queue.IsEmpty());
+}
+
+// Elements left in the queue are destroyed with it
+TEST_F(SpscQueueTest, DestroyRemaining) {
+	int live = 0;
+
+	{
+		SpscQueue<SpscQueueTestCounted> countedQueue(8);
+
+		for (int i = 0; i < 5; ++i) {
+			EXPECT_TRUE(countedQueue.TryPush(SpscQueueTestCounted(&live)));
+		}
+
+		SpscQueueTestCounted popped(&live);
+
+		EXPECT_TRUE(countedQueue.TryPop(&popped));
+		EXPECT_EQ(live, 5);
+	}
+
+	EXPECT_EQ(live, 0);
+}
\ No newline at end of file
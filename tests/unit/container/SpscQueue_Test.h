@@ -0,0 +1,52 @@
+#ifndef SPSCQUEUE_TEST_H_
+#define SPSCQUEUE_TEST_H_
+
+#include <gtest/gtest.h>
+
+#include "container/SpscQueue.h"
+
+// Counts the live copies of itself, and has no default constructor
+struct SpscQueueTestCounted {
+	explicit SpscQueueTestCounted(int* liveCount): live(liveCount) {
+		++*live;
+	}
+
+	SpscQueueTestCounted(const SpscQueueTestCounted& other): live(other.live) {
+		++*live;
+	}
+
+	~SpscQueueTestCounted() {
+		--*live;
+	}
+
+	SpscQueueTestCounted& operator=(const SpscQueueTestCounted& other) {
+		++*other.live;
+		--*live;
+		live = other.live;
+
+		return *this;
+	}
+
+	int* live;
+};
+
+//--------------------------------------------------
+//
+// SpscQueueTest
+//
+// SpscQueue unit test
+//
+//--------------------------------------------------
+class SpscQueueTest: public ::testing::Test {
+
+protected:
+	SpscQueueTest(): queue(64) {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	SpscQueue<int> queue;
+
+};
+
+#endif
\ No newline at end of file
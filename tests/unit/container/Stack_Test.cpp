@@ -75,4 +75,24 @@ TEST_F(StackTest, Clear) {
 	}
     
     delete[] ptrArr;
+}
+
+// Stack that only lives for a frame
+TEST_F(StackTest, FrameAllocator) {
+	FrameAllocator frameAlloc(4096);
+
+	{
+		Stack<StackStruct> frameStack(16, &frameAlloc);
+
+		EXPECT_EQ(frameAlloc.GetUsedSize(), sizeof(StackStruct) * 16);
+
+		StackStruct s = { 1.0, 2.0, 3.0, 4.0 };
+
+		frameStack.Push(s);
+
+		EXPECT_EQ(frameStack.GetFront(), s);
+	}
+
+	// Stack was the last allocation, so its memory is freed
+	EXPECT_EQ(frameAlloc.GetUsedSize(), 0);
 }
\ No newline at end of file
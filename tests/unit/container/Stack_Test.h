@@ -5,6 +5,8 @@
 
 #include "container/Stack.h"
 
+#include "allocator/FrameAllocator.h"
+
 struct StackStruct {
 	double x;
 	double y;
@@ -1,5 +1,12 @@
 #include "treemap_test.h"
 
+// Long enough to be allocated on the heap, so that an entry that is never
+// destroyed leaks and one that is never constructed is not a valid string
+static std::string MakeTreeMapTestString(int i) {
+	return std::to_string(i) + std::string(48, '#');
+}
+
+
 TEST_F(TreeMapTest, MaxInsertion) {
 
 	for (int i = 0; i < kTreeMapSize; ++i) {
@@ -74,4 +81,71 @@ TEST_F(TreeMapTest, Clear) {
     }
 
     map.Clear();
+}
+
+// Growable map is not limited by the initial number of nodes
+TEST_F(TreeMapTest, Growth) {
+	TreeMap<int, int> growMap(8, kContainerGrowthAuto);
+
+	const int entryCount = 1000;
+
+	for (int i = 0; i < entryCount; ++i) {
+		growMap.Insert(i, i);
+	}
+
+	for (int i = 0; i < entryCount; ++i) {
+		EXPECT_EQ(growMap.Find(i).GetValue(), i);
+	}
+
+	int counter = 0;
+	for (auto it = growMap.Begin(); it != growMap.End(); ++it) {
+		EXPECT_EQ(it.GetValue(), counter);
+		++counter;
+	}
+
+	EXPECT_EQ(counter, entryCount);
+}
+
+TEST_F(TreeMapTest, CustomAllocator) {
+	TlsfAllocator tlsf(64 * 1024);
+
+	{
+		TreeMap<int, int> tlsfMap(8, kContainerGrowthAuto, &tlsf);
+
+		EXPECT_EQ(tlsfMap.GetAllocator(), &tlsf);
+
+		for (int i = 0; i < 100; ++i) {
+			tlsfMap.Insert(i, i);
+		}
+
+		EXPECT_EQ(tlsfMap.Find(50).GetValue(), 50);
+		EXPECT_GT(tlsf.GetAllocCount(), 1);
+	}
+
+	EXPECT_EQ(tlsf.GetAllocCount(), 0);
+}
+
+// Values that own memory are constructed on insert and destroyed on removal
+TEST_F(TreeMapTest, NonTrivialValue) {
+	TreeMap<int, std::string> stringMap(8, kContainerGrowthAuto);
+
+	for (int i = 0; i < 200; ++i) {
+		stringMap.Insert(i, MakeTreeMapTestString(i));
+	}
+
+	for (int i = 0; i < 200; i += 2) {
+		stringMap.Remove(i);
+	}
+
+	for (int i = 1; i < 200; i += 2) {
+		EXPECT_EQ(stringMap.Find(i).GetValue(), MakeTreeMapTestString(i));
+	}
+
+	stringMap.Clear();
+
+	for (int i = 0; i < 100; ++i) {
+		stringMap.Insert(i, MakeTreeMapTestString(i));
+	}
+
+	EXPECT_EQ(stringMap.Find(99).GetValue(), MakeTreeMapTestString(99));
 }
\ No newline at end of file
@@ -5,8 +5,12 @@
 
 #include <gtest/gtest.h>
 
+#include <string>
+
 #include "container/TreeMap.h"
 
+#include "allocator/TlsfAllocator.h"
+
 
 const int kTreeMapSize = 128;
 
@@ -0,0 +1,95 @@
+#include "JobDeque_Test.h"
+
+#include <thread>
+#include <vector>
+
+TEST_F(JobDequeTest, Empty) {
+	EXPECT_EQ(deque.Pop(), nullptr);
+	EXPECT_EQ(deque.Steal(), nullptr);
+	EXPECT_EQ(deque.GetSize(), 0);
+}
+
+// Owner takes the newest job and thieves take the oldest
+TEST_F(JobDequeTest, PopAndStealOrder) {
+	for (size_t i = 0; i < 4; ++i) {
+		deque.Push(&jobs[i]);
+	}
+
+	EXPECT_EQ(deque.GetSize(), 4);
+
+	EXPECT_EQ(deque.Pop(), &jobs[3]);
+	EXPECT_EQ(deque.Steal(), &jobs[0]);
+	EXPECT_EQ(deque.Pop(), &jobs[2]);
+	EXPECT_EQ(deque.Steal(), &jobs[1]);
+
+	EXPECT_EQ(deque.Pop(), nullptr);
+	EXPECT_EQ(deque.Steal(), nullptr);
+}
+
+// Positions wrap around the end of the buffer
+TEST_F(JobDequeTest, WrapAround) {
+	for (int round = 0; round < 3; ++round) {
+		for (size_t i = 0; i < kJobDequeTestCapacity; ++i) {
+			deque.Push(&jobs[i]);
+		}
+
+		for (size_t i = 0; i < kJobDequeTestCapacity; ++i) {
+			EXPECT_EQ(deque.Steal(), &jobs[i]);
+		}
+	}
+
+	EXPECT_EQ(deque.GetSize(), 0);
+}
+
+// Every job pushed is taken exactly once while thieves steal concurrently
+TEST_F(JobDequeTest, ConcurrentSteal) {
+	const int kThiefCount = 3;
+	const int kRoundCount = 2000;
+
+	std::atomic<int> takenCount[kJobDequeTestCapacity];
+
+	for (size_t i = 0; i < kJobDequeTestCapacity; ++i) {
+		takenCount[i] = 0;
+	}
+
+	std::atomic<bool> done(false);
+
+	std::vector<std::thread> thieves;
+
+	for (int i = 0; i < kThiefCount; ++i) {
+		thieves.push_back(std::thread([&]() {
+			while (!done) {
+				Job* job = deque.Steal();
+
+				if (job != nullptr) {
+					++takenCount[job - jobs];
+				}
+			}
+		}));
+	}
+
+	for (int round = 0; round < kRoundCount; ++round) {
+		for (size_t i = 0; i < kJobDequeTestCapacity / 2; ++i) {
+			deque.Push(&jobs[i]);
+		}
+
+		// Owner takes jobs until the deque is empty
+		while (deque.GetSize() > 0) {
+			Job* job = deque.Pop();
+
+			if (job != nullptr) {
+				++takenCount[job - jobs];
+			}
+		}
+	}
+
+	done = true;
+
+	for (int i = 0; i < kThiefCount; ++i) {
+		thieves[i].join();
+	}
+
+	for (size_t i = 0; i < kJobDequeTestCapacity / 2; ++i) {
+		EXPECT_EQ(takenCount[i], kRoundCount);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef JOBDEQUE_TEST_H_
+#define JOBDEQUE_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include "job/JobDeque.h"
+#include "job/JobSystem.h"
+
+
+const size_t kJobDequeTestCapacity = 64;
+
+//--------------------------------------------------
+// 
+// JobDequeTest
+//
+// JobDeque unit test
+//
+//--------------------------------------------------
+class JobDequeTest: public ::testing::Test {
+
+protected:
+	JobDequeTest():
+	deque(kJobDequeTestCapacity) {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	JobDeque deque;
+
+	Job jobs[kJobDequeTestCapacity];
+};
+
+#endif
\ No newline at end of file
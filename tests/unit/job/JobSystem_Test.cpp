@@ -0,0 +1,182 @@
+#include "JobSystem_Test.h"
+
+const size_t kJobSystemTestItemCount = 10000;
+
+// Adds 1 to every item in the range
+static void IncrementTask(void* context, size_t begin, size_t end) {
+	std::atomic<int>* items = (std::atomic<int>*)context;
+
+	for (size_t i = begin; i < end; ++i) {
+		++items[i];
+	}
+}
+
+// Records the order that the jobs ran in
+struct JobSystemTestOrder {
+	std::atomic<int> next;
+	int order[2];
+};
+
+static void RecordOrderTask(void* context, size_t begin, size_t end) {
+	JobSystemTestOrder* order = (JobSystemTestOrder*)context;
+
+	order->order[begin] = order->next++;
+}
+
+TEST_F(JobSystemTest, ParallelForVisitsAllItems) {
+	std::atomic<int>* items = new std::atomic<int>[kJobSystemTestItemCount];
+
+	for (size_t i = 0; i < kJobSystemTestItemCount; ++i) {
+		items[i] = 0;
+	}
+
+	jobSystem.ParallelFor(&IncrementTask, (void*)items, kJobSystemTestItemCount, 64);
+
+	for (size_t i = 0; i < kJobSystemTestItemCount; ++i) {
+		EXPECT_EQ(items[i], 1);
+	}
+
+	delete[] items;
+}
+
+TEST_F(JobSystemTest, SubmitAndWait) {
+	std::atomic<int>* items = new std::atomic<int>[kJobSystemTestItemCount];
+
+	for (size_t i = 0; i < kJobSystemTestItemCount; ++i) {
+		items[i] = 0;
+	}
+
+	JobCounter counter;
+
+	EXPECT_TRUE(counter.IsDone());
+
+	for (size_t i = 0; i < kJobSystemTestItemCount; i += 100) {
+		jobSystem.Submit(&IncrementTask, (void*)items, i, i + 100, &counter);
+	}
+
+	jobSystem.Wait(&counter);
+
+	EXPECT_TRUE(counter.IsDone());
+
+	for (size_t i = 0; i < kJobSystemTestItemCount; ++i) {
+		EXPECT_EQ(items[i], 1);
+	}
+
+	delete[] items;
+}
+
+// Job with a dependency only runs after the jobs of the dependency
+TEST_F(JobSystemTest, Dependency) {
+	for (int i = 0; i < 100; ++i) {
+		JobSystemTestOrder order;
+		order.next = 0;
+
+		JobCounter first;
+		JobCounter second;
+
+		jobSystem.Submit(&RecordOrderTask, (void*)&order, 0, 1, &first);
+		jobSystem.Submit(&RecordOrderTask, (void*)&order, 1, 2, &second, &first);
+
+		jobSystem.Wait(&second);
+
+		EXPECT_TRUE(first.IsDone());
+		EXPECT_EQ(order.order[0], 0);
+		EXPECT_EQ(order.order[1], 1);
+	}
+}
+
+// Dependency that is already done does not hold the job back
+TEST_F(JobSystemTest, DoneDependency) {
+	JobSystemTestOrder order;
+	order.next = 0;
+
+	JobCounter first;
+	JobCounter second;
+
+	jobSystem.Submit(&RecordOrderTask, (void*)&order, 0, 1, &first);
+	jobSystem.Wait(&first);
+
+	jobSystem.Submit(&RecordOrderTask, (void*)&order, 1, 2, &second, &first);
+	jobSystem.Wait(&second);
+
+	EXPECT_EQ(order.order[1], 1);
+}
+
+// Without workers all jobs run on the waiting thread
+TEST_F(JobSystemTest, NoWorkers) {
+	JobSystem serial(0);
+
+	std::atomic<int>* items = new std::atomic<int>[kJobSystemTestItemCount];
+
+	for (size_t i = 0; i < kJobSystemTestItemCount; ++i) {
+		items[i] = 0;
+	}
+
+	JobCounter counter;
+
+	serial.Submit(&IncrementTask, (void*)items, 0, 10, &counter);
+	serial.Wait(&counter);
+
+	serial.ParallelFor(&IncrementTask, (void*)items, kJobSystemTestItemCount, 64);
+
+	EXPECT_EQ(items[0], 2);
+	EXPECT_EQ(items[kJobSystemTestItemCount - 1], 1);
+
+	delete[] items;
+}
+
+// Thread 0 can run its own jobs without waiting on their counter
+TEST_F(JobSystemTest, RunPendingJob) {
+	JobSystem serial(0);
+
+	std::atomic<int>* items = new std::atomic<int>[kJobSystemTestItemCount];
+
+	for (size_t i = 0; i < kJobSystemTestItemCount; ++i) {
+		items[i] = 0;
+	}
+
+	JobCounter counter;
+
+	EXPECT_FALSE(serial.RunPendingJob());
+
+	serial.Submit(&IncrementTask, (void*)items, 0, 10, &counter);
+
+	EXPECT_FALSE(counter.IsDone());
+	EXPECT_TRUE(serial.RunPendingJob());
+	EXPECT_TRUE(counter.IsDone());
+	EXPECT_EQ(items[0], 1);
+
+	delete[] items;
+}
+
+// Submitting more jobs than the ring holds waits for slots instead of
+// overwriting unfinished jobs
+TEST_F(JobSystemTest, SubmitMoreThanRing) {
+	size_t jobCount = kJobSystemJobMax * 3;
+
+	std::atomic<int>* items = new std::atomic<int>[jobCount];
+
+	for (size_t i = 0; i < jobCount; ++i) {
+		items[i] = 0;
+	}
+
+	JobCounter counter;
+
+	for (size_t i = 0; i < jobCount; ++i) {
+		jobSystem.Submit(&IncrementTask, (void*)items, i, i + 1, &counter);
+	}
+
+	jobSystem.Wait(&counter);
+
+	for (size_t i = 0; i < jobCount; ++i) {
+		EXPECT_EQ(items[i], 1);
+	}
+
+	jobSystem.ParallelFor(&IncrementTask, (void*)items, jobCount, 1);
+
+	for (size_t i = 0; i < jobCount; ++i) {
+		EXPECT_EQ(items[i], 2);
+	}
+
+	delete[] items;
+}
\ No newline at end of file
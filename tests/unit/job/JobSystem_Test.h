@@ -0,0 +1,32 @@
+#ifndef JOBSYSTEM_TEST_H_
+#define JOBSYSTEM_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include "job/JobSystem.h"
+
+
+const int kJobSystemTestWorkerCount = 3;
+
+//--------------------------------------------------
+// 
+// JobSystemTest
+//
+// JobSystem unit test
+//
+//--------------------------------------------------
+class JobSystemTest: public ::testing::Test {
+
+protected:
+	JobSystemTest():
+	jobSystem(kJobSystemTestWorkerCount) {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	JobSystem jobSystem;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include "CollisionDetector_Test.h"
+
+#include <cstdlib>
+
+// Returns a rect with corners on a small integer grid so that many rects
+// touch or share edges
+static Rect RandomGridRect() {
+	double x = (double)(rand() % 16);
+	double y = (double)(rand() % 16);
+	double w = (double)(rand() % 6);
+	double h = (double)(rand() % 6);
+
+	return Rect(x, y, w, h);
+}
+
+TEST_F(CollisionDetectorTest, AABBToAABB) {
+	Vec2 mtv = detector.AABBToAABB(Rect(0.0, 0.0, 10.0, 10.0), Rect(8.0, 1.0, 10.0, 10.0));
+	EXPECT_EQ(mtv, Vec2(-2.0, 0.0));
+
+	mtv = detector.AABBToAABB(Rect(0.0, 0.0, 10.0, 10.0), Rect(20.0, 0.0, 10.0, 10.0));
+	EXPECT_EQ(mtv, Vec2(0.0, 0.0));
+}
+
+TEST_F(CollisionDetectorTest, QuadToQuad) {
+	Vec2 quad1[4] = { Vec2(0.0, 0.0), Vec2(10.0, 0.0), Vec2(10.0, 10.0), Vec2(0.0, 10.0) };
+	Vec2 quad2[4] = { Vec2(8.0, 1.0), Vec2(18.0, 1.0), Vec2(18.0, 11.0), Vec2(8.0, 11.0) };
+	Vec2 quad3[4] = { Vec2(20.0, 20.0), Vec2(30.0, 20.0), Vec2(30.0, 30.0), Vec2(20.0, 30.0) };
+
+	// Min translation vector moves quad1 out of quad2
+	Vec2 mtv = detector.QuadToQuad(quad1, quad2);
+	EXPECT_EQ(mtv, Vec2(-2.0, 0.0));
+
+	mtv = detector.QuadToQuad(quad2, quad1);
+	EXPECT_EQ(mtv, Vec2(2.0, 0.0));
+
+	// Quads that are far from the world origin
+	mtv = detector.QuadToQuad(quad1, quad3);
+	EXPECT_EQ(mtv, Vec2(0.0, 0.0));
+}
+
+TEST_F(CollisionDetectorTest, SweptAABBToAABB) {
+	double toi = -1.0;
+
+	// Moves through a thin wall in one step
+	EXPECT_TRUE(detector.SweptAABBToAABB(Rect(0.0, 0.0, 4.0, 4.0), Vec2(50.0, 0.0), Rect(24.0, -10.0, 2.0, 20.0), &toi));
+	EXPECT_EQ(toi, 0.4);
+
+	// Moves diagonally past the corner of the wall
+	EXPECT_FALSE(detector.SweptAABBToAABB(Rect(0.0, 0.0, 4.0, 4.0), Vec2(50.0, -50.0), Rect(24.0, 0.0, 2.0, 20.0), &toi));
+
+	// Stops before the wall
+	EXPECT_FALSE(detector.SweptAABBToAABB(Rect(0.0, 0.0, 4.0, 4.0), Vec2(10.0, 0.0), Rect(24.0, -10.0, 2.0, 20.0), &toi));
+
+	// Moves away from the wall
+	EXPECT_FALSE(detector.SweptAABBToAABB(Rect(0.0, 0.0, 4.0, 4.0), Vec2(-50.0, 0.0), Rect(24.0, -10.0, 2.0, 20.0), &toi));
+
+	// Already overlaps before the move
+	EXPECT_FALSE(detector.SweptAABBToAABB(Rect(23.0, 0.0, 4.0, 4.0), Vec2(50.0, 0.0), Rect(24.0, -10.0, 2.0, 20.0), &toi));
+}
+
+TEST_F(CollisionDetectorTest, BatchSeparateAndOverlap) {
+	SetRect1(0, Rect(0.0, 0.0, 10.0, 10.0));
+	SetRect2(0, Rect(8.0, 1.0, 10.0, 10.0));
+
+	SetRect1(1, Rect(0.0, 0.0, 10.0, 10.0));
+	SetRect2(1, Rect(20.0, 0.0, 10.0, 10.0));
+
+	// Touching edges do not collide
+	SetRect1(2, Rect(0.0, 0.0, 10.0, 10.0));
+	SetRect2(2, Rect(10.0, 0.0, 10.0, 10.0));
+
+	SetRect1(3, Rect(0.0, 0.0, 10.0, 10.0));
+	SetRect2(3, Rect(1.0, -7.0, 8.0, 8.0));
+
+	detector.AABBToAABBBatch(rects1, rects2, 4, collisions, mtvX, mtvY);
+
+	EXPECT_EQ(collisions[0], 1);
+	EXPECT_EQ(mtvX[0], -2.0);
+	EXPECT_EQ(mtvY[0], 0.0);
+
+	EXPECT_EQ(collisions[1], 0);
+	EXPECT_EQ(collisions[2], 0);
+
+	EXPECT_EQ(collisions[3], 1);
+	EXPECT_EQ(mtvX[3], 0.0);
+	EXPECT_EQ(mtvY[3], 1.0);
+}
+
+// Rects with no width and height never collide
+TEST_F(CollisionDetectorTest, BatchEmptyRect) {
+	SetRect1(0, Rect(5.0, 5.0, 0.0, 0.0));
+	SetRect2(0, Rect(0.0, 0.0, 10.0, 10.0));
+
+	SetRect1(1, Rect(0.0, 0.0, 10.0, 10.0));
+	SetRect2(1, Rect(5.0, 5.0, 0.0, 0.0));
+
+	detector.AABBToAABBBatch(rects1, rects2, 2, collisions, mtvX, mtvY);
+
+	EXPECT_EQ(collisions[0], 0);
+	EXPECT_EQ(collisions[1], 0);
+}
+
+// Batched results must be the same as testing each pair on its own
+TEST_F(CollisionDetectorTest, BatchMatchesAABBToAABB) {
+	srand(1);
+
+	Rect rectArray1[kCollisionBatchSize];
+	Rect rectArray2[kCollisionBatchSize];
+
+	for (int i = 0; i < kCollisionBatchSize; ++i) {
+		rectArray1[i] = RandomGridRect();
+		rectArray2[i] = RandomGridRect();
+
+		SetRect1(i, rectArray1[i]);
+		SetRect2(i, rectArray2[i]);
+	}
+
+	detector.AABBToAABBBatch(rects1, rects2, kCollisionBatchSize, collisions, mtvX, mtvY);
+
+	for (int i = 0; i < kCollisionBatchSize; ++i) {
+		Vec2 mtv = detector.AABBToAABB(rectArray1[i], rectArray2[i]);
+
+		EXPECT_EQ(collisions[i], (mtv != Vec2(0.0, 0.0)) ? 1 : 0);
+
+		if (collisions[i]) {
+			EXPECT_EQ(Vec2(mtvX[i], mtvY[i]), mtv);
+		}
+	}
+}
+
+TEST_F(CollisionDetectorTest, BatchOneToMany) {
+	srand(2);
+
+	Rect rect = Rect(4.0, 4.0, 6.0, 6.0);
+
+	Rect rectArray[kCollisionBatchSize];
+
+	for (int i = 0; i < kCollisionBatchSize; ++i) {
+		rectArray[i] = RandomGridRect();
+
+		SetRect2(i, rectArray[i]);
+	}
+
+	detector.AABBToAABBBatch(rect, rects2, kCollisionBatchSize, collisions, mtvX, mtvY);
+
+	for (int i = 0; i < kCollisionBatchSize; ++i) {
+		Vec2 mtv = detector.AABBToAABB(rect, rectArray[i]);
+
+		EXPECT_EQ(collisions[i], (mtv != Vec2(0.0, 0.0)) ? 1 : 0);
+
+		if (collisions[i]) {
+			EXPECT_EQ(Vec2(mtvX[i], mtvY[i]), mtv);
+		}
+	}
+}
\ No newline at end of file
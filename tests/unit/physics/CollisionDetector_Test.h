@@ -0,0 +1,74 @@
+#ifndef COLLISIONDETECTOR_TEST_H_
+#define COLLISIONDETECTOR_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include "physics/CollisionDetector.h"
+
+
+// Not a multiple of any lane width so that the scalar tail is also tested
+const int kCollisionBatchSize = 67;
+
+//--------------------------------------------------
+// 
+// CollisionDetectorTest
+//
+// CollisionDetector unit test
+//
+//--------------------------------------------------
+class CollisionDetectorTest: public ::testing::Test {
+
+protected:
+	CollisionDetectorTest() {
+		rects1.minX = minX1;
+		rects1.minY = minY1;
+		rects1.maxX = maxX1;
+		rects1.maxY = maxY1;
+
+		rects2.minX = minX2;
+		rects2.minY = minY2;
+		rects2.maxX = maxX2;
+		rects2.maxY = maxY2;
+	}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	// Packs the rect into element i of the first or second array
+	void SetRect1(int i, const Rect& rect) {
+		minX1[i] = rect.GetX();
+		minY1[i] = rect.GetY();
+		maxX1[i] = rect.GetX() + rect.GetW();
+		maxY1[i] = rect.GetY() + rect.GetH();
+	}
+
+	void SetRect2(int i, const Rect& rect) {
+		minX2[i] = rect.GetX();
+		minY2[i] = rect.GetY();
+		maxX2[i] = rect.GetX() + rect.GetW();
+		maxY2[i] = rect.GetY() + rect.GetH();
+	}
+
+	CollisionDetector detector;
+
+	double minX1[kCollisionBatchSize];
+	double minY1[kCollisionBatchSize];
+	double maxX1[kCollisionBatchSize];
+	double maxY1[kCollisionBatchSize];
+
+	double minX2[kCollisionBatchSize];
+	double minY2[kCollisionBatchSize];
+	double maxX2[kCollisionBatchSize];
+	double maxY2[kCollisionBatchSize];
+
+	CollisionAABBArray rects1;
+	CollisionAABBArray rects2;
+
+	uint8_t collisions[kCollisionBatchSize];
+	double mtvX[kCollisionBatchSize];
+	double mtvY[kCollisionBatchSize];
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "PhysBodyStore_Test.h"
+
+TEST_F(PhysBodyStoreTest, Add) {
+	EXPECT_EQ(store.Add(&bodies[0]), 0);
+	EXPECT_EQ(store.Add(&bodies[1]), 1);
+
+	EXPECT_EQ(store.size, 2);
+	EXPECT_EQ(store.bodies[1], &bodies[1]);
+
+	// New bodies are unrotated and not moving
+	EXPECT_EQ(store.rotXX[1], 1.0);
+	EXPECT_EQ(store.rotXY[1], 0.0);
+	EXPECT_EQ(store.velX[1], 0.0);
+	EXPECT_EQ(store.types[1], kPhysBodyNone);
+}
+
+// Removing a body moves the last body into its place
+TEST_F(PhysBodyStoreTest, Remove) {
+	for (int i = 0; i < 4; ++i) {
+		int index = store.Add(&bodies[i]);
+		store.posX[index] = (double)i;
+		store.layers[index] = (uint16_t)i;
+	}
+
+	store.Remove(1);
+
+	EXPECT_EQ(store.size, 3);
+	EXPECT_EQ(store.bodies[1], &bodies[3]);
+	EXPECT_EQ(store.posX[1], 3.0);
+	EXPECT_EQ(store.layers[1], 3);
+
+	// Removing the last body leaves the others in place
+	store.Remove(2);
+
+	EXPECT_EQ(store.size, 2);
+	EXPECT_EQ(store.bodies[0], &bodies[0]);
+	EXPECT_EQ(store.bodies[1], &bodies[3]);
+}
+
+TEST_F(PhysBodyStoreTest, Full) {
+	for (int i = 0; i < kPhysBodyStoreCapacity; ++i) {
+		store.Add(&bodies[i]);
+	}
+
+	EXPECT_EQ(store.size, store.capacity);
+
+	store.Remove(0);
+	EXPECT_EQ(store.Add(&bodies[0]), kPhysBodyStoreCapacity - 1);
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef PHYSBODYSTORE_TEST_H_
+#define PHYSBODYSTORE_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include "physics/PhysBodyStore.h"
+
+
+const int kPhysBodyStoreCapacity = 8;
+
+//--------------------------------------------------
+// 
+// PhysBodyStoreTest
+//
+// PhysBodyStore unit test
+//
+//--------------------------------------------------
+class PhysBodyStoreTest: public ::testing::Test {
+
+protected:
+	PhysBodyStoreTest():
+	store(kPhysBodyStoreCapacity) {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	PhysBodyStore store;
+
+	// Handles are never constructed into the store, only used as back
+	// pointers
+	PhysBody bodies[kPhysBodyStoreCapacity];
+};
+
+#endif
\ No newline at end of file
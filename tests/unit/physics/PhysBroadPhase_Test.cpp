@@ -0,0 +1,157 @@
+#include "PhysBroadPhase_Test.h"
+
+#include <cstdlib>
+#include <cstring>
+
+static bool TestRectOverlap(const Rect& rect1, const Rect& rect2) {
+	return !(rect1.GetX() + rect1.GetW() < rect2.GetX() ||
+			rect2.GetX() + rect2.GetW() < rect1.GetX() ||
+			rect1.GetY() + rect1.GetH() < rect2.GetY() ||
+			rect2.GetY() + rect2.GetH() < rect1.GetY());
+}
+
+TEST_F(PhysBroadPhaseTest, NoBodies) {
+	broadPhase.FindPairs(&pairs);
+
+	EXPECT_EQ(pairs.GetSize(), 0);
+}
+
+TEST_F(PhysBroadPhaseTest, SeparateBodies) {
+	broadPhase.Insert(0, Rect(0.0, 0.0, 10.0, 10.0));
+	broadPhase.Insert(1, Rect(20.0, 0.0, 10.0, 10.0));
+	broadPhase.Insert(2, Rect(0.0, 20.0, 10.0, 10.0));
+
+	broadPhase.FindPairs(&pairs);
+
+	EXPECT_EQ(pairs.GetSize(), 0);
+}
+
+// Bodies that share many cells must only be reported once
+TEST_F(PhysBroadPhaseTest, LargeBodies) {
+	broadPhase.Insert(0, Rect(-100.0, -100.0, 200.0, 200.0));
+	broadPhase.Insert(1, Rect(-50.0, -50.0, 150.0, 150.0));
+	broadPhase.Insert(2, Rect(90.0, 90.0, 5.0, 5.0));
+
+	broadPhase.FindPairs(&pairs);
+
+	EXPECT_EQ(pairs.GetSize(), 3);
+
+	for (size_t i = 0; i < pairs.GetSize(); ++i) {
+		EXPECT_LT(pairs[i].index1, pairs[i].index2);
+	}
+}
+
+TEST_F(PhysBroadPhaseTest, Clear) {
+	broadPhase.Insert(0, Rect(0.0, 0.0, 10.0, 10.0));
+	broadPhase.Insert(1, Rect(5.0, 5.0, 10.0, 10.0));
+
+	broadPhase.Clear();
+
+	broadPhase.FindPairs(&pairs);
+
+	EXPECT_EQ(pairs.GetSize(), 0);
+}
+
+// Compares the pairs found against testing every pair of bodies
+TEST_F(PhysBroadPhaseTest, MatchesAllPairs) {
+	Rect rects[kPhysBroadPhaseBodyMax];
+
+	srand(1);
+
+	for (int i = 0; i < kPhysBroadPhaseBodyMax; ++i) {
+		rects[i] = Rect((double)(rand() % 1000) - 500.0, (double)(rand() % 1000) - 500.0,
+						(double)(rand() % 80 + 1), (double)(rand() % 80 + 1));
+
+		broadPhase.Insert(i, rects[i]);
+	}
+
+	broadPhase.FindPairs(&pairs);
+
+	// Number of times each pair was reported
+	int* found = new int[kPhysBroadPhaseBodyMax * kPhysBroadPhaseBodyMax];
+	memset((void*)found, 0, sizeof(int) * kPhysBroadPhaseBodyMax * kPhysBroadPhaseBodyMax);
+
+	for (size_t i = 0; i < pairs.GetSize(); ++i) {
+		++found[pairs[i].index1 * kPhysBroadPhaseBodyMax + pairs[i].index2];
+	}
+
+	for (int i = 0; i < kPhysBroadPhaseBodyMax; ++i) {
+		for (int j = i + 1; j < kPhysBroadPhaseBodyMax; ++j) {
+			int expected = TestRectOverlap(rects[i], rects[j]) ? 1 : 0;
+
+			EXPECT_EQ(found[i * kPhysBroadPhaseBodyMax + j], expected);
+		}
+	}
+
+	delete[] found;
+}
+
+// Queried body is not in the grid and existing pairs are kept
+TEST_F(PhysBroadPhaseTest, Query) {
+	broadPhase.Insert(0, Rect(0.0, 0.0, 10.0, 10.0));
+	broadPhase.Insert(2, Rect(100.0, 0.0, 10.0, 10.0));
+	broadPhase.Insert(3, Rect(-40.0, -40.0, 45.0, 45.0));
+
+	broadPhase.Build();
+
+	PhysPair pair;
+	pair.index1 = 5;
+	pair.index2 = 6;
+	pairs.PushBack(pair);
+
+	broadPhase.Query(1, Rect(2.0, 2.0, 4.0, 4.0), &pairs);
+
+	ASSERT_EQ(pairs.GetSize(), 3);
+
+	EXPECT_EQ(pairs[0].index1, 5);
+
+	// Pairs are ordered by index even though the queried body came first
+	for (size_t i = 1; i < pairs.GetSize(); ++i) {
+		EXPECT_LT(pairs[i].index1, pairs[i].index2);
+		EXPECT_TRUE(pairs[i].index1 == 1 || pairs[i].index2 == 1);
+	}
+}
+
+// Compares the pairs found by queries against testing every body
+TEST_F(PhysBroadPhaseTest, QueryMatchesAllBodies) {
+	const int kQueryCount = 64;
+
+	Rect rects[kPhysBroadPhaseBodyMax];
+
+	srand(2);
+
+	for (int i = 0; i < kPhysBroadPhaseBodyMax; ++i) {
+		rects[i] = Rect((double)(rand() % 1000) - 500.0, (double)(rand() % 1000) - 500.0,
+						(double)(rand() % 80 + 1), (double)(rand() % 80 + 1));
+
+		// Queried bodies are not in the grid
+		if (i >= kQueryCount) {
+			broadPhase.Insert(i, rects[i]);
+		}
+	}
+
+	broadPhase.Build();
+
+	for (int i = 0; i < kQueryCount; ++i) {
+		pairs.Clear();
+
+		broadPhase.Query(i, rects[i], &pairs);
+
+		int* found = new int[kPhysBroadPhaseBodyMax];
+		memset((void*)found, 0, sizeof(int) * kPhysBroadPhaseBodyMax);
+
+		for (size_t j = 0; j < pairs.GetSize(); ++j) {
+			EXPECT_EQ(pairs[j].index1, i);
+
+			++found[pairs[j].index2];
+		}
+
+		for (int j = kQueryCount; j < kPhysBroadPhaseBodyMax; ++j) {
+			int expected = TestRectOverlap(rects[i], rects[j]) ? 1 : 0;
+
+			EXPECT_EQ(found[j], expected);
+		}
+
+		delete[] found;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef PHYSBROADPHASE_TEST_H_
+#define PHYSBROADPHASE_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include "physics/PhysBroadPhase.h"
+
+
+const int kPhysBroadPhaseBodyMax = 256;
+
+//--------------------------------------------------
+// 
+// PhysBroadPhaseTest
+//
+// PhysBroadPhase unit test
+//
+//--------------------------------------------------
+class PhysBroadPhaseTest: public ::testing::Test {
+
+protected:
+	PhysBroadPhaseTest():
+	broadPhase(kPhysBroadPhaseBodyMax, 32.0),
+	pairs(16) {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	PhysBroadPhase broadPhase;
+	DynArray<PhysPair> pairs;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,333 @@
+#include "PhysWorld_Test.h"
+
+#include <cstdlib>
+#include <cstring>
+
+const int kPhysWorldCrowdBodyCount = 512;
+
+// Simulates a crowded scene and writes the final position of every body
+//
+// Scene is crowded enough that the pairs are split between the workers
+static void RunCrowdedWorld(JobSystem* jobSystem, Vec2* positions) {
+	PhysWorld world(kPhysWorldCrowdBodyCount);
+	world.SetJobSystem(jobSystem);
+
+	PhysWorldTestEntity* entities = new PhysWorldTestEntity[kPhysWorldCrowdBodyCount];
+	PhysBody** bodies = new PhysBody*[kPhysWorldCrowdBodyCount];
+
+	srand(1);
+
+	for (int i = 0; i < kPhysWorldCrowdBodyCount; ++i) {
+		entities[i].TranslateTo(Vec2((double)(rand() % 300), (double)(rand() % 300)));
+
+		// Some of the bodies are rotated so that the quad test also runs
+		if (i % 16 == 1) {
+			entities[i].RotateTo((double)(rand() % 90));
+		}
+
+		PhysBodyType_t type = (i % 4 == 0) ? kPhysBodyStatic : kPhysBodyDynamic;
+
+		bodies[i] = world.CreateBody(type, 0, &entities[i]);
+		bodies[i]->SetOrigin(Vec2(8.0, 8.0));
+		bodies[i]->SetWidth(16.0);
+		bodies[i]->SetHeight(16.0);
+
+		if (type == kPhysBodyDynamic) {
+			bodies[i]->SetVelocity(Vec2((double)(rand() % 5) - 2.0, (double)(rand() % 5) - 2.0));
+		}
+	}
+
+	for (int i = 0; i < 20; ++i) {
+		world.Update();
+	}
+
+	for (int i = 0; i < kPhysWorldCrowdBodyCount; ++i) {
+		Mat3 transform = entities[i].GetWorldTransform();
+		positions[i] = Vec2(transform.GetRow1().GetZ(), transform.GetRow2().GetZ());
+
+		world.DestroyBody(bodies[i]);
+	}
+
+	delete[] bodies;
+	delete[] entities;
+}
+
+TEST_F(PhysWorldTest, DynamicStopsAtStatic) {
+	PhysWorldTestEntity wall;
+	PhysWorldTestEntity box;
+	box.TranslateTo(Vec2(40.0, 0.0));
+
+	PhysBody* wallBody = CreateBody(kPhysBodyStatic, &wall, 30.0, 30.0);
+	PhysBody* boxBody = CreateBody(kPhysBodyDynamic, &box, 30.0, 30.0);
+	boxBody->SetVelocity(Vec2(-1.0, 0.0));
+
+	for (int i = 0; i < 30; ++i) {
+		world.Update();
+	}
+
+	EXPECT_EQ(box.GetWorldTransform().GetRow1().GetZ(), 30.0);
+	EXPECT_EQ(wall.GetWorldTransform().GetRow1().GetZ(), 0.0);
+	EXPECT_GT(box.collisionCount, 0);
+
+	world.DestroyBody(boxBody);
+	world.DestroyBody(wallBody);
+}
+
+// Each body of a rotated pair must use its own size
+TEST_F(PhysWorldTest, RotatedBodiesOfDifferentSize) {
+	PhysWorldTestEntity box;
+	PhysWorldTestEntity wall;
+
+	// Wall is rotated to become 10 wide and 100 high, and reaches the box
+	// only through its full height
+	wall.TranslateTo(Vec2(8.0, 40.0));
+	wall.RotateTo(90.0);
+
+	PhysBody* boxBody = CreateBody(kPhysBodyDynamic, &box, 10.0, 10.0);
+	PhysBody* wallBody = CreateBody(kPhysBodyStatic, &wall, 100.0, 10.0);
+
+	world.Update();
+
+	EXPECT_EQ(box.collisionCount, 1);
+	EXPECT_EQ(wall.collisionCount, 1);
+
+	world.DestroyBody(wallBody);
+	world.DestroyBody(boxBody);
+}
+
+// Bullet moving further than the width of a wall in one step must stop at
+// the wall
+TEST_F(PhysWorldTest, BulletStopsAtThinWall) {
+	PhysWorldTestEntity bullet;
+	PhysWorldTestEntity wall1;
+	PhysWorldTestEntity wall2;
+
+	wall1.TranslateTo(Vec2(30.0, 0.0));
+	wall2.TranslateTo(Vec2(40.0, 0.0));
+
+	// Created last so that the later wall has the lower index
+	PhysBody* wallBody2 = CreateBody(kPhysBodyStatic, &wall2, 2.0, 20.0);
+	PhysBody* wallBody1 = CreateBody(kPhysBodyStatic, &wall1, 2.0, 20.0);
+	PhysBody* bulletBody = CreateBody(kPhysBodyDynamic, &bullet, 4.0, 4.0);
+	bulletBody->SetVelocity(Vec2(50.0, 0.0));
+	bulletBody->SetBullet(true);
+
+	world.Update();
+
+	// Stops touching the first wall that it hits
+	EXPECT_EQ(bullet.GetWorldTransform().GetRow1().GetZ(), 27.0);
+	EXPECT_EQ(bullet.collisionCount, 1);
+	EXPECT_EQ(wall1.collisionCount, 1);
+	EXPECT_EQ(wall2.collisionCount, 0);
+
+	world.DestroyBody(bulletBody);
+	world.DestroyBody(wallBody1);
+	world.DestroyBody(wallBody2);
+}
+
+// Without the bullet flag the body passes through the wall
+TEST_F(PhysWorldTest, FastBodyPassesThinWall) {
+	PhysWorldTestEntity box;
+	PhysWorldTestEntity wall;
+
+	wall.TranslateTo(Vec2(30.0, 0.0));
+
+	PhysBody* wallBody = CreateBody(kPhysBodyStatic, &wall, 2.0, 20.0);
+	PhysBody* boxBody = CreateBody(kPhysBodyDynamic, &box, 4.0, 4.0);
+	boxBody->SetVelocity(Vec2(50.0, 0.0));
+
+	world.Update();
+
+	EXPECT_EQ(box.GetWorldTransform().GetRow1().GetZ(), 50.0);
+	EXPECT_EQ(box.collisionCount, 0);
+
+	world.DestroyBody(boxBody);
+	world.DestroyBody(wallBody);
+}
+
+// Destroying a body moves another body within the store, which must keep
+// its properties
+TEST_F(PhysWorldTest, DestroyKeepsOtherBodies) {
+	PhysWorldTestEntity entities[3];
+
+	PhysBody* bodies[3];
+
+	for (int i = 0; i < 3; ++i) {
+		entities[i].TranslateTo(Vec2(100.0 * i, 0.0));
+
+		bodies[i] = CreateBody(kPhysBodyDynamic, &entities[i], 10.0 + i, 20.0 + i);
+		bodies[i]->SetVelocity(Vec2(0.0, 1.0 + i));
+	}
+
+	world.DestroyBody(bodies[0]);
+
+	EXPECT_EQ(bodies[2]->GetWidth(), 12.0);
+	EXPECT_EQ(bodies[2]->GetHeight(), 22.0);
+	EXPECT_EQ(bodies[2]->GetVelocity(), Vec2(0.0, 3.0));
+
+	world.Update();
+
+	EXPECT_EQ(entities[1].GetWorldTransform().GetRow2().GetZ(), 2.0);
+	EXPECT_EQ(entities[2].GetWorldTransform().GetRow2().GetZ(), 3.0);
+
+	world.DestroyBody(bodies[1]);
+	world.DestroyBody(bodies[2]);
+}
+
+// Handle of a destroyed body finds nothing, while the handles of the other
+// bodies still find them after they moved within the store
+TEST_F(PhysWorldTest, StaleBodyHandle) {
+	PhysWorldTestEntity entities[2];
+
+	PhysBody* body1 = CreateBody(kPhysBodyDynamic, &entities[0], 10.0, 10.0);
+	PhysBody* body2 = CreateBody(kPhysBodyDynamic, &entities[1], 20.0, 20.0);
+
+	PhysBodyHandle handle1 = body1->GetHandle();
+	PhysBodyHandle handle2 = body2->GetHandle();
+
+	world.DestroyBody(handle1);
+
+	EXPECT_EQ(world.GetBody(handle1), nullptr);
+	EXPECT_EQ(world.GetBody(handle2), body2);
+	EXPECT_EQ(body2->GetWidth(), 20.0);
+
+	// New body does not make the old handle valid again
+	PhysBody* body3 = CreateBody(kPhysBodyDynamic, &entities[0], 30.0, 30.0);
+
+	EXPECT_EQ(world.GetBody(handle1), nullptr);
+	EXPECT_EQ(world.GetBody(body3->GetHandle()), body3);
+
+	// Destroying it again does nothing
+	world.DestroyBody(handle1);
+
+	world.DestroyBody(body3);
+	world.DestroyBody(body2);
+}
+
+// Bodies that stay still fall asleep, static bodies after one step
+TEST_F(PhysWorldTest, StillBodiesFallAsleep) {
+	PhysWorldTestEntity wall;
+	PhysWorldTestEntity box;
+	box.TranslateTo(Vec2(100.0, 0.0));
+
+	PhysBody* wallBody = CreateBody(kPhysBodyStatic, &wall, 30.0, 30.0);
+	PhysBody* boxBody = CreateBody(kPhysBodyDynamic, &box, 10.0, 10.0);
+
+	world.Update();
+
+	EXPECT_TRUE(wallBody->IsAsleep());
+	EXPECT_FALSE(boxBody->IsAsleep());
+
+	for (int i = 1; i < kPhysWorldSleepSteps; ++i) {
+		world.Update();
+	}
+
+	EXPECT_TRUE(boxBody->IsAsleep());
+
+	boxBody->SetVelocity(Vec2(1.0, 0.0));
+
+	EXPECT_FALSE(boxBody->IsAsleep());
+
+	world.Update();
+
+	EXPECT_EQ(box.GetWorldTransform().GetRow1().GetZ(), 101.0);
+
+	world.DestroyBody(boxBody);
+	world.DestroyBody(wallBody);
+}
+
+// Moving body is still stopped by a static body that is asleep
+TEST_F(PhysWorldTest, DynamicStopsAtSleepingStatic) {
+	PhysWorldTestEntity wall;
+	PhysWorldTestEntity box;
+	box.TranslateTo(Vec2(40.0, 0.0));
+
+	PhysBody* wallBody = CreateBody(kPhysBodyStatic, &wall, 30.0, 30.0);
+	PhysBody* boxBody = CreateBody(kPhysBodyDynamic, &box, 10.0, 10.0);
+
+	world.Update();
+
+	ASSERT_TRUE(wallBody->IsAsleep());
+
+	boxBody->SetVelocity(Vec2(-15.0, 0.0));
+
+	world.Update();
+	world.Update();
+
+	EXPECT_EQ(box.GetWorldTransform().GetRow1().GetZ(), 20.0);
+	EXPECT_EQ(box.collisionCount, 1);
+	EXPECT_EQ(wall.collisionCount, 1);
+
+	world.DestroyBody(boxBody);
+	world.DestroyBody(wallBody);
+}
+
+// Static body moved onto a sleeping body pushes it out and wakes it up
+TEST_F(PhysWorldTest, MovedStaticWakesSleepingBody) {
+	PhysWorldTestEntity wall;
+	PhysWorldTestEntity box;
+	box.TranslateTo(Vec2(40.0, 0.0));
+
+	PhysBody* wallBody = CreateBody(kPhysBodyStatic, &wall, 30.0, 30.0);
+	PhysBody* boxBody = CreateBody(kPhysBodyDynamic, &box, 10.0, 10.0);
+
+	for (int i = 0; i < kPhysWorldSleepSteps; ++i) {
+		world.Update();
+	}
+
+	ASSERT_TRUE(boxBody->IsAsleep());
+
+	wallBody->TranslateTo(Vec2(25.0, 0.0));
+
+	world.Update();
+
+	EXPECT_FALSE(boxBody->IsAsleep());
+	EXPECT_EQ(box.GetWorldTransform().GetRow1().GetZ(), 45.0);
+	EXPECT_EQ(box.collisionCount, 1);
+
+	world.DestroyBody(boxBody);
+	world.DestroyBody(wallBody);
+}
+
+// Destroying a body moves a sleeping body within the store, which must
+// still be found at its new index
+TEST_F(PhysWorldTest, DestroyKeepsSleepingBodies) {
+	PhysWorldTestEntity other;
+	PhysWorldTestEntity wall;
+	PhysWorldTestEntity box;
+	other.TranslateTo(Vec2(-100.0, 0.0));
+	box.TranslateTo(Vec2(40.0, 0.0));
+
+	PhysBody* otherBody = CreateBody(kPhysBodyStatic, &other, 10.0, 10.0);
+	PhysBody* boxBody = CreateBody(kPhysBodyDynamic, &box, 10.0, 10.0);
+	PhysBody* wallBody = CreateBody(kPhysBodyStatic, &wall, 30.0, 30.0);
+
+	world.Update();
+
+	world.DestroyBody(otherBody);
+
+	boxBody->SetVelocity(Vec2(-15.0, 0.0));
+
+	world.Update();
+	world.Update();
+
+	EXPECT_EQ(box.GetWorldTransform().GetRow1().GetZ(), 20.0);
+
+	world.DestroyBody(boxBody);
+	world.DestroyBody(wallBody);
+}
+
+// Results must be bit identical for any number of worker threads
+TEST_F(PhysWorldTest, WorkersAreDeterministic) {
+	Vec2 positions1[kPhysWorldCrowdBodyCount];
+	Vec2 positions2[kPhysWorldCrowdBodyCount];
+
+	JobSystem jobSystem(3);
+
+	RunCrowdedWorld(nullptr, positions1);
+	RunCrowdedWorld(&jobSystem, positions2);
+
+	for (int i = 0; i < kPhysWorldCrowdBodyCount; ++i) {
+		EXPECT_EQ(memcmp(&positions1[i], &positions2[i], sizeof(Vec2)), 0);
+	}
+}
\ No newline at end of file
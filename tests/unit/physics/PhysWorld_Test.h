@@ -0,0 +1,56 @@
+#ifndef PHYSWORLD_TEST_H_
+#define PHYSWORLD_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include "physics/PhysWorld.h"
+#include "entity/Entity.h"
+
+
+const int kPhysWorldTestBodyMax = 16;
+
+// Entity that counts its collisions
+class PhysWorldTestEntity: public Entity {
+
+public:
+	PhysWorldTestEntity(): collisionCount(0) {}
+
+	virtual void Spawn() {}
+	virtual void Update() {}
+	virtual void OnCollision(Entity* entity) { ++collisionCount; }
+
+	int collisionCount;
+};
+
+//--------------------------------------------------
+// 
+// PhysWorldTest
+//
+// PhysWorld unit test
+//
+//--------------------------------------------------
+class PhysWorldTest: public ::testing::Test {
+
+protected:
+	PhysWorldTest():
+	world(kPhysWorldTestBodyMax) {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	// Creates a body of the specified size, centered on the entity
+	PhysBody* CreateBody(PhysBodyType_t type, PhysWorldTestEntity* entity, double width, double height) {
+		PhysBody* body = world.CreateBody(type, 0, entity);
+		body->SetOrigin(Vec2(width / 2.0, height / 2.0));
+		body->SetWidth(width);
+		body->SetHeight(height);
+
+		return body;
+	}
+
+	PhysWorld world;
+};
+
+#endif
\ No newline at end of file
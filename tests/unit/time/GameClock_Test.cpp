@@ -0,0 +1,42 @@
+#include "GameClock_Test.h"
+
+TEST_F(GameClockTest, NoTime) {
+	EXPECT_EQ(clock.Advance(0.0), 0);
+	EXPECT_EQ(clock.GetAlpha(), 0.0);
+	EXPECT_EQ(clock.GetStepCount(), 0u);
+}
+
+// Time less than a step is kept until it adds up to a whole step
+TEST_F(GameClockTest, AccumulatesPartialSteps) {
+	EXPECT_EQ(clock.Advance(kGameClockTestStepTime * 0.75), 0);
+	EXPECT_EQ(clock.GetAlpha(), 0.75);
+
+	EXPECT_EQ(clock.Advance(kGameClockTestStepTime * 0.5), 1);
+	EXPECT_EQ(clock.GetAlpha(), 0.25);
+
+	EXPECT_EQ(clock.Advance(kGameClockTestStepTime * 2.0), 2);
+	EXPECT_EQ(clock.GetAlpha(), 0.25);
+
+	EXPECT_EQ(clock.GetStepCount(), 3u);
+	EXPECT_EQ(clock.GetDroppedTime(), 0.0);
+}
+
+// Long frames run at most the max steps and drop the rest of the whole steps
+TEST_F(GameClockTest, LimitsSteps) {
+	EXPECT_EQ(clock.Advance(kGameClockTestStepTime * 10.5), kGameClockTestMaxSteps);
+	EXPECT_EQ(clock.GetAlpha(), 0.5);
+	EXPECT_EQ(clock.GetDroppedTime(), kGameClockTestStepTime * 6.0);
+
+	// Clock is not behind after the long frame
+	EXPECT_EQ(clock.Advance(kGameClockTestStepTime * 0.25), 0);
+	EXPECT_EQ(clock.GetAlpha(), 0.75);
+}
+
+TEST_F(GameClockTest, Reset) {
+	clock.Advance(kGameClockTestStepTime * 0.5);
+
+	clock.Reset();
+
+	EXPECT_EQ(clock.GetAlpha(), 0.0);
+	EXPECT_EQ(clock.Advance(kGameClockTestStepTime * 0.5), 0);
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef GAMECLOCK_TEST_H_
+#define GAMECLOCK_TEST_H_
+
+#include "base_include.h"
+
+#include <gtest/gtest.h>
+
+#include "time/GameClock.h"
+
+
+// Step time that is exact in binary so that results compare exactly
+const double kGameClockTestStepTime = 1.0 / 64.0;
+
+const int kGameClockTestMaxSteps = 4;
+
+//--------------------------------------------------
+// 
+// GameClockTest
+//
+// GameClock unit test
+//
+//--------------------------------------------------
+class GameClockTest: public ::testing::Test {
+
+protected:
+	GameClockTest():
+	clock(kGameClockTestStepTime, kGameClockTestMaxSteps) {}
+
+	// virtual void SetUp() {}
+	// virtual void TearDown() {}
+
+	GameClock clock;
+};
+
+#endif
\ No newline at end of file